@@ -11,6 +11,8 @@ option(GaussLib_ENABLE_INVERSE_OPERATOR "Enable inverse matrix operator (A ^ -1)
 option(GaussLib_DISABLE_AUTO_INIT "Disable automatic initialization" OFF)
 option(GaussLib_ROW_MAJOR_STORAGE "Use row-major storage (column-major storage otherwise)" OFF)
 option(GaussLib_ROW_VECTORS "Use row-vectors (column-vectors otherwise)" OFF)
+option(GaussLib_DISABLE_SIMD "Disable SSE/AVX intrinsics for batch functions" OFF)
+option(GaussLib_ENABLE_MULTI_THREADING "Enable multi-threading for batch functions" OFF)
 
 
 # === Macros ===
@@ -43,6 +45,14 @@ if(GaussLib_ROW_VECTORS)
 	add_definitions(-DGS_ROW_VECTORS)
 endif()
 
+if(GaussLib_DISABLE_SIMD)
+	add_definitions(-DGS_DISABLE_SIMD)
+endif()
+
+if(GaussLib_ENABLE_MULTI_THREADING)
+	add_definitions(-DGS_ENABLE_MULTI_THREADING)
+endif()
+
 
 # === Find library ===
 
@@ -40,8 +40,8 @@ M<T> MulAffineMatrices(const M<T>& lhs, const M<T>& rhs)
                 result(r, c) += lhs(r, i)*rhs(i, c);
         }
 
-        /* Accumulate the rest of the current column of 'lhs' and the implicit 1 of 'rhs' */
-        result(M<T>::rowsSparse - 1, c) += lhs(M<T>::rowsSparse - 1, c);
+        /* Accumulate the implicit 1 of 'lhs' and the rest of the current column of 'rhs' */
+        result(M<T>::rowsSparse - 1, c) += rhs(M<T>::rowsSparse - 1, c);
     }
 
     #else
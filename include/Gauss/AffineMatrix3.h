@@ -106,10 +106,7 @@ class AffineMatrix3T
             #endif
         }
 
-        AffineMatrix3T(const ThisType& rhs)
-        {
-            *this = rhs;
-        }
+        AffineMatrix3T(const ThisType&) = default;
 
         #ifdef GS_ROW_VECTORS
 
@@ -221,12 +218,7 @@ class AffineMatrix3T
             return *this;
         }
 
-        ThisType& operator = (const ThisType& rhs)
-        {
-            for (std::size_t i = 0; i < ThisType::elementsSparse; ++i)
-                m_[i] = rhs.m_[i];
-            return *this;
-        }
+        ThisType& operator = (const ThisType&) = default;
 
         #ifdef GS_ROW_VECTORS
 
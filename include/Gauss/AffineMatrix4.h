@@ -108,10 +108,7 @@ class AffineMatrix4T
             #endif
         }
 
-        AffineMatrix4T(const ThisType& rhs)
-        {
-            *this = rhs;
-        }
+        AffineMatrix4T(const ThisType&) = default;
 
         #ifdef GS_ROW_VECTORS
 
@@ -227,12 +224,7 @@ class AffineMatrix4T
             return *this;
         }
 
-        ThisType& operator = (const ThisType& rhs)
-        {
-            for (std::size_t i = 0; i < ThisType::elementsSparse; ++i)
-                m_[i] = rhs.m_[i];
-            return *this;
-        }
+        ThisType& operator = (const ThisType&) = default;
 
         #ifdef GS_ROW_VECTORS
 
@@ -20,6 +20,7 @@
 #include <cmath>
 #include <cstddef>
 #include <algorithm>
+#include <limits>
 #include <vector>
 #include <type_traits>
 
@@ -0,0 +1,193 @@
+/*
+ * BatchAlgebra.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_BATCH_ALGEBRA_H
+#define GS_BATCH_ALGEBRA_H
+
+
+#include "SIMD.h"
+#include "Algebra.h"
+#include "Vector3.h"
+#include "Matrix.h"
+
+#include <cstddef>
+
+
+namespace Gs
+{
+
+
+#ifdef GS_SIMD_SSE2
+
+namespace Details
+{
+
+
+/*
+Converts four packed 3D vectors (12 floats in the registers a, b, c) into SoA layout:
+a = (x0 y0 z0 x1), b = (y1 z1 x2 y2), c = (z2 x3 y3 z3)  -->  x = (x0 x1 x2 x3), y = (y0 y1 y2 y3), z = (z0 z1 z2 z3)
+*/
+inline void DeinterleaveVector3SSE(__m128 a, __m128 b, __m128 c, __m128& x, __m128& y, __m128& z)
+{
+    x = _mm_shuffle_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 0, 0)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+    y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+    z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+//! Inverse of "DeinterleaveVector3SSE".
+inline void InterleaveVector3SSE(__m128 x, __m128 y, __m128 z, __m128& a, __m128& b, __m128& c)
+{
+    a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+    b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+    c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+
+} // /namespace Details
+
+#endif
+
+namespace Details
+{
+
+
+// Transposes the element arrays of contiguous 4x4 matrices with one tile transpose per matrix. 'input' and 'output' may be equal.
+template <typename T>
+void TransposeArray4x4(const Matrix<T, 4, 4>* input, Matrix<T, 4, 4>* output, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        Transpose4x4(input[i].Ptr(), 4, output[i].Ptr(), 4);
+}
+
+
+} // /namespace Details
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Normalizes all vectors of the specified array to the unit length of 1.
+\param[in,out] vectors Pointer to the first vector.
+\param[in] count Number of vectors.
+\remarks Vectors with a length of zero remain unchanged.
+\see Normalize
+*/
+template <typename VectorType>
+void NormalizeArray(VectorType* vectors, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        Normalize(vectors[i]);
+}
+
+/**
+\brief Normalizes all 3D vectors of the specified array to the unit length of 1.
+\remarks This overload processes four vectors at once with SSE if the macro 'GS_SIMD_SSE2' is defined.
+\see NormalizeArray
+*/
+inline void NormalizeArray(Vector3T<float>* vectors, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #ifdef GS_SIMD_SSE2
+
+    static_assert(sizeof(Vector3T<float>) == sizeof(float)*3, "Vector3T<float> must be tightly packed");
+
+    const __m128 one    = _mm_set1_ps(1.0f);
+    const __m128 zero   = _mm_setzero_ps();
+
+    for (; i + 4 <= count; i += 4)
+    {
+        auto ptr = vectors[i].Ptr();
+
+        /* Load four vectors and compute their reciprocal lengths in SoA layout */
+        __m128 a = _mm_loadu_ps(ptr), b = _mm_loadu_ps(ptr + 4), c = _mm_loadu_ps(ptr + 8);
+        __m128 x, y, z;
+        Details::DeinterleaveVector3SSE(a, b, c, x, y, z);
+
+        const __m128 lenSq  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+        const __m128 mask   = _mm_cmpgt_ps(lenSq, zero);
+        const __m128 scale  = _mm_or_ps(_mm_and_ps(mask, _mm_div_ps(one, _mm_sqrt_ps(lenSq))), _mm_andnot_ps(mask, one));
+
+        /* Broadcast scales back to the packed layout: (s0 s0 s0 s1), (s1 s1 s2 s2), (s2 s3 s3 s3) */
+        a = _mm_mul_ps(a, _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(1, 0, 0, 0)));
+        b = _mm_mul_ps(b, _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(2, 2, 1, 1)));
+        c = _mm_mul_ps(c, _mm_shuffle_ps(scale, scale, _MM_SHUFFLE(3, 3, 3, 2)));
+
+        _mm_storeu_ps(ptr,     a);
+        _mm_storeu_ps(ptr + 4, b);
+        _mm_storeu_ps(ptr + 8, c);
+    }
+
+    #endif
+
+    for (; i < count; ++i)
+        Normalize(vectors[i]);
+}
+
+/**
+\brief Transposes all matrices of the input array into the output array.
+\param[in] input Pointer to the first input matrix.
+\param[out] output Pointer to the first output matrix. This must not overlap with the input array.
+\param[in] count Number of matrices.
+\remarks This can be used to convert an array of transformations between column-major and row-major consumers.
+\see Matrix::Transposed
+*/
+template <typename T, std::size_t Rows, std::size_t Cols>
+void TransposeArray(const Matrix<T, Rows, Cols>* input, Matrix<T, Cols, Rows>* output, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = input[i].Transposed();
+}
+
+/**
+\brief Transposes all 4x4 float matrices of the input array into the output array.
+\remarks The element array of each matrix is transposed directly in SIMD registers (see "MatrixKernels.h"),
+without the temporary matrix of "Matrix::Transposed".
+\see TransposeArray(const Matrix<T, Rows, Cols>*, Matrix<T, Cols, Rows>*, std::size_t)
+*/
+inline void TransposeArray(const Matrix<float, 4, 4>* input, Matrix<float, 4, 4>* output, std::size_t count)
+{
+    Details::TransposeArray4x4(input, output, count);
+}
+
+//! Transposes all 4x4 double matrices of the input array into the output array. \see TransposeArray(const Matrix<float, 4, 4>*, Matrix<float, 4, 4>*, std::size_t)
+inline void TransposeArray(const Matrix<double, 4, 4>* input, Matrix<double, 4, 4>* output, std::size_t count)
+{
+    Details::TransposeArray4x4(input, output, count);
+}
+
+/**
+\brief Transposes all matrices of the specified array in place.
+\see Matrix::Transpose
+*/
+template <typename T, std::size_t N>
+void TransposeArray(Matrix<T, N, N>* matrices, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        matrices[i].Transpose();
+}
+
+//! Transposes all 4x4 float matrices of the specified array in place, directly in SIMD registers. \see TransposeArray(Matrix<T, N, N>*, std::size_t)
+inline void TransposeArray(Matrix<float, 4, 4>* matrices, std::size_t count)
+{
+    Details::TransposeArray4x4(matrices, matrices, count);
+}
+
+//! Transposes all 4x4 double matrices of the specified array in place, directly in SIMD registers. \see TransposeArray(Matrix<T, N, N>*, std::size_t)
+inline void TransposeArray(Matrix<double, 4, 4>* matrices, std::size_t count)
+{
+    Details::TransposeArray4x4(matrices, matrices, count);
+}
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,406 @@
+/*
+ * CastArray.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_CAST_ARRAY_H
+#define GS_CAST_ARRAY_H
+
+
+#include "SIMD.h"
+#include "Assert.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+
+namespace Gs
+{
+
+
+//! Rounding modes for floating-point to integer conversions of the "CastArray" function.
+enum class CastRounding
+{
+    Truncate,   //!< Round towards zero (like static_cast).
+    Nearest,    //!< Round to the nearest integer, ties to even.
+    Floor,      //!< Round towards negative infinity.
+    Ceil,       //!< Round towards positive infinity.
+};
+
+
+namespace Details
+{
+
+
+// Scalar type of the specified arithmetic type or Gauss type (with 'ScalarType').
+template <typename T, bool Arithmetic = std::is_arithmetic<T>::value>
+struct CastScalarType
+{
+    using Type = T;
+};
+
+template <typename T>
+struct CastScalarType<T, false>
+{
+    using Type = typename T::ScalarType;
+};
+
+template <typename T>
+T RoundScalar(const T& x, CastRounding rounding)
+{
+    switch (rounding)
+    {
+        case CastRounding::Truncate:    return std::trunc(x);
+        case CastRounding::Nearest:     return std::nearbyint(x);
+        case CastRounding::Floor:       return std::floor(x);
+        case CastRounding::Ceil:        return std::ceil(x);
+    }
+    return x;
+}
+
+// Floating-point to integer conversion with rounding and optional saturation.
+template <typename Dst, typename Src>
+Dst CastScalar(const Src& x, CastRounding rounding, bool saturate, std::true_type)
+{
+    const Src r = RoundScalar(x, rounding);
+    if (saturate)
+    {
+        if (r != r)
+            return Dst(0);
+        if (r <= static_cast<Src>(std::numeric_limits<Dst>::lowest()))
+            return std::numeric_limits<Dst>::lowest();
+        if (r >= static_cast<Src>(std::numeric_limits<Dst>::max()))
+            return std::numeric_limits<Dst>::max();
+    }
+    return static_cast<Dst>(r);
+}
+
+// All other conversions.
+template <typename Dst, typename Src>
+Dst CastScalar(const Src& x, CastRounding, bool, std::false_type)
+{
+    return static_cast<Dst>(x);
+}
+
+// Returns true if the byte ranges [a, a + sizeA) and [b, b + sizeB) overlap.
+inline bool MemoryRangesOverlap(const void* a, std::size_t sizeA, const void* b, std::size_t sizeB)
+{
+    const auto addrA = reinterpret_cast<std::uintptr_t>(a);
+    const auto addrB = reinterpret_cast<std::uintptr_t>(b);
+    return (addrA < addrB + sizeB && addrB < addrA + sizeA);
+}
+
+template <typename Dst, typename Src>
+void CastScalarRange(Dst* dst, const Src* src, std::size_t count, CastRounding rounding, bool saturate)
+{
+    using FloatToInt = std::integral_constant<bool, std::is_integral<Dst>::value && std::is_floating_point<Src>::value>;
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = CastScalar<Dst>(src[i], rounding, saturate, FloatToInt());
+}
+
+// Generic conversion kernel, specialized below for the conversions with native SIMD instructions.
+template <typename Dst, typename Src>
+struct CastKernel
+{
+    static void Run(Dst* dst, const Src* src, std::size_t count, CastRounding rounding, bool saturate)
+    {
+        CastScalarRange(dst, src, count, rounding, saturate);
+    }
+};
+
+#ifdef GS_SIMD_SSE2
+
+// Returns true if the specified rounding mode can be performed by the SIMD kernels.
+inline bool IsSIMDRoundingSupported(CastRounding rounding)
+{
+    #ifdef GS_SIMD_SSE4_1
+    (void)rounding;
+    return true;
+    #else
+    return (rounding == CastRounding::Truncate || rounding == CastRounding::Nearest);
+    #endif
+}
+
+#ifdef GS_SIMD_SSE4_1
+
+inline __m128 RoundPacket(__m128 v, CastRounding rounding)
+{
+    switch (rounding)
+    {
+        case CastRounding::Truncate:    return _mm_round_ps(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        case CastRounding::Nearest:     return _mm_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        case CastRounding::Floor:       return _mm_round_ps(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+        case CastRounding::Ceil:        return _mm_round_ps(v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+    }
+    return v;
+}
+
+inline __m128d RoundPacket(__m128d v, CastRounding rounding)
+{
+    switch (rounding)
+    {
+        case CastRounding::Truncate:    return _mm_round_pd(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        case CastRounding::Nearest:     return _mm_round_pd(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        case CastRounding::Floor:       return _mm_round_pd(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+        case CastRounding::Ceil:        return _mm_round_pd(v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+    }
+    return v;
+}
+
+#endif
+
+/*
+Converts 4 floats to 4 int32 values. Without SSE4.1 only 'Truncate' and 'Nearest' are supported,
+where 'Nearest' relies on the default rounding mode of the MXCSR register.
+Out of range values result in 0x80000000 (cvtps2dq), which is fixed up when saturation is enabled.
+*/
+inline __m128i ConvertPacketToInt32(__m128 v, CastRounding rounding, bool saturate)
+{
+    #ifdef GS_SIMD_SSE4_1
+    v = RoundPacket(v, rounding);
+    auto r = _mm_cvttps_epi32(v);
+    #else
+    auto r = (rounding == CastRounding::Nearest ? _mm_cvtps_epi32(v) : _mm_cvttps_epi32(v));
+    #endif
+
+    if (saturate)
+    {
+        /* Flip 0x80000000 to 0x7fffffff for positive overflow, and clear NaN to zero */
+        const auto overflow = _mm_castps_si128(_mm_cmpge_ps(v, _mm_set1_ps(2147483648.0f)));
+        const auto ordered  = _mm_castps_si128(_mm_cmpord_ps(v, v));
+        r = _mm_and_si128(_mm_xor_si128(r, overflow), ordered);
+    }
+
+    return r;
+}
+
+// Converts 2 doubles to 2 int32 values in the lower 64 bits (see ConvertPacketToInt32 for __m128).
+inline __m128i ConvertPacketToInt32(__m128d v, CastRounding rounding, bool saturate)
+{
+    #ifdef GS_SIMD_SSE4_1
+    v = RoundPacket(v, rounding);
+    auto r = _mm_cvttpd_epi32(v);
+    #else
+    auto r = (rounding == CastRounding::Nearest ? _mm_cvtpd_epi32(v) : _mm_cvttpd_epi32(v));
+    #endif
+
+    if (saturate)
+    {
+        #ifdef GS_SIMD_SSE4_1
+        const auto threshold = _mm_set1_pd(2147483648.0);
+        #else
+        /* Without SSE4.1 the rounded value is not available, so 'Nearest' must use the midpoint as threshold */
+        const auto threshold = _mm_set1_pd(rounding == CastRounding::Nearest ? 2147483647.5 : 2147483648.0);
+        #endif
+        const auto overflow = _mm_castpd_ps(_mm_cmpge_pd(v, threshold));
+        const auto ordered  = _mm_castpd_ps(_mm_cmpord_pd(v, v));
+        r = _mm_and_si128(
+            _mm_xor_si128(r, _mm_castps_si128(_mm_shuffle_ps(overflow, overflow, _MM_SHUFFLE(2, 0, 2, 0)))),
+            _mm_castps_si128(_mm_shuffle_ps(ordered, ordered, _MM_SHUFFLE(2, 0, 2, 0)))
+        );
+    }
+
+    return r;
+}
+
+// float -> double (cvtps2pd)
+template <>
+struct CastKernel<double, float>
+{
+    static void Run(double* dst, const float* src, std::size_t count, CastRounding rounding, bool saturate)
+    {
+        std::size_t i = 0;
+
+        #ifdef GS_SIMD_AVX
+        for (; i + 4 <= count; i += 4)
+            _mm256_storeu_pd(dst + i, _mm256_cvtps_pd(_mm_loadu_ps(src + i)));
+        #else
+        for (; i + 4 <= count; i += 4)
+        {
+            const auto v = _mm_loadu_ps(src + i);
+            _mm_storeu_pd(dst + i,     _mm_cvtps_pd(v));
+            _mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+        }
+        #endif
+
+        CastScalarRange(dst + i, src + i, count - i, rounding, saturate);
+    }
+};
+
+// double -> float (cvtpd2ps)
+template <>
+struct CastKernel<float, double>
+{
+    static void Run(float* dst, const double* src, std::size_t count, CastRounding rounding, bool saturate)
+    {
+        std::size_t i = 0;
+
+        #ifdef GS_SIMD_AVX
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_ps(dst + i, _mm256_cvtpd_ps(_mm256_loadu_pd(src + i)));
+        #else
+        for (; i + 4 <= count; i += 4)
+        {
+            const auto lo = _mm_cvtpd_ps(_mm_loadu_pd(src + i));
+            const auto hi = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 2));
+            _mm_storeu_ps(dst + i, _mm_movelh_ps(lo, hi));
+        }
+        #endif
+
+        CastScalarRange(dst + i, src + i, count - i, rounding, saturate);
+    }
+};
+
+// int32 -> float (cvtdq2ps)
+template <>
+struct CastKernel<float, std::int32_t>
+{
+    static void Run(float* dst, const std::int32_t* src, std::size_t count, CastRounding rounding, bool saturate)
+    {
+        std::size_t i = 0;
+
+        #ifdef GS_SIMD_AVX
+        for (; i + 8 <= count; i += 8)
+            _mm256_storeu_ps(dst + i, _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i))));
+        #endif
+
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_ps(dst + i, _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+
+        CastScalarRange(dst + i, src + i, count - i, rounding, saturate);
+    }
+};
+
+// int32 -> double (cvtdq2pd)
+template <>
+struct CastKernel<double, std::int32_t>
+{
+    static void Run(double* dst, const std::int32_t* src, std::size_t count, CastRounding rounding, bool saturate)
+    {
+        std::size_t i = 0;
+
+        #ifdef GS_SIMD_AVX
+        for (; i + 4 <= count; i += 4)
+            _mm256_storeu_pd(dst + i, _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+        #else
+        for (; i + 2 <= count; i += 2)
+            _mm_storeu_pd(dst + i, _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i))));
+        #endif
+
+        CastScalarRange(dst + i, src + i, count - i, rounding, saturate);
+    }
+};
+
+// float -> int32 (cvttps2dq/cvtps2dq)
+template <>
+struct CastKernel<std::int32_t, float>
+{
+    static void Run(std::int32_t* dst, const float* src, std::size_t count, CastRounding rounding, bool saturate)
+    {
+        std::size_t i = 0;
+
+        if (IsSIMDRoundingSupported(rounding))
+        {
+            for (; i + 4 <= count; i += 4)
+            {
+                _mm_storeu_si128(
+                    reinterpret_cast<__m128i*>(dst + i),
+                    ConvertPacketToInt32(_mm_loadu_ps(src + i), rounding, saturate)
+                );
+            }
+        }
+
+        CastScalarRange(dst + i, src + i, count - i, rounding, saturate);
+    }
+};
+
+// double -> int32 (cvttpd2dq/cvtpd2dq)
+template <>
+struct CastKernel<std::int32_t, double>
+{
+    static void Run(std::int32_t* dst, const double* src, std::size_t count, CastRounding rounding, bool saturate)
+    {
+        std::size_t i = 0;
+
+        if (IsSIMDRoundingSupported(rounding))
+        {
+            for (; i + 4 <= count; i += 4)
+            {
+                const auto lo = ConvertPacketToInt32(_mm_loadu_pd(src + i), rounding, saturate);
+                const auto hi = ConvertPacketToInt32(_mm_loadu_pd(src + i + 2), rounding, saturate);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi64(lo, hi));
+            }
+        }
+
+        CastScalarRange(dst + i, src + i, count - i, rounding, saturate);
+    }
+};
+
+#endif // /GS_SIMD_SSE2
+
+
+} // /namespace Details
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Converts an entire array of scalars or Gauss types into another precision.
+\param[out] dst Pointer to the destination array. This must have space for at least 'count' elements.
+\param[in] src Pointer to the source array with 'count' elements. For conversions to a scalar type of the same or a smaller size (e.g. double to float),
+this must not overlap with 'dst' unless both are the same, i.e. the conversion can be done in place. For widening conversions (e.g. float to double, or int32 to double)
+this must not overlap with 'dst' at all, because the elements are converted front to back and would overwrite source elements before they are read.
+\param[in] count Specifies the number of elements (i.e. scalars, vectors, matrices etc.) to convert.
+\param[in] rounding Specifies the rounding mode for floating-point to integer conversions. By default CastRounding::Truncate.
+\param[in] saturate Specifies whether floating-point to integer conversions are clamped to the range of the integer type,
+where NaN is converted to zero. Otherwise, out of range values are undefined. By default false.
+\remarks This operates on the raw storage (see 'Ptr()') of the Gauss types, i.e. this is the same as calling 'Cast<D>()'
+for each element but the conversions of float, double and int32 are performed with SSE/AVX instructions.
+Both types must have the same number of scalar components, e.g. Matrix4d to Matrix4f, or Vector3i to Vector3f.
+\code
+std::vector<Gs::Matrix4d> simTransforms = ...;
+std::vector<Gs::Matrix4f> renderTransforms(simTransforms.size());
+Gs::CastArray(renderTransforms.data(), simTransforms.data(), simTransforms.size());
+\endcode
+\see Vector::Cast
+\see Matrix::Cast
+*/
+template <typename Dst, typename Src>
+void CastArray(Dst* dst, const Src* src, std::size_t count, CastRounding rounding = CastRounding::Truncate, bool saturate = false)
+{
+    using DstScalar = typename Details::CastScalarType<Dst>::Type;
+    using SrcScalar = typename Details::CastScalarType<Src>::Type;
+
+    static_assert(
+        sizeof(Dst) / sizeof(DstScalar) == sizeof(Src) / sizeof(SrcScalar),
+        "CastArray requires source and destination types with the same number of scalar components"
+    );
+
+    GS_ASSERT(
+        sizeof(DstScalar) <= sizeof(SrcScalar) ||
+        !Details::MemoryRangesOverlap(dst, sizeof(Dst)*count, src, sizeof(Src)*count)
+    );
+
+    Details::CastKernel<DstScalar, SrcScalar>::Run(
+        reinterpret_cast<DstScalar*>(dst),
+        reinterpret_cast<const SrcScalar*>(src),
+        count * (sizeof(Src) / sizeof(SrcScalar)),
+        rounding,
+        saturate
+    );
+}
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
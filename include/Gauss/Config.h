@@ -34,6 +34,12 @@
 //! Enables row vectors. If undefined, column vectors are used (default).
 //#define GS_ROW_VECTORS
 
+//! Disables SSE/AVX intrinsics for the batch functions. If undefined, the instruction sets the compiler targets are used (default).
+//#define GS_DISABLE_SIMD
+
+//! Enables multi-threading for the batch functions (requires std::thread). If undefined, all batch functions run on the calling thread (default).
+//#define GS_ENABLE_MULTI_THREADING
+
 
 #endif
 
@@ -0,0 +1,675 @@
+/*
+ * ConvexHull.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_CONVEX_HULL_H
+#define GS_CONVEX_HULL_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/Parallel.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+
+namespace Gs
+{
+
+
+namespace Details
+{
+
+
+// Half-edge of the convex hull; 'vertex' is the point index of the edge's head.
+struct HullHalfEdge
+{
+    std::uint32_t vertex;
+    std::uint32_t next;
+    std::uint32_t twin;
+    std::uint32_t face;
+};
+
+// Triangle of the convex hull with its plane and the list of outside points (conflict list) it can see.
+template <typename T>
+struct HullFace
+{
+    std::uint32_t   edge;
+    Vector3T<T>     normal;
+    T               offset;
+    std::uint32_t   firstPoint;
+    std::uint32_t   furthestPoint;
+    T               furthestDistance;
+    std::uint32_t   stamp;
+    bool            alive;
+    bool            visible;
+};
+
+// Face of the depth-first search for the horizon with the edge to continue at.
+struct HullHorizonEntry
+{
+    std::uint32_t   firstEdge;
+    std::uint32_t   edge;
+    bool            started;
+};
+
+template <typename T>
+struct HullFaceQueueEntry
+{
+    T               distance;
+    std::uint32_t   face;
+    std::uint32_t   stamp;
+
+    bool operator < (const HullFaceQueueEntry& rhs) const
+    {
+        return (distance < rhs.distance);
+    }
+};
+
+/*
+Quickhull algorithm in 3D (Barber, Dobkin & Huhdanpaa).
+Faces and half-edges are allocated from arenas (vectors with free lists), and the conflict lists are singly linked lists through the point indices,
+so no memory is allocated per face. The partitioning of the points onto new faces is distributed with "ParallelFor".
+The point with the greatest distance over all faces is added first, so a vertex limit yields the most extreme points.
+Faces are only triangles (coplanar faces are not merged), so the tolerance is kept as small as possible.
+*/
+template <typename T>
+class QuickHull
+{
+
+    public:
+
+        static const std::uint32_t invalidIndex = 0xffffffff;
+
+        /*
+        Precision of the face planes and distances: single precision points are processed in double precision,
+        because sliver triangles between nearby points (e.g. on densely sampled spheres) would otherwise fold the hull.
+        */
+        using R = typename std::conditional<std::is_same<T, float>::value, double, T>::type;
+
+        QuickHull(const Vector3T<T>* points, std::size_t numPoints) :
+            points_    { points                             },
+            numPoints_ { numPoints                          },
+            nextPoint_ ( numPoints, std::uint32_t(invalidIndex) )
+        {
+        }
+
+        // Builds the hull and returns false if the points are degenerated (coplanar, collinear, or less than four).
+        bool Build(std::size_t maxVertices)
+        {
+            if (numPoints_ < 4 || !BuildInitialTetrahedron())
+                return false;
+
+            std::size_t numVertices = 4;
+
+            while (!queue_.empty() && (maxVertices == 0 || numVertices < maxVertices))
+            {
+                const auto entry = queue_.top();
+                queue_.pop();
+
+                /* Skip stale entries (lazy update) */
+                const auto& face = faces_[entry.face];
+                if (!face.alive || face.stamp != entry.stamp || face.firstPoint == invalidIndex)
+                    continue;
+
+                AddPoint(entry.face);
+
+                /* Euler's formula for closed triangle meshes: V = F/2 + 2 */
+                numVertices = numAliveFaces_/2 + 2;
+            }
+
+            return true;
+        }
+
+        // Writes the triangle indices (into the input points) of the hull, which are counter-clockwise when seen from outside.
+        template <typename Index>
+        void Output(std::vector<Index>& outIndices) const
+        {
+            outIndices.clear();
+            outIndices.reserve(numAliveFaces_*3);
+
+            for (const auto& face : faces_)
+            {
+                if (!face.alive)
+                    continue;
+
+                auto e = face.edge;
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                    outIndices.push_back(static_cast<Index>(edges_[e].vertex));
+                    e = edges_[e].next;
+                }
+            }
+        }
+
+    private:
+
+        // Returns the specified point in the precision of the hull planes.
+        Vector3T<R> Point(std::uint32_t point) const
+        {
+            return points_[point].template Cast<R>();
+        }
+
+        R Distance(std::uint32_t face, std::uint32_t point) const
+        {
+            return Dot(faces_[face].normal, Point(point)) - faces_[face].offset;
+        }
+
+        // Returns the index of the point in the specified range with the greatest distance to the line (a, b), or to the plane if 'c' is valid.
+        std::uint32_t FindFurthestPoint(std::uint32_t a, std::uint32_t b, std::uint32_t c, R& maxDistance) const
+        {
+            const auto pa = Point(a);
+            const auto ab = Point(b) - pa;
+
+            Vector3T<R> normal;
+            if (c != invalidIndex)
+                normal = Cross(ab, Point(c) - pa);
+
+            const std::size_t numChunks = ParallelChunks(numPoints_, 16384);
+            std::vector<std::uint32_t> chunkPoints(numChunks, std::uint32_t(invalidIndex));
+            std::vector<R> chunkDistances(numChunks, R(0));
+
+            ParallelFor(
+                numPoints_, 16384,
+                [&](std::size_t begin, std::size_t end, std::size_t chunk)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        const auto ap = Point(i) - pa;
+                        const R d = (c != invalidIndex ? std::abs(Dot(normal, ap)) : Cross(ab, ap).LengthSq());
+                        if (d > chunkDistances[chunk])
+                        {
+                            chunkDistances[chunk] = d;
+                            chunkPoints[chunk] = static_cast<std::uint32_t>(i);
+                        }
+                    }
+                }
+            );
+
+            auto furthest = std::uint32_t(invalidIndex);
+            maxDistance = R(0);
+
+            for (std::size_t chunk = 0; chunk < numChunks; ++chunk)
+            {
+                if (chunkDistances[chunk] > maxDistance)
+                {
+                    maxDistance = chunkDistances[chunk];
+                    furthest = chunkPoints[chunk];
+                }
+            }
+
+            return furthest;
+        }
+
+        bool BuildInitialTetrahedron()
+        {
+            /* Find extreme points along the axes and the tolerance from the bounding box */
+            const std::size_t numChunks = ParallelChunks(numPoints_, 16384);
+            std::vector<std::uint32_t> chunkExtremes(numChunks*6, 0);
+
+            ParallelFor(
+                numPoints_, 16384,
+                [&](std::size_t begin, std::size_t end, std::size_t chunk)
+                {
+                    std::uint32_t* extremes = &chunkExtremes[chunk*6];
+                    for (std::size_t j = 0; j < 6; ++j)
+                        extremes[j] = static_cast<std::uint32_t>(begin);
+
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        for (std::size_t axis = 0; axis < 3; ++axis)
+                        {
+                            if (points_[i][axis] < points_[extremes[axis*2]][axis])
+                                extremes[axis*2] = static_cast<std::uint32_t>(i);
+                            if (points_[i][axis] > points_[extremes[axis*2 + 1]][axis])
+                                extremes[axis*2 + 1] = static_cast<std::uint32_t>(i);
+                        }
+                    }
+                }
+            );
+
+            std::uint32_t extremes[6];
+            std::copy(chunkExtremes.begin(), chunkExtremes.begin() + 6, extremes);
+
+            for (std::size_t chunk = 1; chunk < numChunks; ++chunk)
+            {
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    const auto lo = chunkExtremes[chunk*6 + axis*2], hi = chunkExtremes[chunk*6 + axis*2 + 1];
+                    if (points_[lo][axis] < points_[extremes[axis*2]][axis])
+                        extremes[axis*2] = lo;
+                    if (points_[hi][axis] > points_[extremes[axis*2 + 1]][axis])
+                        extremes[axis*2 + 1] = hi;
+                }
+            }
+
+            R maxCoord = R(0);
+            for (std::size_t axis = 0; axis < 3; ++axis)
+                maxCoord += std::max(std::abs(Point(extremes[axis*2])[axis]), std::abs(Point(extremes[axis*2 + 1])[axis]));
+
+            tolerance_ = R(3) * std::numeric_limits<R>::epsilon() * maxCoord;
+
+            /* Initial tetrahedron: the most distant pair of extreme points, the furthest point to their line, and the furthest point to their plane */
+            std::uint32_t v[4] = { 0, 0, invalidIndex, invalidIndex };
+            R maxDistance = R(0);
+
+            for (std::size_t i = 0; i < 6; ++i)
+            {
+                for (std::size_t j = i + 1; j < 6; ++j)
+                {
+                    const R d = DistanceSq(Point(extremes[i]), Point(extremes[j]));
+                    if (d > maxDistance)
+                    {
+                        maxDistance = d;
+                        v[0] = extremes[i];
+                        v[1] = extremes[j];
+                    }
+                }
+            }
+
+            if (std::sqrt(maxDistance) <= tolerance_)
+                return false;
+
+            v[2] = FindFurthestPoint(v[0], v[1], invalidIndex, maxDistance);
+            if (v[2] == invalidIndex || std::sqrt(maxDistance) <= tolerance_ * std::sqrt(DistanceSq(Point(v[0]), Point(v[1]))))
+                return false;
+
+            v[3] = FindFurthestPoint(v[0], v[1], v[2], maxDistance);
+            if (v[3] == invalidIndex || maxDistance <= tolerance_ * Cross(Point(v[1]) - Point(v[0]), Point(v[2]) - Point(v[0])).Length())
+                return false;
+
+            /* Orient the base triangle (v0, v1, v2) so that v3 lies behind it */
+            if (Dot(Cross(Point(v[1]) - Point(v[0]), Point(v[2]) - Point(v[0])), Point(v[3]) - Point(v[0])) > R(0))
+                std::swap(v[1], v[2]);
+
+            const std::uint32_t faces[4][3] =
+            {
+                { v[0], v[1], v[2] },
+                { v[0], v[3], v[1] },
+                { v[1], v[3], v[2] },
+                { v[2], v[3], v[0] },
+            };
+
+            std::uint32_t newFaces[4];
+            for (std::size_t i = 0; i < 4; ++i)
+                newFaces[i] = AllocFace(faces[i][0], faces[i][1], faces[i][2]);
+
+            /* Connect the twins of all 12 half-edges by brute force */
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                auto e = faces_[newFaces[i]].edge;
+                for (std::size_t j = 0; j < 3; ++j, e = edges_[e].next)
+                {
+                    const auto tail = edges_[edges_[edges_[e].next].next].vertex;
+                    for (std::size_t k = 0; k < 4; ++k)
+                    {
+                        auto f = faces_[newFaces[k]].edge;
+                        for (std::size_t l = 0; l < 3; ++l, f = edges_[f].next)
+                        {
+                            if (edges_[f].vertex == tail && edges_[edges_[edges_[f].next].next].vertex == edges_[e].vertex)
+                                edges_[e].twin = f;
+                        }
+                    }
+                }
+            }
+
+            /* Partition all points onto the initial faces */
+            candidates_.resize(numPoints_);
+            for (std::size_t i = 0; i < numPoints_; ++i)
+                candidates_[i] = static_cast<std::uint32_t>(i);
+
+            for (auto i : v)
+                candidates_[i] = invalidIndex;
+
+            PartitionPoints(newFaces, newFaces + 4);
+
+            return true;
+        }
+
+        std::uint32_t AllocEdge()
+        {
+            if (!freeEdges_.empty())
+            {
+                const auto e = freeEdges_.back();
+                freeEdges_.pop_back();
+                return e;
+            }
+            edges_.push_back(HullHalfEdge());
+            return static_cast<std::uint32_t>(edges_.size() - 1);
+        }
+
+        // Allocates a new face for the triangle (a, b, c) with the half-edges a->b, b->c, c->a; the twins are not connected.
+        std::uint32_t AllocFace(std::uint32_t a, std::uint32_t b, std::uint32_t c)
+        {
+            std::uint32_t f;
+            if (!freeFaces_.empty())
+            {
+                f = freeFaces_.back();
+                freeFaces_.pop_back();
+            }
+            else
+            {
+                faces_.push_back(HullFace<R>());
+                faces_.back().stamp = 0;
+                f = static_cast<std::uint32_t>(faces_.size() - 1);
+            }
+
+            const std::uint32_t e[3] = { AllocEdge(), AllocEdge(), AllocEdge() };
+            const std::uint32_t heads[3] = { b, c, a };
+
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                edges_[e[i]].vertex = heads[i];
+                edges_[e[i]].next   = e[(i + 1) % 3];
+                edges_[e[i]].twin   = invalidIndex;
+                edges_[e[i]].face   = f;
+            }
+
+            auto& face = faces_[f];
+            {
+                const auto normal = Cross(Point(b) - Point(a), Point(c) - Point(a));
+                const R len = normal.Length();
+
+                face.edge               = e[0];
+                face.normal             = (len > R(0) ? normal / len : Vector3T<R>(R(0)));
+                face.offset             = Dot(face.normal, Point(a));
+                face.firstPoint         = invalidIndex;
+                face.furthestPoint      = invalidIndex;
+                face.furthestDistance   = R(0);
+                face.alive              = true;
+                face.visible            = false;
+                ++face.stamp;
+            }
+
+            ++numAliveFaces_;
+
+            return f;
+        }
+
+        void FreeFace(std::uint32_t f)
+        {
+            auto e = faces_[f].edge;
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                freeEdges_.push_back(e);
+                e = edges_[e].next;
+            }
+            faces_[f].alive = false;
+            freeFaces_.push_back(f);
+            --numAliveFaces_;
+        }
+
+        /*
+        Assigns each point of the candidate list to the face of the specified range it has the greatest distance to.
+        Points that are not outside of any face are inside the hull and discarded.
+        */
+        void PartitionPoints(const std::uint32_t* facesBegin, const std::uint32_t* facesEnd)
+        {
+            const std::size_t numCandidates = candidates_.size();
+            assignment_.resize(numCandidates);
+            distances_.resize(numCandidates);
+
+            /* Gather the face planes (normal in XYZ and offset in W) for the inner loop */
+            planes_.clear();
+            for (auto f = facesBegin; f != facesEnd; ++f)
+            {
+                const auto& face = faces_[*f];
+                planes_.push_back(Vector4T<R>(face.normal.x, face.normal.y, face.normal.z, face.offset));
+            }
+
+            const Vector4T<R>*      planes      = planes_.data();
+            const std::size_t       numPlanes   = planes_.size();
+            const Vector3T<T>*      points      = points_;
+            const std::uint32_t*    candidates  = candidates_.data();
+            std::uint32_t*          assignment  = assignment_.data();
+            R*                      distances   = distances_.data();
+            const R                 tolerance   = tolerance_;
+
+            ParallelFor(
+                numCandidates, 4096,
+                [=](std::size_t begin, std::size_t end, std::size_t)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        const auto p = candidates[i];
+
+                        auto bestPlane = std::uint32_t(invalidIndex);
+                        R bestDistance = tolerance;
+
+                        if (p != invalidIndex)
+                        {
+                            const R x = R(points[p].x), y = R(points[p].y), z = R(points[p].z);
+                            for (std::size_t j = 0; j < numPlanes; ++j)
+                            {
+                                const R d = planes[j].x*x + planes[j].y*y + planes[j].z*z - planes[j].w;
+                                if (d > bestDistance)
+                                {
+                                    bestDistance = d;
+                                    bestPlane = static_cast<std::uint32_t>(j);
+                                }
+                            }
+                        }
+
+                        assignment[i] = (bestPlane != invalidIndex ? facesBegin[bestPlane] : std::uint32_t(invalidIndex));
+                        distances[i] = bestDistance;
+                    }
+                }
+            );
+
+            /* Link the points into the conflict lists */
+            for (std::size_t i = 0; i < numCandidates; ++i)
+            {
+                const auto f = assignment_[i];
+                if (f == invalidIndex)
+                    continue;
+
+                auto& face = faces_[f];
+                const auto p = candidates_[i];
+
+                nextPoint_[p] = face.firstPoint;
+                face.firstPoint = p;
+
+                if (distances_[i] > face.furthestDistance)
+                {
+                    face.furthestDistance = distances_[i];
+                    face.furthestPoint = p;
+                }
+            }
+
+            for (auto f = facesBegin; f != facesEnd; ++f)
+            {
+                const auto& face = faces_[*f];
+                if (face.firstPoint != invalidIndex)
+                    queue_.push({ face.furthestDistance, *f, face.stamp });
+            }
+        }
+
+        /*
+        Finds the faces that are visible from the eye point with a depth-first search over the face adjacency,
+        and writes the horizon edges (on the visible side) as closed loop in counter-clockwise order.
+        */
+        void ComputeHorizon(std::uint32_t startFace, std::uint32_t eye)
+        {
+            horizon_.clear();
+            visibleFaces_.clear();
+
+            auto& stack = horizonStack_;
+            stack.clear();
+
+            faces_[startFace].visible = true;
+            visibleFaces_.push_back(startFace);
+            stack.push_back({ faces_[startFace].edge, faces_[startFace].edge, false });
+
+            while (!stack.empty())
+            {
+                auto& top = stack.back();
+
+                if (top.started && top.edge == top.firstEdge)
+                {
+                    stack.pop_back();
+                    continue;
+                }
+
+                const auto e = top.edge;
+                top.edge = edges_[e].next;
+                top.started = true;
+
+                const auto twin = edges_[e].twin;
+                const auto neighbor = edges_[twin].face;
+
+                if (faces_[neighbor].visible)
+                    continue;
+
+                if (Distance(neighbor, eye) > tolerance_)
+                {
+                    /* Continue the search behind the crossed edge, so that the horizon edges remain in order */
+                    faces_[neighbor].visible = true;
+                    visibleFaces_.push_back(neighbor);
+                    stack.push_back({ edges_[twin].next, edges_[twin].next, false });
+                }
+                else
+                    horizon_.push_back(e);
+            }
+        }
+
+        void AddPoint(std::uint32_t face)
+        {
+            const auto eye = faces_[face].furthestPoint;
+
+            ComputeHorizon(face, eye);
+
+            /* Collect the outside points of all visible faces */
+            candidates_.clear();
+            for (auto f : visibleFaces_)
+            {
+                for (auto p = faces_[f].firstPoint; p != invalidIndex; p = nextPoint_[p])
+                {
+                    if (p != eye)
+                        candidates_.push_back(p);
+                }
+            }
+
+            /* Store the horizon before the visible faces are released, since their half-edges are reused for the new faces */
+            horizonEdges_.resize(horizon_.size());
+            for (std::size_t i = 0; i < horizon_.size(); ++i)
+            {
+                const auto e = horizon_[i];
+                horizonEdges_[i].vertex = edges_[e].vertex;
+                horizonEdges_[i].next   = edges_[edges_[edges_[e].next].next].vertex;
+                horizonEdges_[i].twin   = edges_[e].twin;
+            }
+
+            for (auto f : visibleFaces_)
+                FreeFace(f);
+
+            /* Build a cone of new faces (tail, head, eye) from the horizon to the eye point */
+            newFaces_.resize(horizon_.size());
+
+            for (std::size_t i = 0; i < horizon_.size(); ++i)
+            {
+                const auto& h = horizonEdges_[i];
+
+                const auto f = AllocFace(h.next, h.vertex, eye);
+                const auto e = faces_[f].edge;
+
+                edges_[e].twin = h.twin;
+                edges_[h.twin].twin = e;
+
+                newFaces_[i] = f;
+            }
+
+            /* Connect the side edges of consecutive new faces, i.e. (head -> eye) of face i with (eye -> tail) of face i+1 */
+            for (std::size_t i = 0; i < newFaces_.size(); ++i)
+            {
+                const auto side     = edges_[faces_[newFaces_[i]].edge].next;
+                const auto other    = edges_[edges_[faces_[newFaces_[(i + 1) % newFaces_.size()]].edge].next].next;
+                edges_[side].twin   = other;
+                edges_[other].twin  = side;
+            }
+
+            PartitionPoints(newFaces_.data(), newFaces_.data() + newFaces_.size());
+        }
+
+    private:
+
+        const Vector3T<T>*                      points_             = nullptr;
+        std::size_t                             numPoints_          = 0;
+        R                                       tolerance_          = R(0);
+
+        std::vector<HullFace<R>>                faces_;
+        std::vector<HullHalfEdge>               edges_;
+        std::vector<std::uint32_t>              freeFaces_;
+        std::vector<std::uint32_t>              freeEdges_;
+        std::size_t                             numAliveFaces_      = 0;
+
+        std::vector<std::uint32_t>              nextPoint_;
+        std::priority_queue<HullFaceQueueEntry<R>> queue_;
+
+        std::vector<std::uint32_t>              candidates_;
+        std::vector<std::uint32_t>              assignment_;
+        std::vector<R>                          distances_;
+        std::vector<Vector4T<R>>                planes_;
+
+        std::vector<std::uint32_t>              horizon_;
+        std::vector<HullHalfEdge>               horizonEdges_;  // Copies of the horizon edges with the tail vertex in 'next'
+        std::vector<std::uint32_t>              visibleFaces_;
+        std::vector<HullHorizonEntry>           horizonStack_;
+        std::vector<std::uint32_t>              newFaces_;
+
+};
+
+
+} // /namespace Details
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Builds the convex hull of the specified points with the quickhull algorithm.
+\param[in] points Pointer to the point positions. They are not copied, so the hull indices refer to this array.
+\param[in] numPoints Specifies the number of points.
+\param[out] outIndices Specifies the resulting triangle list indices into 'points'. The triangles are counter-clockwise when seen from outside.
+\param[in] maxVertices Specifies the optional maximal number of hull vertices for a simplified hull. By default 0, which means unlimited.
+Since the point with the greatest distance to the current hull is always added first, a limited hull consists of the most extreme points.
+Such a hull is contained in the exact convex hull. The limit should be at least 4.
+\return Number of triangles, or zero if the points are degenerated (less than four points, or all points are collinear or coplanar).
+\remarks Points within a tolerance (relative to the bounding box) of a hull face are considered to be inside, so coplanar points don't produce slivers.
+The search for the initial tetrahedron and the partitioning of the points onto new faces are distributed with "Details::ParallelFor".
+Faces and half-edges are allocated from reused arenas, and the outside points of each face are linked through a single array.
+*/
+template <typename T, typename Index>
+std::size_t BuildConvexHull(const Vector3T<T>* points, std::size_t numPoints, std::vector<Index>& outIndices, std::size_t maxVertices = 0)
+{
+    Details::QuickHull<T> hull(points, numPoints);
+
+    if (!hull.Build(maxVertices))
+    {
+        outIndices.clear();
+        return 0;
+    }
+
+    hull.Output(outIndices);
+
+    return outIndices.size() / 3;
+}
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
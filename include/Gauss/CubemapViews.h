@@ -0,0 +1,382 @@
+/*
+ * CubemapViews.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_CUBEMAP_VIEWS_H
+#define GS_CUBEMAP_VIEWS_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/Parallel.h>
+#include <Gauss/SIMDPacket.h>
+
+#include <cstddef>
+#include <cmath>
+
+
+namespace Gs
+{
+
+
+/**
+\brief Cubemap face enumeration in the common order of the graphics APIs.
+\remarks The view orientations (forward, up) of the faces are, for left-handed (Direct3D) and right-handed (OpenGL) view spaces:
+\code
+//             forward         left-handed up   right-handed up
+// PositiveX: (+1,  0,  0),   ( 0, +1,  0),    ( 0, -1,  0)
+// NegativeX: (-1,  0,  0),   ( 0, +1,  0),    ( 0, -1,  0)
+// PositiveY: ( 0, +1,  0),   ( 0,  0, -1),    ( 0,  0, +1)
+// NegativeY: ( 0, -1,  0),   ( 0,  0, +1),    ( 0,  0, -1)
+// PositiveZ: ( 0,  0, +1),   ( 0, +1,  0),    ( 0, -1,  0)
+// NegativeZ: ( 0,  0, -1),   ( 0, +1,  0),    ( 0, -1,  0)
+\endcode
+The right-handed up vectors are negated, so that the right vector of each face, and thus the horizontal texture axis, is the same in both conventions
+(e.g. -Z for PositiveX), and the faces are only flipped vertically as the OpenGL cubemap layout expects.
+*/
+enum class CubemapFace
+{
+    PositiveX = 0,
+    NegativeX,
+    PositiveY,
+    NegativeY,
+    PositiveZ,
+    NegativeZ,
+};
+
+/**
+\brief Indices of the frustum planes, as generated by "ExtractFrustumPlanes".
+\remarks Planes are specified as 4D vectors (a, b, c, d) of the plane equation a*x + b*y + c*z + d = 0 with a normalized (a, b, c),
+and the inside of the frustum is where the equation is greater than or equal to zero (the same convention as for "PolygonClipperT").
+*/
+struct FrustumPlane
+{
+    enum
+    {
+        Left = 0,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far,
+        Num,
+    };
+};
+
+
+namespace Details
+{
+
+
+// Returns the forward and up vector of the specified cubemap face (see CubemapFace).
+template <typename T>
+void CubemapFaceOrientation(CubemapFace face, bool rightHanded, Vector3T<T>& forward, Vector3T<T>& up)
+{
+    static const T orientations[6][6] =
+    {
+        { T( 1), T( 0), T( 0),   T(0), T(1), T( 0) },
+        { T(-1), T( 0), T( 0),   T(0), T(1), T( 0) },
+        { T( 0), T( 1), T( 0),   T(0), T(0), T(-1) },
+        { T( 0), T(-1), T( 0),   T(0), T(0), T( 1) },
+        { T( 0), T( 0), T( 1),   T(0), T(1), T( 0) },
+        { T( 0), T( 0), T(-1),   T(0), T(1), T( 0) },
+    };
+
+    const auto& o = orientations[static_cast<std::size_t>(face)];
+
+    forward = Vector3T<T>(o[0], o[1], o[2]);
+    up      = Vector3T<T>(o[3], o[4], o[5]);
+
+    if (rightHanded)
+        up = -up;
+}
+
+// Returns the row of the matrix in terms of the 'At' accessor.
+template <class M, typename T = typename M::ScalarType>
+Vector4T<T> MatrixRow4(const M& m, std::size_t row)
+{
+    return Vector4T<T>(m.At(row, 0), m.At(row, 1), m.At(row, 2), m.At(row, 3));
+}
+
+// Returns the plane with a normalized normal vector.
+template <typename T>
+Vector4T<T> NormalizePlane(const Vector4T<T>& plane)
+{
+    const T len = std::sqrt(plane.x*plane.x + plane.y*plane.y + plane.z*plane.z);
+    return (len > T(0) ? plane * (T(1) / len) : plane);
+}
+
+/*
+Builds the view matrices, view-projection matrices, and frustum planes of all cubemap faces for packets of eye positions.
+All outputs are translations of the outputs for the eye at the origin: for each row (x, y, z, w) of the view and view-projection matrices
+(in terms of the 'At' accessor) and for each frustum plane, only the W component changes with the eye position 'e', i.e. w' = w - dot((x, y, z), e).
+The outputs for the origin are computed once, and the varying components are evaluated with SIMD packets.
+*/
+template <typename T>
+class CubemapViewKernel
+{
+
+    public:
+
+        static_assert(sizeof(AffineMatrix4T<T>) == sizeof(T)*12 && sizeof(Matrix4T<T>) == sizeof(T)*16, "matrices must be tightly packed");
+
+        CubemapViewKernel(
+            const Vector3T<T>*              eyes,
+            const ProjectionMatrix4T<T>&    projection,
+            int                             flags,
+            AffineMatrix4T<T>*              views,
+            Matrix4T<T>*                    viewProjections,
+            Vector4T<T>*                    frustumPlanes) :
+                eyes_               { eyes[0].Ptr()   },
+                views_              { views           },
+                viewProjections_    { viewProjections },
+                frustumPlanes_      { frustumPlanes   }
+        {
+            Matrix4T<T> p { UninitializeTag{} };
+            ProjectionToMatrix4(p, projection);
+
+            for (std::size_t f = 0; f < 6; ++f)
+            {
+                CubemapFaceView(viewTemplates_[f], Vector3T<T>(T(0)), static_cast<CubemapFace>(f), flags);
+
+                /* View-projection matrix in terms of the 'At' accessor */
+                const auto v = viewTemplates_[f].ToMatrix4();
+
+                for (std::size_t r = 0; r < 4; ++r)
+                {
+                    for (std::size_t c = 0; c < 4; ++c)
+                    {
+                        viewProjectionTemplates_[f].At(r, c) =
+                        (
+                            p.At(r, 0) * v.At(0, c) +
+                            p.At(r, 1) * v.At(1, c) +
+                            p.At(r, 2) * v.At(2, c) +
+                            p.At(r, 3) * v.At(3, c)
+                        );
+                    }
+                }
+
+                ExtractFrustumPlanes(frustumPlaneTemplates_[f], viewProjectionTemplates_[f], flags);
+            }
+
+            /* Element offsets of the translation column */
+            for (std::size_t r = 0; r < 4; ++r)
+            {
+                if (r < 3)
+                    viewOffsets_[r] = static_cast<std::size_t>(&(viewTemplates_[0].At(r, 3)) - viewTemplates_[0].Ptr());
+                viewProjectionOffsets_[r] = static_cast<std::size_t>(&(viewProjectionTemplates_[0].At(r, 3)) - viewProjectionTemplates_[0].Ptr());
+            }
+        }
+
+        template <typename P>
+        void Run(std::size_t i) const
+        {
+            using Traits = PacketTraits<P>;
+
+            const P ex = Traits::LoadStrided(eyes_ + i*3,     3);
+            const P ey = Traits::LoadStrided(eyes_ + i*3 + 1, 3);
+            const P ez = Traits::LoadStrided(eyes_ + i*3 + 2, 3);
+
+            /* Copy the outputs for the origin, then overwrite their translations */
+            for (std::size_t j = 0; j < Traits::size; ++j)
+            {
+                for (std::size_t f = 0; f < 6; ++f)
+                {
+                    const std::size_t k = (i + j)*6 + f;
+
+                    if (views_)
+                        views_[k] = viewTemplates_[f];
+                    if (viewProjections_)
+                        viewProjections_[k] = viewProjectionTemplates_[f];
+                    if (frustumPlanes_)
+                    {
+                        for (std::size_t l = 0; l < FrustumPlane::Num; ++l)
+                            frustumPlanes_[k*FrustumPlane::Num + l] = frustumPlaneTemplates_[f][l];
+                    }
+                }
+            }
+
+            for (std::size_t f = 0; f < 6; ++f)
+            {
+                const std::size_t k = i*6 + f;
+
+                if (views_)
+                {
+                    for (std::size_t r = 0; r < 3; ++r)
+                        Translate<P>(MatrixRow4(viewTemplates_[f], r), ex, ey, ez, views_[k].Ptr() + viewOffsets_[r], 6*12);
+                }
+
+                if (viewProjections_)
+                {
+                    for (std::size_t r = 0; r < 4; ++r)
+                        Translate<P>(MatrixRow4(viewProjectionTemplates_[f], r), ex, ey, ez, viewProjections_[k].Ptr() + viewProjectionOffsets_[r], 6*16);
+                }
+
+                if (frustumPlanes_)
+                {
+                    for (std::size_t l = 0; l < FrustumPlane::Num; ++l)
+                        Translate<P>(frustumPlaneTemplates_[f][l], ex, ey, ez, &(frustumPlanes_[k*FrustumPlane::Num + l].w), 6*FrustumPlane::Num*4);
+                }
+            }
+        }
+
+    private:
+
+        // Stores w - dot((x, y, z), e) with the specified stride.
+        template <typename P>
+        static void Translate(const Vector4T<T>& row, const P& ex, const P& ey, const P& ez, T* out, std::size_t stride)
+        {
+            PacketTraits<P>::StoreStrided(out, stride, P(row.w) - (P(row.x)*ex + P(row.y)*ey + P(row.z)*ez));
+        }
+
+        const T*            eyes_;
+        AffineMatrix4T<T>*  views_;
+        Matrix4T<T>*        viewProjections_;
+        Vector4T<T>*        frustumPlanes_;
+
+        AffineMatrix4T<T>   viewTemplates_[6];
+        Matrix4T<T>         viewProjectionTemplates_[6];
+        Vector4T<T>         frustumPlaneTemplates_[6][FrustumPlane::Num];
+
+        std::size_t         viewOffsets_[3];
+        std::size_t         viewProjectionOffsets_[4];
+
+};
+
+
+} // /namespace Details
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Builds the view matrix (world space to view space) of a camera at the specified eye position, that looks along the specified cubemap face.
+\param[out] view Specifies the output view matrix.
+\param[in] eye Specifies the eye position in world space.
+\param[in] face Specifies the cubemap face. \see CubemapFace
+\param[in] flags Optional bit mask with projection generation flags. If ProjectionFlags::RightHanded is set,
+the camera looks along the negative Z axis of the view space and uses the right-handed up vectors (see CubemapFace).
+Otherwise, it looks along the positive Z axis.
+*/
+template <typename T>
+void CubemapFaceView(AffineMatrix4T<T>& view, const Vector3T<T>& eye, CubemapFace face, int flags = 0)
+{
+    const bool rightHanded = ((flags & ProjectionFlags::RightHanded) != 0);
+
+    Vector3T<T> forward, up;
+    Details::CubemapFaceOrientation(face, rightHanded, forward, up);
+
+    /* Look-at basis: the rows of the rotation are the view space axes in world space */
+    const Vector3T<T> zAxis = (rightHanded ? -forward : forward);
+    const Vector3T<T> xAxis = Cross(up, zAxis);
+    const Vector3T<T> yAxis = Cross(zAxis, xAxis);
+
+    const Vector3T<T> axes[3] = { xAxis, yAxis, zAxis };
+
+    for (std::size_t r = 0; r < 3; ++r)
+    {
+        view.At(r, 0) = axes[r].x;
+        view.At(r, 1) = axes[r].y;
+        view.At(r, 2) = axes[r].z;
+        view.At(r, 3) = -Dot(axes[r], eye);
+    }
+}
+
+//! \see CubemapFaceView(AffineMatrix4T<T>&, const Vector3T<T>&, CubemapFace, int)
+template <typename T>
+AffineMatrix4T<T> CubemapFaceView(const Vector3T<T>& eye, CubemapFace face, int flags = 0)
+{
+    AffineMatrix4T<T> view { UninitializeTag{} };
+    CubemapFaceView(view, eye, face, flags);
+    return view;
+}
+
+/**
+\brief Returns the perspective projection for cubemap faces, i.e. with a field-of-view of 90 degrees and an aspect ratio of 1.
+\see ProjectionMatrix4T::Perspective
+*/
+template <typename T>
+ProjectionMatrix4T<T> CubemapProjection(const T& nearPlane, const T& farPlane, int flags = 0)
+{
+    return ProjectionMatrix4T<T>::Perspective(T(1), nearPlane, farPlane, T(pi) / T(2), flags);
+}
+
+/**
+\brief Extracts the frustum planes from the specified view-projection matrix (Gribb-Hartmann method).
+\param[out] planes Specifies the output planes in world space, ordered by the indices of FrustumPlane.
+\param[in] viewProjection Specifies the matrix that transforms world space into clip space.
+\param[in] flags Optional bit mask with projection generation flags. If ProjectionFlags::UnitCube is set,
+the near plane is extracted for the clip space Z range [-w, w]. Otherwise, the range [0, w] is used.
+\see FrustumPlane
+*/
+template <typename T>
+void ExtractFrustumPlanes(Vector4T<T> (&planes)[FrustumPlane::Num], const Matrix4T<T>& viewProjection, int flags = 0)
+{
+    const auto r0 = Details::MatrixRow4(viewProjection, 0);
+    const auto r1 = Details::MatrixRow4(viewProjection, 1);
+    const auto r2 = Details::MatrixRow4(viewProjection, 2);
+    const auto r3 = Details::MatrixRow4(viewProjection, 3);
+
+    planes[FrustumPlane::Left  ] = Details::NormalizePlane(r3 + r0);
+    planes[FrustumPlane::Right ] = Details::NormalizePlane(r3 - r0);
+    planes[FrustumPlane::Bottom] = Details::NormalizePlane(r3 + r1);
+    planes[FrustumPlane::Top   ] = Details::NormalizePlane(r3 - r1);
+    planes[FrustumPlane::Near  ] = Details::NormalizePlane((flags & ProjectionFlags::UnitCube) != 0 ? r3 + r2 : r2);
+    planes[FrustumPlane::Far   ] = Details::NormalizePlane(r3 - r2);
+}
+
+/**
+\brief Builds the view matrices, view-projection matrices, and frustum planes of all six cubemap faces for each of the specified eye positions.
+\param[in] eyes Pointer to the eye positions in world space, e.g. the positions of point lights or reflection probes.
+\param[in] count Specifies the number of eye positions.
+\param[in] projection Specifies the projection that is shared by all faces, e.g. from "CubemapProjection".
+\param[out] views Optional pointer to the output array of 6*count view matrices. The view matrix of face 'f' for eye 'i' is at index i*6 + f.
+\param[out] viewProjections Optional pointer to the output array of 6*count view-projection matrices, with the same layout as 'views'.
+\param[out] frustumPlanes Optional pointer to the output array of 36*count frustum planes in world space.
+The planes of face 'f' for eye 'i' begin at index (i*6 + f)*FrustumPlane::Num and are ordered by the indices of FrustumPlane.
+\param[in] flags Optional bit mask with projection generation flags. This should be the same flags 'projection' was generated with.
+\remarks The cube face orientations are fixed, so the rotations, projections, and plane normals are computed only once.
+Per eye position only the translations remain, which are evaluated in SIMD packets (4 or 8 eyes at once for floats).
+Large arrays are distributed with "Details::ParallelFor".
+\see CubemapFaceView
+\see ExtractFrustumPlanes
+*/
+template <typename T>
+void BuildCubemapViews(
+    const Vector3T<T>*              eyes,
+    std::size_t                     count,
+    const ProjectionMatrix4T<T>&    projection,
+    AffineMatrix4T<T>*              views,
+    Matrix4T<T>*                    viewProjections,
+    Vector4T<T>*                    frustumPlanes,
+    int                             flags = 0)
+{
+    static_assert(sizeof(Vector3T<T>) == sizeof(T)*3 && sizeof(Vector4T<T>) == sizeof(T)*4, "vectors must be tightly packed");
+
+    if (count == 0)
+        return;
+
+    const Details::CubemapViewKernel<T> kernel(eyes, projection, flags, views, viewProjections, frustumPlanes);
+
+    Details::ParallelFor(
+        count, 1024,
+        [&kernel](std::size_t begin, std::size_t end, std::size_t)
+        {
+            Details::ForEachPacket<T>(begin, end, kernel);
+        }
+    );
+}
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
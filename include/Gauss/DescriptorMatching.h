@@ -0,0 +1,154 @@
+/*
+ * DescriptorMatching.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_DESCRIPTOR_MATCHING_H
+#define GS_DESCRIPTOR_MATCHING_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/Parallel.h>
+#include <Gauss/VectorKernels.h>
+
+#include <cstddef>
+#include <limits>
+
+
+namespace Gs
+{
+
+
+/**
+\brief Result of a nearest descriptor search.
+\tparam T Specifies the data type of the distances.
+\see FindNearestDescriptors
+*/
+template <typename T>
+struct DescriptorMatchT
+{
+    //! Index of the nearest descriptor, or the number of descriptors if there is none.
+    std::size_t index;
+
+    //! Squared distance to the nearest descriptor.
+    T           distanceSq;
+
+    //! Squared distance to the second nearest descriptor, e.g. for the ratio test (distanceSq < ratio^2 * secondDistanceSq).
+    T           secondDistanceSq;
+};
+
+
+namespace Details
+{
+
+
+// Updates the best and second best match with the specified candidate.
+template <typename T>
+void UpdateDescriptorMatch(DescriptorMatchT<T>& match, std::size_t index, const T& distanceSq)
+{
+    if (distanceSq < match.distanceSq)
+    {
+        match.secondDistanceSq  = match.distanceSq;
+        match.distanceSq        = distanceSq;
+        match.index             = index;
+    }
+    else if (distanceSq < match.secondDistanceSq)
+        match.secondDistanceSq = distanceSq;
+}
+
+// Brute force search for the queries in the range [begin, end), blocked for the cache.
+template <typename T, std::size_t N>
+void FindNearestDescriptorsRange(
+    const Vector<T, N>*     queries,
+    std::size_t             begin,
+    std::size_t             end,
+    const Vector<T, N>*     descriptors,
+    std::size_t             numDescriptors,
+    DescriptorMatchT<T>*    matches)
+{
+    /* Descriptor blocks of about 32 KB stay in the L1/L2 cache while all queries of this range are processed */
+    const std::size_t blockSize = std::max<std::size_t>(1, 32768 / sizeof(Vector<T, N>));
+
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        matches[i].index            = numDescriptors;
+        matches[i].distanceSq       = std::numeric_limits<T>::max();
+        matches[i].secondDistanceSq = std::numeric_limits<T>::max();
+    }
+
+    for (std::size_t blockBegin = 0; blockBegin < numDescriptors; blockBegin += blockSize)
+    {
+        const std::size_t blockEnd = std::min(blockBegin + blockSize, numDescriptors);
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            for (std::size_t j = blockBegin; j < blockEnd; ++j)
+                UpdateDescriptorMatch(matches[i], j, VectorAccumulator<T, T>::DistanceSq(queries[i].Ptr(), descriptors[j].Ptr(), N));
+        }
+    }
+}
+
+
+} // /namespace Details
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Finds the nearest descriptor for each query vector by brute force (squared euclidean distance).
+\param[in] queries Pointer to the query vectors.
+\param[in] numQueries Specifies the number of query vectors.
+\param[in] descriptors Pointer to the descriptors that are searched.
+\param[in] numDescriptors Specifies the number of descriptors.
+\param[out] matches Pointer to the output array of 'numQueries' matches, which also contain the second nearest distance for the ratio test.
+\remarks The descriptors are processed in cache sized blocks, and each distance is computed with SIMD packets in the same order as "DistanceSq".
+Large numbers of queries are distributed with "Details::ParallelFor". This is meant for feature descriptors and small embeddings
+(e.g. Vector<float, 128>), for which spatial search structures such as KdTreeT are not efficient.
+\see DescriptorMatchT
+*/
+template <typename T, std::size_t N>
+void FindNearestDescriptors(
+    const Vector<T, N>*     queries,
+    std::size_t             numQueries,
+    const Vector<T, N>*     descriptors,
+    std::size_t             numDescriptors,
+    DescriptorMatchT<T>*    matches)
+{
+    Details::ParallelFor(
+        numQueries, 64,
+        [&](std::size_t begin, std::size_t end, std::size_t /*chunk*/)
+        {
+            Details::FindNearestDescriptorsRange(queries, begin, end, descriptors, numDescriptors, matches);
+        }
+    );
+}
+
+//! Returns the nearest descriptor for the specified query vector. \see FindNearestDescriptors
+template <typename T, std::size_t N>
+DescriptorMatchT<T> FindNearestDescriptor(const Vector<T, N>& query, const Vector<T, N>* descriptors, std::size_t numDescriptors)
+{
+    DescriptorMatchT<T> match;
+    Details::FindNearestDescriptorsRange(&query, 0, 1, descriptors, numDescriptors, &match);
+    return match;
+}
+
+
+/* --- Type Alias --- */
+
+using DescriptorMatch   = DescriptorMatchT<Real>;
+using DescriptorMatchf  = DescriptorMatchT<float>;
+using DescriptorMatchd  = DescriptorMatchT<double>;
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
@@ -35,6 +35,10 @@
 
 #include "TransformVector.h"
 #include "RotateVector.h"
+#include "TransformChain.h"
+#include "BatchAlgebra.h"
+#include "Packing.h"
+#include "CastArray.h"
 
 #include "ScalarType.h"
 
@@ -0,0 +1,532 @@
+/*
+ * IntegerVector.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_INTEGER_VECTOR_H
+#define GS_INTEGER_VECTOR_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/Assert.h>
+#include <Gauss/StdMath.h>
+#include <Gauss/Relational.h>
+#include <Gauss/SIMD.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace Gs
+{
+
+
+/* --- Global Operators --- */
+
+//! Returns the bitwise AND of the two integer vectors.
+template <typename T, std::size_t N>
+Vector<T, N> operator & (const Vector<T, N>& lhs, const Vector<T, N>& rhs)
+{
+    Vector<T, N> result { UninitializeTag{} };
+    for (std::size_t i = 0; i < N; ++i)
+        result[i] = (lhs[i] & rhs[i]);
+    return result;
+}
+
+//! Returns the bitwise OR of the two integer vectors.
+template <typename T, std::size_t N>
+Vector<T, N> operator | (const Vector<T, N>& lhs, const Vector<T, N>& rhs)
+{
+    Vector<T, N> result { UninitializeTag{} };
+    for (std::size_t i = 0; i < N; ++i)
+        result[i] = (lhs[i] | rhs[i]);
+    return result;
+}
+
+//! Returns the bitwise XOR of the two integer vectors.
+template <typename T, std::size_t N>
+Vector<T, N> operator ^ (const Vector<T, N>& lhs, const Vector<T, N>& rhs)
+{
+    Vector<T, N> result { UninitializeTag{} };
+    for (std::size_t i = 0; i < N; ++i)
+        result[i] = (lhs[i] ^ rhs[i]);
+    return result;
+}
+
+//! Returns the bitwise complement of the integer vector.
+template <typename T, std::size_t N>
+Vector<T, N> operator ~ (const Vector<T, N>& vec)
+{
+    Vector<T, N> result { UninitializeTag{} };
+    for (std::size_t i = 0; i < N; ++i)
+        result[i] = static_cast<T>(~vec[i]);
+    return result;
+}
+
+//! Shifts all components of the integer vector to the left (the bits of signed types are shifted like unsigned integers).
+template <typename T, std::size_t N>
+Vector<T, N> operator << (const Vector<T, N>& vec, int count)
+{
+    /* Shift in the unsigned type (at least 'unsigned int' after promotion), since left shifts of negative values are undefined */
+    using U = typename std::common_type<typename std::make_unsigned<T>::type, unsigned int>::type;
+
+    Vector<T, N> result { UninitializeTag{} };
+    for (std::size_t i = 0; i < N; ++i)
+        result[i] = static_cast<T>(static_cast<U>(vec[i]) << count);
+    return result;
+}
+
+//! Shifts all components of the integer vector to the right (arithmetic shift for signed types).
+template <typename T, std::size_t N>
+Vector<T, N> operator >> (const Vector<T, N>& vec, int count)
+{
+    Vector<T, N> result { UninitializeTag{} };
+    for (std::size_t i = 0; i < N; ++i)
+        result[i] = static_cast<T>(vec[i] >> count);
+    return result;
+}
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Fast division of 32-bit integers by a divisor that is constant at runtime (e.g. the width of a grid).
+\tparam T Specifies the integer type. This must be std::int32_t or std::uint32_t.
+\remarks The division is replaced by a multiplication with a precomputed "magic number" and two shifts
+(Granlund and Montgomery, "Division by Invariant Integers using Multiplication"), which is considerably faster than an integer division,
+and which can also be done with SSE2 where no integer division instruction exists. Signed integers are divided by their magnitudes,
+and the quotient is rounded towards zero like the built-in division.
+\code
+// Convert linear cell indices into 2D grid coordinates
+const Gs::IntegerDividerui gridWidth(width);
+std::uint32_t y = index / gridWidth;
+std::uint32_t x = index - y * width;
+\endcode
+*/
+template <typename T>
+class IntegerDividerT
+{
+
+    public:
+
+        static_assert(
+            std::is_same<T, std::int32_t>::value || std::is_same<T, std::uint32_t>::value,
+            "integer divider can only be used with 32-bit integers"
+        );
+
+        //! Specifies the typename of the scalar components.
+        using ScalarType = T;
+
+        //! Precomputes the multiplier and shifts for the specified divisor, which must not be zero.
+        explicit IntegerDividerT(const T& divisor) :
+            divisor_ { divisor }
+        {
+            GS_ASSERT(divisor != T(0));
+
+            const std::uint32_t d = Magnitude(divisor);
+
+            /* l = ceil(log2(d)), m = floor(2^32 * (2^l - d) / d) + 1 */
+            std::uint32_t l = 0;
+            while ((std::uint64_t(1) << l) < d)
+                ++l;
+
+            multiplier_ = static_cast<std::uint32_t>((((std::uint64_t(1) << l) - d) << 32) / d + 1);
+            shift1_     = (l > 0 ? 1 : 0);
+            shift2_     = (l > 0 ? l - 1 : 0);
+            negative_   = IsNegativeValue(divisor);
+        }
+
+        //! Returns the quotient 'n / divisor'.
+        T Divide(const T& n) const
+        {
+            const std::uint32_t sign = (IsNegativeValue(n) ? ~0u : 0u);
+            const std::uint32_t q = DivideMagnitude(Magnitude(n));
+            const std::uint32_t qSign = (negative_ ? ~sign : sign);
+            return static_cast<T>((q ^ qSign) - qSign);
+        }
+
+        //! Returns the remainder 'n % divisor'.
+        T Remainder(const T& n) const
+        {
+            return static_cast<T>(n - Divide(n) * divisor_);
+        }
+
+        //! Returns the divisor.
+        const T& GetDivisor() const
+        {
+            return divisor_;
+        }
+
+        //! Returns the quotient of the unsigned magnitudes, i.e. 'n / |divisor|'.
+        std::uint32_t DivideMagnitude(std::uint32_t n) const
+        {
+            const std::uint32_t t = static_cast<std::uint32_t>((static_cast<std::uint64_t>(multiplier_) * n) >> 32);
+            return ((t + ((n - t) >> shift1_)) >> shift2_);
+        }
+
+        //! Returns the multiplier of the magnitude division. \see DivideMagnitude
+        std::uint32_t GetMultiplier() const
+        {
+            return multiplier_;
+        }
+
+        //! Returns the first shift of the magnitude division (0 or 1). \see DivideMagnitude
+        std::uint32_t GetShift1() const
+        {
+            return shift1_;
+        }
+
+        //! Returns the second shift of the magnitude division. \see DivideMagnitude
+        std::uint32_t GetShift2() const
+        {
+            return shift2_;
+        }
+
+        //! Returns true if the divisor is negative.
+        bool IsNegative() const
+        {
+            return negative_;
+        }
+
+    private:
+
+        static bool IsNegativeValue(const T& x)
+        {
+            return (std::is_signed<T>::value && (static_cast<std::uint32_t>(x) >> 31) != 0);
+        }
+
+        static std::uint32_t Magnitude(const T& x)
+        {
+            return (IsNegativeValue(x) ? 0u - static_cast<std::uint32_t>(x) : static_cast<std::uint32_t>(x));
+        }
+
+        T               divisor_;
+        std::uint32_t   multiplier_ = 0;
+        std::uint32_t   shift1_     = 0;
+        std::uint32_t   shift2_     = 0;
+        bool            negative_   = false;
+
+};
+
+//! Returns the quotient 'lhs / rhs.GetDivisor()'. \see IntegerDividerT
+template <typename T>
+T operator / (const T& lhs, const IntegerDividerT<T>& rhs)
+{
+    return rhs.Divide(lhs);
+}
+
+//! Returns the component-wise quotient 'lhs / rhs.GetDivisor()'. \see IntegerDividerT
+template <typename T, std::size_t N>
+Vector<T, N> operator / (const Vector<T, N>& lhs, const IntegerDividerT<T>& rhs)
+{
+    Vector<T, N> result { UninitializeTag{} };
+    for (std::size_t i = 0; i < N; ++i)
+        result[i] = rhs.Divide(lhs[i]);
+    return result;
+}
+
+
+namespace Details
+{
+
+
+#ifdef GS_SIMD_SSE2
+
+template <typename T>
+__m128i LoadInt4(const T* ptr)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+}
+
+template <typename T>
+void StoreInt4(T* ptr, __m128i v)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), v);
+}
+
+// Returns the lower 32 bits of the products (the same for signed and unsigned integers).
+inline __m128i MulLoInt4(__m128i a, __m128i b)
+{
+    #ifdef GS_SIMD_SSE4_1
+    return _mm_mullo_epi32(a, b);
+    #else
+    const __m128i even  = _mm_mul_epu32(a, b);
+    const __m128i odd   = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    #endif
+}
+
+// Returns the upper 32 bits of the unsigned products, where 'b' has the same value in all lanes.
+inline __m128i MulHiUInt4(__m128i a, __m128i b)
+{
+    const __m128i even  = _mm_srli_epi64(_mm_mul_epu32(a, b), 32);
+    const __m128i odd   = _mm_mul_epu32(_mm_srli_epi64(a, 32), b);
+    return _mm_or_si128(even, _mm_and_si128(odd, _mm_setr_epi32(0, -1, 0, -1)));
+}
+
+// Signed and unsigned comparison 'a > b'.
+template <typename T>
+__m128i CompareGreaterInt4(__m128i a, __m128i b)
+{
+    return _mm_cmpgt_epi32(a, b);
+}
+
+template <>
+inline __m128i CompareGreaterInt4<std::uint32_t>(__m128i a, __m128i b)
+{
+    /* Flip the sign bits to compare unsigned integers with the signed instruction */
+    const __m128i bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    return _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+}
+
+template <typename T>
+__m128i MinInt4(__m128i a, __m128i b)
+{
+    #ifdef GS_SIMD_SSE4_1
+    return (std::is_signed<T>::value ? _mm_min_epi32(a, b) : _mm_min_epu32(a, b));
+    #else
+    const __m128i mask = CompareGreaterInt4<T>(a, b);
+    return _mm_or_si128(_mm_and_si128(mask, b), _mm_andnot_si128(mask, a));
+    #endif
+}
+
+template <typename T>
+__m128i MaxInt4(__m128i a, __m128i b)
+{
+    #ifdef GS_SIMD_SSE4_1
+    return (std::is_signed<T>::value ? _mm_max_epi32(a, b) : _mm_max_epu32(a, b));
+    #else
+    const __m128i mask = CompareGreaterInt4<T>(a, b);
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    #endif
+}
+
+// Arithmetic shift for signed and logical shift for unsigned integers.
+template <typename T>
+__m128i ShiftRightInt4(__m128i a, int count)
+{
+    const __m128i n = _mm_cvtsi32_si128(count);
+    return (std::is_signed<T>::value ? _mm_sra_epi32(a, n) : _mm_srl_epi32(a, n));
+}
+
+// Divides four integers by the divisor of the specified divider.
+template <typename T>
+__m128i DivideInt4(__m128i n, const IntegerDividerT<T>& divider)
+{
+    const __m128i multiplier    = _mm_set1_epi32(static_cast<int>(divider.GetMultiplier()));
+    const __m128i shift1        = _mm_cvtsi32_si128(static_cast<int>(divider.GetShift1()));
+    const __m128i shift2        = _mm_cvtsi32_si128(static_cast<int>(divider.GetShift2()));
+
+    /* Signed integers: divide the magnitudes and restore the sign of the quotient */
+    __m128i sign = _mm_setzero_si128();
+
+    if (std::is_signed<T>::value)
+    {
+        sign = _mm_srai_epi32(n, 31);
+        n = _mm_sub_epi32(_mm_xor_si128(n, sign), sign);
+    }
+
+    const __m128i t = MulHiUInt4(n, multiplier);
+    __m128i q = _mm_srl_epi32(_mm_add_epi32(t, _mm_srl_epi32(_mm_sub_epi32(n, t), shift1)), shift2);
+
+    if (std::is_signed<T>::value)
+    {
+        if (divider.IsNegative())
+            sign = _mm_xor_si128(sign, _mm_set1_epi32(-1));
+        q = _mm_sub_epi32(_mm_xor_si128(q, sign), sign);
+    }
+
+    return q;
+}
+
+// Multiplies two 4x4 matrices: each line of the result is a linear combination of the lines of 'x' with the weights from 'y'.
+template <typename T>
+void MulMatrix4Int4(T* result, const T* x, const T* y)
+{
+    const __m128i x0 = LoadInt4(x), x1 = LoadInt4(x + 4), x2 = LoadInt4(x + 8), x3 = LoadInt4(x + 12);
+
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        const T* w = y + i*4;
+        const __m128i r = _mm_add_epi32(
+            _mm_add_epi32(MulLoInt4(x0, _mm_set1_epi32(static_cast<int>(w[0]))), MulLoInt4(x1, _mm_set1_epi32(static_cast<int>(w[1])))),
+            _mm_add_epi32(MulLoInt4(x2, _mm_set1_epi32(static_cast<int>(w[2]))), MulLoInt4(x3, _mm_set1_epi32(static_cast<int>(w[3]))))
+        );
+        StoreInt4(result + i*4, r);
+    }
+}
+
+// Multiplies the 4x4 matrix with the 4D column vector.
+template <typename T>
+void MulMatrix4Vector4Int4(T* result, const T* m, const T* v)
+{
+    __m128i c0 = LoadInt4(m), c1 = LoadInt4(m + 4), c2 = LoadInt4(m + 8), c3 = LoadInt4(m + 12);
+
+    #ifdef GS_ROW_MAJOR_STORAGE
+
+    /* Transpose the rows into columns */
+    const __m128i t0 = _mm_unpacklo_epi32(c0, c1);
+    const __m128i t1 = _mm_unpacklo_epi32(c2, c3);
+    const __m128i t2 = _mm_unpackhi_epi32(c0, c1);
+    const __m128i t3 = _mm_unpackhi_epi32(c2, c3);
+
+    c0 = _mm_unpacklo_epi64(t0, t1);
+    c1 = _mm_unpackhi_epi64(t0, t1);
+    c2 = _mm_unpacklo_epi64(t2, t3);
+    c3 = _mm_unpackhi_epi64(t2, t3);
+
+    #endif
+
+    const __m128i r = _mm_add_epi32(
+        _mm_add_epi32(MulLoInt4(c0, _mm_set1_epi32(static_cast<int>(v[0]))), MulLoInt4(c1, _mm_set1_epi32(static_cast<int>(v[1])))),
+        _mm_add_epi32(MulLoInt4(c2, _mm_set1_epi32(static_cast<int>(v[2]))), MulLoInt4(c3, _mm_set1_epi32(static_cast<int>(v[3]))))
+    );
+    StoreInt4(result, r);
+}
+
+#endif // /GS_SIMD_SSE2
+
+
+} // /namespace Details
+
+
+#ifdef GS_SIMD_SSE2
+
+/*
+SSE2 overloads for 4D vectors and 4x4 matrices of 32-bit integers. These non-template functions are preferred over the generic templates,
+e.g. "min" and "max" from "StdMath.h". Comparisons of integer vectors use the SSE2 paths of "LessThan", "Equal" etc. from "Relational.h".
+The matrix product uses the storage layout directly: with column-major storage, each column of (A * B) is a combination of the columns of A,
+and with row-major storage, each row of (A * B) is a combination of the rows of B.
+*/
+#ifdef GS_ROW_MAJOR_STORAGE
+#   define GS_MUL_MATRIX4_INT4(R, A, B) Details::MulMatrix4Int4((R).Ptr(), (B).Ptr(), (A).Ptr())
+#else
+#   define GS_MUL_MATRIX4_INT4(R, A, B) Details::MulMatrix4Int4((R).Ptr(), (A).Ptr(), (B).Ptr())
+#endif
+
+#define GS_DECL_INT4_BINARY_OP(T, OP, FUNC)                                                                 \
+    inline Vector4T<T> operator OP (const Vector4T<T>& lhs, const Vector4T<T>& rhs)                         \
+    {                                                                                                       \
+        Vector4T<T> result { UninitializeTag{} };                                                           \
+        Details::StoreInt4(result.Ptr(), FUNC(Details::LoadInt4(lhs.Ptr()), Details::LoadInt4(rhs.Ptr()))); \
+        return result;                                                                                      \
+    }
+
+#define GS_DECL_INT4_BINARY_FUNC(T, NAME, FUNC)                                                             \
+    inline Vector4T<T> NAME(const Vector4T<T>& lhs, const Vector4T<T>& rhs)                                 \
+    {                                                                                                       \
+        Vector4T<T> result { UninitializeTag{} };                                                           \
+        Details::StoreInt4(result.Ptr(), FUNC(Details::LoadInt4(lhs.Ptr()), Details::LoadInt4(rhs.Ptr()))); \
+        return result;                                                                                      \
+    }
+
+#define GS_DECL_INT4_FUNCTIONS(T)                                                                           \
+    GS_DECL_INT4_BINARY_OP(T, +, _mm_add_epi32)                                                             \
+    GS_DECL_INT4_BINARY_OP(T, -, _mm_sub_epi32)                                                             \
+    GS_DECL_INT4_BINARY_OP(T, *, Details::MulLoInt4)                                                        \
+    GS_DECL_INT4_BINARY_OP(T, &, _mm_and_si128)                                                             \
+    GS_DECL_INT4_BINARY_OP(T, |, _mm_or_si128)                                                              \
+    GS_DECL_INT4_BINARY_OP(T, ^, _mm_xor_si128)                                                             \
+    GS_DECL_INT4_BINARY_FUNC(T, min, Details::MinInt4<T>)                                                   \
+    GS_DECL_INT4_BINARY_FUNC(T, max, Details::MaxInt4<T>)                                                   \
+    inline Vector4T<T> operator ~ (const Vector4T<T>& vec)                                                  \
+    {                                                                                                       \
+        Vector4T<T> result { UninitializeTag{} };                                                           \
+        Details::StoreInt4(result.Ptr(), _mm_xor_si128(Details::LoadInt4(vec.Ptr()), _mm_set1_epi32(-1)));  \
+        return result;                                                                                      \
+    }                                                                                                       \
+    inline Vector4T<T> operator << (const Vector4T<T>& vec, int count)                                      \
+    {                                                                                                       \
+        Vector4T<T> result { UninitializeTag{} };                                                           \
+        Details::StoreInt4(result.Ptr(), _mm_sll_epi32(Details::LoadInt4(vec.Ptr()), _mm_cvtsi32_si128(count))); \
+        return result;                                                                                      \
+    }                                                                                                       \
+    inline Vector4T<T> operator >> (const Vector4T<T>& vec, int count)                                      \
+    {                                                                                                       \
+        Vector4T<T> result { UninitializeTag{} };                                                           \
+        Details::StoreInt4(result.Ptr(), Details::ShiftRightInt4<T>(Details::LoadInt4(vec.Ptr()), count));  \
+        return result;                                                                                      \
+    }                                                                                                       \
+    inline Vector4T<T> operator / (const Vector4T<T>& lhs, const IntegerDividerT<T>& rhs)                   \
+    {                                                                                                       \
+        Vector4T<T> result { UninitializeTag{} };                                                           \
+        Details::StoreInt4(result.Ptr(), Details::DivideInt4(Details::LoadInt4(lhs.Ptr()), rhs));          \
+        return result;                                                                                      \
+    }                                                                                                       \
+    inline Matrix4T<T> operator + (const Matrix4T<T>& lhs, const Matrix4T<T>& rhs)                          \
+    {                                                                                                       \
+        Matrix4T<T> result { UninitializeTag{} };                                                           \
+        for (std::size_t i = 0; i < 16; i += 4)                                                             \
+            Details::StoreInt4(result.Ptr() + i, _mm_add_epi32(Details::LoadInt4(lhs.Ptr() + i), Details::LoadInt4(rhs.Ptr() + i))); \
+        return result;                                                                                      \
+    }                                                                                                       \
+    inline Matrix4T<T> operator - (const Matrix4T<T>& lhs, const Matrix4T<T>& rhs)                          \
+    {                                                                                                       \
+        Matrix4T<T> result { UninitializeTag{} };                                                           \
+        for (std::size_t i = 0; i < 16; i += 4)                                                             \
+            Details::StoreInt4(result.Ptr() + i, _mm_sub_epi32(Details::LoadInt4(lhs.Ptr() + i), Details::LoadInt4(rhs.Ptr() + i))); \
+        return result;                                                                                      \
+    }                                                                                                       \
+    inline Matrix4T<T> operator * (const Matrix4T<T>& lhs, const Matrix4T<T>& rhs)                          \
+    {                                                                                                       \
+        Matrix4T<T> result { UninitializeTag{} };                                                           \
+        GS_MUL_MATRIX4_INT4(result, lhs, rhs);                                                              \
+        return result;                                                                                      \
+    }                                                                                                       \
+    inline Vector4T<T> operator * (const Matrix4T<T>& lhs, const Vector4T<T>& rhs)                          \
+    {                                                                                                       \
+        Vector4T<T> result { UninitializeTag{} };                                                           \
+        Details::MulMatrix4Vector4Int4(result.Ptr(), lhs.Ptr(), rhs.Ptr());                                 \
+        return result;                                                                                      \
+    }
+
+GS_DECL_INT4_FUNCTIONS(std::int32_t)
+GS_DECL_INT4_FUNCTIONS(std::uint32_t)
+
+#undef GS_DECL_INT4_FUNCTIONS
+#undef GS_DECL_INT4_BINARY_FUNC
+#undef GS_DECL_INT4_BINARY_OP
+#undef GS_MUL_MATRIX4_INT4
+
+#endif // /GS_SIMD_SSE2
+
+/**
+\brief Divides all integers of the input array by the divisor of the specified divider.
+\param[in] input Pointer to the input array of 'count' integers.
+\param[out] output Pointer to the output array of 'count' integers. This may be equal to 'input'.
+\see IntegerDividerT
+*/
+template <typename T>
+void DivideArray(const T* input, T* output, std::size_t count, const IntegerDividerT<T>& divider)
+{
+    std::size_t i = 0;
+
+    #ifdef GS_SIMD_SSE2
+    for (; i + 4 <= count; i += 4)
+        Details::StoreInt4(output + i, Details::DivideInt4(Details::LoadInt4(input + i), divider));
+    #endif
+
+    for (; i < count; ++i)
+        output[i] = divider.Divide(input[i]);
+}
+
+
+/* --- Type Alias --- */
+
+using IntegerDivideri   = IntegerDividerT<std::int32_t>;
+using IntegerDividerui  = IntegerDividerT<std::uint32_t>;
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,464 @@
+/*
+ * KdTree.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_KD_TREE_H
+#define GS_KD_TREE_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/Parallel.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+
+namespace Gs
+{
+
+
+namespace Details
+{
+
+
+// Entry of the bounded priority queue for k-nearest-neighbor queries (max-heap by distance).
+template <typename T>
+struct KdTreeNeighbor
+{
+    T               distanceSq;
+    std::uint32_t   index;
+
+    bool operator < (const KdTreeNeighbor& rhs) const
+    {
+        return (distanceSq < rhs.distanceSq);
+    }
+};
+
+// Spreads the lower 10 bits of the specified value, so that there are two zero bits between each bit.
+inline std::uint32_t MortonSpreadBits(std::uint32_t x)
+{
+    x &= 0x000003ff;
+    x = (x ^ (x << 16)) & 0xff0000ff;
+    x = (x ^ (x <<  8)) & 0x0300f00f;
+    x = (x ^ (x <<  4)) & 0x030c30c3;
+    x = (x ^ (x <<  2)) & 0x09249249;
+    return x;
+}
+
+// Returns the 30-bit Morton code of the specified point within the bounding box [minima, minima + 1/invExtent].
+template <typename T>
+std::uint32_t MortonCode(const Vector3T<T>& point, const Vector3T<T>& minima, const Vector3T<T>& invExtent)
+{
+    std::uint32_t code = 0;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        const T t = Clamp((point[i] - minima[i]) * invExtent[i], T(0), T(1));
+        code |= (MortonSpreadBits(static_cast<std::uint32_t>(t * T(1023))) << i);
+    }
+    return code;
+}
+
+
+} // /namespace Details
+
+
+/**
+\brief Static k-d tree for nearest neighbor queries over 3D point sets.
+\tparam T Specifies the data type of the point coordinates. This should be float or double.
+\remarks The tree is always split at the median, so it is perfectly balanced and can be stored implicitly:
+the children of the internal node 'i' are the nodes '2*i + 1' and '2*i + 2', and only the split axis and value are stored per node.
+All leaves are on the same level and cover contiguous ranges of the reordered points, which are stored in tree order for cache-friendly leaf scans.
+The construction partitions the point indices with std::nth_element on SoA coordinate arrays, and the nodes of each tree level are processed with "Details::ParallelFor".
+\code
+Gs::KdTreef tree;
+tree.Build(points.data(), points.size());
+
+std::uint32_t indices[8];
+float distancesSq[8];
+auto n = tree.FindNearest(query, 8, indices, distancesSq);
+\endcode
+*/
+template <typename T>
+class KdTreeT
+{
+
+    public:
+
+        static_assert(std::is_floating_point<T>::value, "k-d trees can only be used with floating point types");
+
+        //! Specifies the typename of the scalar components.
+        using ScalarType = T;
+
+        //! Index value for missing neighbors in the output of "FindNearestBatch".
+        static const std::uint32_t invalidIndex = 0xffffffff;
+
+        /**
+        \brief Builds the tree for the specified points.
+        \param[in] points Pointer to the points. The points are copied, so they don't need to remain valid.
+        \param[in] numPoints Specifies the number of points.
+        \param[in] leafSize Specifies the maximal number of points per leaf. By default 8.
+        */
+        void Build(const Vector3T<T>* points, std::size_t numPoints, std::size_t leafSize = 8)
+        {
+            leafSize = std::max<std::size_t>(leafSize, 1);
+
+            /* Determine the number of tree levels, so that all leaves have at most 'leafSize' points */
+            depth_ = 0;
+            while (((numPoints + (std::size_t(1) << depth_) - 1) >> depth_) > leafSize)
+                ++depth_;
+
+            const std::size_t numInternal = (std::size_t(1) << depth_) - 1;
+
+            splitValues_.resize(numInternal);
+            splitAxes_.resize(numInternal);
+
+            /* Copy coordinates into SoA arrays for the partitioning */
+            std::vector<T> coords[3];
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                coords[axis].resize(numPoints);
+                for (std::size_t i = 0; i < numPoints; ++i)
+                    coords[axis][i] = points[i][axis];
+            }
+
+            indices_.resize(numPoints);
+            for (std::size_t i = 0; i < numPoints; ++i)
+                indices_[i] = static_cast<std::uint32_t>(i);
+
+            /* Build tree level by level, all nodes of a level are independent */
+            for (std::size_t level = 0; level < depth_; ++level)
+            {
+                const std::size_t firstNode = (std::size_t(1) << level) - 1;
+                const std::size_t numNodes  = (std::size_t(1) << level);
+
+                Details::ParallelFor(
+                    numNodes, 1,
+                    [&](std::size_t begin, std::size_t end, std::size_t)
+                    {
+                        for (std::size_t i = begin; i < end; ++i)
+                            SplitNode(firstNode + i, level, coords, numPoints);
+                    }
+                );
+            }
+
+            /* Store points in tree order */
+            points_.resize(numPoints);
+            for (std::size_t i = 0; i < numPoints; ++i)
+                points_[i] = points[indices_[i]];
+        }
+
+        //! Returns the number of points in the tree.
+        std::size_t Size() const
+        {
+            return points_.size();
+        }
+
+        /**
+        \brief Finds the k nearest neighbors of the specified query point.
+        \param[in] query Specifies the query point.
+        \param[in] k Specifies the number of neighbors to find.
+        \param[out] indices Pointer to the output point indices (into the array passed to "Build"). This must have 'k' elements.
+        \param[out] distancesSq Optional pointer to the output squared distances. This must have 'k' elements if it's not null.
+        \return Number of neighbors found, i.e. min(k, Size()). The neighbors are sorted by ascending distance.
+        */
+        std::size_t FindNearest(const Vector3T<T>& query, std::size_t k, std::uint32_t* indices, T* distancesSq = nullptr) const
+        {
+            std::vector<Details::KdTreeNeighbor<T>> heap(k);
+            return FindNearest(query, k, indices, distancesSq, heap.data());
+        }
+
+        /**
+        \brief Finds all points within the specified radius around the query point.
+        \param[in] query Specifies the query point.
+        \param[in] radius Specifies the search radius.
+        \param[out] indices Specifies the output point indices (into the array passed to "Build"). The container is cleared first.
+        \param[out] distancesSq Optional pointer to the output squared distances. The container is cleared first.
+        \remarks The output is not sorted.
+        */
+        void FindRadius(const Vector3T<T>& query, const T& radius, std::vector<std::uint32_t>& indices, std::vector<T>* distancesSq = nullptr) const
+        {
+            indices.clear();
+            if (distancesSq)
+                distancesSq->clear();
+            if (!points_.empty())
+                SearchRadius(query, radius*radius, 0, 0, points_.size(), indices, distancesSq);
+        }
+
+        /**
+        \brief Finds the k nearest neighbors for each of the specified query points.
+        \param[in] queries Pointer to the query points.
+        \param[in] numQueries Specifies the number of query points.
+        \param[in] k Specifies the number of neighbors to find per query.
+        \param[out] indices Pointer to the output point indices. This must have 'numQueries * k' elements,
+        where the neighbors of query 'i' are stored in the range [i*k, (i + 1)*k). Missing neighbors are set to 'invalidIndex'.
+        \param[out] distancesSq Optional pointer to the output squared distances (same layout as 'indices').
+        Missing neighbors are set to std::numeric_limits<T>::max().
+        \remarks The queries are processed in Morton order, so consecutive queries traverse similar paths of the tree,
+        and the ordered queries are distributed with "Details::ParallelFor".
+        */
+        void FindNearestBatch(
+            const Vector3T<T>*  queries,
+            std::size_t         numQueries,
+            std::size_t         k,
+            std::uint32_t*      indices,
+            T*                  distancesSq = nullptr) const
+        {
+            if (numQueries == 0 || k == 0)
+                return;
+
+            /* Sort queries by their Morton codes */
+            Vector3T<T> minima = queries[0], maxima = queries[0];
+            for (std::size_t i = 1; i < numQueries; ++i)
+            {
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    minima[axis] = std::min(minima[axis], queries[i][axis]);
+                    maxima[axis] = std::max(maxima[axis], queries[i][axis]);
+                }
+            }
+
+            Vector3T<T> invExtent { UninitializeTag{} };
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                const T extent = maxima[axis] - minima[axis];
+                invExtent[axis] = (extent > T(0) ? T(1) / extent : T(0));
+            }
+
+            std::vector<std::uint64_t> order(numQueries);
+            for (std::size_t i = 0; i < numQueries; ++i)
+                order[i] = (static_cast<std::uint64_t>(Details::MortonCode(queries[i], minima, invExtent)) << 32) | static_cast<std::uint64_t>(i);
+
+            std::sort(order.begin(), order.end());
+
+            /* Process queries in Morton order */
+            Details::ParallelFor(
+                numQueries, 1024,
+                [&](std::size_t begin, std::size_t end, std::size_t)
+                {
+                    std::vector<Details::KdTreeNeighbor<T>> heap(k);
+
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        const std::size_t q = static_cast<std::size_t>(order[i] & 0xffffffff);
+
+                        auto outIndices     = indices + q*k;
+                        auto outDistancesSq = (distancesSq != nullptr ? distancesSq + q*k : nullptr);
+
+                        const std::size_t n = FindNearest(queries[q], k, outIndices, outDistancesSq, heap.data());
+
+                        for (std::size_t j = n; j < k; ++j)
+                        {
+                            outIndices[j] = invalidIndex;
+                            if (outDistancesSq)
+                                outDistancesSq[j] = std::numeric_limits<T>::max();
+                        }
+                    }
+                }
+            );
+        }
+
+    private:
+
+        // Returns the point range [begin, end) of the specified node on the specified level.
+        void NodeRange(std::size_t node, std::size_t level, std::size_t numPoints, std::size_t& begin, std::size_t& end) const
+        {
+            begin   = 0;
+            end     = numPoints;
+
+            /* Walk down from the root, the path is given by the bits of the node index relative to the first node of its level */
+            const std::size_t path = node + 1 - (std::size_t(1) << level);
+            for (std::size_t i = level; i > 0; --i)
+            {
+                const std::size_t mid = begin + (end - begin)/2;
+                if ((path >> (i - 1)) & 1)
+                    begin = mid;
+                else
+                    end = mid;
+            }
+        }
+
+        void SplitNode(std::size_t node, std::size_t level, const std::vector<T>* coords, std::size_t numPoints)
+        {
+            std::size_t begin, end;
+            NodeRange(node, level, numPoints, begin, end);
+
+            /* Split along the axis with the largest extent */
+            T minima[3], maxima[3];
+            for (std::size_t axis = 0; axis < 3; ++axis)
+            {
+                minima[axis] = std::numeric_limits<T>::max();
+                maxima[axis] = std::numeric_limits<T>::lowest();
+            }
+
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                for (std::size_t axis = 0; axis < 3; ++axis)
+                {
+                    const T x = coords[axis][indices_[i]];
+                    minima[axis] = std::min(minima[axis], x);
+                    maxima[axis] = std::max(maxima[axis], x);
+                }
+            }
+
+            std::size_t splitAxis = 0;
+            for (std::size_t axis = 1; axis < 3; ++axis)
+            {
+                if (maxima[axis] - minima[axis] > maxima[splitAxis] - minima[splitAxis])
+                    splitAxis = axis;
+            }
+
+            /* Partition at the median */
+            const std::size_t mid = begin + (end - begin)/2;
+            const auto& c = coords[splitAxis];
+
+            std::nth_element(
+                indices_.begin() + begin, indices_.begin() + mid, indices_.begin() + end,
+                [&c](std::uint32_t lhs, std::uint32_t rhs)
+                {
+                    return (c[lhs] < c[rhs]);
+                }
+            );
+
+            splitAxes_[node]    = static_cast<std::uint8_t>(splitAxis);
+            splitValues_[node]  = c[indices_[mid]];
+        }
+
+        std::size_t FindNearest(
+            const Vector3T<T>&              query,
+            std::size_t                     k,
+            std::uint32_t*                  indices,
+            T*                              distancesSq,
+            Details::KdTreeNeighbor<T>*     heap) const
+        {
+            if (k == 0 || points_.empty())
+                return 0;
+
+            std::size_t count = 0;
+            SearchNearest(query, 0, 0, points_.size(), heap, k, count);
+
+            /* Sort neighbors by ascending distance */
+            std::sort_heap(heap, heap + count);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                indices[i] = indices_[heap[i].index];
+                if (distancesSq)
+                    distancesSq[i] = heap[i].distanceSq;
+            }
+
+            return count;
+        }
+
+        void SearchNearest(
+            const Vector3T<T>&              query,
+            std::size_t                     node,
+            std::size_t                     begin,
+            std::size_t                     end,
+            Details::KdTreeNeighbor<T>*     heap,
+            std::size_t                     k,
+            std::size_t&                    count) const
+        {
+            if (node >= splitValues_.size())
+            {
+                /* Scan leaf points with the bounded max-heap */
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    const T d = DistanceSq(query, points_[i]);
+                    if (count < k)
+                    {
+                        heap[count++] = { d, static_cast<std::uint32_t>(i) };
+                        std::push_heap(heap, heap + count);
+                    }
+                    else if (d < heap[0].distanceSq)
+                    {
+                        std::pop_heap(heap, heap + k);
+                        heap[k - 1] = { d, static_cast<std::uint32_t>(i) };
+                        std::push_heap(heap, heap + k);
+                    }
+                }
+                return;
+            }
+
+            const std::size_t mid = begin + (end - begin)/2;
+            const T diff = query[splitAxes_[node]] - splitValues_[node];
+
+            /* Visit the near side first, then the far side only if the splitting plane is closer than the current k-th neighbor */
+            if (diff < T(0))
+            {
+                SearchNearest(query, node*2 + 1, begin, mid, heap, k, count);
+                if (count < k || diff*diff < heap[0].distanceSq)
+                    SearchNearest(query, node*2 + 2, mid, end, heap, k, count);
+            }
+            else
+            {
+                SearchNearest(query, node*2 + 2, mid, end, heap, k, count);
+                if (count < k || diff*diff < heap[0].distanceSq)
+                    SearchNearest(query, node*2 + 1, begin, mid, heap, k, count);
+            }
+        }
+
+        void SearchRadius(
+            const Vector3T<T>&              query,
+            const T&                        radiusSq,
+            std::size_t                     node,
+            std::size_t                     begin,
+            std::size_t                     end,
+            std::vector<std::uint32_t>&     indices,
+            std::vector<T>*                 distancesSq) const
+        {
+            if (node >= splitValues_.size())
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    const T d = DistanceSq(query, points_[i]);
+                    if (d <= radiusSq)
+                    {
+                        indices.push_back(indices_[i]);
+                        if (distancesSq)
+                            distancesSq->push_back(d);
+                    }
+                }
+                return;
+            }
+
+            const std::size_t mid = begin + (end - begin)/2;
+            const T diff = query[splitAxes_[node]] - splitValues_[node];
+
+            if (diff < T(0) || diff*diff <= radiusSq)
+                SearchRadius(query, radiusSq, node*2 + 1, begin, mid, indices, distancesSq);
+            if (diff >= T(0) || diff*diff <= radiusSq)
+                SearchRadius(query, radiusSq, node*2 + 2, mid, end, indices, distancesSq);
+        }
+
+        std::size_t                 depth_ = 0;
+        std::vector<T>              splitValues_;
+        std::vector<std::uint8_t>   splitAxes_;
+        std::vector<Vector3T<T>>    points_;
+        std::vector<std::uint32_t>  indices_;
+
+};
+
+
+/* --- Type Alias --- */
+
+using KdTree    = KdTreeT<Real>;
+using KdTreef   = KdTreeT<float>;
+using KdTreed   = KdTreeT<double>;
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,578 @@
+/*
+ * LieGroup.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_LIE_GROUP_H
+#define GS_LIE_GROUP_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/Conversions.h>
+#include <Gauss/Parallel.h>
+#include <Gauss/SIMDPacket.h>
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+
+
+namespace Gs
+{
+
+
+/*
+Lie group utilities for rotations (SO(3)) and rigid transformations (SE(3)).
+Rotation vectors 'omega' are in axis-angle form (the axis scaled by the angle in radians),
+and twists are specified by a translational part 'v' and a rotational part 'omega' (in this order for the 6x6 Jacobians).
+All functions use the column vector convention in terms of the 'At' accessor, i.e. they follow the GS_ROW_VECTORS configuration like "QuaternionToMatrix".
+*/
+
+namespace Details
+{
+
+
+/*
+Returns the squared angle below which the Taylor series (up to theta^4) of the packet exponential and logarithm maps are used.
+This is about 0.02 for float.
+*/
+template <typename T>
+T SmallAngleThresholdSq()
+{
+    return std::sqrt(std::sqrt(std::numeric_limits<T>::epsilon()));
+}
+
+/*
+Returns the squared angle below which the Taylor series (up to theta^6) of the Jacobian coefficients are used.
+Closed forms like (theta - sin(theta))/theta^3 lose about -log2(theta^2/6) bits to cancellation, so the series are used
+as long as their truncation error (about theta^8/362880) is below the machine epsilon, i.e. up to theta = 0.67 for float and 0.055 for double.
+*/
+template <typename T>
+T SeriesThresholdSq()
+{
+    return std::sqrt(std::sqrt(std::numeric_limits<T>::epsilon() * T(362880)));
+}
+
+// Coefficients of the SO(3) exponential and Jacobians for the squared angle.
+template <typename T>
+struct SO3Coefficients
+{
+    SO3Coefficients(const T& thetaSq)
+    {
+        if (thetaSq < SeriesThresholdSq<T>())
+        {
+            const T t2 = thetaSq, t4 = thetaSq*thetaSq, t6 = t4*thetaSq;
+            a = T(1) - t2/T(6) + t4/T(120) - t6/T(5040);
+            b = T(1)/T(2) - t2/T(24) + t4/T(720) - t6/T(40320);
+            c = T(1)/T(6) - t2/T(120) + t4/T(5040) - t6/T(362880);
+            d = T(1)/T(12) + t2/T(720) + t4/T(30240) + t6/T(1209600);
+        }
+        else
+        {
+            const T theta = std::sqrt(thetaSq);
+            const T s = std::sin(theta), co = std::cos(theta);
+            a = s / theta;
+            b = (T(1) - co) / thetaSq;
+            c = (theta - s) / (thetaSq*theta);
+            d = (T(1) - a/(T(2)*b)) / thetaSq;
+        }
+    }
+
+    T a; //!< sin(theta)/theta
+    T b; //!< (1 - cos(theta))/theta^2
+    T c; //!< (theta - sin(theta))/theta^3
+    T d; //!< (1 - theta*sin(theta)/(2*(1 - cos(theta))))/theta^2
+};
+
+// Returns I + a*K + b*K^2 where K is the skew-symmetric cross product matrix of 'w', and K^2 = w*w^T - |w|^2*I.
+template <typename T>
+Matrix3T<T> SkewPolynomial(const Vector3T<T>& w, const T& a, const T& b)
+{
+    Matrix3T<T> m { UninitializeTag{} };
+
+    const T diag = T(1) - b*w.LengthSq();
+
+    m.At(0, 0) = diag + b*w.x*w.x;
+    m.At(0, 1) = b*w.x*w.y - a*w.z;
+    m.At(0, 2) = b*w.x*w.z + a*w.y;
+
+    m.At(1, 0) = b*w.y*w.x + a*w.z;
+    m.At(1, 1) = diag + b*w.y*w.y;
+    m.At(1, 2) = b*w.y*w.z - a*w.x;
+
+    m.At(2, 0) = b*w.z*w.x - a*w.y;
+    m.At(2, 1) = b*w.z*w.y + a*w.x;
+    m.At(2, 2) = diag + b*w.z*w.z;
+
+    return m;
+}
+
+// Returns the product of the upper-left 3x3 matrix with the vector.
+template <class M, typename T>
+Vector3T<T> Transform3x3(const M& m, const Vector3T<T>& v)
+{
+    return Vector3T<T>(
+        m.At(0, 0)*v.x + m.At(0, 1)*v.y + m.At(0, 2)*v.z,
+        m.At(1, 0)*v.x + m.At(1, 1)*v.y + m.At(1, 2)*v.z,
+        m.At(2, 0)*v.x + m.At(2, 1)*v.y + m.At(2, 2)*v.z
+    );
+}
+
+// Exponential map from a rotation vector to a unit quaternion for packets.
+template <typename P>
+void ExpSO3Packet(const P& x, const P& y, const P& z, P& qx, P& qy, P& qz, P& qw)
+{
+    using T = typename PacketTraits<P>::ScalarType;
+
+    const P thetaSq = x*x + y*y + z*z;
+    const P theta   = PacketSqrt(thetaSq);
+
+    P s, c;
+    PacketSinCos(theta * P(T(0.5)), s, c);
+
+    /* Taylor series of sin(theta/2)/theta and cos(theta/2) */
+    const P t4      = thetaSq*thetaSq;
+    const P sSeries = P(T(0.5)) - thetaSq*P(T(1)/T(48)) + t4*P(T(1)/T(3840));
+    const P cSeries = P(T(1)) - thetaSq*P(T(0.125)) + t4*P(T(1)/T(384));
+
+    const P small   = P(SmallAngleThresholdSq<T>()) - thetaSq;
+    const P k       = PacketSelectPositive(small, sSeries, s / theta);
+
+    qx = x * k;
+    qy = y * k;
+    qz = z * k;
+    qw = PacketSelectPositive(small, cSeries, c);
+}
+
+// Logarithm map from a unit quaternion to a rotation vector for packets.
+template <typename P>
+void LogSO3Packet(const P& qx, const P& qy, const P& qz, const P& qw, P& x, P& y, P& z)
+{
+    using T = typename PacketTraits<P>::ScalarType;
+
+    /* Use the quaternion with non-negative W, so the angle is in [0, pi] */
+    const P sign    = PacketSelectPositive(qw, P(T(1)), P(T(-1)));
+    const P w       = PacketAbs(qw);
+    const P nSq     = qx*qx + qy*qy + qz*qz;
+    const P n       = PacketSqrt(nSq);
+
+    /* theta/n = 2*atan(n/w)/n with the Taylor series 2/w*(1 - t^2/3 + t^4/5) for t = n/w */
+    const P tSq     = nSq / (w*w);
+    const P series  = P(T(2)) / w * (P(T(1)) - tSq*P(T(1)/T(3)) + tSq*tSq*P(T(0.2)));
+    const P closed  = P(T(2)) * PacketAtan(n / w) / n;
+    const P k       = sign * PacketSelectPositive(P(SmallAngleThresholdSq<T>()) - tSq, series, closed);
+
+    x = qx * k;
+    y = qy * k;
+    z = qz * k;
+}
+
+template <typename T>
+class ExpSO3Kernel
+{
+
+    public:
+
+        ExpSO3Kernel(const Vector3T<T>* omegas, QuaternionT<T>* quaternions) :
+            in_  { omegas[0].Ptr()      },
+            out_ { &(quaternions[0].x)  }
+        {
+        }
+
+        template <typename P>
+        void Run(std::size_t i) const
+        {
+            using Traits = PacketTraits<P>;
+            P qx, qy, qz, qw;
+            ExpSO3Packet(
+                Traits::LoadStrided(in_ + i*3, 3), Traits::LoadStrided(in_ + i*3 + 1, 3), Traits::LoadStrided(in_ + i*3 + 2, 3),
+                qx, qy, qz, qw
+            );
+            Traits::StoreStrided(out_ + i*4,     4, qx);
+            Traits::StoreStrided(out_ + i*4 + 1, 4, qy);
+            Traits::StoreStrided(out_ + i*4 + 2, 4, qz);
+            Traits::StoreStrided(out_ + i*4 + 3, 4, qw);
+        }
+
+    private:
+
+        const T*    in_;
+        T*          out_;
+
+};
+
+template <typename T>
+class LogSO3Kernel
+{
+
+    public:
+
+        LogSO3Kernel(const QuaternionT<T>* quaternions, Vector3T<T>* omegas) :
+            in_  { &(quaternions[0].x)  },
+            out_ { omegas[0].Ptr()      }
+        {
+        }
+
+        template <typename P>
+        void Run(std::size_t i) const
+        {
+            using Traits = PacketTraits<P>;
+            P x, y, z;
+            LogSO3Packet(
+                Traits::LoadStrided(in_ + i*4, 4), Traits::LoadStrided(in_ + i*4 + 1, 4),
+                Traits::LoadStrided(in_ + i*4 + 2, 4), Traits::LoadStrided(in_ + i*4 + 3, 4),
+                x, y, z
+            );
+            Traits::StoreStrided(out_ + i*3,     3, x);
+            Traits::StoreStrided(out_ + i*3 + 1, 3, y);
+            Traits::StoreStrided(out_ + i*3 + 2, 3, z);
+        }
+
+    private:
+
+        const T*    in_;
+        T*          out_;
+
+};
+
+
+} // /namespace Details
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Exponential map of SO(3): converts the specified rotation vector into a unit quaternion.
+\param[out] out Specifies the output quaternion.
+\param[in] omega Specifies the rotation vector, i.e. the rotation axis scaled by the angle (in radians).
+\remarks In contrast to "QuaternionT::SetAngleAxis", this requires no normalization and uses a Taylor series for small angles.
+*/
+template <typename T>
+void ExpSO3(QuaternionT<T>& out, const Vector3T<T>& omega)
+{
+    const T thetaSq = omega.LengthSq();
+
+    T k, w;
+    if (thetaSq < Details::SmallAngleThresholdSq<T>())
+    {
+        /* Taylor series of sin(theta/2)/theta and cos(theta/2) */
+        const T t4 = thetaSq*thetaSq;
+        k = T(0.5) - thetaSq/T(48) + t4/T(3840);
+        w = T(1) - thetaSq*T(0.125) + t4/T(384);
+    }
+    else
+    {
+        const T theta = std::sqrt(thetaSq);
+        k = std::sin(theta*T(0.5)) / theta;
+        w = std::cos(theta*T(0.5));
+    }
+
+    out.x = omega.x * k;
+    out.y = omega.y * k;
+    out.z = omega.z * k;
+    out.w = w;
+}
+
+/**
+\brief Exponential map of SO(3): converts the specified rotation vector into a rotation matrix (Rodrigues' formula).
+\see ExpSO3(QuaternionT<T>&, const Vector3T<T>&)
+*/
+template <typename T>
+void ExpSO3(Matrix3T<T>& out, const Vector3T<T>& omega)
+{
+    const Details::SO3Coefficients<T> k(omega.LengthSq());
+    out = Details::SkewPolynomial(omega, k.a, k.b);
+}
+
+/**
+\brief Logarithm map of SO(3): converts the specified unit quaternion into a rotation vector with an angle in the range [0, pi].
+\see ExpSO3
+*/
+template <typename T>
+Vector3T<T> LogSO3(const QuaternionT<T>& q)
+{
+    /* Use the quaternion with non-negative W, so the angle is in [0, pi] */
+    const T w   = std::abs(q.w);
+    const T nSq = q.x*q.x + q.y*q.y + q.z*q.z;
+
+    T k;
+    if (nSq < Details::SmallAngleThresholdSq<T>() * w*w)
+    {
+        /* Taylor series of 2*atan(n/w)/n = 2/w*(1 - t^2/3 + t^4/5) for t = n/w */
+        const T tSq = nSq / (w*w);
+        k = T(2) / w * (T(1) - tSq/T(3) + tSq*tSq*T(0.2));
+    }
+    else
+    {
+        const T n = std::sqrt(nSq);
+        k = T(2) * std::atan2(n, w) / n;
+    }
+
+    if (!(q.w > T(0)))
+        k = -k;
+
+    return Vector3T<T>(q.x * k, q.y * k, q.z * k);
+}
+
+/**
+\brief Logarithm map of SO(3): converts the specified rotation matrix into a rotation vector with an angle in the range [0, pi].
+\see ExpSO3
+*/
+template <typename T>
+Vector3T<T> LogSO3(const Matrix3T<T>& m)
+{
+    QuaternionT<T> q { UninitializeTag{} };
+    MatrixToQuaternion(q, m);
+    return LogSO3(q);
+}
+
+/**
+\brief Returns the left Jacobian of SO(3), which maps a perturbation of the rotation vector to a rotation applied on the left side:
+Exp(omega + delta) = Exp(LeftJacobianSO3(omega) * delta) * Exp(omega) for small delta.
+\remarks This is also the matrix V of the SE(3) exponential map.
+*/
+template <typename T>
+Matrix3T<T> LeftJacobianSO3(const Vector3T<T>& omega)
+{
+    const Details::SO3Coefficients<T> k(omega.LengthSq());
+    return Details::SkewPolynomial(omega, k.b, k.c);
+}
+
+/**
+\brief Returns the right Jacobian of SO(3): Exp(omega + delta) = Exp(omega) * Exp(RightJacobianSO3(omega) * delta) for small delta.
+\remarks This is equal to LeftJacobianSO3(-omega).
+*/
+template <typename T>
+Matrix3T<T> RightJacobianSO3(const Vector3T<T>& omega)
+{
+    const Details::SO3Coefficients<T> k(omega.LengthSq());
+    return Details::SkewPolynomial(omega, -k.b, k.c);
+}
+
+//! Returns the inverse of the left Jacobian of SO(3). \see LeftJacobianSO3
+template <typename T>
+Matrix3T<T> InverseLeftJacobianSO3(const Vector3T<T>& omega)
+{
+    const Details::SO3Coefficients<T> k(omega.LengthSq());
+    return Details::SkewPolynomial(omega, T(-0.5), k.d);
+}
+
+//! Returns the inverse of the right Jacobian of SO(3). \see RightJacobianSO3
+template <typename T>
+Matrix3T<T> InverseRightJacobianSO3(const Vector3T<T>& omega)
+{
+    const Details::SO3Coefficients<T> k(omega.LengthSq());
+    return Details::SkewPolynomial(omega, T(0.5), k.d);
+}
+
+/**
+\brief Composes the rotations of the two rotation vectors, i.e. returns Log(Exp(lhs) * Exp(rhs)) where 'rhs' is applied first.
+\remarks The composition is done with quaternions.
+*/
+template <typename T>
+Vector3T<T> ComposeSO3(const Vector3T<T>& lhs, const Vector3T<T>& rhs)
+{
+    QuaternionT<T> a { UninitializeTag{} }, b { UninitializeTag{} };
+    ExpSO3(a, lhs);
+    ExpSO3(b, rhs);
+    /* QuaternionT multiplication 'b * a' rotates by 'b' first */
+    return LogSO3(b * a);
+}
+
+/**
+\brief Exponential map of SE(3): converts the specified twist into an affine transformation.
+\param[out] out Specifies the output transformation.
+\param[in] v Specifies the translational part of the twist.
+\param[in] omega Specifies the rotational part of the twist.
+\remarks The rotation is Exp(omega) and the translation is LeftJacobianSO3(omega) * v.
+*/
+template <typename T>
+void ExpSE3(AffineMatrix4T<T>& out, const Vector3T<T>& v, const Vector3T<T>& omega)
+{
+    const Details::SO3Coefficients<T> k(omega.LengthSq());
+
+    const auto r = Details::SkewPolynomial(omega, k.a, k.b);
+    const auto t = Details::Transform3x3(Details::SkewPolynomial(omega, k.b, k.c), v);
+
+    for (std::size_t row = 0; row < 3; ++row)
+    {
+        for (std::size_t col = 0; col < 3; ++col)
+            out.At(row, col) = r.At(row, col);
+    }
+
+    out.SetPosition(t);
+}
+
+/**
+\brief Logarithm map of SE(3): converts the specified rigid transformation (without scaling) into a twist.
+\param[in] m Specifies the rigid transformation.
+\param[out] v Specifies the output translational part of the twist.
+\param[out] omega Specifies the output rotational part of the twist.
+\see ExpSE3
+*/
+template <typename T>
+void LogSE3(const AffineMatrix4T<T>& m, Vector3T<T>& v, Vector3T<T>& omega)
+{
+    QuaternionT<T> q { UninitializeTag{} };
+    MatrixToQuaternion(q, m);
+    omega = LogSO3(q);
+    v = Details::Transform3x3(InverseLeftJacobianSO3(omega), m.GetPosition());
+}
+
+/**
+\brief Returns the left Jacobian of SE(3) for the twist (v, omega) in the 6x6 block form [ J, Q ; 0, J ], where J is the left Jacobian of SO(3).
+\remarks The coupling block Q follows Barfoot, "State Estimation for Robotics", with Taylor series for small angles.
+*/
+template <typename T>
+Matrix<T, 6, 6> LeftJacobianSE3(const Vector3T<T>& v, const Vector3T<T>& omega)
+{
+    const T thetaSq = omega.LengthSq();
+
+    /* Coefficients of the Q block: (theta - sin)/theta^3, (theta^2 + 2*cos - 2)/(2*theta^4), and (2*theta - 3*sin + theta*cos)/(2*theta^5) */
+    T c1, c2, c3;
+    if (thetaSq < Details::SeriesThresholdSq<T>())
+    {
+        const T t4 = thetaSq*thetaSq, t6 = t4*thetaSq;
+        c1 = T(1)/T(6)  - thetaSq/T(120)  + t4/T(5040)  - t6/T(362880);
+        c2 = T(1)/T(24) - thetaSq/T(720)  + t4/T(40320) - t6/T(3628800);
+        c3 = T(1)/T(120) - thetaSq/T(2520) + t4/T(120960) - t6/T(9979200);
+    }
+    else
+    {
+        const T theta = std::sqrt(thetaSq);
+        const T s = std::sin(theta), co = std::cos(theta);
+        c1 = (theta - s) / (thetaSq*theta);
+        c2 = (thetaSq*T(0.5) + co - T(1)) / (thetaSq*thetaSq);
+        c3 = T(0.5) * (c2 + T(3)*(theta - s - thetaSq*theta/T(6)) / (thetaSq*thetaSq*theta));
+    }
+
+    /* Q = 1/2*V + c1*(WV + VW + WVW) + c2*(WWV + VWW - 3*WVW) + c3*(WVWW + WWVW) with V = skew(v), W = skew(omega) */
+    auto skew = [](const Vector3T<T>& a) -> Matrix3T<T>
+    {
+        Matrix3T<T> m { UninitializeTag{} };
+        m.At(0, 0) = T(0);  m.At(0, 1) = -a.z;  m.At(0, 2) = a.y;
+        m.At(1, 0) = a.z;   m.At(1, 1) = T(0);  m.At(1, 2) = -a.x;
+        m.At(2, 0) = -a.y;  m.At(2, 1) = a.x;   m.At(2, 2) = T(0);
+        return m;
+    };
+
+    const auto V    = skew(v);
+    const auto W    = skew(omega);
+    const auto WV   = W*V;
+    const auto VW   = V*W;
+    const auto WVW  = WV*W;
+
+    Matrix3T<T> Q = V*T(0.5) + (WV + VW + WVW)*c1 + (W*WV + VW*W - WVW*T(3))*c2 + (WVW*W + W*WVW)*c3;
+
+    const auto J = LeftJacobianSO3(omega);
+
+    Matrix<T, 6, 6> result;
+    result.Reset();
+
+    for (std::size_t row = 0; row < 3; ++row)
+    {
+        for (std::size_t col = 0; col < 3; ++col)
+        {
+            result.At(row,     col    ) = J.At(row, col);
+            result.At(row,     col + 3) = Q.At(row, col);
+            result.At(row + 3, col + 3) = J.At(row, col);
+        }
+    }
+
+    return result;
+}
+
+//! Returns the right Jacobian of SE(3), which is equal to LeftJacobianSE3(-v, -omega). \see LeftJacobianSE3
+template <typename T>
+Matrix<T, 6, 6> RightJacobianSE3(const Vector3T<T>& v, const Vector3T<T>& omega)
+{
+    return LeftJacobianSE3(-v, -omega);
+}
+
+/**
+\brief Composes the rigid transformations of the two twists, i.e. computes Log(Exp(lhs) * Exp(rhs)) where 'rhs' is applied first.
+\see ExpSE3
+\see LogSE3
+*/
+template <typename T>
+void ComposeSE3(
+    const Vector3T<T>& lhsV, const Vector3T<T>& lhsOmega,
+    const Vector3T<T>& rhsV, const Vector3T<T>& rhsOmega,
+    Vector3T<T>& v, Vector3T<T>& omega)
+{
+    AffineMatrix4T<T> a { UninitializeTag{} }, b { UninitializeTag{} };
+    ExpSE3(a, lhsV, lhsOmega);
+    ExpSE3(b, rhsV, rhsOmega);
+    /* With row vectors, the product 'b * a' applies 'b' first */
+    #ifdef GS_ROW_VECTORS
+    LogSE3(b * a, v, omega);
+    #else
+    LogSE3(a * b, v, omega);
+    #endif
+}
+
+/**
+\brief Applies the SO(3) exponential map to all rotation vectors of the specified array.
+\param[in] omegas Pointer to the input rotation vectors.
+\param[out] quaternions Pointer to the output unit quaternions.
+\param[in] count Specifies the number of elements.
+\remarks Single precision arrays are processed in SIMD packets (4 or 8 elements at once) with a vectorized sine and cosine,
+and the range is distributed with "Details::ParallelFor".
+\see ExpSO3(QuaternionT<T>&, const Vector3T<T>&)
+*/
+template <typename T>
+void ExpSO3Array(const Vector3T<T>* omegas, QuaternionT<T>* quaternions, std::size_t count)
+{
+    static_assert(sizeof(Vector3T<T>) == sizeof(T)*3 && sizeof(QuaternionT<T>) == sizeof(T)*4, "vectors and quaternions must be tightly packed");
+
+    if (count == 0)
+        return;
+
+    const Details::ExpSO3Kernel<T> kernel(omegas, quaternions);
+
+    Details::ParallelFor(
+        count, 8192,
+        [&kernel](std::size_t begin, std::size_t end, std::size_t)
+        {
+            Details::ForEachPacket<T>(begin, end, kernel);
+        }
+    );
+}
+
+/**
+\brief Applies the SO(3) logarithm map to all unit quaternions of the specified array.
+\see ExpSO3Array
+\see LogSO3(const QuaternionT<T>&)
+*/
+template <typename T>
+void LogSO3Array(const QuaternionT<T>* quaternions, Vector3T<T>* omegas, std::size_t count)
+{
+    static_assert(sizeof(Vector3T<T>) == sizeof(T)*3 && sizeof(QuaternionT<T>) == sizeof(T)*4, "vectors and quaternions must be tightly packed");
+
+    if (count == 0)
+        return;
+
+    const Details::LogSO3Kernel<T> kernel(quaternions, omegas);
+
+    Details::ParallelFor(
+        count, 8192,
+        [&kernel](std::size_t begin, std::size_t end, std::size_t)
+        {
+            Details::ForEachPacket<T>(begin, end, kernel);
+        }
+    );
+}
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
@@ -15,6 +15,7 @@
 #include "Tags.h"
 #include "Rotate.h"
 #include "MatrixInitializer.h"
+#include "MatrixKernels.h"
 
 #include <cmath>
 #include <cstring>
@@ -124,10 +125,7 @@ class Matrix
         }
 
         //! Copy constructor.
-        Matrix(const ThisType& rhs)
-        {
-            *this = rhs;
-        }
+        Matrix(const ThisType&) = default;
 
         //! Initializes this matrix with the specified values (row by row, and column by column).
         Matrix(const std::initializer_list<T>& values)
@@ -224,12 +222,7 @@ class Matrix
             return *this;
         }
 
-        ThisType& operator = (const ThisType& rhs)
-        {
-            for (std::size_t i = 0; i < ThisType::elements; ++i)
-                m_[i] = rhs.m_[i];
-            return *this;
-        }
+        ThisType& operator = (const ThisType&) = default;
 
         #ifdef GS_ROW_VECTORS
 
@@ -282,34 +275,31 @@ class Matrix
             return result;
         }
 
-        //! Returns a transposed copy of this matrix.
+        /**
+        \brief Returns a transposed copy of this matrix.
+        \remarks 4x4 tiles of float and double matrices are transposed in SIMD registers (see "MatrixKernels.h").
+        */
         TransposedType Transposed() const
         {
-            TransposedType result;
+            TransposedType result { UninitializeTag{} };
 
-            GS_FOREACH_ROW_COL(r, c)
-            {
-                result(c, r) = (*this)(r, c);
-            }
+            #ifdef GS_ROW_MAJOR_STORAGE
+            Details::TransposeElements<Rows, Cols>(m_, result.Ptr());
+            #else
+            Details::TransposeElements<Cols, Rows>(m_, result.Ptr());
+            #endif
 
             return result;
         }
 
-        //! Transposes this matrix.
+        /**
+        \brief Transposes this matrix.
+        \remarks Large matrices are transposed in cache sized blocks of 4x4 tiles (see "MatrixKernels.h").
+        */
         void Transpose()
         {
             GS_ASSERT_NxN_MATRIX;
-
-            for (std::size_t i = 0; i + 1 < Cols; ++i)
-            {
-                for (std::size_t j = 1; j + i < Cols; ++j)
-                {
-                    std::swap(
-                        m_[i*(Cols + 1) + j],
-                        m_[(j + i)*Cols + i]
-                    );
-                }
-            }
+            Details::TransposeElementsInPlace<Cols>(m_);
         }
 
         /**
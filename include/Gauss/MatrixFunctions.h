@@ -0,0 +1,475 @@
+/*
+ * MatrixFunctions.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_MATRIX_FUNCTIONS_H
+#define GS_MATRIX_FUNCTIONS_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/Parallel.h>
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+
+namespace Gs
+{
+
+
+/*
+Matrix functions for square matrices: exponential, logarithm, square root, and integer powers.
+All functions operate on copies of the fixed size matrices on the stack, i.e. they are allocation-free.
+Linear systems are solved with Gaussian elimination (partial pivoting), so they are not limited to the 2x2, 3x3, and 4x4 inverses.
+*/
+
+namespace Details
+{
+
+
+// Returns the 1-norm (maximum absolute column sum) of the matrix, or NaN if any component is NaN.
+template <typename T, std::size_t N>
+T MatrixNorm1(const Matrix<T, N, N>& m)
+{
+    T norm = T(0);
+
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        T sum = T(0);
+        for (std::size_t r = 0; r < N; ++r)
+            sum += std::abs(m(r, c));
+        if (sum > norm || std::isnan(sum))
+            norm = sum;
+    }
+
+    return norm;
+}
+
+// Returns the 1-norm of the difference between the matrix and the identity matrix.
+template <typename T, std::size_t N>
+T MatrixNorm1FromIdentity(const Matrix<T, N, N>& m)
+{
+    T norm = T(0);
+
+    for (std::size_t c = 0; c < N; ++c)
+    {
+        T sum = T(0);
+        for (std::size_t r = 0; r < N; ++r)
+            sum += std::abs(r == c ? m(r, c) - T(1) : m(r, c));
+        if (sum > norm || std::isnan(sum))
+            norm = sum;
+    }
+
+    return norm;
+}
+
+// Adds the scalar 's' to the diagonal elements of the matrix.
+template <typename T, std::size_t N>
+void AddToDiagonal(Matrix<T, N, N>& m, const T& s)
+{
+    for (std::size_t i = 0; i < N; ++i)
+        m(i, i) += s;
+}
+
+/*
+Solves the linear system 'A * X = B' for all columns of 'B' by Gaussian elimination with partial pivoting.
+The solution X is written to 'b'. Returns false if the matrix 'a' is singular.
+*/
+template <typename T, std::size_t N>
+bool SolveMatrixSystem(Matrix<T, N, N> a, Matrix<T, N, N>& b)
+{
+    for (std::size_t k = 0; k < N; ++k)
+    {
+        /* Find pivot element */
+        std::size_t pivot = k;
+        T pivotAbs = std::abs(a(k, k));
+
+        for (std::size_t i = k + 1; i < N; ++i)
+        {
+            const T x = std::abs(a(i, k));
+            if (pivotAbs < x)
+            {
+                pivot       = i;
+                pivotAbs    = x;
+            }
+        }
+
+        if (pivotAbs == T(0))
+            return false;
+
+        if (pivot != k)
+        {
+            for (std::size_t j = k; j < N; ++j)
+                std::swap(a(k, j), a(pivot, j));
+            for (std::size_t j = 0; j < N; ++j)
+                std::swap(b(k, j), b(pivot, j));
+        }
+
+        /* Eliminate the column below the pivot */
+        const T invPivot = T(1) / a(k, k);
+
+        for (std::size_t i = k + 1; i < N; ++i)
+        {
+            const T f = a(i, k) * invPivot;
+
+            if (f != T(0))
+            {
+                for (std::size_t j = k + 1; j < N; ++j)
+                    a(i, j) -= f * a(k, j);
+                for (std::size_t j = 0; j < N; ++j)
+                    b(i, j) -= f * b(k, j);
+            }
+        }
+    }
+
+    /* Back substitution */
+    for (std::size_t i = N; i-- > 0;)
+    {
+        const T invDiag = T(1) / a(i, i);
+
+        for (std::size_t j = 0; j < N; ++j)
+        {
+            T x = b(i, j);
+            for (std::size_t k = i + 1; k < N; ++k)
+                x -= a(i, k) * b(k, j);
+            b(i, j) = x * invDiag;
+        }
+    }
+
+    return true;
+}
+
+// Returns 'c[0]*I + c[1]*a2 + c[2]*a4 + c[3]*a6' for the even powers 'a2', 'a4', and 'a6' of a matrix.
+template <typename T, std::size_t N>
+Matrix<T, N, N> MatrixExpPadeTerm(const double (&c)[4], const Matrix<T, N, N>& a2, const Matrix<T, N, N>& a4, const Matrix<T, N, N>& a6)
+{
+    Matrix<T, N, N> result { UninitializeTag{} };
+
+    for (std::size_t i = 0; i < N*N; ++i)
+        result[i] = T(c[1])*a2[i] + T(c[2])*a4[i] + T(c[3])*a6[i];
+
+    AddToDiagonal(result, T(c[0]));
+
+    return result;
+}
+
+/*
+Degree of the diagonal Pade approximant and the maximal 1-norm 'theta' for which its backward error is below the unit roundoff
+(see N. J. Higham, "The Scaling and Squaring Method for the Matrix Exponential Revisited", 2005).
+*/
+template <typename T>
+struct MatrixExpPadeTraits
+{
+    static const int degree = 13;
+    static T Theta() { return T(5.371920351148152); }
+};
+
+template <>
+struct MatrixExpPadeTraits<float>
+{
+    static const int degree = 7;
+    static float Theta() { return 3.925724783138660f; }
+};
+
+// Computes the odd part 'u' and the even part 'v' of the [7/7] Pade approximant, i.e. exp(a) ~ (v - u)^-1 * (v + u).
+template <typename T, std::size_t N>
+void MatrixExpPade(const Matrix<T, N, N>& a, Matrix<T, N, N>& u, Matrix<T, N, N>& v, std::integral_constant<int, 7>)
+{
+    static const double cv[4] = { 17297280.0, 1995840.0, 25200.0, 56.0 };
+    static const double cu[4] = {  8648640.0,  277200.0,  1512.0,  1.0 };
+
+    const auto a2 = a * a;
+    const auto a4 = a2 * a2;
+    const auto a6 = a2 * a4;
+
+    u = a * MatrixExpPadeTerm(cu, a2, a4, a6);
+    v = MatrixExpPadeTerm(cv, a2, a4, a6);
+}
+
+// Computes the odd part 'u' and the even part 'v' of the [13/13] Pade approximant with six matrix multiplications.
+template <typename T, std::size_t N>
+void MatrixExpPade(const Matrix<T, N, N>& a, Matrix<T, N, N>& u, Matrix<T, N, N>& v, std::integral_constant<int, 13>)
+{
+    static const double cv0[4] = { 64764752532480000.0, 7771770303897600.0, 129060195264000.0, 670442572800.0 };
+    static const double cv1[4] = { 0.0, 1323241920.0, 960960.0, 182.0 };
+    static const double cu0[4] = { 32382376266240000.0, 1187353796428800.0, 10559470521600.0, 33522128640.0 };
+    static const double cu1[4] = { 0.0, 40840800.0, 16380.0, 1.0 };
+
+    const auto a2 = a * a;
+    const auto a4 = a2 * a2;
+    const auto a6 = a2 * a4;
+
+    u = a * (a6 * MatrixExpPadeTerm(cu1, a2, a4, a6) + MatrixExpPadeTerm(cu0, a2, a4, a6));
+    v = a6 * MatrixExpPadeTerm(cv1, a2, a4, a6) + MatrixExpPadeTerm(cv0, a2, a4, a6);
+}
+
+/*
+Nodes and weights of the 7-point Gauss-Legendre quadrature on [0, 1]. Applied to log(I + X) = integral of X * (I + t*X)^-1 over t in [0, 1],
+this is the [7/7] Pade approximant of the logarithm, which is accurate to double precision for ||X|| <= 0.25.
+*/
+static const double matrixLogNodes[7] =
+{
+    0.5 - 0.9491079123427585*0.5, 0.5 - 0.7415311855993945*0.5, 0.5 - 0.4058451513773972*0.5, 0.5,
+    0.5 + 0.4058451513773972*0.5, 0.5 + 0.7415311855993945*0.5, 0.5 + 0.9491079123427585*0.5,
+};
+
+static const double matrixLogWeights[7] =
+{
+    0.1294849661688697*0.5, 0.2797053914892766*0.5, 0.3818300505051189*0.5, 0.4179591836734694*0.5,
+    0.3818300505051189*0.5, 0.2797053914892766*0.5, 0.1294849661688697*0.5,
+};
+
+// Computes log(I + x) with the Pade approximant in partial fraction form.
+template <typename T, std::size_t N>
+bool MatrixLogPade(Matrix<T, N, N>& result, const Matrix<T, N, N>& x)
+{
+    result.Reset();
+
+    for (std::size_t j = 0; j < 7; ++j)
+    {
+        /* Solve (I + t*X) * Y = X, since X and (I + t*X)^-1 commute */
+        auto a = x * T(matrixLogNodes[j]);
+        AddToDiagonal(a, T(1));
+
+        auto y = x;
+        if (!SolveMatrixSystem(a, y))
+            return false;
+
+        result += y * T(matrixLogWeights[j]);
+    }
+
+    return true;
+}
+
+
+} // /namespace Details
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Computes the exponential of the specified square matrix, i.e. the sum of m^k/k! for k = 0, 1, 2, ...
+\param[out] exp Specifies the output matrix.
+\param[in] m Specifies the input matrix.
+\return True on success. Otherwise, 'm' has non-finite components or the denominator of the Pade approximant is singular, and 'exp' is not modified.
+\remarks This uses the scaling-and-squaring method: the matrix is scaled by 2^-s until its 1-norm is small enough
+for a diagonal Pade approximant (degree 13 for double, degree 7 for float), which is then squared s times.
+Typical use cases are the discretization of continuous-time systems (e.g. exp(A*dt) for a Kalman filter) and transform interpolation.
+\see MatrixLog
+*/
+template <typename T, std::size_t N>
+bool MatrixExp(Matrix<T, N, N>& exp, const Matrix<T, N, N>& m)
+{
+    using Traits = Details::MatrixExpPadeTraits<T>;
+
+    /* Scale matrix into the range of the Pade approximant */
+    const T norm = Details::MatrixNorm1(m);
+
+    if (!std::isfinite(norm))
+        return false;
+
+    int s = 0;
+    if (norm > Traits::Theta())
+        s = static_cast<int>(std::ceil(std::log2(norm / Traits::Theta())));
+
+    const auto a = m * std::ldexp(T(1), -s);
+
+    /* Evaluate the Pade approximant: (V - U) * X = (V + U) */
+    Matrix<T, N, N> u { UninitializeTag{} }, v { UninitializeTag{} };
+    Details::MatrixExpPade(a, u, v, std::integral_constant<int, Traits::degree>());
+
+    auto x = v + u;
+    if (!Details::SolveMatrixSystem(v - u, x))
+        return false;
+
+    /* Undo scaling by repeated squaring */
+    for (int i = 0; i < s; ++i)
+        x = x * x;
+
+    exp = x;
+
+    return true;
+}
+
+/**
+\brief Returns the exponential of the specified square matrix.
+\remarks If the exponential can not be computed, all components of the returned matrix are NaN.
+\see MatrixExp(Matrix<T, N, N>&, const Matrix<T, N, N>&)
+*/
+template <typename T, std::size_t N>
+Matrix<T, N, N> MatrixExp(const Matrix<T, N, N>& m)
+{
+    Matrix<T, N, N> result { UninitializeTag{} };
+
+    if (!MatrixExp(result, m))
+    {
+        for (std::size_t i = 0; i < N*N; ++i)
+            result.Ptr()[i] = std::numeric_limits<T>::quiet_NaN();
+    }
+
+    return result;
+}
+
+/**
+\brief Computes the principal square root of the specified square matrix with the Denman-Beavers iteration.
+\param[out] sqrt Specifies the output matrix with (sqrt * sqrt) = m.
+\param[in] m Specifies the input matrix. It must not have eigenvalues on the closed negative real axis.
+\return True on success. Otherwise, the matrix is singular or the iteration did not converge, and 'sqrt' is not modified.
+*/
+template <typename T, std::size_t N>
+bool MatrixSqrt(Matrix<T, N, N>& sqrt, const Matrix<T, N, N>& m)
+{
+    static const T tolerance = std::sqrt(std::numeric_limits<T>::epsilon());
+
+    auto y = m;
+    auto z = m;
+
+    bool nearlyConverged = false;
+
+    for (int i = 0; i < 64; ++i)
+    {
+        auto inv = Matrix<T, N, N>::Identity();
+        if (!Details::SolveMatrixSystem(z, inv))
+            return false;
+
+        /* Product form: Y <- Y * (I + Z^-1) / 2, Z <- (I + (Z + Z^-1) / 2) / 2 */
+        auto a = inv;
+        Details::AddToDiagonal(a, T(1));
+        y = y * a;
+        y *= T(0.5);
+
+        z += inv;
+        z *= T(0.25);
+        Details::AddToDiagonal(z, T(0.5));
+
+        /* Apply one more iteration after the tolerance was reached, since the convergence is quadratic */
+        if (nearlyConverged)
+        {
+            sqrt = y;
+            return true;
+        }
+
+        nearlyConverged = (Details::MatrixNorm1FromIdentity(z) <= tolerance);
+    }
+
+    return false;
+}
+
+/**
+\brief Computes the principal logarithm of the specified square matrix, i.e. the inverse of "MatrixExp".
+\param[out] log Specifies the output matrix with MatrixExp(log) = m.
+\param[in] m Specifies the input matrix. It must not have eigenvalues on the closed negative real axis.
+\return True on success. Otherwise, 'log' is not modified.
+\remarks This uses the inverse scaling-and-squaring method: square roots are taken (see "MatrixSqrt") until m^(1/2^k) is close to the identity,
+then log(m) = 2^k * log(m^(1/2^k)) is evaluated with a Pade approximant.
+\see MatrixExp
+*/
+template <typename T, std::size_t N>
+bool MatrixLog(Matrix<T, N, N>& log, const Matrix<T, N, N>& m)
+{
+    auto a = m;
+
+    int k = 0;
+
+    while (Details::MatrixNorm1FromIdentity(a) > T(0.25))
+    {
+        if (k == 64 || !MatrixSqrt(a, a))
+            return false;
+        ++k;
+    }
+
+    Details::AddToDiagonal(a, T(-1));
+
+    Matrix<T, N, N> x { UninitializeTag{} };
+    if (!Details::MatrixLogPade(x, a))
+        return false;
+
+    log = x * std::ldexp(T(1), k);
+
+    return true;
+}
+
+/**
+\brief Computes the integer power of the specified square matrix by binary exponentiation.
+\param[out] pow Specifies the output matrix m^e.
+\param[in] m Specifies the input matrix.
+\param[in] e Specifies the exponent. If this is negative, the power of the inverse matrix is computed, and zero results in the identity matrix.
+\return True on success. Otherwise, 'e' is negative and the matrix is singular, and 'pow' is not modified.
+*/
+template <typename T, std::size_t N>
+bool MatrixPow(Matrix<T, N, N>& pow, const Matrix<T, N, N>& m, int e)
+{
+    auto base = m;
+
+    if (e < 0)
+    {
+        base = Matrix<T, N, N>::Identity();
+        if (!Details::SolveMatrixSystem(m, base))
+            return false;
+    }
+
+    auto result = Matrix<T, N, N>::Identity();
+
+    for (unsigned int i = (e < 0 ? 0u - static_cast<unsigned int>(e) : static_cast<unsigned int>(e)); i > 0; i >>= 1)
+    {
+        if ((i & 1u) != 0)
+            result = result * base;
+        if (i > 1)
+            base = base * base;
+    }
+
+    pow = result;
+
+    return true;
+}
+
+/**
+\brief Returns the integer power of the specified square matrix.
+\remarks If 'e' is negative and the matrix is singular, the identity matrix is returned.
+\see MatrixPow(Matrix<T, N, N>&, const Matrix<T, N, N>&, int)
+*/
+template <typename T, std::size_t N>
+Matrix<T, N, N> MatrixPow(const Matrix<T, N, N>& m, int e)
+{
+    auto result = Matrix<T, N, N>::Identity();
+    MatrixPow(result, m, e);
+    return result;
+}
+
+/**
+\brief Computes the exponential of all matrices of the specified array.
+\param[in] input Pointer to the input matrices.
+\param[out] output Pointer to the output matrices.
+\param[in] count Specifies the number of matrices.
+\remarks The range is distributed with "Details::ParallelFor".
+\see MatrixExp
+*/
+template <typename T, std::size_t N>
+void MatrixExpArray(const Matrix<T, N, N>* input, Matrix<T, N, N>* output, std::size_t count)
+{
+    Details::ParallelFor(
+        count, 256,
+        [input, output](std::size_t begin, std::size_t end, std::size_t)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+                output[i] = MatrixExp(input[i]);
+        }
+    );
+}
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
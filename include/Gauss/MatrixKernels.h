@@ -0,0 +1,274 @@
+/*
+ * MatrixKernels.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_MATRIX_KERNELS_H
+#define GS_MATRIX_KERNELS_H
+
+
+#include "SIMD.h"
+
+#include <cstddef>
+#include <algorithm>
+
+
+namespace Gs
+{
+
+
+namespace Details
+{
+
+
+/*
+Transpose kernels for the generic Matrix<T, Rows, Cols> class. They operate on the plain element arrays,
+i.e. independent of the storage layout: an array of N rows with M elements each (in memory order)
+is transposed into an array of M rows with N elements each. Matrices are processed in 4x4 tiles,
+which are transposed in SSE/AVX registers for floats and doubles.
+*/
+
+// Transposes the 4x4 tile 'src' into the tile 'dst' (the strides are specified in elements). 'src' and 'dst' may be equal.
+template <typename T>
+void Transpose4x4(const T* src, std::size_t srcStride, T* dst, std::size_t dstStride)
+{
+    T tile[4][4];
+
+    for (std::size_t r = 0; r < 4; ++r)
+    {
+        for (std::size_t c = 0; c < 4; ++c)
+            tile[c][r] = src[r*srcStride + c];
+    }
+
+    for (std::size_t r = 0; r < 4; ++r)
+    {
+        for (std::size_t c = 0; c < 4; ++c)
+            dst[r*dstStride + c] = tile[r][c];
+    }
+}
+
+// Transposes the two 4x4 tiles 'a' and 'b' and exchanges them.
+template <typename T>
+void SwapTranspose4x4(T* a, T* b, std::size_t stride)
+{
+    for (std::size_t r = 0; r < 4; ++r)
+    {
+        for (std::size_t c = 0; c < 4; ++c)
+            std::swap(a[r*stride + c], b[c*stride + r]);
+    }
+}
+
+#ifdef GS_SIMD_SSE2
+
+inline void LoadTransposed4x4(const float* src, std::size_t stride, __m128 (&rows)[4])
+{
+    rows[0] = _mm_loadu_ps(src           );
+    rows[1] = _mm_loadu_ps(src + stride  );
+    rows[2] = _mm_loadu_ps(src + stride*2);
+    rows[3] = _mm_loadu_ps(src + stride*3);
+    _MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+}
+
+inline void Store4x4(float* dst, std::size_t stride, const __m128 (&rows)[4])
+{
+    _mm_storeu_ps(dst           , rows[0]);
+    _mm_storeu_ps(dst + stride  , rows[1]);
+    _mm_storeu_ps(dst + stride*2, rows[2]);
+    _mm_storeu_ps(dst + stride*3, rows[3]);
+}
+
+inline void Transpose4x4(const float* src, std::size_t srcStride, float* dst, std::size_t dstStride)
+{
+    __m128 rows[4];
+    LoadTransposed4x4(src, srcStride, rows);
+    Store4x4(dst, dstStride, rows);
+}
+
+inline void SwapTranspose4x4(float* a, float* b, std::size_t stride)
+{
+    __m128 rowsA[4], rowsB[4];
+    LoadTransposed4x4(a, stride, rowsA);
+    LoadTransposed4x4(b, stride, rowsB);
+    Store4x4(a, stride, rowsB);
+    Store4x4(b, stride, rowsA);
+}
+
+#ifdef GS_SIMD_AVX
+
+// Transposes a 4x4 tile of doubles with the same unpack/shuffle pattern as _MM_TRANSPOSE4_PS, but with 256-bit registers.
+inline void LoadTransposed4x4(const double* src, std::size_t stride, __m256d (&rows)[4])
+{
+    const __m256d r0 = _mm256_loadu_pd(src           );
+    const __m256d r1 = _mm256_loadu_pd(src + stride  );
+    const __m256d r2 = _mm256_loadu_pd(src + stride*2);
+    const __m256d r3 = _mm256_loadu_pd(src + stride*3);
+
+    /* (a0 b0 a2 b2), (a1 b1 a3 b3), (c0 d0 c2 d2), (c1 d1 c3 d3) */
+    const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+    const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+    const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+    rows[0] = _mm256_permute2f128_pd(t0, t2, 0x20);
+    rows[1] = _mm256_permute2f128_pd(t1, t3, 0x20);
+    rows[2] = _mm256_permute2f128_pd(t0, t2, 0x31);
+    rows[3] = _mm256_permute2f128_pd(t1, t3, 0x31);
+}
+
+inline void Store4x4(double* dst, std::size_t stride, const __m256d (&rows)[4])
+{
+    _mm256_storeu_pd(dst           , rows[0]);
+    _mm256_storeu_pd(dst + stride  , rows[1]);
+    _mm256_storeu_pd(dst + stride*2, rows[2]);
+    _mm256_storeu_pd(dst + stride*3, rows[3]);
+}
+
+using Transpose4x4RowsD = __m256d[4];
+
+#else
+
+// Transposes a 4x4 tile of doubles in 2x2 blocks: 'rows[r*2]' stores the left and 'rows[r*2 + 1]' the right half of row r.
+inline void LoadTransposed4x4(const double* src, std::size_t stride, __m128d (&rows)[8])
+{
+    const __m128d a0 = _mm_loadu_pd(src             ), a1 = _mm_loadu_pd(src              + 2);
+    const __m128d b0 = _mm_loadu_pd(src + stride    ), b1 = _mm_loadu_pd(src + stride     + 2);
+    const __m128d c0 = _mm_loadu_pd(src + stride*2  ), c1 = _mm_loadu_pd(src + stride*2   + 2);
+    const __m128d d0 = _mm_loadu_pd(src + stride*3  ), d1 = _mm_loadu_pd(src + stride*3   + 2);
+
+    rows[0] = _mm_unpacklo_pd(a0, b0);
+    rows[1] = _mm_unpacklo_pd(c0, d0);
+    rows[2] = _mm_unpackhi_pd(a0, b0);
+    rows[3] = _mm_unpackhi_pd(c0, d0);
+    rows[4] = _mm_unpacklo_pd(a1, b1);
+    rows[5] = _mm_unpacklo_pd(c1, d1);
+    rows[6] = _mm_unpackhi_pd(a1, b1);
+    rows[7] = _mm_unpackhi_pd(c1, d1);
+}
+
+inline void Store4x4(double* dst, std::size_t stride, const __m128d (&rows)[8])
+{
+    for (std::size_t r = 0; r < 4; ++r)
+    {
+        _mm_storeu_pd(dst + stride*r,     rows[r*2    ]);
+        _mm_storeu_pd(dst + stride*r + 2, rows[r*2 + 1]);
+    }
+}
+
+using Transpose4x4RowsD = __m128d[8];
+
+#endif // /GS_SIMD_AVX
+
+inline void Transpose4x4(const double* src, std::size_t srcStride, double* dst, std::size_t dstStride)
+{
+    Transpose4x4RowsD rows;
+    LoadTransposed4x4(src, srcStride, rows);
+    Store4x4(dst, dstStride, rows);
+}
+
+inline void SwapTranspose4x4(double* a, double* b, std::size_t stride)
+{
+    Transpose4x4RowsD rowsA, rowsB;
+    LoadTransposed4x4(a, stride, rowsA);
+    LoadTransposed4x4(b, stride, rowsB);
+    Store4x4(a, stride, rowsB);
+    Store4x4(b, stride, rowsA);
+}
+
+#endif // /GS_SIMD_SSE2
+
+/*
+Block size (in elements) for the transposition of large matrices. The 4x4 tiles of a 16x16 block cover full cache lines
+of the rows that are read and of the rows that are written, so each cache line is only loaded once per block.
+*/
+static const std::size_t matrixTransposeBlockSize = 16;
+
+// Transposes the N x M array 'src' into the M x N array 'dst'. 'src' and 'dst' must not overlap, unless N = M = 4.
+template <std::size_t N, std::size_t M, typename T>
+void TransposeElements(const T* src, T* dst)
+{
+    const std::size_t b     = matrixTransposeBlockSize;
+    const std::size_t n4    = N - N % 4;
+    const std::size_t m4    = M - M % 4;
+
+    /* Transpose the 4x4 tiles in cache sized blocks */
+    for (std::size_t ib = 0; ib < n4; ib += b)
+    {
+        const std::size_t iEnd = std::min(ib + b, n4);
+
+        for (std::size_t jb = 0; jb < m4; jb += b)
+        {
+            const std::size_t jEnd = std::min(jb + b, m4);
+
+            for (std::size_t i = ib; i < iEnd; i += 4)
+            {
+                for (std::size_t j = jb; j < jEnd; j += 4)
+                    Transpose4x4(src + i*M + j, M, dst + j*N + i, N);
+            }
+        }
+    }
+
+    /* Transpose the remaining columns and rows which do not fill a tile */
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        for (std::size_t j = m4; j < M; ++j)
+            dst[j*N + i] = src[i*M + j];
+    }
+
+    for (std::size_t i = n4; i < N; ++i)
+    {
+        for (std::size_t j = 0; j < m4; ++j)
+            dst[j*N + i] = src[i*M + j];
+    }
+}
+
+// Transposes the N x N array 'm' in place.
+template <std::size_t N, typename T>
+void TransposeElementsInPlace(T* m)
+{
+    const std::size_t b     = matrixTransposeBlockSize;
+    const std::size_t n4    = N - N % 4;
+
+    /* Exchange the 4x4 tiles of the upper and lower triangle in cache sized blocks */
+    for (std::size_t ib = 0; ib < n4; ib += b)
+    {
+        const std::size_t iEnd = std::min(ib + b, n4);
+
+        for (std::size_t jb = ib; jb < n4; jb += b)
+        {
+            const std::size_t jEnd = std::min(jb + b, n4);
+
+            for (std::size_t i = ib; i < iEnd; i += 4)
+            {
+                for (std::size_t j = std::max(jb, i); j < jEnd; j += 4)
+                {
+                    if (i == j)
+                        Transpose4x4(m + i*N + i, N, m + i*N + i, N);
+                    else
+                        SwapTranspose4x4(m + i*N + j, m + j*N + i, N);
+                }
+            }
+        }
+    }
+
+    /* Exchange the remaining elements which do not fill a tile */
+    for (std::size_t i = n4; i < N; ++i)
+    {
+        for (std::size_t j = 0; j < i; ++j)
+            std::swap(m[i*N + j], m[j*N + i]);
+    }
+}
+
+
+} // /namespace Details
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,115 @@
+/*
+ * MeshAdjacency.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_MESH_ADJACENCY_H
+#define GS_MESH_ADJACENCY_H
+
+
+#include "Assert.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace Gs
+{
+
+
+/**
+\brief Vertex-to-face adjacency of a triangle mesh in compressed sparse row (CSR) layout.
+\remarks The faces of vertex 'i' are stored in the range [offsets[i], offsets[i + 1]) of the 'faces' array.
+This allows per-vertex gathering over adjacent triangles without atomic operations or per-thread buffers:
+\code
+Gs::VertexFaceAdjacency adjacency;
+adjacency.Build(indices.data(), indices.size(), vertices.size());
+
+for (std::size_t i = 0; i < vertices.size(); ++i)
+{
+    for (auto f = adjacency.FacesBegin(i); f != adjacency.FacesEnd(i); ++f)
+        // ... gather data of triangle *f
+}
+\endcode
+*/
+class VertexFaceAdjacency
+{
+
+    public:
+
+        /**
+        \brief Builds the adjacency for the specified triangle list.
+        \param[in] indices Pointer to the triangle list indices.
+        \param[in] numIndices Specifies the number of indices. This should be a multiple of 3.
+        \param[in] numVertices Specifies the number of vertices. All indices must be in the range [0, numVertices).
+        */
+        template <typename Index>
+        void Build(const Index* indices, std::size_t numIndices, std::size_t numVertices)
+        {
+            const std::size_t numFaces = numIndices / 3;
+
+            offsets.assign(numVertices + 1, 0);
+            faces.resize(numFaces*3);
+
+            /* Count faces per vertex */
+            for (std::size_t i = 0; i < numFaces*3; ++i)
+            {
+                GS_ASSERT(static_cast<std::size_t>(indices[i]) < numVertices);
+                ++offsets[static_cast<std::size_t>(indices[i]) + 1];
+            }
+
+            /* Convert counts to offsets (prefix sum) */
+            for (std::size_t i = 0; i < numVertices; ++i)
+                offsets[i + 1] += offsets[i];
+
+            /* Scatter face indices, the per-vertex face lists remain in ascending order */
+            std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+
+            for (std::size_t f = 0; f < numFaces; ++f)
+            {
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    const auto v = static_cast<std::size_t>(indices[f*3 + j]);
+                    faces[cursor[v]++] = static_cast<std::uint32_t>(f);
+                }
+            }
+        }
+
+        //! Returns the number of faces that are adjacent to the specified vertex.
+        std::size_t NumFaces(std::size_t vertex) const
+        {
+            return (offsets[vertex + 1] - offsets[vertex]);
+        }
+
+        //! Returns a pointer to the first face index of the specified vertex.
+        const std::uint32_t* FacesBegin(std::size_t vertex) const
+        {
+            return faces.data() + offsets[vertex];
+        }
+
+        //! Returns a pointer after the last face index of the specified vertex.
+        const std::uint32_t* FacesEnd(std::size_t vertex) const
+        {
+            return faces.data() + offsets[vertex + 1];
+        }
+
+        //! Face offsets for each vertex (with numVertices + 1 entries).
+        std::vector<std::uint32_t> offsets;
+
+        //! Face indices of all vertices.
+        std::vector<std::uint32_t> faces;
+
+};
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,358 @@
+/*
+ * MeshNormals.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_MESH_NORMALS_H
+#define GS_MESH_NORMALS_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/MeshAdjacency.h>
+#include <Gauss/BatchAlgebra.h>
+#include <Gauss/Packing.h>
+#include <Gauss/Parallel.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+
+
+namespace Gs
+{
+
+
+//! Weighting schemes of the face normals that contribute to a vertex normal.
+enum class NormalWeighting
+{
+    Uniform,    //!< Each adjacent face has the same weight.
+    Area,       //!< Each adjacent face is weighted by its area.
+    Angle,      //!< Each adjacent face is weighted by its interior angle at the vertex.
+};
+
+//! Packed formats of vertex normals.
+enum class NormalPacking
+{
+    Octahedral16,   //!< Octahedral mapping with two 16-bit signed normalized integers. \see PackOctahedral16
+    Snorm10_10_10_2,//!< Three 10-bit signed normalized integers, the 2-bit component is zero. \see PackSnorm10_10_10_2
+};
+
+
+namespace Details
+{
+
+
+// Returns the interior angle between the two edge vectors.
+template <typename T>
+T EdgeAngle(const Vector3T<T>& a, const Vector3T<T>& b)
+{
+    const T lenSq = a.LengthSq() * b.LengthSq();
+    if (lenSq > T(0))
+        return std::acos(Clamp(Dot(a, b) / std::sqrt(lenSq), T(-1), T(1)));
+    return T(0);
+}
+
+/*
+Computes the normalized normal of each face and the weights of its three corners (stored in x, y, and z).
+Degenerated faces get a zero normal, so they don't contribute to any vertex normal.
+*/
+template <typename T, typename Index>
+void ComputeFaceNormals(
+    const Vector3T<T>*          positions,
+    const Index*                indices,
+    std::size_t                 numFaces,
+    NormalWeighting             weighting,
+    std::vector<Vector3T<T>>&   faceNormals,
+    std::vector<Vector3T<T>>&   cornerWeights)
+{
+    faceNormals.resize(numFaces);
+    cornerWeights.resize(numFaces);
+
+    ParallelFor(
+        numFaces, 4096,
+        [&](std::size_t begin, std::size_t end, std::size_t)
+        {
+            for (std::size_t f = begin; f < end; ++f)
+            {
+                const auto& p0 = positions[indices[f*3    ]];
+                const auto& p1 = positions[indices[f*3 + 1]];
+                const auto& p2 = positions[indices[f*3 + 2]];
+
+                auto normal = Cross(p1 - p0, p2 - p0);
+                const T len = normal.Length();
+
+                if (len > T(0))
+                    normal /= len;
+                else
+                    normal = Vector3T<T>(T(0));
+
+                faceNormals[f] = normal;
+
+                switch (weighting)
+                {
+                    case NormalWeighting::Uniform:
+                        cornerWeights[f] = Vector3T<T>(T(1));
+                        break;
+                    case NormalWeighting::Area:
+                        cornerWeights[f] = Vector3T<T>(len*T(0.5));
+                        break;
+                    case NormalWeighting::Angle:
+                        cornerWeights[f] = Vector3T<T>(
+                            EdgeAngle(p1 - p0, p2 - p0),
+                            EdgeAngle(p2 - p1, p0 - p1),
+                            EdgeAngle(p0 - p2, p1 - p2)
+                        );
+                        break;
+                }
+            }
+        }
+    );
+}
+
+// Returns the corner weight of the specified vertex within the face (or zero if the vertex is not part of the face).
+template <typename T, typename Index>
+T CornerWeight(const Index* indices, std::size_t face, std::size_t vertex, const Vector3T<T>& weights)
+{
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+        if (static_cast<std::size_t>(indices[face*3 + j]) == vertex)
+            return weights[j];
+    }
+    return T(0);
+}
+
+// Gathers the weighted face vectors of all faces adjacent to the vertex.
+template <typename T, typename Index>
+Vector3T<T> GatherFaceVectors(
+    const VertexFaceAdjacency&  adjacency,
+    const Index*                indices,
+    std::size_t                 vertex,
+    const Vector3T<T>*          faceVectors,
+    const Vector3T<T>*          cornerWeights)
+{
+    Vector3T<T> sum(T(0));
+    for (auto f = adjacency.FacesBegin(vertex); f != adjacency.FacesEnd(vertex); ++f)
+        sum += faceVectors[*f] * CornerWeight(indices, *f, vertex, cornerWeights[*f]);
+    return sum;
+}
+
+
+} // /namespace Details
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Computes the vertex normals of the specified triangle mesh.
+\param[in] positions Pointer to the vertex positions.
+\param[in] numVertices Specifies the number of vertices.
+\param[in] indices Pointer to the triangle list indices.
+\param[in] numIndices Specifies the number of indices. This should be a multiple of 3.
+\param[in] adjacency Specifies the vertex-to-face adjacency of the mesh. \see VertexFaceAdjacency::Build
+\param[out] normals Pointer to the output normals. This must have 'numVertices' elements.
+\param[in] weighting Specifies how the adjacent face normals are weighted. By default NormalWeighting::Area.
+\remarks The face normals are computed first, then each vertex gathers the normals of its adjacent faces.
+Both passes are distributed with "Details::ParallelFor" and no atomic operations are required.
+The final normalization is done with "NormalizeArray". Vertices without any (non-degenerated) face get a zero normal.
+*/
+template <typename T, typename Index>
+void ComputeVertexNormals(
+    const Vector3T<T>*          positions,
+    std::size_t                 numVertices,
+    const Index*                indices,
+    std::size_t                 numIndices,
+    const VertexFaceAdjacency&  adjacency,
+    Vector3T<T>*                normals,
+    NormalWeighting             weighting = NormalWeighting::Area)
+{
+    std::vector<Vector3T<T>> faceNormals, cornerWeights;
+    Details::ComputeFaceNormals(positions, indices, numIndices / 3, weighting, faceNormals, cornerWeights);
+
+    Details::ParallelFor(
+        numVertices, 4096,
+        [&](std::size_t begin, std::size_t end, std::size_t)
+        {
+            for (std::size_t v = begin; v < end; ++v)
+                normals[v] = Details::GatherFaceVectors(adjacency, indices, v, faceNormals.data(), cornerWeights.data());
+            NormalizeArray(normals + begin, end - begin);
+        }
+    );
+}
+
+/**
+\brief Computes the vertex normals of the specified triangle mesh and builds the vertex-to-face adjacency internally.
+\see ComputeVertexNormals(const Vector3T<T>*, std::size_t, const Index*, std::size_t, const VertexFaceAdjacency&, Vector3T<T>*, NormalWeighting)
+*/
+template <typename T, typename Index>
+void ComputeVertexNormals(
+    const Vector3T<T>*  positions,
+    std::size_t         numVertices,
+    const Index*        indices,
+    std::size_t         numIndices,
+    Vector3T<T>*        normals,
+    NormalWeighting     weighting = NormalWeighting::Area)
+{
+    VertexFaceAdjacency adjacency;
+    adjacency.Build(indices, numIndices, numVertices);
+    ComputeVertexNormals(positions, numVertices, indices, numIndices, adjacency, normals, weighting);
+}
+
+/**
+\brief Computes the vertex normals of the specified triangle mesh and writes them in a packed format.
+\param[out] packedNormals Pointer to the output packed normals. This must have 'numVertices' elements.
+\param[in] packing Specifies the packed format.
+\remarks This avoids an intermediate array of unpacked normals.
+\see ComputeVertexNormals
+\see NormalPacking
+*/
+template <typename T, typename Index>
+void ComputeVertexNormals(
+    const Vector3T<T>*          positions,
+    std::size_t                 numVertices,
+    const Index*                indices,
+    std::size_t                 numIndices,
+    const VertexFaceAdjacency&  adjacency,
+    std::uint32_t*              packedNormals,
+    NormalPacking               packing,
+    NormalWeighting             weighting = NormalWeighting::Area)
+{
+    std::vector<Vector3T<T>> faceNormals, cornerWeights;
+    Details::ComputeFaceNormals(positions, indices, numIndices / 3, weighting, faceNormals, cornerWeights);
+
+    Details::ParallelFor(
+        numVertices, 4096,
+        [&](std::size_t begin, std::size_t end, std::size_t)
+        {
+            for (std::size_t v = begin; v < end; ++v)
+            {
+                auto normal = Details::GatherFaceVectors(adjacency, indices, v, faceNormals.data(), cornerWeights.data());
+
+                if (normal.LengthSq() > T(0))
+                    normal.Normalize();
+                else
+                    normal = Vector3T<T>(T(0), T(0), T(1));
+
+                if (packing == NormalPacking::Octahedral16)
+                    packedNormals[v] = PackOctahedral16(normal);
+                else
+                    packedNormals[v] = PackSnorm10_10_10_2(Vector4T<T>(normal.x, normal.y, normal.z, T(0)));
+            }
+        }
+    );
+}
+
+/**
+\brief Computes the tangent frames of the specified triangle mesh.
+\param[in] positions Pointer to the vertex positions.
+\param[in] texCoords Pointer to the vertex texture coordinates.
+\param[in] normals Pointer to the normalized vertex normals.
+\param[in] numVertices Specifies the number of vertices.
+\param[in] indices Pointer to the triangle list indices.
+\param[in] numIndices Specifies the number of indices. This should be a multiple of 3.
+\param[in] adjacency Specifies the vertex-to-face adjacency of the mesh. \see VertexFaceAdjacency::Build
+\param[out] tangents Pointer to the output tangents. This must have 'numVertices' elements.
+The XYZ components contain the normalized tangent (orthogonal to the normal),
+and the W component contains the handedness (+1 or -1), i.e. the bitangent is 'Cross(normal, tangent.xyz) * tangent.w'.
+\param[in] weighting Specifies how the adjacent face tangents are weighted. By default NormalWeighting::Area.
+\remarks The face tangents are derived from the texture coordinate gradients (Lengyel's method),
+and orthogonalized against the vertex normal with the Gram-Schmidt process.
+Vertices with degenerated texture coordinates get an arbitrary tangent orthogonal to their normal.
+*/
+template <typename T, typename Index>
+void ComputeTangentFrames(
+    const Vector3T<T>*          positions,
+    const Vector2T<T>*          texCoords,
+    const Vector3T<T>*          normals,
+    std::size_t                 numVertices,
+    const Index*                indices,
+    std::size_t                 numIndices,
+    const VertexFaceAdjacency&  adjacency,
+    Vector4T<T>*                tangents,
+    NormalWeighting             weighting = NormalWeighting::Area)
+{
+    const std::size_t numFaces = numIndices / 3;
+
+    std::vector<Vector3T<T>> faceNormals, cornerWeights;
+    Details::ComputeFaceNormals(positions, indices, numFaces, weighting, faceNormals, cornerWeights);
+
+    /* Compute normalized tangent and bitangent of each face */
+    std::vector<Vector3T<T>> faceTangents(numFaces), faceBitangents(numFaces);
+
+    Details::ParallelFor(
+        numFaces, 4096,
+        [&](std::size_t begin, std::size_t end, std::size_t)
+        {
+            for (std::size_t f = begin; f < end; ++f)
+            {
+                const auto i0 = indices[f*3], i1 = indices[f*3 + 1], i2 = indices[f*3 + 2];
+
+                const auto e1 = positions[i1] - positions[i0];
+                const auto e2 = positions[i2] - positions[i0];
+                const auto t1 = texCoords[i1] - texCoords[i0];
+                const auto t2 = texCoords[i2] - texCoords[i0];
+
+                const T det = t1.x*t2.y - t2.x*t1.y;
+
+                if (std::abs(det) > std::numeric_limits<T>::epsilon())
+                {
+                    const T invDet = T(1) / det;
+                    faceTangents[f]     = (e1*t2.y - e2*t1.y) * invDet;
+                    faceBitangents[f]   = (e2*t1.x - e1*t2.x) * invDet;
+                    Normalize(faceTangents[f]);
+                    Normalize(faceBitangents[f]);
+                }
+                else
+                {
+                    faceTangents[f]     = Vector3T<T>(T(0));
+                    faceBitangents[f]   = Vector3T<T>(T(0));
+                }
+            }
+        }
+    );
+
+    /* Gather tangents per vertex and orthonormalize them against the normals */
+    Details::ParallelFor(
+        numVertices, 4096,
+        [&](std::size_t begin, std::size_t end, std::size_t)
+        {
+            for (std::size_t v = begin; v < end; ++v)
+            {
+                const auto& normal      = normals[v];
+                const auto  tangent     = Details::GatherFaceVectors(adjacency, indices, v, faceTangents.data(), cornerWeights.data());
+                const auto  bitangent   = Details::GatherFaceVectors(adjacency, indices, v, faceBitangents.data(), cornerWeights.data());
+
+                /* Gram-Schmidt orthogonalization */
+                auto t = tangent - normal * Dot(normal, tangent);
+
+                const T lenSq = t.LengthSq();
+                if (lenSq > std::numeric_limits<T>::epsilon())
+                    t /= std::sqrt(lenSq);
+                else
+                {
+                    /* Choose any vector orthogonal to the normal */
+                    t = (std::abs(normal.x) < T(0.9) ? Cross(normal, Vector3T<T>(T(1), T(0), T(0))) : Cross(normal, Vector3T<T>(T(0), T(1), T(0))));
+                    t.Normalize();
+                }
+
+                const T handedness = (Dot(Cross(normal, t), bitangent) < T(0) ? T(-1) : T(1));
+
+                tangents[v] = Vector4T<T>(t.x, t.y, t.z, handedness);
+            }
+        }
+    );
+}
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,865 @@
+/*
+ * MeshSimplification.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_MESH_SIMPLIFICATION_H
+#define GS_MESH_SIMPLIFICATION_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/MeshAdjacency.h>
+#include <Gauss/Parallel.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <queue>
+#include <limits>
+#include <algorithm>
+#include <iterator>
+
+
+namespace Gs
+{
+
+
+/**
+\brief Symmetric 4x4 error quadric for the quadric error metric (QEM).
+\tparam T Specifies the data type of the quadric components. This should be float or double.
+\remarks Only the 10 unique elements of the symmetric matrix are stored (packed upper triangle, row by row):
+\code
+// / xx xy xz xw \
+// | xy yy yz yw |
+// | xz yz zz zw |
+// \ xw yw zw ww /
+\endcode
+*/
+template <typename T>
+class QuadricT
+{
+
+    public:
+
+        static_assert(std::is_floating_point<T>::value, "quadrics can only be used with floating point types");
+
+        //! Specifies the typename of the scalar components.
+        using ScalarType = T;
+
+        //! Number of packed quadric elements.
+        static const std::size_t elements = 10;
+
+        #ifndef GS_DISABLE_AUTO_INIT
+        QuadricT() :
+            xx { T(0) }, xy { T(0) }, xz { T(0) }, xw { T(0) },
+            yy { T(0) }, yz { T(0) }, yw { T(0) },
+            zz { T(0) }, zw { T(0) },
+            ww { T(0) }
+        {
+        }
+        #else
+        QuadricT() = default;
+        #endif
+
+        explicit QuadricT(UninitializeTag)
+        {
+            // do nothing
+        }
+
+        /**
+        \brief Returns the quadric of the specified plane, i.e. 'weight * p * p^T'.
+        \param[in] normal Specifies the plane normal. This should be normalized.
+        \param[in] distance Specifies the plane distance, i.e. the plane equation is Dot(normal, x) + distance = 0.
+        \param[in] weight Specifies the weight of this quadric, e.g. the triangle area.
+        */
+        static QuadricT<T> Plane(const Vector3T<T>& normal, const T& distance, const T& weight = T(1))
+        {
+            QuadricT<T> q { UninitializeTag{} };
+
+            const T a = normal.x, b = normal.y, c = normal.z, d = distance;
+
+            q.xx = weight*a*a; q.xy = weight*a*b; q.xz = weight*a*c; q.xw = weight*a*d;
+            q.yy = weight*b*b; q.yz = weight*b*c; q.yw = weight*b*d;
+            q.zz = weight*c*c; q.zw = weight*c*d;
+            q.ww = weight*d*d;
+
+            return q;
+        }
+
+        QuadricT<T>& operator += (const QuadricT<T>& rhs)
+        {
+            for (std::size_t i = 0; i < QuadricT<T>::elements; ++i)
+                Ptr()[i] += rhs.Ptr()[i];
+            return *this;
+        }
+
+        QuadricT<T>& operator *= (const T& rhs)
+        {
+            for (std::size_t i = 0; i < QuadricT<T>::elements; ++i)
+                Ptr()[i] *= rhs;
+            return *this;
+        }
+
+        //! Returns the quadric error v^T * Q * v for the homogeneous point v = (p, 1).
+        T Evaluate(const Vector3T<T>& p) const
+        {
+            return
+            (
+                p.x*(xx*p.x + T(2)*(xy*p.y + xz*p.z + xw)) +
+                p.y*(yy*p.y + T(2)*(yz*p.z + yw)) +
+                p.z*(zz*p.z + T(2)*zw) +
+                ww
+            );
+        }
+
+        /**
+        \brief Computes the point with the minimal quadric error.
+        \param[out] p Specifies the resulting point.
+        \return True if the upper-left 3x3 block is invertible, otherwise the output is not modified.
+        */
+        bool Minimize(Vector3T<T>& p) const
+        {
+            Matrix3T<T> a { UninitializeTag{} };
+
+            a(0, 0) = xx; a(0, 1) = xy; a(0, 2) = xz;
+            a(1, 0) = xy; a(1, 1) = yy; a(1, 2) = yz;
+            a(2, 0) = xz; a(2, 1) = yz; a(2, 2) = zz;
+
+            /* Reject (nearly) singular systems relative to the magnitude of the quadric */
+            const T trace = xx + yy + zz;
+            if (std::abs(a.Determinant()) <= Epsilon<T>() * trace*trace*trace)
+                return false;
+
+            Matrix3T<T> inv { UninitializeTag{} };
+            if (!Gs::Inverse(inv, a))
+                return false;
+
+            p = inv * Vector3T<T>(-xw, -yw, -zw);
+
+            return true;
+        }
+
+        //! Returns this quadric as full symmetric 4x4 matrix.
+        Matrix4T<T> ToMatrix4() const
+        {
+            return Matrix4T<T>
+            {
+                xx, xy, xz, xw,
+                xy, yy, yz, yw,
+                xz, yz, zz, zw,
+                xw, yw, zw, ww
+            };
+        }
+
+        //! Returns a pointer to the first element of this quadric.
+        T* Ptr()
+        {
+            return &xx;
+        }
+
+        //! Returns a constant pointer to the first element of this quadric.
+        const T* Ptr() const
+        {
+            return &xx;
+        }
+
+        T xx, xy, xz, xw;
+        T     yy, yz, yw;
+        T         zz, zw;
+        T             ww;
+
+};
+
+template <typename T>
+QuadricT<T> operator + (const QuadricT<T>& lhs, const QuadricT<T>& rhs)
+{
+    auto result = lhs;
+    result += rhs;
+    return result;
+}
+
+
+/* --- Type Alias --- */
+
+using Quadric   = QuadricT<Real>;
+using Quadricf  = QuadricT<float>;
+using Quadricd  = QuadricT<double>;
+
+
+namespace Details
+{
+
+
+template <typename T>
+struct QEMCollapse
+{
+    T               cost;
+    std::uint32_t   v0;
+    std::uint32_t   v1;
+    std::uint32_t   stamp0;
+    std::uint32_t   stamp1;
+};
+
+template <typename T>
+struct QEMCollapseGreater
+{
+    bool operator () (const QEMCollapse<T>& lhs, const QEMCollapse<T>& rhs) const
+    {
+        return (lhs.cost > rhs.cost);
+    }
+};
+
+//! Internal state of the quadric error metric simplification.
+template <typename T>
+class QEMSimplifier
+{
+
+    public:
+
+        template <typename Index>
+        QEMSimplifier(const Vector3T<T>* vertices, std::size_t numVertices, const Index* indices, std::size_t numIndices, const T& boundaryWeight) :
+            positions_ ( vertices, vertices + numVertices ),
+            quadrics_  ( numVertices ),
+            parent_    ( numVertices ),
+            stamps_    ( numVertices, 0 ),
+            faces_     ( (numIndices / 3) * 3 ),
+            removed_   ( numIndices / 3, false )
+        {
+            const std::size_t numFaces = numIndices / 3;
+
+            for (std::size_t i = 0; i < numFaces*3; ++i)
+                faces_[i] = static_cast<std::uint32_t>(indices[i]);
+
+            for (std::size_t i = 0; i < numVertices; ++i)
+                parent_[i] = static_cast<std::uint32_t>(i);
+
+            numTriangles_ = numFaces;
+
+            InitQuadrics(boundaryWeight);
+        }
+
+        //! Collapses edges until the target triangle count or the maximal error is reached.
+        void Simplify(std::size_t targetTriangleCount, const T& maxError)
+        {
+            InitQueue();
+
+            while (numTriangles_ > targetTriangleCount && !queue_.empty())
+            {
+                const auto entry = queue_.top();
+                queue_.pop();
+
+                /* Skip stale entries (lazy update) */
+                if (parent_[entry.v0] != entry.v0 || parent_[entry.v1] != entry.v1)
+                    continue;
+                if (stamps_[entry.v0] != entry.stamp0 || stamps_[entry.v1] != entry.stamp1)
+                    continue;
+
+                if (entry.cost > maxError)
+                    break;
+
+                Vector3T<T> p;
+                ComputeCollapse(entry.v0, entry.v1, p);
+
+                if (!IsCollapseValid(entry.v0, entry.v1, p))
+                {
+                    /* Keep rejected edge until a neighboring collapse changes its surroundings */
+                    AddRejected(entry.v0, entry.v1);
+                    AddRejected(entry.v1, entry.v0);
+                    continue;
+                }
+
+                Collapse(entry.v0, entry.v1, p);
+            }
+        }
+
+        //! Writes the compacted output vertices, indices and the vertex remap.
+        template <typename Index>
+        void Output(std::vector<Vector3T<T>>& outVertices, std::vector<Index>& outIndices, std::vector<Index>& vertexRemap)
+        {
+            const std::size_t numVertices = positions_.size();
+            const auto invalidIndex = std::numeric_limits<std::uint32_t>::max();
+
+            std::vector<std::uint32_t> compact(numVertices, invalidIndex);
+
+            outVertices.clear();
+            outIndices.clear();
+            outIndices.reserve(numTriangles_*3);
+
+            /* Only keep vertices which are referenced by the remaining triangles */
+            for (std::size_t f = 0; f < removed_.size(); ++f)
+            {
+                if (removed_[f])
+                    continue;
+
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    const auto v = faces_[f*3 + j];
+                    if (compact[v] == invalidIndex)
+                    {
+                        compact[v] = static_cast<std::uint32_t>(outVertices.size());
+                        outVertices.push_back(positions_[v]);
+                    }
+                    outIndices.push_back(static_cast<Index>(compact[v]));
+                }
+            }
+
+            /* Map each input vertex to its collapse target, or to an invalid index if it was removed */
+            vertexRemap.resize(numVertices);
+            for (std::size_t i = 0; i < numVertices; ++i)
+            {
+                const auto v = compact[Find(static_cast<std::uint32_t>(i))];
+                vertexRemap[i] = (v == invalidIndex ? std::numeric_limits<Index>::max() : static_cast<Index>(v));
+            }
+        }
+
+    private:
+
+        Vector3T<T> FaceNormal(std::size_t f) const
+        {
+            const auto& p0 = positions_[faces_[f*3    ]];
+            const auto& p1 = positions_[faces_[f*3 + 1]];
+            const auto& p2 = positions_[faces_[f*3 + 2]];
+            return Cross(p1 - p0, p2 - p0);
+        }
+
+        void InitQuadrics(const T& boundaryWeight)
+        {
+            const std::size_t numFaces      = removed_.size();
+            const std::size_t numVertices   = positions_.size();
+
+            /* Compute area weighted plane quadric of each triangle */
+            std::vector<QuadricT<T>> faceQuadrics(numFaces);
+
+            ParallelFor(
+                numFaces, 4096,
+                [&](std::size_t begin, std::size_t end, std::size_t)
+                {
+                    for (std::size_t f = begin; f < end; ++f)
+                    {
+                        auto normal = FaceNormal(f);
+                        const T area = normal.Length();
+
+                        if (area > T(0))
+                        {
+                            normal /= area;
+                            faceQuadrics[f] = QuadricT<T>::Plane(normal, -Dot(normal, positions_[faces_[f*3]]), area*T(0.5));
+                        }
+                        else
+                            faceQuadrics[f] = QuadricT<T>::Plane(normal, T(0), T(0));
+                    }
+                }
+            );
+
+            /* Accumulate face quadrics per vertex via CSR adjacency (no atomics required) */
+            adjacency_.Build(faces_.data(), faces_.size(), numVertices);
+
+            ParallelFor(
+                numVertices, 4096,
+                [&](std::size_t begin, std::size_t end, std::size_t)
+                {
+                    for (std::size_t v = begin; v < end; ++v)
+                    {
+                        auto q = QuadricT<T>::Plane(Vector3T<T>(T(0)), T(0), T(0));
+                        for (auto f = adjacency_.FacesBegin(v); f != adjacency_.FacesEnd(v); ++f)
+                            q += faceQuadrics[*f];
+                        quadrics_[v] = q;
+                    }
+                }
+            );
+
+            if (boundaryWeight > T(0))
+                InitBoundaryQuadrics(boundaryWeight);
+        }
+
+        /* Adds perpendicular plane quadrics for all boundary edges to preserve open borders */
+        void InitBoundaryQuadrics(const T& boundaryWeight)
+        {
+            const std::size_t numFaces = removed_.size();
+
+            for (std::size_t f = 0; f < numFaces; ++f)
+            {
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    const auto v0 = faces_[f*3 + j];
+                    const auto v1 = faces_[f*3 + (j + 1) % 3];
+
+                    if (CountEdgeFaces(v0, v1) != 1)
+                        continue;
+
+                    const auto edge = positions_[v1] - positions_[v0];
+                    auto normal = Cross(edge, FaceNormal(f));
+
+                    const T len = normal.Length();
+                    if (len <= T(0))
+                        continue;
+
+                    normal /= len;
+
+                    const auto q = QuadricT<T>::Plane(normal, -Dot(normal, positions_[v0]), boundaryWeight*edge.LengthSq());
+
+                    quadrics_[v0] += q;
+                    quadrics_[v1] += q;
+                }
+            }
+        }
+
+        std::size_t CountEdgeFaces(std::uint32_t v0, std::uint32_t v1) const
+        {
+            std::size_t n = 0;
+            for (auto f = adjacency_.FacesBegin(v0); f != adjacency_.FacesEnd(v0); ++f)
+            {
+                const auto* tri = &faces_[(*f)*3];
+                if (tri[0] == v1 || tri[1] == v1 || tri[2] == v1)
+                    ++n;
+            }
+            return n;
+        }
+
+        void InitQueue()
+        {
+            const std::size_t numFaces      = removed_.size();
+            const std::size_t numVertices   = positions_.size();
+
+            /* Collect unique edges */
+            std::vector<std::uint64_t> edges;
+            edges.reserve(numFaces*3);
+
+            for (std::size_t f = 0; f < numFaces; ++f)
+            {
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    const std::uint64_t a = faces_[f*3 + j];
+                    const std::uint64_t b = faces_[f*3 + (j + 1) % 3];
+                    if (a != b)
+                        edges.push_back(a < b ? ((a << 32) | b) : ((b << 32) | a));
+                }
+            }
+
+            std::sort(edges.begin(), edges.end());
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+            /* Compute initial collapse costs in parallel */
+            std::vector<QEMCollapse<T>> entries(edges.size());
+
+            ParallelFor(
+                edges.size(), 4096,
+                [&](std::size_t begin, std::size_t end, std::size_t)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        const auto v0 = static_cast<std::uint32_t>(edges[i] >> 32);
+                        const auto v1 = static_cast<std::uint32_t>(edges[i] & 0xffffffff);
+                        entries[i] = MakeCollapse(v0, v1);
+                    }
+                }
+            );
+
+            /* Build face lists that can grow during the collapses */
+            vertexFaces_.resize(numVertices);
+            for (std::size_t v = 0; v < numVertices; ++v)
+                vertexFaces_[v].assign(adjacency_.FacesBegin(v), adjacency_.FacesEnd(v));
+
+            queue_ = QueueType(QEMCollapseGreater<T>(), std::move(entries));
+
+            rejected_.clear();
+            rejected_.resize(numVertices);
+        }
+
+        T ComputeCollapse(std::uint32_t v0, std::uint32_t v1, Vector3T<T>& p) const
+        {
+            auto q = quadrics_[v0];
+            q += quadrics_[v1];
+
+            if (q.Minimize(p))
+                return q.Evaluate(p);
+
+            /* Fall back to the best of both end points and the edge center */
+            const auto& p0 = positions_[v0];
+            const auto& p1 = positions_[v1];
+            const auto  pm = (p0 + p1) * T(0.5);
+
+            const T e0 = q.Evaluate(p0);
+            const T e1 = q.Evaluate(p1);
+            const T em = q.Evaluate(pm);
+
+            if (e0 <= e1 && e0 <= em)
+            {
+                p = p0;
+                return e0;
+            }
+            if (e1 <= em)
+            {
+                p = p1;
+                return e1;
+            }
+
+            p = pm;
+            return em;
+        }
+
+        QEMCollapse<T> MakeCollapse(std::uint32_t v0, std::uint32_t v1) const
+        {
+            Vector3T<T> p;
+            QEMCollapse<T> entry;
+            {
+                entry.cost      = std::max(T(0), ComputeCollapse(v0, v1, p));
+                entry.v0        = v0;
+                entry.v1        = v1;
+                entry.stamp0    = stamps_[v0];
+                entry.stamp1    = stamps_[v1];
+            }
+            return entry;
+        }
+
+        //! Returns false if the collapse would violate the link condition or flip the orientation of any remaining triangle.
+        bool IsCollapseValid(std::uint32_t v0, std::uint32_t v1, const Vector3T<T>& p)
+        {
+            return (SatisfiesLinkCondition(v0, v1) && !FlipsFaces(v0, v1, p) && !FlipsFaces(v1, v0, p));
+        }
+
+        // Collects the vertices opposite to 'v' in all remaining faces, i.e. each interior edge of 'v' appears twice.
+        void GatherRing(std::uint32_t v, std::vector<std::uint32_t>& ring) const
+        {
+            ring.clear();
+
+            for (auto f : vertexFaces_[v])
+            {
+                if (removed_[f])
+                    continue;
+
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    if (faces_[f*3 + j] != v)
+                        ring.push_back(faces_[f*3 + j]);
+                }
+            }
+
+            std::sort(ring.begin(), ring.end());
+        }
+
+        // Removes duplicates from the sorted ring and returns true if any edge of the ring has only one face (i.e. a boundary vertex).
+        static bool UniqueRing(std::vector<std::uint32_t>& ring)
+        {
+            bool boundary = false;
+            std::size_t n = 0;
+
+            for (std::size_t i = 0; i < ring.size();)
+            {
+                std::size_t j = i + 1;
+                while (j < ring.size() && ring[j] == ring[i])
+                    ++j;
+
+                if (j - i == 1)
+                    boundary = true;
+
+                ring[n++] = ring[i];
+                i = j;
+            }
+
+            ring.resize(n);
+
+            return boundary;
+        }
+
+        /*
+        Returns true if the collapse of edge (v0, v1) preserves the mesh topology (Dey et al.), i.e. the common neighbors of both vertices
+        are exactly the vertices opposite to the edge, the links of both vertices share no edge, and an interior edge does not connect two boundary vertices.
+        Otherwise the collapse would create non-manifold edges or pinch the surface at a single vertex.
+        */
+        bool SatisfiesLinkCondition(std::uint32_t v0, std::uint32_t v1)
+        {
+            GatherRing(v0, ring0_);
+            GatherRing(v1, ring1_);
+
+            /* Vertices opposite to the edge */
+            opposite_.clear();
+            for (auto f : vertexFaces_[v0])
+            {
+                if (removed_[f])
+                    continue;
+
+                const auto* tri = &faces_[f*3];
+                if (tri[0] == v1 || tri[1] == v1 || tri[2] == v1)
+                    opposite_.push_back(tri[0] ^ tri[1] ^ tri[2] ^ v0 ^ v1);
+            }
+
+            /* Reject pairs which are no longer connected by an edge */
+            if (opposite_.empty())
+                return false;
+
+            std::sort(opposite_.begin(), opposite_.end());
+
+            const bool boundary0 = UniqueRing(ring0_);
+            const bool boundary1 = UniqueRing(ring1_);
+
+            if (opposite_.size() > 1 && boundary0 && boundary1)
+                return false;
+
+            /* Compare common neighbors with opposite vertices */
+            common_.clear();
+            std::set_intersection(ring0_.begin(), ring0_.end(), ring1_.begin(), ring1_.end(), std::back_inserter(common_));
+
+            if (common_ != opposite_)
+                return false;
+
+            /* Links of both vertices must not share an edge either, e.g. (x, y) for the faces (v0, x, y) and (v1, x, y) of a tetrahedron */
+            GatherLinkEdges(v0, v1, linkEdges0_);
+            GatherLinkEdges(v1, v0, linkEdges1_);
+
+            auto it0 = linkEdges0_.begin(), it1 = linkEdges1_.begin();
+            while (it0 != linkEdges0_.end() && it1 != linkEdges1_.end())
+            {
+                if (*it0 < *it1)
+                    ++it0;
+                else if (*it1 < *it0)
+                    ++it1;
+                else
+                    return false;
+            }
+
+            return true;
+        }
+
+        // Collects the sorted edges opposite to 'v' in all remaining faces that do not contain 'other'.
+        void GatherLinkEdges(std::uint32_t v, std::uint32_t other, std::vector<std::uint64_t>& edges) const
+        {
+            edges.clear();
+
+            for (auto f : vertexFaces_[v])
+            {
+                if (removed_[f])
+                    continue;
+
+                const auto* tri = &faces_[f*3];
+                if (tri[0] == other || tri[1] == other || tri[2] == other)
+                    continue;
+
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    if (tri[j] == v)
+                    {
+                        const std::uint64_t a = tri[(j + 1) % 3];
+                        const std::uint64_t b = tri[(j + 2) % 3];
+                        edges.push_back(a < b ? ((a << 32) | b) : ((b << 32) | a));
+                    }
+                }
+            }
+
+            std::sort(edges.begin(), edges.end());
+        }
+
+        bool FlipsFaces(std::uint32_t v, std::uint32_t other, const Vector3T<T>& p) const
+        {
+            for (auto f : vertexFaces_[v])
+            {
+                if (removed_[f])
+                    continue;
+
+                const auto* tri = &faces_[f*3];
+                if (tri[0] == other || tri[1] == other || tri[2] == other)
+                    continue;
+
+                Vector3T<T> q[3];
+                for (std::size_t j = 0; j < 3; ++j)
+                    q[j] = (tri[j] == v ? p : positions_[tri[j]]);
+
+                const auto n0 = FaceNormal(f);
+                const auto n1 = Cross(q[1] - q[0], q[2] - q[0]);
+
+                if (Dot(n0, n1) <= T(0))
+                    return true;
+            }
+            return false;
+        }
+
+        void Collapse(std::uint32_t v0, std::uint32_t v1, const Vector3T<T>& p)
+        {
+            /* Merge v1 into v0 */
+            quadrics_[v0] += quadrics_[v1];
+            positions_[v0] = p;
+            parent_[v1] = v0;
+            ++stamps_[v0];
+
+            auto& faces0 = vertexFaces_[v0];
+            auto& faces1 = vertexFaces_[v1];
+
+            for (auto f : faces1)
+            {
+                if (removed_[f])
+                    continue;
+
+                auto* tri = &faces_[f*3];
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    if (tri[j] == v1)
+                        tri[j] = v0;
+                }
+
+                if (tri[0] == tri[1] || tri[1] == tri[2] || tri[2] == tri[0])
+                {
+                    removed_[f] = true;
+                    --numTriangles_;
+                }
+                else
+                    faces0.push_back(f);
+            }
+
+            faces1.clear();
+            faces1.shrink_to_fit();
+
+            /* Remove degenerated faces from the merged face list */
+            faces0.erase(
+                std::remove_if(
+                    faces0.begin(), faces0.end(),
+                    [this](std::uint32_t f) { return removed_[f]; }
+                ),
+                faces0.end()
+            );
+
+            /* Re-insert the collapses of all edges around the merged vertex */
+            neighbors_.clear();
+            for (auto f : faces0)
+            {
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    const auto v = faces_[f*3 + j];
+                    if (v != v0)
+                        neighbors_.push_back(v);
+                }
+            }
+
+            std::sort(neighbors_.begin(), neighbors_.end());
+            neighbors_.erase(std::unique(neighbors_.begin(), neighbors_.end()), neighbors_.end());
+
+            for (auto v : neighbors_)
+                queue_.push(MakeCollapse(v0, v));
+
+            /* Re-insert rejected collapses whose surrounding faces have changed (edges of the merged vertex are already re-inserted) */
+            ClearRejected(v0);
+            ClearRejected(v1);
+
+            for (auto v : neighbors_)
+            {
+                for (auto other : rejected_[v])
+                {
+                    if (other != v0 && parent_[other] == other)
+                        queue_.push(MakeCollapse(v, other));
+                    RemoveRejected(other, v);
+                }
+                rejected_[v].clear();
+            }
+        }
+
+        void AddRejected(std::uint32_t v, std::uint32_t other)
+        {
+            auto& list = rejected_[v];
+            if (std::find(list.begin(), list.end(), other) == list.end())
+                list.push_back(other);
+        }
+
+        void RemoveRejected(std::uint32_t v, std::uint32_t other)
+        {
+            auto& list = rejected_[v];
+            list.erase(std::remove(list.begin(), list.end(), other), list.end());
+        }
+
+        void ClearRejected(std::uint32_t v)
+        {
+            for (auto other : rejected_[v])
+                RemoveRejected(other, v);
+            rejected_[v].clear();
+        }
+
+        std::uint32_t Find(std::uint32_t v)
+        {
+            /* Find root with path halving */
+            while (parent_[v] != v)
+            {
+                parent_[v] = parent_[parent_[v]];
+                v = parent_[v];
+            }
+            return v;
+        }
+
+    private:
+
+        using QueueType = std::priority_queue<QEMCollapse<T>, std::vector<QEMCollapse<T>>, QEMCollapseGreater<T>>;
+
+        std::vector<Vector3T<T>>                positions_;
+        std::vector<QuadricT<T>>                quadrics_;
+        std::vector<std::uint32_t>              parent_;
+        std::vector<std::uint32_t>              stamps_;
+        std::vector<std::uint32_t>              faces_;
+        std::vector<bool>                       removed_;
+        std::size_t                             numTriangles_   = 0;
+
+        VertexFaceAdjacency                     adjacency_;
+        std::vector<std::vector<std::uint32_t>> vertexFaces_;
+        std::vector<std::uint32_t>              neighbors_;
+        std::vector<std::vector<std::uint32_t>> rejected_;
+        std::vector<std::uint32_t>              ring0_;
+        std::vector<std::uint32_t>              ring1_;
+        std::vector<std::uint32_t>              opposite_;
+        std::vector<std::uint32_t>              common_;
+        std::vector<std::uint64_t>              linkEdges0_;
+        std::vector<std::uint64_t>              linkEdges1_;
+        QueueType                               queue_;
+
+};
+
+
+} // /namespace Details
+
+
+/**
+\brief Simplifies the specified triangle mesh with the quadric error metric (Garland & Heckbert).
+\param[in] vertices Pointer to the vertex positions.
+\param[in] numVertices Specifies the number of vertices.
+\param[in] indices Pointer to the triangle list indices.
+\param[in] numIndices Specifies the number of indices. This should be a multiple of 3.
+\param[in] targetTriangleCount Specifies the number of triangles the simplification stops at.
+\param[out] outVertices Specifies the resulting (compacted) vertex positions.
+\param[out] outIndices Specifies the resulting triangle list indices into 'outVertices'.
+\param[out] vertexRemap Specifies the vertex remap, i.e. vertexRemap[i] is the index into 'outVertices' for the input vertex 'i',
+or std::numeric_limits<Index>::max() if the vertex is no longer referenced by any triangle.
+\param[in] maxError Specifies the maximal quadric error of a single edge collapse. By default unlimited.
+\param[in] boundaryWeight Specifies the weight of the boundary preservation quadrics. By default 1. Zero disables boundary preservation.
+\return Number of remaining triangles.
+\remarks Edge collapses are ordered by a lazy-update priority queue, i.e. outdated queue entries are only detected and skipped when they are popped.
+Collapses that would flip a triangle or violate the link condition (i.e. create non-manifold edges or vertices) are rejected,
+and re-inserted into the queue once a neighboring collapse changes their surroundings. The initialization of the quadrics and collapse costs is distributed with "Details::ParallelFor".
+\see QuadricT
+*/
+template <typename T, typename Index>
+std::size_t SimplifyMesh(
+    const Vector3T<T>*          vertices,
+    std::size_t                 numVertices,
+    const Index*                indices,
+    std::size_t                 numIndices,
+    std::size_t                 targetTriangleCount,
+    std::vector<Vector3T<T>>&   outVertices,
+    std::vector<Index>&         outIndices,
+    std::vector<Index>&         vertexRemap,
+    const T&                    maxError        = std::numeric_limits<T>::max(),
+    const T&                    boundaryWeight  = T(1))
+{
+    Details::QEMSimplifier<T> simplifier(vertices, numVertices, indices, numIndices, boundaryWeight);
+    simplifier.Simplify(targetTriangleCount, maxError);
+    simplifier.Output(outVertices, outIndices, vertexRemap);
+    return outIndices.size() / 3;
+}
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
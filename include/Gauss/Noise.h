@@ -0,0 +1,706 @@
+/*
+ * Noise.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_NOISE_H
+#define GS_NOISE_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/Parallel.h>
+#include <Gauss/SIMDPacket.h>
+
+#include <cstddef>
+#include <algorithm>
+
+
+namespace Gs
+{
+
+
+//! Basis functions of the fractal noise. \see NoiseDescriptorT
+enum class NoiseType
+{
+    Gradient,   //!< Gradient noise (Perlin noise) on the square lattice with the "SmootherStep" fade curve. \see GradientNoise
+    Simplex,    //!< Simplex noise on the skewed simplex lattice. \see SimplexNoise
+};
+
+/**
+\brief Descriptor of fractal noise (fractional Brownian motion) with optional domain warping.
+\tparam T Specifies the data type of the parameters. This should be float or double.
+\see Noise
+\see NoiseArray
+\see NoiseGrid
+*/
+template <typename T>
+struct NoiseDescriptorT
+{
+    NoiseType   type            = NoiseType::Simplex;   //!< Basis function of each octave.
+    T           frequency       = T(1);                 //!< Frequency of the first octave.
+    std::size_t octaves         = 1;                    //!< Number of octaves. This must be greater than zero.
+    T           lacunarity      = T(2);                 //!< Frequency multiplier of each subsequent octave.
+    T           gain            = T(0.5);               //!< Amplitude multiplier of each subsequent octave.
+    T           warpStrength    = T(0);                 //!< Domain warping: the input is offset by this factor times the fractal noise itself. Zero disables warping.
+};
+
+
+namespace Details
+{
+
+
+/*
+The lattice hash is the permutation polynomial (34x^2 + x) mod 289 of Gustavson and McEwan ("webgl-noise"), which is evaluated
+with floating-point arithmetic only. All intermediate values are integers below 2^24, so the hash is exact in single precision
+and the same kernels run on SSE/AVX packets (without integer instructions) and scalars. The noise is periodic with 289 lattice cells.
+*/
+
+template <typename P>
+P NoiseMod289(const P& x)
+{
+    /* Use a division rather than a multiplication with 1/289, so that multiples of 289 are always mapped to zero */
+    return x - PacketFloor(x / P(289)) * P(289);
+}
+
+template <typename P>
+P NoisePermute(const P& x)
+{
+    return NoiseMod289(PacketMulAdd(x, P(34), P(1)) * x);
+}
+
+template <typename P>
+P NoiseFract(const P& x)
+{
+    return x - PacketFloor(x);
+}
+
+// First order Taylor approximation of 1/sqrt(r) around r = 0.7 (the mean squared length of the unnormalized gradients).
+template <typename P>
+P NoiseTaylorInvSqrt(const P& r)
+{
+    return P(1.79284291400159) - P(0.85373472095314) * r;
+}
+
+template <typename P>
+P NoiseLerp(const P& a, const P& b, const P& t)
+{
+    return PacketMulAdd(b - a, t, a);
+}
+
+// 2D gradient for the hash value h: points on a diamond that are approximately normalized.
+template <typename P>
+void NoiseGradient(const P& h, P (&g)[2])
+{
+    const P x = NoiseFract(h * P(1.0/41.0)) * P(2) - P(1);
+    g[1] = PacketAbs(x) - P(0.5);
+    g[0] = x - PacketFloor(x + P(0.5));
+
+    const P n = NoiseTaylorInvSqrt(g[0]*g[0] + g[1]*g[1]);
+    g[0] = g[0] * n;
+    g[1] = g[1] * n;
+}
+
+// 3D gradient for the hash value h: 7x7 points on the faces of an octahedron.
+template <typename P>
+void NoiseGradient(const P& h, P (&g)[3])
+{
+    /* Divisions keep the grid indices in [0, 6], a multiplication with 1/49 or 1/7 could round multiples down */
+    const P j   = h - P(49) * PacketFloor(h / P(49));
+    const P xi  = PacketFloor(j / P(7));
+    const P yi  = PacketFloor(j - P(7) * xi);
+    const P x   = PacketMulAdd(xi, P(2.0/7.0), P(1.0/14.0 - 1.0));
+    const P y   = PacketMulAdd(yi, P(2.0/7.0), P(1.0/14.0 - 1.0));
+    const P z   = P(1) - PacketAbs(x) - PacketAbs(y);
+
+    /* Fold the lower half of the octahedron */
+    const P sh  = -PacketStep(z, P(0));
+    g[0] = PacketMulAdd(PacketMulAdd(PacketFloor(x), P(2), P(1)), sh, x);
+    g[1] = PacketMulAdd(PacketMulAdd(PacketFloor(y), P(2), P(1)), sh, y);
+    g[2] = z;
+
+    const P n = NoiseTaylorInvSqrt(g[0]*g[0] + g[1]*g[1] + g[2]*g[2]);
+    g[0] = g[0] * n;
+    g[1] = g[1] * n;
+    g[2] = g[2] * n;
+}
+
+// 4D gradient for the hash value h: 7x7x6 points on the surface of a cross polytope.
+template <typename P>
+void NoiseGradient(const P& h, P (&g)[4])
+{
+    g[0] = PacketFloor(NoiseFract(h * P(1.0/294.0)) * P(7)) * P(1.0/7.0) - P(1);
+    g[1] = PacketFloor(NoiseFract(h * P(1.0/49.0 )) * P(7)) * P(1.0/7.0) - P(1);
+    g[2] = PacketFloor(NoiseFract(h * P(1.0/7.0  )) * P(7)) * P(1.0/7.0) - P(1);
+    g[3] = P(1.5) - PacketAbs(g[0]) - PacketAbs(g[1]) - PacketAbs(g[2]);
+
+    /* g[0..2] are negative, so they are flipped to the positive side where g[3] is negative */
+    const P s = P(1) - PacketStep(P(0), g[3]);
+    g[0] = g[0] + s;
+    g[1] = g[1] + s;
+    g[2] = g[2] + s;
+
+    const P n = NoiseTaylorInvSqrt(g[0]*g[0] + g[1]*g[1] + g[2]*g[2] + g[3]*g[3]);
+    g[0] = g[0] * n;
+    g[1] = g[1] * n;
+    g[2] = g[2] * n;
+    g[3] = g[3] * n;
+}
+
+template <std::size_t N, typename P>
+P NoiseDot(const P (&g)[N], const P (&x)[N])
+{
+    P d = g[0] * x[0];
+    for (std::size_t k = 1; k < N; ++k)
+        d = PacketMulAdd(g[k], x[k], d);
+    return d;
+}
+
+// Returns the scale of the gradient noise to map its values approximately into [-1, 1] (measured over 4 million random points).
+inline double GradientNoiseScale(std::size_t n)
+{
+    return (n == 2 ? 2.3 : n == 3 ? 1.5 : 1.9);
+}
+
+// Gradient noise in N dimensions: interpolates the 2^N corner gradients of the lattice cell with the "SmootherStep" fade curve.
+template <std::size_t N, typename P>
+P GradientNoisePacket(const P (&v)[N])
+{
+    P i[N], f[N], u[N];
+
+    for (std::size_t k = 0; k < N; ++k)
+    {
+        i[k] = PacketFloor(v[k]);
+        f[k] = v[k] - i[k];
+        u[k] = SmootherStep(f[k]);
+        i[k] = NoiseMod289(i[k]);
+    }
+
+    P values[1u << N];
+
+    for (std::size_t c = 0; c < (1u << N); ++c)
+    {
+        P h = P(0), x[N];
+
+        for (std::size_t k = N; k-- > 0;)
+        {
+            const bool upper = ((c >> k) & 1u) != 0;
+            h = NoisePermute(h + i[k] + P(upper ? 1 : 0));
+            x[k] = (upper ? f[k] - P(1) : f[k]);
+        }
+
+        P g[N];
+        NoiseGradient(h, g);
+        values[c] = NoiseDot(g, x);
+    }
+
+    /* Multilinear interpolation, one dimension after another */
+    for (std::size_t k = 0, n = (1u << N); k < N; ++k)
+    {
+        n /= 2;
+        for (std::size_t c = 0; c < n; ++c)
+            values[c] = NoiseLerp(values[c*2], values[c*2 + 1], u[k]);
+    }
+
+    return values[0] * P(GradientNoiseScale(N));
+}
+
+// Contribution of a simplex corner with the offset x to the corner and the hash value h.
+template <std::size_t N, typename P>
+P SimplexNoiseCorner(const P (&x)[N], const P& h)
+{
+    P g[N];
+    NoiseGradient(h, g);
+
+    P m = P(0.5);
+    for (std::size_t k = 0; k < N; ++k)
+        m = m - x[k]*x[k];
+
+    m = PacketMax(m, P(0));
+    m = m*m;
+
+    return m*m * NoiseDot(g, x);
+}
+
+template <typename P>
+P SimplexNoisePacket(const P (&v)[2])
+{
+    const P F2 = P(0.366025403784439);  // (sqrt(3) - 1) / 2
+    const P G2 = P(0.211324865405187);  // (3 - sqrt(3)) / 6
+
+    /* Skew the input space to find the simplex cell */
+    const P s   = (v[0] + v[1]) * F2;
+    P ix        = PacketFloor(v[0] + s);
+    P iy        = PacketFloor(v[1] + s);
+    const P t   = (ix + iy) * G2;
+
+    const P x0[2] = { v[0] - ix + t, v[1] - iy + t };
+
+    /* Offsets of the middle corner: (1, 0) for the lower triangle, (0, 1) for the upper triangle */
+    const P i1x = PacketStep(x0[1], x0[0]);
+    const P i1y = P(1) - i1x;
+
+    const P x1[2] = { x0[0] - i1x + G2, x0[1] - i1y + G2 };
+    const P x2[2] = { x0[0] - P(1) + G2*P(2), x0[1] - P(1) + G2*P(2) };
+
+    ix = NoiseMod289(ix);
+    iy = NoiseMod289(iy);
+
+    const P h0 = NoisePermute(NoisePermute(iy       ) + ix       );
+    const P h1 = NoisePermute(NoisePermute(iy + i1y ) + ix + i1x );
+    const P h2 = NoisePermute(NoisePermute(iy + P(1)) + ix + P(1));
+
+    return (SimplexNoiseCorner(x0, h0) + SimplexNoiseCorner(x1, h1) + SimplexNoiseCorner(x2, h2)) * P(130.0);
+}
+
+template <typename P>
+P SimplexNoisePacket(const P (&v)[3])
+{
+    const P F3 = P(1.0/3.0);
+    const P G3 = P(1.0/6.0);
+
+    const P s   = (v[0] + v[1] + v[2]) * F3;
+    P ix        = PacketFloor(v[0] + s);
+    P iy        = PacketFloor(v[1] + s);
+    P iz        = PacketFloor(v[2] + s);
+    const P t   = (ix + iy + iz) * G3;
+
+    const P x0[3] = { v[0] - ix + t, v[1] - iy + t, v[2] - iz + t };
+
+    /* Rank the components of x0 to find the offsets of the second and third corner */
+    const P gx = PacketStep(x0[1], x0[0]);
+    const P gy = PacketStep(x0[2], x0[1]);
+    const P gz = PacketStep(x0[0], x0[2]);
+    const P lx = P(1) - gx;
+    const P ly = P(1) - gy;
+    const P lz = P(1) - gz;
+
+    const P i1[3] = { PacketMin(gx, lz), PacketMin(gy, lx), PacketMin(gz, ly) };
+    const P i2[3] = { PacketMax(gx, lz), PacketMax(gy, lx), PacketMax(gz, ly) };
+
+    const P x1[3] = { x0[0] - i1[0] + G3, x0[1] - i1[1] + G3, x0[2] - i1[2] + G3 };
+    const P x2[3] = { x0[0] - i2[0] + F3, x0[1] - i2[1] + F3, x0[2] - i2[2] + F3 };
+    const P x3[3] = { x0[0] - P(0.5), x0[1] - P(0.5), x0[2] - P(0.5) };
+
+    ix = NoiseMod289(ix);
+    iy = NoiseMod289(iy);
+    iz = NoiseMod289(iz);
+
+    const P h0 = NoisePermute(NoisePermute(NoisePermute(iz        ) + iy        ) + ix        );
+    const P h1 = NoisePermute(NoisePermute(NoisePermute(iz + i1[2]) + iy + i1[1]) + ix + i1[0]);
+    const P h2 = NoisePermute(NoisePermute(NoisePermute(iz + i2[2]) + iy + i2[1]) + ix + i2[0]);
+    const P h3 = NoisePermute(NoisePermute(NoisePermute(iz + P(1) ) + iy + P(1) ) + ix + P(1) );
+
+    return (
+        SimplexNoiseCorner(x0, h0) + SimplexNoiseCorner(x1, h1) +
+        SimplexNoiseCorner(x2, h2) + SimplexNoiseCorner(x3, h3)
+    ) * P(105.0);
+}
+
+template <typename P>
+P SimplexNoisePacket(const P (&v)[4])
+{
+    const P F4 = P(0.309016994374947);  // (sqrt(5) - 1) / 4
+    const P G4 = P(0.138196601125011);  // (5 - sqrt(5)) / 20
+
+    const P s   = (v[0] + v[1] + v[2] + v[3]) * F4;
+    P i[4]      = { PacketFloor(v[0] + s), PacketFloor(v[1] + s), PacketFloor(v[2] + s), PacketFloor(v[3] + s) };
+    const P t   = (i[0] + i[1] + i[2] + i[3]) * G4;
+
+    const P x0[4] = { v[0] - i[0] + t, v[1] - i[1] + t, v[2] - i[2] + t, v[3] - i[3] + t };
+
+    /* Rank of each component of x0 (number of components it is greater than or equal to) */
+    const P isX[3]  = { PacketStep(x0[1], x0[0]), PacketStep(x0[2], x0[0]), PacketStep(x0[3], x0[0]) };
+    const P isYZ[3] = { PacketStep(x0[2], x0[1]), PacketStep(x0[3], x0[1]), PacketStep(x0[3], x0[2]) };
+
+    const P rank[4] =
+    {
+        isX[0] + isX[1] + isX[2],
+        (P(1) - isX[0]) + isYZ[0] + isYZ[1],
+        (P(1) - isX[1]) + (P(1) - isYZ[0]) + isYZ[2],
+        (P(1) - isX[2]) + (P(1) - isYZ[1]) + (P(1) - isYZ[2]),
+    };
+
+    P i1[4], i2[4], i3[4], x1[4], x2[4], x3[4], x4[4];
+
+    for (std::size_t k = 0; k < 4; ++k)
+    {
+        i3[k] = PacketMin(PacketMax(rank[k]       , P(0)), P(1));
+        i2[k] = PacketMin(PacketMax(rank[k] - P(1), P(0)), P(1));
+        i1[k] = PacketMin(PacketMax(rank[k] - P(2), P(0)), P(1));
+        x1[k] = x0[k] - i1[k] + G4;
+        x2[k] = x0[k] - i2[k] + G4*P(2);
+        x3[k] = x0[k] - i3[k] + G4*P(3);
+        x4[k] = x0[k] - P(1)  + G4*P(4);
+        i[k]  = NoiseMod289(i[k]);
+    }
+
+    auto hash = [&i](const P (&o)[4]) -> P
+    {
+        return NoisePermute(NoisePermute(NoisePermute(NoisePermute(i[3] + o[3]) + i[2] + o[2]) + i[1] + o[1]) + i[0] + o[0]);
+    };
+
+    const P zero[4] = { P(0), P(0), P(0), P(0) };
+    const P one[4]  = { P(1), P(1), P(1), P(1) };
+
+    return (
+        SimplexNoiseCorner(x0, hash(zero)) + SimplexNoiseCorner(x1, hash(i1)) + SimplexNoiseCorner(x2, hash(i2)) +
+        SimplexNoiseCorner(x3, hash(i3)) + SimplexNoiseCorner(x4, hash(one))
+    ) * P(108.0);
+}
+
+template <std::size_t N, typename P>
+P NoisePacket(NoiseType type, const P (&v)[N])
+{
+    return (type == NoiseType::Gradient ? GradientNoisePacket(v) : SimplexNoisePacket(v));
+}
+
+// Sum of the octaves, normalized by the sum of their amplitudes.
+template <std::size_t N, typename P, typename T>
+P FractalNoisePacket(const NoiseDescriptorT<T>& desc, const P (&v)[N])
+{
+    P sum = P(0);
+    T frequency = desc.frequency, amplitude = T(1), amplitudeSum = T(0);
+
+    for (std::size_t octave = 0; octave < desc.octaves; ++octave)
+    {
+        /* Shift each octave, so that the lattice points of all octaves do not coincide at the origin */
+        P p[N];
+        for (std::size_t k = 0; k < N; ++k)
+            p[k] = PacketMulAdd(v[k], P(frequency), P(T(octave) * T(17.31)));
+
+        sum = PacketMulAdd(NoisePacket(desc.type, p), P(amplitude), sum);
+
+        amplitudeSum    += amplitude;
+        amplitude       *= desc.gain;
+        frequency       *= desc.lacunarity;
+    }
+
+    return (amplitudeSum > T(0) ? sum * P(T(1) / amplitudeSum) : sum);
+}
+
+// Fractal noise with domain warping: v' = v + warpStrength * (fBm(v + offset_0), ..., fBm(v + offset_N-1)).
+template <std::size_t N, typename P, typename T>
+P NoiseDescriptorPacket(const NoiseDescriptorT<T>& desc, const P (&v)[N])
+{
+    if (desc.warpStrength == T(0))
+        return FractalNoisePacket(desc, v);
+
+    P w[N];
+
+    for (std::size_t k = 0; k < N; ++k)
+    {
+        P q[N];
+        for (std::size_t j = 0; j < N; ++j)
+            q[j] = v[j] + P(T(k) * T(5.2) + T(j) * T(1.3));
+        w[k] = PacketMulAdd(FractalNoisePacket(desc, q), P(desc.warpStrength), v[k]);
+    }
+
+    return FractalNoisePacket(desc, w);
+}
+
+// Evaluates the noise for an array of N-dimensional points.
+template <typename T, std::size_t N>
+class NoiseArrayKernel
+{
+
+    public:
+
+        NoiseArrayKernel(const NoiseDescriptorT<T>& desc, const T* points, T* values) :
+            desc_   { desc   },
+            in_     { points },
+            out_    { values }
+        {
+        }
+
+        template <typename P>
+        void Run(std::size_t i) const
+        {
+            using Traits = PacketTraits<P>;
+            P v[N];
+            for (std::size_t k = 0; k < N; ++k)
+                v[k] = Traits::LoadStrided(in_ + i*N + k, N);
+            Traits::Store(out_ + i, NoiseDescriptorPacket(desc_, v));
+        }
+
+    private:
+
+        const NoiseDescriptorT<T>&  desc_;
+        const T*                    in_;
+        T*                          out_;
+
+};
+
+// Evaluates the noise for a row of grid points, which only differ in the first coordinate.
+template <typename T, std::size_t N>
+class NoiseGridRowKernel
+{
+
+    public:
+
+        NoiseGridRowKernel(const NoiseDescriptorT<T>& desc, const T (&rowOrigin)[N], const T& spacing, T* values) :
+            desc_       { desc    },
+            spacing_    { spacing },
+            out_        { values  }
+        {
+            for (std::size_t k = 0; k < N; ++k)
+                rowOrigin_[k] = rowOrigin[k];
+        }
+
+        template <typename P>
+        void Run(std::size_t i) const
+        {
+            using Traits = PacketTraits<P>;
+
+            T x[Traits::size];
+            for (std::size_t j = 0; j < Traits::size; ++j)
+                x[j] = rowOrigin_[0] + T(i + j) * spacing_;
+
+            P v[N];
+            v[0] = Traits::Load(x);
+            for (std::size_t k = 1; k < N; ++k)
+                v[k] = P(rowOrigin_[k]);
+
+            Traits::Store(out_ + i, NoiseDescriptorPacket(desc_, v));
+        }
+
+    private:
+
+        const NoiseDescriptorT<T>&  desc_;
+        T                           rowOrigin_[N];
+        T                           spacing_;
+        T*                          out_;
+
+};
+
+template <typename T, std::size_t N>
+void NoiseArray(const T* points, T* values, std::size_t count, const NoiseDescriptorT<T>& desc)
+{
+    const NoiseArrayKernel<T, N> kernel(desc, points, values);
+
+    ParallelFor(
+        count, 1024,
+        [&kernel](std::size_t begin, std::size_t end, std::size_t)
+        {
+            ForEachPacket<T>(begin, end, kernel);
+        }
+    );
+}
+
+
+} // /namespace Details
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Returns the gradient noise (Perlin noise) at the specified 2D point.
+\return Noise value approximately in the range [-1, 1]. The value is zero at all integral lattice points.
+\remarks The lattice gradients are interpolated with the same fade curve as "SmootherStep" (6x^5 - 15x^4 + 10x^3).
+The noise is periodic with 289 units in each dimension.
+*/
+template <typename T>
+T GradientNoise(const Vector2T<T>& p)
+{
+    const T v[2] = { p.x, p.y };
+    return Details::GradientNoisePacket(v);
+}
+
+//! Returns the gradient noise at the specified 3D point. \see GradientNoise(const Vector2T<T>&)
+template <typename T>
+T GradientNoise(const Vector3T<T>& p)
+{
+    const T v[3] = { p.x, p.y, p.z };
+    return Details::GradientNoisePacket(v);
+}
+
+//! Returns the gradient noise at the specified 4D point. \see GradientNoise(const Vector2T<T>&)
+template <typename T>
+T GradientNoise(const Vector4T<T>& p)
+{
+    const T v[4] = { p.x, p.y, p.z, p.w };
+    return Details::GradientNoisePacket(v);
+}
+
+/**
+\brief Returns the simplex noise at the specified 2D point.
+\return Noise value approximately in the range [-1, 1].
+\remarks Simplex noise sums the contributions of the N+1 corners of a simplex instead of the 2^N corners of a lattice cell,
+so it is considerably faster than gradient noise in 3D and 4D. The noise is periodic with 289 units along the lattice axes.
+*/
+template <typename T>
+T SimplexNoise(const Vector2T<T>& p)
+{
+    const T v[2] = { p.x, p.y };
+    return Details::SimplexNoisePacket(v);
+}
+
+//! Returns the simplex noise at the specified 3D point. \see SimplexNoise(const Vector2T<T>&)
+template <typename T>
+T SimplexNoise(const Vector3T<T>& p)
+{
+    const T v[3] = { p.x, p.y, p.z };
+    return Details::SimplexNoisePacket(v);
+}
+
+//! Returns the simplex noise at the specified 4D point. \see SimplexNoise(const Vector2T<T>&)
+template <typename T>
+T SimplexNoise(const Vector4T<T>& p)
+{
+    const T v[4] = { p.x, p.y, p.z, p.w };
+    return Details::SimplexNoisePacket(v);
+}
+
+/**
+\brief Returns the fractal noise at the specified 2D point.
+\param[in] p Specifies the input point.
+\param[in] desc Specifies the noise type, octaves, and domain warping.
+\return Weighted sum of the octaves divided by the sum of their weights, i.e. approximately in the range [-1, 1].
+\see NoiseDescriptorT
+*/
+template <typename T>
+T Noise(const Vector2T<T>& p, const NoiseDescriptorT<T>& desc)
+{
+    const T v[2] = { p.x, p.y };
+    return Details::NoiseDescriptorPacket(desc, v);
+}
+
+//! Returns the fractal noise at the specified 3D point. \see Noise(const Vector2T<T>&, const NoiseDescriptorT<T>&)
+template <typename T>
+T Noise(const Vector3T<T>& p, const NoiseDescriptorT<T>& desc)
+{
+    const T v[3] = { p.x, p.y, p.z };
+    return Details::NoiseDescriptorPacket(desc, v);
+}
+
+//! Returns the fractal noise at the specified 4D point. \see Noise(const Vector2T<T>&, const NoiseDescriptorT<T>&)
+template <typename T>
+T Noise(const Vector4T<T>& p, const NoiseDescriptorT<T>& desc)
+{
+    const T v[4] = { p.x, p.y, p.z, p.w };
+    return Details::NoiseDescriptorPacket(desc, v);
+}
+
+/**
+\brief Evaluates the fractal noise for all points of the specified array.
+\param[in] points Pointer to the input points.
+\param[out] values Pointer to the output array of 'count' noise values.
+\param[in] count Specifies the number of points.
+\param[in] desc Specifies the noise type, octaves, and domain warping.
+\remarks The points are processed with SIMD packets (i.e. 8 points at once with AVX) and distributed with "Details::ParallelFor".
+\see Noise(const Vector2T<T>&, const NoiseDescriptorT<T>&)
+*/
+template <typename T>
+void NoiseArray(const Vector2T<T>* points, T* values, std::size_t count, const NoiseDescriptorT<T>& desc)
+{
+    static_assert(sizeof(Vector2T<T>) == sizeof(T)*2, "vectors must be tightly packed");
+    if (count > 0)
+        Details::NoiseArray<T, 2>(points[0].Ptr(), values, count, desc);
+}
+
+//! Evaluates the fractal noise for all points of the specified array. \see NoiseArray(const Vector2T<T>*, T*, std::size_t, const NoiseDescriptorT<T>&)
+template <typename T>
+void NoiseArray(const Vector3T<T>* points, T* values, std::size_t count, const NoiseDescriptorT<T>& desc)
+{
+    static_assert(sizeof(Vector3T<T>) == sizeof(T)*3, "vectors must be tightly packed");
+    if (count > 0)
+        Details::NoiseArray<T, 3>(points[0].Ptr(), values, count, desc);
+}
+
+//! Evaluates the fractal noise for all points of the specified array. \see NoiseArray(const Vector2T<T>*, T*, std::size_t, const NoiseDescriptorT<T>&)
+template <typename T>
+void NoiseArray(const Vector4T<T>* points, T* values, std::size_t count, const NoiseDescriptorT<T>& desc)
+{
+    static_assert(sizeof(Vector4T<T>) == sizeof(T)*4, "vectors must be tightly packed");
+    if (count > 0)
+        Details::NoiseArray<T, 4>(points[0].Ptr(), values, count, desc);
+}
+
+/**
+\brief Fills a 2D grid with fractal noise, e.g. for a height map or a texture.
+\param[out] values Pointer to the output array of 'width * height' noise values in row-major order.
+\param[in] width Specifies the number of grid points in X direction.
+\param[in] height Specifies the number of grid points in Y direction.
+\param[in] origin Specifies the position of the first grid point.
+\param[in] spacing Specifies the distance between two grid points in X and Y direction.
+\param[in] desc Specifies the noise type, octaves, and domain warping.
+\remarks The rows are distributed with "Details::ParallelFor", and each row is processed with SIMD packets.
+*/
+template <typename T>
+void NoiseGrid(
+    T*                          values,
+    std::size_t                 width,
+    std::size_t                 height,
+    const Vector2T<T>&          origin,
+    const Vector2T<T>&          spacing,
+    const NoiseDescriptorT<T>&  desc)
+{
+    if (width == 0)
+        return;
+
+    Details::ParallelFor(
+        height, std::max<std::size_t>(1, 4096 / width),
+        [&](std::size_t begin, std::size_t end, std::size_t)
+        {
+            for (std::size_t y = begin; y < end; ++y)
+            {
+                const T rowOrigin[2] = { origin.x, origin.y + T(y) * spacing.y };
+                const Details::NoiseGridRowKernel<T, 2> kernel(desc, rowOrigin, spacing.x, values + y*width);
+                Details::ForEachPacket<T>(0, width, kernel);
+            }
+        }
+    );
+}
+
+/**
+\brief Fills a 3D grid with fractal noise, e.g. for a volume texture or a density field.
+\param[out] values Pointer to the output array of 'width * height * depth' noise values, where X is the fastest and Z the slowest dimension.
+\see NoiseGrid(T*, std::size_t, std::size_t, const Vector2T<T>&, const Vector2T<T>&, const NoiseDescriptorT<T>&)
+*/
+template <typename T>
+void NoiseGrid(
+    T*                          values,
+    std::size_t                 width,
+    std::size_t                 height,
+    std::size_t                 depth,
+    const Vector3T<T>&          origin,
+    const Vector3T<T>&          spacing,
+    const NoiseDescriptorT<T>&  desc)
+{
+    if (width == 0 || height == 0)
+        return;
+
+    Details::ParallelFor(
+        height*depth, std::max<std::size_t>(1, 4096 / width),
+        [&](std::size_t begin, std::size_t end, std::size_t)
+        {
+            for (std::size_t row = begin; row < end; ++row)
+            {
+                const std::size_t y = row % height, z = row / height;
+                const T rowOrigin[3] = { origin.x, origin.y + T(y) * spacing.y, origin.z + T(z) * spacing.z };
+                const Details::NoiseGridRowKernel<T, 3> kernel(desc, rowOrigin, spacing.x, values + row*width);
+                Details::ForEachPacket<T>(0, width, kernel);
+            }
+        }
+    );
+}
+
+
+/* --- Type Alias --- */
+
+using NoiseDescriptor   = NoiseDescriptorT<Real>;
+using NoiseDescriptorf  = NoiseDescriptorT<float>;
+using NoiseDescriptord  = NoiseDescriptorT<double>;
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
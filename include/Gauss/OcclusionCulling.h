@@ -0,0 +1,630 @@
+/*
+ * OcclusionCulling.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_OCCLUSION_CULLING_H
+#define GS_OCCLUSION_CULLING_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/Parallel.h>
+#include <Gauss/SIMDPacket.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+
+namespace Gs
+{
+
+
+namespace Details
+{
+
+
+// Each subtile has a 32 bit coverage mask for 8x4 pixels, where the bit (y*8 + x) belongs to the pixel (x, y) within the subtile.
+static const std::int32_t occlusionSubtileWidth     = 8;
+static const std::int32_t occlusionSubtileHeight    = 4;
+
+/*
+Screen space setup of an occluder triangle: edge functions (A*(x - X) + B*(y - Y), inside if the sign bit is cleared) and depth plane.
+Each edge function is evaluated relative to the lexicographically smaller endpoint (X, Y) of its edge, so two triangles which share an edge
+compute exactly negated values, and every pixel center along the shared edge is covered by at least one of them.
+*/
+template <typename T>
+struct OcclusionTriangle
+{
+    T           edgeA[3];
+    T           edgeB[3];
+    T           edgeX[3];
+    T           edgeY[3];
+    T           depthC;     // depth = depthC + depthDx*x + depthDy*y
+    T           depthDx;
+    T           depthDy;
+    T           depthMax;
+    std::int32_t minX, minY, maxX, maxY;
+};
+
+/*
+Coverage mask and depth layers of a subtile (masked occlusion culling):
+all pixels are covered by occluders closer than 'zMax0', and the pixels of the working layer 'mask' are covered closer than 'zMax1'.
+*/
+template <typename T>
+struct OcclusionSubtile
+{
+    std::uint32_t   mask;
+    T               zMax0;
+    T               zMax1;
+};
+
+// Merges the coverage of a triangle, whose farthest depth within the subtile is 'zTri', into the depth layers of the subtile.
+template <typename T>
+void MergeOcclusionSubtile(OcclusionSubtile<T>& subtile, std::uint32_t coverage, const T& zTri)
+{
+    /* Triangles behind the reference layer don't occlude anything more */
+    if (coverage == 0 || !(zTri < subtile.zMax0))
+        return;
+
+    /* Discard the working layer if the triangle is closer to it than the working layer is to the reference layer */
+    if (subtile.mask != 0 && subtile.zMax1 - zTri > subtile.zMax0 - subtile.zMax1)
+        subtile.mask = 0;
+
+    subtile.zMax1   = (subtile.mask != 0 ? std::max(subtile.zMax1, zTri) : zTri);
+    subtile.mask    |= coverage;
+
+    /* Working layer covers the entire subtile, so it becomes the new reference layer */
+    if (subtile.mask == ~std::uint32_t(0))
+    {
+        subtile.zMax0   = subtile.zMax1;
+        subtile.mask    = 0;
+    }
+}
+
+// Returns the mask of the pixels outside of the viewport (width x height) for the subtile at the pixel position (left, top).
+inline std::uint32_t OcclusionSubtileOutsideMask(std::int32_t left, std::int32_t top, std::int32_t width, std::int32_t height)
+{
+    std::uint32_t mask = 0;
+
+    if (left + occlusionSubtileWidth <= width && top + occlusionSubtileHeight <= height)
+        return mask;
+
+    for (std::int32_t y = 0; y < occlusionSubtileHeight; ++y)
+    {
+        for (std::int32_t x = 0; x < occlusionSubtileWidth; ++x)
+        {
+            if (left + x >= width || top + y >= height)
+                mask |= (1u << (y*occlusionSubtileWidth + x));
+        }
+    }
+
+    return mask;
+}
+
+// Returns the mask of the pixels in the rectangle [x0, x1] x [y0, y1] relative to a subtile.
+inline std::uint32_t OcclusionSubtileRectMask(std::int32_t x0, std::int32_t y0, std::int32_t x1, std::int32_t y1)
+{
+    const std::uint32_t rowMask = ((1u << (x1 - x0 + 1)) - 1u) << x0;
+
+    std::uint32_t mask = 0;
+    for (auto y = y0; y <= y1; ++y)
+        mask |= rowMask << (y*occlusionSubtileWidth);
+
+    return mask;
+}
+
+/*
+Rasterizes the binned triangles into a single tile, whose pixel position is (tx, ty), in packets of pixels along each subtile row.
+'subtiles' points to the first subtile of the tile, and pixels outside of the viewport (width x height) count as covered.
+*/
+template <typename T, typename P>
+void RasterizeOcclusionTile(
+    const OcclusionTriangle<T>*         triangles,
+    const std::vector<std::uint32_t>&   bin,
+    OcclusionSubtile<T>*                subtiles,
+    std::size_t                         subtilePitch,
+    std::int32_t                        tx,
+    std::int32_t                        ty,
+    std::int32_t                        tileWidth,
+    std::int32_t                        tileHeight,
+    std::int32_t                        width,
+    std::int32_t                        height)
+{
+    using Traits = PacketTraits<P>;
+
+    static const std::int32_t N = static_cast<std::int32_t>(Traits::size);
+    static const std::int32_t sw = occlusionSubtileWidth, sh = occlusionSubtileHeight;
+
+    static_assert(occlusionSubtileWidth % Traits::size == 0, "packet size must divide the subtile width");
+
+    const unsigned laneMask = (1u << N) - 1u;
+
+    T laneOffsets[Traits::size];
+    for (std::size_t i = 0; i < Traits::size; ++i)
+        laneOffsets[i] = static_cast<T>(i) + T(0.5);
+
+    const P offsets = Traits::Load(laneOffsets);
+
+    for (auto index : bin)
+    {
+        const auto& tri = triangles[index];
+
+        /* Clip triangle bounds against the tile and determine the overlapped subtiles */
+        const auto sx0 = (std::max(tri.minX, tx) - tx) / sw;
+        const auto sx1 = (std::min(tri.maxX, tx + tileWidth - 1) - tx) / sw;
+        const auto sy0 = (std::max(tri.minY, ty) - ty) / sh;
+        const auto sy1 = (std::min(tri.maxY, ty + tileHeight - 1) - ty) / sh;
+
+        const P a0 = P(tri.edgeA[0]), a1 = P(tri.edgeA[1]), a2 = P(tri.edgeA[2]);
+        const P x0 = P(tri.edgeX[0]), x1 = P(tri.edgeX[1]), x2 = P(tri.edgeX[2]);
+
+        for (auto sy = sy0; sy <= sy1; ++sy)
+        {
+            for (auto sx = sx0; sx <= sx1; ++sx)
+            {
+                const auto left = tx + sx*sw, top = ty + sy*sh;
+
+                /* Coverage of the pixel centers, where pixels outside of the viewport count as covered */
+                std::uint32_t coverage = 0;
+
+                for (std::int32_t y = 0; y < sh; ++y)
+                {
+                    const T py = static_cast<T>(top + y) + T(0.5);
+
+                    const P c0 = P(tri.edgeB[0]*(py - tri.edgeY[0]));
+                    const P c1 = P(tri.edgeB[1]*(py - tri.edgeY[1]));
+                    const P c2 = P(tri.edgeB[2]*(py - tri.edgeY[2]));
+
+                    for (std::int32_t x = 0; x < sw; x += N)
+                    {
+                        const P px = P(static_cast<T>(left + x)) + offsets;
+
+                        const unsigned outside =
+                        (
+                            PacketSignMask(PacketMulAdd(a0, px - x0, c0)) |
+                            PacketSignMask(PacketMulAdd(a1, px - x1, c1)) |
+                            PacketSignMask(PacketMulAdd(a2, px - x2, c2))
+                        );
+
+                        coverage |= static_cast<std::uint32_t>(~outside & laneMask) << (y*sw + x);
+                    }
+                }
+
+                if (coverage != 0)
+                    coverage |= OcclusionSubtileOutsideMask(left, top, width, height);
+
+                /* Farthest depth of the triangle within the subtile */
+                const T zTri = std::min(
+                    tri.depthMax,
+                    tri.depthC +
+                    tri.depthDx * static_cast<T>(tri.depthDx > T(0) ? left + sw : left) +
+                    tri.depthDy * static_cast<T>(tri.depthDy > T(0) ? top + sh : top)
+                );
+
+                MergeOcclusionSubtile(subtiles[sy*subtilePitch + sx], coverage, zTri);
+            }
+        }
+    }
+}
+
+
+} // /namespace Details
+
+
+/**
+\brief Low resolution depth buffer for software occlusion culling.
+\tparam T Specifies the data type of the depth values. This should be float or double.
+\remarks Occluder triangles are rasterized with masked occlusion culling: each subtile of 8x4 pixels keeps a coverage mask with two depth layers,
+the coverage of each triangle is merged into the working layer, and the working layer replaces the reference layer as soon as it covers the entire subtile.
+The buffer is split into tiles of 'tileWidth' x 'tileHeight' pixels, which are rasterized in SIMD packets of pixels and distributed across threads with "Details::ParallelFor".
+Depth values are the normalized device Z coordinates (i.e. Z/W after projection), and smaller values must be closer to the viewer,
+which is the case for all projections generated by ProjectionMatrix4T.
+The coverage is sampled at the pixel centers, and the occluder vertices are snapped to a sub-pixel grid that never hits a pixel center,
+so adjacent triangles which share an edge (i.e. the same vertices) cover all pixels along the edge. The results are conservative:
+occludee rectangles are extended by one pixel to account for the partly covered pixels along the occluder silhouettes, occluder triangles which intersect the near plane are dropped,
+and occludees which intersect the near plane are always visible.
+\code
+Gs::OcclusionBufferf buffer(256, 128);
+buffer.SetViewProjection(viewMatrix, projectionMatrix);
+buffer.Clear();
+buffer.RasterizeOccluders(occluderVertices.data(), occluderVertices.size(), occluderIndices.data(), occluderIndices.size());
+if (buffer.TestBox(boxMin, boxMax))
+    DrawObject();
+\endcode
+*/
+template <typename T>
+class OcclusionBufferT
+{
+
+    public:
+
+        static_assert(std::is_floating_point<T>::value, "occlusion buffers can only be used with floating point types");
+
+        //! Specifies the typename of the scalar components.
+        using ScalarType = T;
+
+        //! Number of pixels per tile in X direction.
+        static const std::size_t tileWidth  = 32;
+
+        //! Number of pixels per tile in Y direction.
+        static const std::size_t tileHeight = 8;
+
+        OcclusionBufferT() = default;
+
+        OcclusionBufferT(std::size_t width, std::size_t height)
+        {
+            Resize(width, height);
+        }
+
+        //! Resizes the depth buffer to the specified resolution and clears it.
+        void Resize(std::size_t width, std::size_t height)
+        {
+            width_  = width;
+            height_ = height;
+            tilesX_ = (width + tileWidth - 1) / tileWidth;
+            tilesY_ = (height + tileHeight - 1) / tileHeight;
+
+            subtilesX_ = tilesX_*tileWidth / Details::occlusionSubtileWidth;
+
+            subtiles_.resize(subtilesX_ * tilesY_*tileHeight / Details::occlusionSubtileHeight);
+            bins_.resize(tilesX_*tilesY_);
+
+            Clear();
+        }
+
+        //! Clears the depth buffer to the far plane, i.e. nothing is occluded.
+        void Clear()
+        {
+            const Details::OcclusionSubtile<T> farSubtile = { 0, FarDepth(), FarDepth() };
+            std::fill(subtiles_.begin(), subtiles_.end(), farSubtile);
+        }
+
+        /**
+        \brief Sets the view and projection transformations for the occluders and occludees.
+        \param[in] view Specifies the view transformation from world space to view space.
+        \param[in] projection Specifies the projection transformation from view space to clip space.
+        */
+        void SetViewProjection(const AffineMatrix4T<T>& view, const ProjectionMatrix4T<T>& projection)
+        {
+            const auto v = view.ToMatrix4();
+
+            Matrix<T, 4, 4> p;
+            Details::ProjectionToMatrix4(p, projection);
+
+            for (std::size_t row = 0; row < 4; ++row)
+            {
+                for (std::size_t col = 0; col < 4; ++col)
+                {
+                    viewProjection_.At(row, col) =
+                    (
+                        p.At(row, 0) * v.At(0, col) +
+                        p.At(row, 1) * v.At(1, col) +
+                        p.At(row, 2) * v.At(2, col) +
+                        p.At(row, 3) * v.At(3, col)
+                    );
+                }
+            }
+        }
+
+        /**
+        \brief Rasterizes the specified occluder triangles into the depth buffer.
+        \param[in] vertices Pointer to the world space vertex positions.
+        \param[in] numVertices Specifies the number of vertices.
+        \param[in] indices Pointer to the triangle list indices.
+        \param[in] numIndices Specifies the number of indices. This should be a multiple of 3.
+        \remarks Both triangle windings are rasterized. This can be called several times before the occludees are tested.
+        */
+        void RasterizeOccluders(const Vector3T<T>* vertices, std::size_t numVertices, const std::uint32_t* indices, std::size_t numIndices)
+        {
+            /* Transform vertices into screen space (X, Y in pixels, Z as depth, W to detect the near plane) */
+            screenVertices_.resize(numVertices);
+
+            Details::ParallelFor(
+                numVertices, 4096,
+                [&](std::size_t begin, std::size_t end, std::size_t)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
+                        screenVertices_[i] = SnapToSubpixel(ClipToScreen(TransformToClip(vertices[i])));
+                }
+            );
+
+            /* Setup triangles and bin them into the tiles they overlap */
+            triangles_.clear();
+            for (auto& bin : bins_)
+                bin.clear();
+
+            for (std::size_t i = 0; i + 2 < numIndices; i += 3)
+            {
+                Details::OcclusionTriangle<T> tri;
+                if (!SetupTriangle(screenVertices_[indices[i]], screenVertices_[indices[i + 1]], screenVertices_[indices[i + 2]], tri))
+                    continue;
+
+                const auto index = static_cast<std::uint32_t>(triangles_.size());
+                triangles_.push_back(tri);
+
+                for (std::int32_t ty = tri.minY / static_cast<std::int32_t>(tileHeight); ty <= tri.maxY / static_cast<std::int32_t>(tileHeight); ++ty)
+                {
+                    for (std::int32_t tx = tri.minX / static_cast<std::int32_t>(tileWidth); tx <= tri.maxX / static_cast<std::int32_t>(tileWidth); ++tx)
+                        bins_[ty*tilesX_ + tx].push_back(index);
+                }
+            }
+
+            /* Rasterize all tiles independently */
+            Details::ParallelFor(
+                bins_.size(), 4,
+                [this](std::size_t begin, std::size_t end, std::size_t)
+                {
+                    for (std::size_t tile = begin; tile < end; ++tile)
+                        RasterizeTile(tile);
+                }
+            );
+        }
+
+        /**
+        \brief Returns true if the specified world space bounding box is potentially visible, i.e. not occluded by the rasterized occluders.
+        \remarks Boxes outside the viewport are not visible, while boxes which intersect the near plane are always visible.
+        */
+        bool TestBox(const Vector3T<T>& boxMin, const Vector3T<T>& boxMax) const
+        {
+            /* Project all corners and determine the screen rectangle and the nearest depth */
+            T minX = std::numeric_limits<T>::max(), minY = minX, nearestDepth = minX;
+            T maxX = std::numeric_limits<T>::lowest(), maxY = maxX;
+
+            /* Corners in clip space are the clip space minimum plus the transformed box extents along each axis */
+            const auto& m = viewProjection_;
+            const auto base = TransformToClip(boxMin);
+            const auto size = boxMax - boxMin;
+
+            const Vector4T<T> ext[3] =
+            {
+                Vector4T<T>(m.At(0, 0), m.At(1, 0), m.At(2, 0), m.At(3, 0)) * size.x,
+                Vector4T<T>(m.At(0, 1), m.At(1, 1), m.At(2, 1), m.At(3, 1)) * size.y,
+                Vector4T<T>(m.At(0, 2), m.At(1, 2), m.At(2, 2), m.At(3, 2)) * size.z,
+            };
+
+            for (std::size_t i = 0; i < 8; ++i)
+            {
+                auto corner = base;
+                for (std::size_t a = 0; a < 3; ++a)
+                {
+                    if ((i & (1u << a)) != 0)
+                        corner += ext[a];
+                }
+
+                const auto p = ClipToScreen(corner);
+                if (p.w <= Epsilon<T>())
+                    return true;
+
+                minX = std::min(minX, p.x);
+                minY = std::min(minY, p.y);
+                maxX = std::max(maxX, p.x);
+                maxY = std::max(maxY, p.y);
+                nearestDepth = std::min(nearestDepth, p.z);
+            }
+
+            /* Clip screen rectangle against the viewport */
+            auto x0 = std::max<std::int32_t>(0, static_cast<std::int32_t>(std::floor(minX)));
+            auto y0 = std::max<std::int32_t>(0, static_cast<std::int32_t>(std::floor(minY)));
+            auto x1 = std::min<std::int32_t>(static_cast<std::int32_t>(width_) - 1, static_cast<std::int32_t>(std::floor(maxX)));
+            auto y1 = std::min<std::int32_t>(static_cast<std::int32_t>(height_) - 1, static_cast<std::int32_t>(std::floor(maxY)));
+
+            if (x0 > x1 || y0 > y1)
+                return false;
+
+            /* Extend the rectangle by one pixel, since the occluders cover pixels whose center is inside */
+            x0 = std::max<std::int32_t>(0, x0 - 1);
+            y0 = std::max<std::int32_t>(0, y0 - 1);
+            x1 = std::min<std::int32_t>(static_cast<std::int32_t>(width_) - 1, x1 + 1);
+            y1 = std::min<std::int32_t>(static_cast<std::int32_t>(height_) - 1, y1 + 1);
+
+            const auto sw = Details::occlusionSubtileWidth, sh = Details::occlusionSubtileHeight;
+
+            for (auto sy = y0 / sh; sy <= y1 / sh; ++sy)
+            {
+                for (auto sx = x0 / sw; sx <= x1 / sw; ++sx)
+                {
+                    /* Entire subtile is closer than the box */
+                    const auto& subtile = subtiles_[sy*subtilesX_ + sx];
+                    if (subtile.zMax0 < nearestDepth)
+                        continue;
+
+                    /* Pixels in the intersection of the subtile and the screen rectangle must be covered by the working layer */
+                    const auto rectMask = Details::OcclusionSubtileRectMask(
+                        std::max(x0, sx*sw) - sx*sw, std::max(y0, sy*sh) - sy*sh,
+                        std::min(x1, sx*sw + sw - 1) - sx*sw, std::min(y1, sy*sh + sh - 1) - sy*sh
+                    );
+
+                    if ((rectMask & ~subtile.mask) != 0 || !(subtile.zMax1 < nearestDepth))
+                        return true;
+                }
+            }
+
+            return false;
+        }
+
+        /**
+        \brief Tests the specified world space bounding boxes.
+        \param[in] boxMins Pointer to the minimum corners of the boxes.
+        \param[in] boxMaxs Pointer to the maximum corners of the boxes.
+        \param[in] count Specifies the number of boxes.
+        \param[out] visible Pointer to the output visibility flags.
+        \see TestBox
+        */
+        void TestBoxes(const Vector3T<T>* boxMins, const Vector3T<T>* boxMaxs, std::size_t count, bool* visible) const
+        {
+            Details::ParallelFor(
+                count, 1024,
+                [&](std::size_t begin, std::size_t end, std::size_t)
+                {
+                    for (std::size_t i = begin; i < end; ++i)
+                        visible[i] = TestBox(boxMins[i], boxMaxs[i]);
+                }
+            );
+        }
+
+        //! Returns the depth of the specified pixel, i.e. the pixel is covered by occluders which are closer than this depth.
+        T GetDepth(std::size_t x, std::size_t y) const
+        {
+            const auto& subtile = subtiles_[(y / Details::occlusionSubtileHeight)*subtilesX_ + x / Details::occlusionSubtileWidth];
+            const auto bit = 1u << ((y % Details::occlusionSubtileHeight)*Details::occlusionSubtileWidth + x % Details::occlusionSubtileWidth);
+            return ((subtile.mask & bit) != 0 ? subtile.zMax1 : subtile.zMax0);
+        }
+
+        //! Returns the width of the depth buffer (in pixels).
+        std::size_t GetWidth() const
+        {
+            return width_;
+        }
+
+        //! Returns the height of the depth buffer (in pixels).
+        std::size_t GetHeight() const
+        {
+            return height_;
+        }
+
+    private:
+
+        static T FarDepth()
+        {
+            return std::numeric_limits<T>::max();
+        }
+
+        Vector4T<T> TransformToClip(const Vector3T<T>& v) const
+        {
+            const auto& m = viewProjection_;
+            return Vector4T<T>(
+                m.At(0, 0)*v.x + m.At(0, 1)*v.y + m.At(0, 2)*v.z + m.At(0, 3),
+                m.At(1, 0)*v.x + m.At(1, 1)*v.y + m.At(1, 2)*v.z + m.At(1, 3),
+                m.At(2, 0)*v.x + m.At(2, 1)*v.y + m.At(2, 2)*v.z + m.At(2, 3),
+                m.At(3, 0)*v.x + m.At(3, 1)*v.y + m.At(3, 2)*v.z + m.At(3, 3)
+            );
+        }
+
+        // Returns the screen position (X, Y in pixels) with the normalized depth Z and the clip space W.
+        Vector4T<T> ClipToScreen(const Vector4T<T>& c) const
+        {
+            if (c.w <= Epsilon<T>())
+                return Vector4T<T>(T(0), T(0), T(0), c.w);
+
+            const T invW = T(1) / c.w;
+
+            return Vector4T<T>(
+                (c.x*invW*T(0.5) + T(0.5)) * static_cast<T>(width_),
+                (T(0.5) - c.y*invW*T(0.5)) * static_cast<T>(height_),
+                c.z*invW,
+                c.w
+            );
+        }
+
+        // Snaps the screen position to odd multiples of 1/512 pixels, so vertices never lie on a pixel center.
+        static Vector4T<T> SnapToSubpixel(const Vector4T<T>& p)
+        {
+            return Vector4T<T>(
+                (std::floor(p.x*T(256)) + T(0.5)) / T(256),
+                (std::floor(p.y*T(256)) + T(0.5)) / T(256),
+                p.z,
+                p.w
+            );
+        }
+
+        bool SetupTriangle(Vector4T<T> v0, Vector4T<T> v1, Vector4T<T> v2, Details::OcclusionTriangle<T>& tri) const
+        {
+            /* Drop triangles which intersect the near plane (conservative) */
+            if (v0.w <= Epsilon<T>() || v1.w <= Epsilon<T>() || v2.w <= Epsilon<T>())
+                return false;
+
+            /* Make the winding counter-clockwise */
+            T area = (v1.x - v0.x)*(v2.y - v0.y) - (v1.y - v0.y)*(v2.x - v0.x);
+            if (area < T(0))
+            {
+                std::swap(v1, v2);
+                area = -area;
+            }
+            if (area <= Epsilon<T>())
+                return false;
+
+            /* Pixel bounding box clipped against the viewport */
+            tri.minX = std::max<std::int32_t>(0, static_cast<std::int32_t>(std::floor(std::min(v0.x, std::min(v1.x, v2.x)))));
+            tri.minY = std::max<std::int32_t>(0, static_cast<std::int32_t>(std::floor(std::min(v0.y, std::min(v1.y, v2.y)))));
+            tri.maxX = std::min<std::int32_t>(static_cast<std::int32_t>(width_) - 1, static_cast<std::int32_t>(std::floor(std::max(v0.x, std::max(v1.x, v2.x)))));
+            tri.maxY = std::min<std::int32_t>(static_cast<std::int32_t>(height_) - 1, static_cast<std::int32_t>(std::floor(std::max(v0.y, std::max(v1.y, v2.y)))));
+
+            if (tri.minX > tri.maxX || tri.minY > tri.maxY)
+                return false;
+
+            /* Edge functions relative to the lexicographically smaller endpoint of each edge */
+            const Vector4T<T>* v[3] = { &v0, &v1, &v2 };
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                const auto& a = *v[i];
+                const auto& b = *v[(i + 1) % 3];
+                const auto& origin = (a.x < b.x || (a.x == b.x && a.y < b.y) ? a : b);
+                tri.edgeA[i] = a.y - b.y;
+                tri.edgeB[i] = b.x - a.x;
+                tri.edgeX[i] = origin.x;
+                tri.edgeY[i] = origin.y;
+            }
+
+            /* Depth plane */
+            tri.depthDx  = ((v1.z - v0.z)*(v2.y - v0.y) - (v2.z - v0.z)*(v1.y - v0.y)) / area;
+            tri.depthDy  = ((v2.z - v0.z)*(v1.x - v0.x) - (v1.z - v0.z)*(v2.x - v0.x)) / area;
+            tri.depthC   = v0.z - tri.depthDx*v0.x - tri.depthDy*v0.y;
+            tri.depthMax = std::max(v0.z, std::max(v1.z, v2.z));
+
+            return true;
+        }
+
+        void RasterizeTile(std::size_t tile)
+        {
+            const auto tx = (tile % tilesX_) * tileWidth;
+            const auto ty = (tile / tilesX_) * tileHeight;
+
+            Details::RasterizeOcclusionTile<T, typename Details::NativePacket<T>::Type>(
+                triangles_.data(), bins_[tile], &subtiles_[(ty / Details::occlusionSubtileHeight)*subtilesX_ + tx / Details::occlusionSubtileWidth], subtilesX_,
+                static_cast<std::int32_t>(tx), static_cast<std::int32_t>(ty), static_cast<std::int32_t>(tileWidth), static_cast<std::int32_t>(tileHeight),
+                static_cast<std::int32_t>(width_), static_cast<std::int32_t>(height_)
+            );
+        }
+
+    private:
+
+        std::size_t                                 width_          = 0;
+        std::size_t                                 height_         = 0;
+        std::size_t                                 tilesX_         = 0;
+        std::size_t                                 tilesY_         = 0;
+        std::size_t                                 subtilesX_      = 0;
+
+        Matrix<T, 4, 4>                             viewProjection_;
+
+        std::vector<Details::OcclusionSubtile<T>>   subtiles_;
+
+        std::vector<Vector4T<T>>                    screenVertices_;
+        std::vector<Details::OcclusionTriangle<T>>  triangles_;
+        std::vector<std::vector<std::uint32_t>>     bins_;
+
+};
+
+
+/* --- Type Alias --- */
+
+using OcclusionBuffer   = OcclusionBufferT<Real>;
+using OcclusionBufferf  = OcclusionBufferT<float>;
+using OcclusionBufferd  = OcclusionBufferT<double>;
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
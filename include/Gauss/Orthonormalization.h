@@ -0,0 +1,360 @@
+/*
+ * Orthonormalization.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_ORTHONORMALIZATION_H
+#define GS_ORTHONORMALIZATION_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/Parallel.h>
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+namespace Gs
+{
+
+
+//! Methods for the "Orthonormalize" and "OrthonormalizeArray" functions.
+enum class OrthonormalizationMethod
+{
+    /**
+    \brief Modified Gram-Schmidt process: the first basis vector is normalized, and the others are made orthogonal to the previous ones.
+    \remarks This is fast, but the correction is not distributed evenly, i.e. the direction of the first basis vector is kept.
+    */
+    GramSchmidt,
+
+    /**
+    \brief Polar decomposition with the Newton iteration X <- (X + X^-T) / 2.
+    \remarks This returns the nearest orthonormal matrix (in terms of the Frobenius norm), i.e. the symmetric re-orthonormalization
+    which does not prefer any axis. Slightly drifted matrices converge within two or three iterations.
+    */
+    Polar,
+};
+
+/**
+\brief Drift statistics of the "OrthonormalizeArray" and "RenormalizeArray" functions.
+\remarks The drift of a matrix is the maximal absolute element of (B^T * B - I), where B is the 3x3 basis,
+and the drift of a quaternion is the absolute difference of its squared length to 1.
+*/
+template <typename T>
+struct OrthonormalizationStatsT
+{
+    //! Number of entries whose drift exceeded the threshold and which were corrected.
+    std::size_t numCorrected;
+
+    //! Maximal drift of all entries before the correction.
+    T           maxDrift;
+
+    //! Mean drift of all entries before the correction.
+    T           meanDrift;
+
+    //! Maximal remaining drift of the corrected entries.
+    T           maxResidual;
+};
+
+
+namespace Details
+{
+
+
+// Accumulates the drift statistics of a range of entries.
+template <typename T>
+struct OrthonormalizationAccumulator
+{
+    std::size_t numCorrected    = 0;
+    T           maxDrift        = T(0);
+    T           sumDrift        = T(0);
+    T           maxResidual     = T(0);
+
+    void Add(const T& drift)
+    {
+        maxDrift = std::max(maxDrift, drift);
+        sumDrift += drift;
+    }
+
+    void AddCorrected(const T& residual)
+    {
+        ++numCorrected;
+        maxResidual = std::max(maxResidual, residual);
+    }
+
+    void Merge(const OrthonormalizationAccumulator<T>& rhs)
+    {
+        numCorrected    += rhs.numCorrected;
+        maxDrift        = std::max(maxDrift, rhs.maxDrift);
+        sumDrift        += rhs.sumDrift;
+        maxResidual     = std::max(maxResidual, rhs.maxResidual);
+    }
+};
+
+// Loads the basis vectors of the 3x3 block, i.e. the columns in terms of the 'At' accessor.
+template <typename M, typename T>
+void LoadBasis3(const M& m, Vector3T<T> (&b)[3])
+{
+    for (std::size_t i = 0; i < 3; ++i)
+        b[i] = Vector3T<T>(m.At(0, i), m.At(1, i), m.At(2, i));
+}
+
+// Stores the basis vectors into the 3x3 block. The other elements of the matrix remain unchanged.
+template <typename M, typename T>
+void StoreBasis3(M& m, const Vector3T<T> (&b)[3])
+{
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        m.At(0, i) = b[i].x;
+        m.At(1, i) = b[i].y;
+        m.At(2, i) = b[i].z;
+    }
+}
+
+// Returns the maximal absolute element of (B^T * B - I).
+template <typename T>
+T BasisDrift3(const Vector3T<T> (&b)[3])
+{
+    const T d00 = std::abs(Dot(b[0], b[0]) - T(1));
+    const T d11 = std::abs(Dot(b[1], b[1]) - T(1));
+    const T d22 = std::abs(Dot(b[2], b[2]) - T(1));
+    const T d01 = std::abs(Dot(b[0], b[1]));
+    const T d02 = std::abs(Dot(b[0], b[2]));
+    const T d12 = std::abs(Dot(b[1], b[2]));
+    return std::max(std::max(std::max(d00, d11), std::max(d22, d01)), std::max(d02, d12));
+}
+
+template <typename T>
+void OrthonormalizeGramSchmidt3(Vector3T<T> (&b)[3])
+{
+    b[0].Normalize();
+
+    b[1] -= b[0] * Dot(b[0], b[1]);
+    b[1].Normalize();
+
+    b[2] -= b[0] * Dot(b[0], b[2]);
+    b[2] -= b[1] * Dot(b[1], b[2]);
+    b[2].Normalize();
+}
+
+// Newton iteration for the orthogonal polar factor. The columns of X^-T are the cross products of the columns of X divided by the determinant.
+template <typename T>
+void OrthonormalizePolar3(Vector3T<T> (&b)[3])
+{
+    const T tolerance = std::numeric_limits<T>::epsilon() * T(8);
+
+    for (int i = 0; i < 16; ++i)
+    {
+        const Vector3T<T> c0 = Cross(b[1], b[2]);
+        const Vector3T<T> c1 = Cross(b[2], b[0]);
+        const Vector3T<T> c2 = Cross(b[0], b[1]);
+
+        const T det = Dot(b[0], c0);
+        if (det == T(0))
+            return;
+
+        const T s = T(0.5) / det;
+
+        b[0] = b[0] * T(0.5) + c0 * s;
+        b[1] = b[1] * T(0.5) + c1 * s;
+        b[2] = b[2] * T(0.5) + c2 * s;
+
+        if (BasisDrift3(b) <= tolerance)
+            return;
+    }
+}
+
+// Re-orthonormalizes the 3x3 block of the matrix if its drift exceeds the threshold.
+template <typename M, typename T>
+void OrthonormalizeEntry(M& m, OrthonormalizationMethod method, const T& threshold, OrthonormalizationAccumulator<T>& accum)
+{
+    Vector3T<T> b[3];
+    LoadBasis3(m, b);
+
+    const T drift = BasisDrift3(b);
+    accum.Add(drift);
+
+    if (drift <= threshold)
+        return;
+
+    if (method == OrthonormalizationMethod::GramSchmidt)
+        OrthonormalizeGramSchmidt3(b);
+    else
+        OrthonormalizePolar3(b);
+
+    accum.AddCorrected(BasisDrift3(b));
+    StoreBasis3(m, b);
+}
+
+// Renormalizes the quaternion if its drift exceeds the threshold.
+template <typename T>
+void RenormalizeEntry(QuaternionT<T>& q, const T& threshold, OrthonormalizationAccumulator<T>& accum)
+{
+    const T lenSq = q.x*q.x + q.y*q.y + q.z*q.z + q.w*q.w;
+    const T drift = std::abs(lenSq - T(1));
+    accum.Add(drift);
+
+    if (drift <= threshold || lenSq == T(0))
+        return;
+
+    const T s = T(1) / std::sqrt(lenSq);
+    q.x *= s;
+    q.y *= s;
+    q.z *= s;
+    q.w *= s;
+
+    accum.AddCorrected(std::abs(q.x*q.x + q.y*q.y + q.z*q.z + q.w*q.w - T(1)));
+}
+
+// Calls 'func(i, accum)' for all entries in [0, count) with "ParallelFor" and writes the merged statistics (if 'stats' is not null).
+template <typename T, typename Func>
+void ForEachOrthonormalizationEntry(std::size_t count, OrthonormalizationStatsT<T>* stats, const Func& func)
+{
+    const std::size_t grainSize = 4096;
+
+    std::vector<OrthonormalizationAccumulator<T>> chunkAccums(stats != nullptr ? ParallelChunks(count, grainSize) : 0);
+
+    ParallelFor(
+        count, grainSize,
+        [&](std::size_t begin, std::size_t end, std::size_t chunk)
+        {
+            OrthonormalizationAccumulator<T> accum;
+
+            for (std::size_t i = begin; i < end; ++i)
+                func(i, accum);
+
+            if (!chunkAccums.empty())
+                chunkAccums[chunk] = accum;
+        }
+    );
+
+    if (stats != nullptr)
+    {
+        OrthonormalizationAccumulator<T> accum;
+
+        for (const auto& chunkAccum : chunkAccums)
+            accum.Merge(chunkAccum);
+
+        stats->numCorrected = accum.numCorrected;
+        stats->maxDrift     = accum.maxDrift;
+        stats->meanDrift    = (count > 0 ? accum.sumDrift / static_cast<T>(count) : T(0));
+        stats->maxResidual  = accum.maxResidual;
+    }
+}
+
+
+} // /namespace Details
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Re-orthonormalizes the specified 3x3 matrix, e.g. a rotation matrix that has drifted by numerical integration.
+\see OrthonormalizationMethod
+*/
+template <typename T>
+void Orthonormalize(Matrix3T<T>& m, const OrthonormalizationMethod method = OrthonormalizationMethod::Polar)
+{
+    Details::OrthonormalizationAccumulator<T> accum;
+    Details::OrthonormalizeEntry(m, method, T(-1), accum);
+}
+
+//! Re-orthonormalizes the 3x3 rotation block of the specified affine matrix. The translation remains unchanged.
+template <typename T>
+void Orthonormalize(AffineMatrix4T<T>& m, const OrthonormalizationMethod method = OrthonormalizationMethod::Polar)
+{
+    Details::OrthonormalizationAccumulator<T> accum;
+    Details::OrthonormalizeEntry(m, method, T(-1), accum);
+}
+
+/**
+\brief Re-orthonormalizes all 3x3 matrices of the specified array.
+\param[in,out] matrices Pointer to the first matrix.
+\param[in] count Specifies the number of matrices.
+\param[in] method Specifies the re-orthonormalization method.
+\param[in] threshold Specifies the drift (see OrthonormalizationStatsT) up to which a matrix is considered clean and is skipped. By default 0.
+\param[out] stats Optional pointer to the output drift statistics. By default null.
+\remarks The range is distributed with "Details::ParallelFor".
+\see OrthonormalizationMethod
+*/
+template <typename T>
+void OrthonormalizeArray(
+    Matrix3T<T>*                    matrices,
+    std::size_t                     count,
+    const OrthonormalizationMethod  method      = OrthonormalizationMethod::Polar,
+    const T&                        threshold   = T(0),
+    OrthonormalizationStatsT<T>*    stats       = nullptr)
+{
+    Details::ForEachOrthonormalizationEntry(
+        count, stats,
+        [matrices, method, &threshold](std::size_t i, Details::OrthonormalizationAccumulator<T>& accum)
+        {
+            Details::OrthonormalizeEntry(matrices[i], method, threshold, accum);
+        }
+    );
+}
+
+//! Re-orthonormalizes the 3x3 rotation blocks of all affine matrices of the specified array. \see OrthonormalizeArray(Matrix3T<T>*, std::size_t, const OrthonormalizationMethod, const T&, OrthonormalizationStatsT<T>*)
+template <typename T>
+void OrthonormalizeArray(
+    AffineMatrix4T<T>*              matrices,
+    std::size_t                     count,
+    const OrthonormalizationMethod  method      = OrthonormalizationMethod::Polar,
+    const T&                        threshold   = T(0),
+    OrthonormalizationStatsT<T>*    stats       = nullptr)
+{
+    Details::ForEachOrthonormalizationEntry(
+        count, stats,
+        [matrices, method, &threshold](std::size_t i, Details::OrthonormalizationAccumulator<T>& accum)
+        {
+            Details::OrthonormalizeEntry(matrices[i], method, threshold, accum);
+        }
+    );
+}
+
+/**
+\brief Renormalizes all quaternions of the specified array to unit length.
+\param[in,out] quaternions Pointer to the first quaternion.
+\param[in] count Specifies the number of quaternions.
+\param[in] threshold Specifies the drift |x^2 + y^2 + z^2 + w^2 - 1| up to which a quaternion is considered clean and is skipped. By default 0.
+\param[out] stats Optional pointer to the output drift statistics. By default null.
+\remarks Quaternions with a length of zero remain unchanged. The range is distributed with "Details::ParallelFor".
+*/
+template <typename T>
+void RenormalizeArray(
+    QuaternionT<T>*                 quaternions,
+    std::size_t                     count,
+    const T&                        threshold   = T(0),
+    OrthonormalizationStatsT<T>*    stats       = nullptr)
+{
+    Details::ForEachOrthonormalizationEntry(
+        count, stats,
+        [quaternions, &threshold](std::size_t i, Details::OrthonormalizationAccumulator<T>& accum)
+        {
+            Details::RenormalizeEntry(quaternions[i], threshold, accum);
+        }
+    );
+}
+
+
+/* --- Type Alias --- */
+
+using OrthonormalizationStats   = OrthonormalizationStatsT<Real>;
+using OrthonormalizationStatsf  = OrthonormalizationStatsT<float>;
+using OrthonormalizationStatsd  = OrthonormalizationStatsT<double>;
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
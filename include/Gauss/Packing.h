@@ -0,0 +1,156 @@
+/*
+ * Packing.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_PACKING_H
+#define GS_PACKING_H
+
+
+#include "Algebra.h"
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Vector4.h"
+
+#include <cmath>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+
+namespace Gs
+{
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Packs the specified value in the range [-1, 1] into a signed normalized integer with the specified number of bits.
+\tparam I Specifies the integral type of the packed value, e.g. std::int16_t.
+\tparam Bits Specifies the number of bits. By default all bits of 'I'.
+\remarks Values outside the range [-1, 1] are clamped.
+*/
+template <typename I, int Bits = static_cast<int>(sizeof(I)*8), typename T>
+I PackSnorm(const T& x)
+{
+    static_assert(std::is_integral<I>::value, "PackSnorm function only allows integral output types");
+    const T scale = T((1ll << (Bits - 1)) - 1);
+    return static_cast<I>(std::floor(Clamp(x, T(-1), T(1)) * scale + T(0.5)));
+}
+
+/**
+\brief Unpacks the specified signed normalized integer with the specified number of bits into the range [-1, 1].
+\see PackSnorm
+*/
+template <typename T, int Bits, typename I>
+T UnpackSnorm(const I& x)
+{
+    const T scale = T((1ll << (Bits - 1)) - 1);
+    return std::max(T(x) / scale, T(-1));
+}
+
+/**
+\brief Encodes the specified normalized 3D vector with an octahedral mapping into the range [-1, 1]^2.
+\see OctahedralDecode
+*/
+template <typename T>
+Vector2T<T> OctahedralEncode(const Vector3T<T>& n)
+{
+    const T invL1 = T(1) / (std::abs(n.x) + std::abs(n.y) + std::abs(n.z));
+
+    Vector2T<T> e { n.x*invL1, n.y*invL1 };
+
+    if (n.z < T(0))
+    {
+        /* Fold the lower hemisphere over the diagonals */
+        const T ex = e.x;
+        e.x = (T(1) - std::abs(e.y)) * (ex  >= T(0) ? T(1) : T(-1));
+        e.y = (T(1) - std::abs(ex )) * (e.y >= T(0) ? T(1) : T(-1));
+    }
+
+    return e;
+}
+
+/**
+\brief Decodes the specified octahedral mapped vector into a normalized 3D vector.
+\see OctahedralEncode
+*/
+template <typename T>
+Vector3T<T> OctahedralDecode(const Vector2T<T>& e)
+{
+    Vector3T<T> n { e.x, e.y, T(1) - std::abs(e.x) - std::abs(e.y) };
+
+    if (n.z < T(0))
+    {
+        const T nx = n.x;
+        n.x = (T(1) - std::abs(n.y)) * (nx  >= T(0) ? T(1) : T(-1));
+        n.y = (T(1) - std::abs(nx )) * (n.y >= T(0) ? T(1) : T(-1));
+    }
+
+    Normalize(n);
+
+    return n;
+}
+
+//! Packs the specified normalized 3D vector into two octahedral mapped 16-bit signed normalized integers (x in the lower 16 bits).
+template <typename T>
+std::uint32_t PackOctahedral16(const Vector3T<T>& n)
+{
+    const auto e = OctahedralEncode(n);
+    return
+    (
+        (static_cast<std::uint32_t>(static_cast<std::uint16_t>(PackSnorm<std::int16_t>(e.x)))      ) |
+        (static_cast<std::uint32_t>(static_cast<std::uint16_t>(PackSnorm<std::int16_t>(e.y))) << 16)
+    );
+}
+
+//! Unpacks the specified octahedral mapped vector.
+template <typename T>
+Vector3T<T> UnpackOctahedral16(std::uint32_t packed)
+{
+    return OctahedralDecode(
+        Vector2T<T>(
+            UnpackSnorm<T, 16>(static_cast<std::int16_t>(packed & 0xffff)),
+            UnpackSnorm<T, 16>(static_cast<std::int16_t>(packed >> 16))
+        )
+    );
+}
+
+//! Packs the specified 4D vector into a 10-10-10-2 signed normalized integer (x in the lower 10 bits).
+template <typename T>
+std::uint32_t PackSnorm10_10_10_2(const Vector4T<T>& v)
+{
+    return
+    (
+        ((static_cast<std::uint32_t>(PackSnorm<std::int32_t, 10>(v.x)) & 0x3ff)      ) |
+        ((static_cast<std::uint32_t>(PackSnorm<std::int32_t, 10>(v.y)) & 0x3ff) << 10) |
+        ((static_cast<std::uint32_t>(PackSnorm<std::int32_t, 10>(v.z)) & 0x3ff) << 20) |
+        ((static_cast<std::uint32_t>(PackSnorm<std::int32_t,  2>(v.w)) & 0x003) << 30)
+    );
+}
+
+//! Unpacks the specified 10-10-10-2 signed normalized integer.
+template <typename T>
+Vector4T<T> UnpackSnorm10_10_10_2(std::uint32_t packed)
+{
+    /* Sign extend each bit field by shifting it to the most significant bits */
+    return Vector4T<T>(
+        UnpackSnorm<T, 10>(static_cast<std::int32_t>(packed << 22) >> 22),
+        UnpackSnorm<T, 10>(static_cast<std::int32_t>(packed << 12) >> 22),
+        UnpackSnorm<T, 10>(static_cast<std::int32_t>(packed <<  2) >> 22),
+        UnpackSnorm<T,  2>(static_cast<std::int32_t>(packed      ) >> 30)
+    );
+}
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
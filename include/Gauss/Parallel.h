@@ -0,0 +1,142 @@
+/*
+ * Parallel.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_PARALLEL_H
+#define GS_PARALLEL_H
+
+
+#include "Config.h"
+
+#include <cstddef>
+#include <algorithm>
+
+#ifdef GS_ENABLE_MULTI_THREADING
+#   include <thread>
+#   include <vector>
+#   include <exception>
+#endif
+
+
+namespace Gs
+{
+
+
+namespace Details
+{
+
+
+/**
+\brief Returns the number of chunks the range [0, count) is split into by "ParallelFor".
+\param[in] count Specifies the number of elements.
+\param[in] grainSize Specifies the minimal number of elements per chunk.
+\remarks This is always 1 if the macro 'GS_ENABLE_MULTI_THREADING' is not defined.
+It can be used to allocate per-chunk buffers before calling "ParallelFor".
+*/
+inline std::size_t ParallelChunks(std::size_t count, std::size_t grainSize)
+{
+    #ifdef GS_ENABLE_MULTI_THREADING
+    const std::size_t maxThreads    = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t maxChunks     = (count + std::max<std::size_t>(grainSize, 1) - 1) / std::max<std::size_t>(grainSize, 1);
+    return std::max<std::size_t>(1, std::min(maxThreads, maxChunks));
+    #else
+    (void)count;
+    (void)grainSize;
+    return 1;
+    #endif
+}
+
+/**
+\brief Calls 'func(begin, end, chunk)' for each chunk of the range [0, count).
+\param[in] count Specifies the number of elements.
+\param[in] grainSize Specifies the minimal number of elements per chunk.
+\param[in] func Specifies the function which is called for each chunk. The chunk index is in the range [0, ParallelChunks(count, grainSize)).
+\remarks The chunks are processed by worker threads if the macro 'GS_ENABLE_MULTI_THREADING' is defined.
+Otherwise, the function is called once for the entire range on the calling thread.
+If the function throws an exception in any chunk, all chunks are still joined and the exception of the first failed chunk is re-thrown on the calling thread.
+\see ParallelChunks
+*/
+template <typename Func>
+void ParallelFor(std::size_t count, std::size_t grainSize, const Func& func)
+{
+    if (count == 0)
+        return;
+
+    const std::size_t numChunks = ParallelChunks(count, grainSize);
+
+    #ifdef GS_ENABLE_MULTI_THREADING
+
+    if (numChunks > 1)
+    {
+        const std::size_t chunkSize = (count + numChunks - 1) / numChunks;
+
+        std::vector<std::thread> workers;
+        workers.reserve(numChunks - 1);
+
+        /* Exceptions are stored per chunk, since they must not leave the thread functions */
+        std::vector<std::exception_ptr> exceptions(numChunks);
+
+        /* Run all chunks except the first one on worker threads */
+        for (std::size_t chunk = 1; chunk < numChunks; ++chunk)
+        {
+            const std::size_t begin = std::min(count, chunk*chunkSize);
+            const std::size_t end   = std::min(count, begin + chunkSize);
+            workers.emplace_back(
+                [&func, &exceptions, begin, end, chunk]()
+                {
+                    try
+                    {
+                        func(begin, end, chunk);
+                    }
+                    catch (...)
+                    {
+                        exceptions[chunk] = std::current_exception();
+                    }
+                }
+            );
+        }
+
+        /* Run first chunk on the calling thread */
+        try
+        {
+            func(0, std::min(count, chunkSize), 0);
+        }
+        catch (...)
+        {
+            exceptions[0] = std::current_exception();
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+
+        /* Re-throw the exception of the first failed chunk on the calling thread */
+        for (const auto& e : exceptions)
+        {
+            if (e)
+                std::rethrow_exception(e);
+        }
+
+        return;
+    }
+
+    #endif
+
+    (void)numChunks;
+    func(0, count, 0);
+}
+
+
+} // /namespace Details
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
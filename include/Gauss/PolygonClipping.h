@@ -0,0 +1,474 @@
+/*
+ * PolygonClipping.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_POLYGON_CLIPPING_H
+#define GS_POLYGON_CLIPPING_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/Assert.h>
+#include <Gauss/Parallel.h>
+#include <Gauss/SIMDPacket.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace Gs
+{
+
+
+namespace Details
+{
+
+
+/*
+Clipping planes are specified as 4D vectors (a, b, c, d) of the plane equation a*x + b*y + c*z + d = 0,
+and the inside (i.e. the part that is kept) is where the equation is greater than or equal to zero.
+*/
+template <typename T>
+T PlaneDistance(const Vector4T<T>& plane, const Vector3T<T>& point)
+{
+    return plane.x*point.x + plane.y*point.y + plane.z*point.z + plane.w;
+}
+
+/*
+Returns the intersection of the edge (a, b) with a plane, where 'da' and 'db' are the signed distances of the end points.
+The intersection is always interpolated from the inside to the outside point, so that the shared edges of adjacent polygons produce the same vertex.
+*/
+template <typename T>
+Vector3T<T> ClipEdge(const Vector3T<T>& a, const T& da, const Vector3T<T>& b, const T& db)
+{
+    if (da >= T(0))
+        return Lerp(a, b, da / (da - db));
+    else
+        return Lerp(b, a, db / (db - da));
+}
+
+/*
+Clips the convex polygon against all planes whose bits are set in 'planeMask' (Sutherland-Hodgman), ping-ponging between the two buffers.
+Returns the number of remaining vertices and the pointer to them in 'result', or 0 if less than three vertices remain.
+*/
+template <typename T>
+std::size_t ClipConvexPolygon(
+    const Vector3T<T>*          vertices,
+    std::size_t                 numVertices,
+    const Vector4T<T>*          planes,
+    std::uint32_t               planeMask,
+    std::vector<Vector3T<T>>&   bufferA,
+    std::vector<Vector3T<T>>&   bufferB,
+    const Vector3T<T>*&         result)
+{
+    const Vector3T<T>* src = vertices;
+    std::vector<Vector3T<T>>* dst = &bufferA;
+
+    for (std::size_t j = 0; planeMask != 0; ++j, planeMask >>= 1)
+    {
+        if ((planeMask & 1u) == 0)
+            continue;
+
+        const auto& plane = planes[j];
+
+        dst->clear();
+
+        auto prev = src[numVertices - 1];
+        T prevDist = PlaneDistance(plane, prev);
+
+        for (std::size_t i = 0; i < numVertices; ++i)
+        {
+            const auto& curr = src[i];
+            const T currDist = PlaneDistance(plane, curr);
+
+            if ((prevDist >= T(0)) != (currDist >= T(0)))
+                dst->push_back(ClipEdge(prev, prevDist, curr, currDist));
+            if (currDist >= T(0))
+                dst->push_back(curr);
+
+            prev = curr;
+            prevDist = currDist;
+        }
+
+        numVertices = dst->size();
+        if (numVertices < 3)
+            return 0;
+
+        src = dst->data();
+        dst = (dst == &bufferA ? &bufferB : &bufferA);
+    }
+
+    result = src;
+
+    return numVertices;
+}
+
+// Output arena of clipped polygons in compressed sparse row (CSR) layout.
+template <typename T>
+struct ClippedPolygonArena
+{
+    void Clear()
+    {
+        vertices.clear();
+        offsets.assign(1, 0);
+        sources.clear();
+    }
+
+    void AddPolygon(const Vector3T<T>* polygon, std::size_t numVertices, std::uint32_t source)
+    {
+        vertices.insert(vertices.end(), polygon, polygon + numVertices);
+        offsets.push_back(static_cast<std::uint32_t>(vertices.size()));
+        sources.push_back(source);
+    }
+
+    void Append(const ClippedPolygonArena& rhs)
+    {
+        const auto base = static_cast<std::uint32_t>(vertices.size());
+        vertices.insert(vertices.end(), rhs.vertices.begin(), rhs.vertices.end());
+        for (std::size_t i = 1; i < rhs.offsets.size(); ++i)
+            offsets.push_back(base + rhs.offsets[i]);
+        sources.insert(sources.end(), rhs.sources.begin(), rhs.sources.end());
+    }
+
+    std::vector<Vector3T<T>>    vertices;
+    std::vector<std::uint32_t>  offsets     = { 0 };
+    std::vector<std::uint32_t>  sources;
+
+    // Ping-pong buffers for the Sutherland-Hodgman passes.
+    std::vector<Vector3T<T>>    bufferA;
+    std::vector<Vector3T<T>>    bufferB;
+};
+
+/*
+Classifies the corners of packets of triangles against all planes.
+For each triangle, the mask of planes that must be clipped against is written, or 'culledMask' if the triangle is completely outside of a plane.
+*/
+template <typename T, typename Index>
+class TriangleClipClassifier
+{
+
+    public:
+
+        static const std::uint32_t culledMask = 0x80000000;
+
+        TriangleClipClassifier(const Vector3T<T>* vertices, const Index* indices, const Vector4T<T>* planes, std::size_t numPlanes, std::uint32_t* clipMasks) :
+            vertices_  { vertices  },
+            indices_   { indices   },
+            planes_    { planes    },
+            numPlanes_ { numPlanes },
+            clipMasks_ { clipMasks }
+        {
+        }
+
+        template <typename P>
+        void Run(std::size_t i) const
+        {
+            using Traits = PacketTraits<P>;
+
+            const std::size_t n = Traits::size;
+
+            /* Gather the triangle corners into SoA layout */
+            T coords[9][n];
+
+            for (std::size_t lane = 0; lane < n; ++lane)
+            {
+                for (std::size_t corner = 0; corner < 3; ++corner)
+                {
+                    const auto& v = vertices_[static_cast<std::size_t>(indices_[(i + lane)*3 + corner])];
+                    coords[corner*3    ][lane] = v.x;
+                    coords[corner*3 + 1][lane] = v.y;
+                    coords[corner*3 + 2][lane] = v.z;
+                }
+            }
+
+            P c[9];
+            for (std::size_t k = 0; k < 9; ++k)
+                c[k] = Traits::Load(coords[k]);
+
+            /* Sign masks of the plane distances: bit 'lane' is set if the corner is outside */
+            std::uint32_t masks[n];
+            for (std::size_t lane = 0; lane < n; ++lane)
+                masks[lane] = 0;
+
+            unsigned culled = 0;
+
+            for (std::size_t j = 0; j < numPlanes_; ++j)
+            {
+                const P a = planes_[j].x, b = planes_[j].y, cz = planes_[j].z, d = planes_[j].w;
+
+                const unsigned m0 = PacketSignMask(PacketMulAdd(a, c[0], PacketMulAdd(b, c[1], PacketMulAdd(cz, c[2], d))));
+                const unsigned m1 = PacketSignMask(PacketMulAdd(a, c[3], PacketMulAdd(b, c[4], PacketMulAdd(cz, c[5], d))));
+                const unsigned m2 = PacketSignMask(PacketMulAdd(a, c[6], PacketMulAdd(b, c[7], PacketMulAdd(cz, c[8], d))));
+
+                culled |= (m0 & m1 & m2);
+
+                const unsigned straddling = (m0 | m1 | m2);
+                if (straddling != 0)
+                {
+                    for (std::size_t lane = 0; lane < n; ++lane)
+                        masks[lane] |= ((straddling >> lane) & 1u) << j;
+                }
+            }
+
+            for (std::size_t lane = 0; lane < n; ++lane)
+                clipMasks_[i + lane] = (((culled >> lane) & 1u) != 0 ? culledMask : masks[lane]);
+        }
+
+    private:
+
+        const Vector3T<T>*  vertices_;
+        const Index*        indices_;
+        const Vector4T<T>*  planes_;
+        std::size_t         numPlanes_;
+        std::uint32_t*      clipMasks_;
+
+};
+
+
+} // /namespace Details
+
+
+/**
+\brief Clips triangles and convex polygons against a set of planes (Sutherland-Hodgman) and stores the resulting polygons in an arena.
+\tparam T Specifies the data type of the vector components. This should be float or double.
+\remarks The planes are specified as 4D vectors (a, b, c, d) of the plane equation a*x + b*y + c*z + d = 0, where the normal (a, b, c) points to the inside,
+i.e. the part of the polygons with a*x + b*y + c*z + d >= 0 is kept. A common use case are decals, which are clipped against the six planes of a box:
+\code
+Gs::PolygonClipper clipper;
+clipper.Clear();
+
+for (const auto& decal : decals)
+{
+    const std::size_t firstPolygon = clipper.NumPolygons();
+    clipper.SetPlanes(decal.planes, 6);
+    clipper.ClipTriangles(meshVertices, decal.candidateIndices.data(), decal.candidateIndices.size() / 3);
+    // ... polygons [firstPolygon, clipper.NumPolygons()) belong to this decal
+}
+\endcode
+The output memory is only released by the destructor, so a clipper that is reused every frame does not allocate memory once it has grown.
+*/
+template <typename T>
+class PolygonClipperT
+{
+
+    public:
+
+        static_assert(std::is_floating_point<T>::value, "polygon clipper can only be used with floating point types");
+
+        //! Specifies the typename of the scalar components.
+        using ScalarType = T;
+
+        //! Maximal number of clipping planes.
+        static const std::size_t maxPlanes = 31;
+
+        //! Removes all output polygons. The memory is kept for the next frame.
+        void Clear()
+        {
+            output_.Clear();
+        }
+
+        //! Sets the clipping planes. At most 'maxPlanes' planes can be specified.
+        void SetPlanes(const Vector4T<T>* planes, std::size_t numPlanes)
+        {
+            GS_ASSERT(numPlanes <= maxPlanes);
+            planes_.assign(planes, planes + numPlanes);
+        }
+
+        /**
+        \brief Clips the specified convex polygon against the planes and appends the result if it is not empty.
+        \param[in] source Specifies an arbitrary index which is stored for the output polygon (see GetSource).
+        \return Number of vertices of the output polygon, or zero if the polygon was clipped away completely.
+        */
+        std::size_t ClipPolygon(const Vector3T<T>* vertices, std::size_t numVertices, std::uint32_t source = 0)
+        {
+            if (numVertices < 3)
+                return 0;
+
+            /* Fast path: only clip against the planes that have at least one vertex outside */
+            std::uint32_t clipMask = 0;
+
+            for (std::size_t j = 0; j < planes_.size(); ++j)
+            {
+                std::size_t numOutside = 0;
+                for (std::size_t i = 0; i < numVertices; ++i)
+                {
+                    if (Details::PlaneDistance(planes_[j], vertices[i]) < T(0))
+                        ++numOutside;
+                }
+
+                if (numOutside == numVertices)
+                    return 0;
+                if (numOutside > 0)
+                    clipMask |= (1u << j);
+            }
+
+            return ClipAndAppend(vertices, numVertices, clipMask, source, output_);
+        }
+
+        /**
+        \brief Clips the specified triangles against the planes and appends the results.
+        \param[in] vertices Pointer to the vertex positions.
+        \param[in] indices Pointer to the triangle list indices.
+        \param[in] numTriangles Specifies the number of triangles, i.e. 'indices' must contain 'numTriangles*3' elements.
+        \remarks The triangle index is stored as source of each output polygon (see GetSource).
+        The triangle corners are classified against all planes in SIMD packets, so that triangles which are completely inside are copied,
+        triangles which are completely outside of any plane are skipped, and the others are only clipped against the planes they intersect.
+        Large ranges of triangles are distributed with "Details::ParallelFor", and the output order is the same as the input order.
+        */
+        template <typename Index>
+        void ClipTriangles(const Vector3T<T>* vertices, const Index* indices, std::size_t numTriangles)
+        {
+            if (numTriangles == 0)
+                return;
+
+            clipMasks_.resize(numTriangles);
+
+            const Details::TriangleClipClassifier<T, Index> classifier(vertices, indices, planes_.data(), planes_.size(), clipMasks_.data());
+
+            const std::size_t grainSize = 2048;
+            const std::size_t numChunks = Details::ParallelChunks(numTriangles, grainSize);
+
+            if (numChunks == 1)
+            {
+                Details::ForEachPacket<T>(0, numTriangles, classifier);
+                ClipTriangleRange(vertices, indices, 0, numTriangles, output_);
+                return;
+            }
+
+            /* Clip chunks into separate arenas and append them in order */
+            if (chunkOutputs_.size() < numChunks)
+                chunkOutputs_.resize(numChunks);
+
+            Details::ParallelFor(
+                numTriangles, grainSize,
+                [&](std::size_t begin, std::size_t end, std::size_t chunk)
+                {
+                    auto& output = chunkOutputs_[chunk];
+                    output.Clear();
+                    Details::ForEachPacket<T>(begin, end, classifier);
+                    ClipTriangleRange(vertices, indices, begin, end, output);
+                }
+            );
+
+            for (std::size_t chunk = 0; chunk < numChunks; ++chunk)
+                output_.Append(chunkOutputs_[chunk]);
+        }
+
+        /**
+        \brief Appends the triangle fan indices of all output polygons, beginning with the specified polygon, to the index list.
+        \remarks The indices refer to the output vertices (see GetVertices). Since the polygons are convex, a triangle fan is a valid triangulation.
+        */
+        template <typename Index>
+        void Triangulate(std::vector<Index>& indices, std::size_t firstPolygon = 0) const
+        {
+            for (std::size_t i = firstPolygon; i < NumPolygons(); ++i)
+            {
+                const auto first = output_.offsets[i];
+                for (auto v = first + 2; v < output_.offsets[i + 1]; ++v)
+                {
+                    indices.push_back(static_cast<Index>(first));
+                    indices.push_back(static_cast<Index>(v - 1));
+                    indices.push_back(static_cast<Index>(v));
+                }
+            }
+        }
+
+        //! Returns the number of output polygons.
+        std::size_t NumPolygons() const
+        {
+            return output_.sources.size();
+        }
+
+        //! Returns the number of vertices of the specified output polygon.
+        std::size_t NumVertices(std::size_t polygon) const
+        {
+            return (output_.offsets[polygon + 1] - output_.offsets[polygon]);
+        }
+
+        //! Returns a pointer to the first vertex of the specified output polygon.
+        const Vector3T<T>* VerticesBegin(std::size_t polygon) const
+        {
+            return output_.vertices.data() + output_.offsets[polygon];
+        }
+
+        //! Returns a pointer after the last vertex of the specified output polygon.
+        const Vector3T<T>* VerticesEnd(std::size_t polygon) const
+        {
+            return output_.vertices.data() + output_.offsets[polygon + 1];
+        }
+
+        //! Returns the source index of the specified output polygon, i.e. the triangle index or the index passed to ClipPolygon.
+        std::uint32_t GetSource(std::size_t polygon) const
+        {
+            return output_.sources[polygon];
+        }
+
+        //! Returns the vertices of all output polygons.
+        const std::vector<Vector3T<T>>& GetVertices() const
+        {
+            return output_.vertices;
+        }
+
+    private:
+
+        std::size_t ClipAndAppend(const Vector3T<T>* vertices, std::size_t numVertices, std::uint32_t clipMask, std::uint32_t source, Details::ClippedPolygonArena<T>& output)
+        {
+            const Vector3T<T>* result = vertices;
+
+            if (clipMask != 0)
+                numVertices = Details::ClipConvexPolygon(vertices, numVertices, planes_.data(), clipMask, output.bufferA, output.bufferB, result);
+
+            if (numVertices > 0)
+                output.AddPolygon(result, numVertices, source);
+
+            return numVertices;
+        }
+
+        template <typename Index>
+        void ClipTriangleRange(const Vector3T<T>* vertices, const Index* indices, std::size_t begin, std::size_t end, Details::ClippedPolygonArena<T>& output)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const auto clipMask = clipMasks_[i];
+                if (clipMask == Details::TriangleClipClassifier<T, Index>::culledMask)
+                    continue;
+
+                const Vector3T<T> triangle[3] =
+                {
+                    vertices[static_cast<std::size_t>(indices[i*3    ])],
+                    vertices[static_cast<std::size_t>(indices[i*3 + 1])],
+                    vertices[static_cast<std::size_t>(indices[i*3 + 2])],
+                };
+
+                ClipAndAppend(triangle, 3, clipMask, static_cast<std::uint32_t>(i), output);
+            }
+        }
+
+        std::vector<Vector4T<T>>                        planes_;
+        Details::ClippedPolygonArena<T>                 output_;
+        std::vector<std::uint32_t>                      clipMasks_;
+        std::vector<Details::ClippedPolygonArena<T>>    chunkOutputs_;
+
+};
+
+
+/* --- Type Alias --- */
+
+using PolygonClipper    = PolygonClipperT<Real>;
+using PolygonClipperf   = PolygonClipperT<float>;
+using PolygonClipperd   = PolygonClipperT<double>;
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
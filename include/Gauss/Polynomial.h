@@ -0,0 +1,687 @@
+/*
+ * Polynomial.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_POLYNOMIAL_H
+#define GS_POLYNOMIAL_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/Parallel.h>
+#include <Gauss/SIMDPacket.h>
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+
+namespace Gs
+{
+
+
+/*
+Root solvers for quadratic, cubic, and quartic polynomials with real coefficients.
+The coefficients are always specified from the highest to the lowest degree, e.g. (a, b, c) for a*x^2 + b*x + c = 0.
+All solvers return the number of real roots and write them in ascending order, where roots of higher multiplicity are written multiple times.
+The remaining elements of the root arrays are set to +infinity, so that for instance the first root greater than a ray parameter can be searched without the root count.
+*/
+
+namespace Details
+{
+
+
+/*
+The solvers are written once for packets (see "ForEachPacket"), i.e. all branches are evaluated and the results are selected per element.
+The leading coefficient must not be zero here, which is handled by the public functions.
+*/
+
+template <typename P>
+P PacketInfinity()
+{
+    return P(std::numeric_limits<typename PacketTraits<P>::ScalarType>::infinity());
+}
+
+template <typename P>
+void PacketSortMinMax(P& a, P& b)
+{
+    const P t = a;
+    a = PacketMin(t, b);
+    b = PacketMax(t, b);
+}
+
+// Horner scheme of the monic polynomial x^N + c[0]*x^(N-1) + ... + c[N-1] and its derivative.
+template <typename P, std::size_t N>
+void EvalMonicPolynomial(const P (&c)[N], const P& x, P& f, P& df)
+{
+    f   = x + c[0];
+    df  = P(typename PacketTraits<P>::ScalarType(1));
+    for (std::size_t i = 1; i < N; ++i)
+    {
+        df  = PacketMulAdd(df, x, f);
+        f   = PacketMulAdd(f, x, c[i]);
+    }
+}
+
+// Horner scheme of the monic polynomial, its derivative, and half of its second derivative.
+template <typename P, std::size_t N>
+void EvalMonicPolynomial(const P (&c)[N], const P& x, P& f, P& df, P& halfDdf)
+{
+    f       = x + c[0];
+    df      = P(typename PacketTraits<P>::ScalarType(1));
+    halfDdf = P(typename PacketTraits<P>::ScalarType(0));
+    for (std::size_t i = 1; i < N; ++i)
+    {
+        halfDdf = PacketMulAdd(halfDdf, x, df);
+        df      = PacketMulAdd(df, x, f);
+        f       = PacketMulAdd(f, x, c[i]);
+    }
+}
+
+// Polishes the root 'x' with one Newton-Raphson iteration, which is only accepted if it reduces the residual (e.g. not for flat double roots).
+template <typename P, std::size_t N>
+P PolishMonicRoot(const P (&c)[N], const P& x)
+{
+    P f, df, fn, dfn;
+    EvalMonicPolynomial(c, x, f, df);
+
+    const P xn = x - f / df;
+    EvalMonicPolynomial(c, xn, fn, dfn);
+
+    return PacketSelectPositive(PacketAbs(f) - PacketAbs(fn), xn, x);
+}
+
+/*
+Refines the pair of close roots 'x0' <= 'x1' (e.g. a double root) at the critical point 'xc' of the polynomial between them,
+which Newton-Raphson finds with quadratic convergence, in contrast to the roots of higher multiplicity themselves.
+The roots are xc -/+ sqrt(d) with d = -f(xc)/(f''(xc)/2), and a negative 'd' (which is returned) means that the pair is complex.
+Both roots are then polished with two Newton-Raphson iterations, but only as long as they stay on their side of the critical point.
+*/
+template <typename P, std::size_t N>
+P RefineMonicRootPair(const P (&c)[N], P& x0, P& x1)
+{
+    using T = typename PacketTraits<P>::ScalarType;
+
+    P f, df, halfDdf;
+    P xc = (x0 + x1) * P(T(0.5));
+
+    for (int i = 0; i < 2; ++i)
+    {
+        EvalMonicPolynomial(c, xc, f, df, halfDdf);
+        xc = xc - df / (P(T(2)) * halfDdf);
+    }
+
+    EvalMonicPolynomial(c, xc, f, df, halfDdf);
+
+    const P d = -f / halfDdf;
+    const P h = PacketSqrt(PacketMax(d, P(T(0))));
+
+    x0 = xc - h;
+    x1 = xc + h;
+
+    for (int i = 0; i < 2; ++i)
+    {
+        const P p0 = PolishMonicRoot(c, x0);
+        const P p1 = PolishMonicRoot(c, x1);
+        x0 = PacketSelectPositive(xc - p0, p0, x0);
+        x1 = PacketSelectPositive(p1 - xc, p1, x1);
+    }
+
+    return d;
+}
+
+/*
+Solves a*x^2 + b*x + c = 0 with the cancellation-free form q = -(b + sign(b)*sqrt(b^2 - 4ac))/2, x0 = q/a, x1 = c/q.
+Returns the number of roots (0 or 2) as packet. Discriminants down to '-discTolerance' are treated as zero, i.e. as double root.
+*/
+template <typename P>
+P SolveQuadraticPacket(const P& a, const P& b, const P& c, P* roots, const P& discTolerance)
+{
+    using T = typename PacketTraits<P>::ScalarType;
+
+    const P zero    = T(0);
+    const P disc    = PacketMulAdd(b, b, -(P(T(4)) * a * c));
+    const P s       = PacketSqrt(PacketMax(disc, zero));
+    const P q       = P(T(-0.5)) * (b + PacketSelectPositive(b, s, -s));
+
+    P x0 = q / a;
+    P x1 = PacketSelectPositive(PacketAbs(q), c / q, zero);
+    PacketSortMinMax(x0, x1);
+
+    /* Negative discriminant: no real roots */
+    const P negDisc = -(disc + discTolerance);
+
+    roots[0] = PacketSelectPositive(negDisc, PacketInfinity<P>(), x0);
+    roots[1] = PacketSelectPositive(negDisc, PacketInfinity<P>(), x1);
+
+    return PacketSelectPositive(negDisc, zero, P(T(2)));
+}
+
+template <typename P>
+P SolveQuadraticPacket(const P& a, const P& b, const P& c, P* roots)
+{
+    return SolveQuadraticPacket(a, b, c, roots, P(typename PacketTraits<P>::ScalarType(0)));
+}
+
+/*
+Solves the monic cubic x^3 + c[0]*x^2 + c[1]*x + c[2] = 0 with the trigonometric method for three real roots and Cardano's formula otherwise.
+All three roots are written (in ascending order) and the single real root is replicated, if the returned discriminant is positive.
+*/
+template <typename P>
+P SolveMonicCubicPacket(const P (&c)[3], P* roots)
+{
+    using T = typename PacketTraits<P>::ScalarType;
+
+    const P zero    = T(0);
+    const P a3      = c[0] * P(T(1)/T(3));
+    const P q       = (c[0]*c[0] - P(T(3))*c[1]) * P(T(1)/T(9));
+    const P r       = (c[0]*(P(T(2))*c[0]*c[0] - P(T(9))*c[1]) + P(T(27))*c[2]) * P(T(1)/T(54));
+    const P q3      = q*q*q;
+    const P disc    = r*r - q3;
+
+    /* Three real roots: x_k = -2*sqrt(q)*cos((theta + 2*pi*k)/3) - a/3 with theta = acos(r/sqrt(q^3)) */
+    const P sqrtQ   = PacketSqrt(PacketMax(q, zero));
+    const P cosArg  = PacketMax(P(T(-1)), PacketMin(r / PacketMax(sqrtQ*sqrtQ*sqrtQ, P(std::numeric_limits<T>::min())), P(T(1))));
+
+    P sn, cs;
+    PacketSinCos(PacketAcos(cosArg) * P(T(1)/T(3)), sn, cs);
+
+    const P m       = P(T(-2)) * sqrtQ;
+    const P csHalf  = P(T(-0.5)) * cs;
+    const P snRoot3 = P(T(0.86602540378443864676)) * sn;
+
+    const P t0      = m * cs - a3;
+    const P t1      = m * (csHalf + snRoot3) - a3;
+    const P t2      = m * (csHalf - snRoot3) - a3;
+
+    /* One real root: x = A + q/A - a/3 with A = -sign(r)*cbrt(|r| + sqrt(r^2 - q^3)) */
+    const P s       = PacketCbrt(PacketAbs(r) + PacketSqrt(PacketMax(disc, zero)));
+    const P sa      = PacketSelectPositive(r, -s, s);
+    const P u       = sa + PacketSelectPositive(s, q / sa, zero) - a3;
+
+    roots[0] = PolishMonicRoot(c, PacketSelectPositive(disc, u, t0));
+    roots[1] = PolishMonicRoot(c, PacketSelectPositive(disc, u, t1));
+    roots[2] = PolishMonicRoot(c, PacketSelectPositive(disc, u, t2));
+
+    PacketSortMinMax(roots[0], roots[1]);
+    PacketSortMinMax(roots[1], roots[2]);
+    PacketSortMinMax(roots[0], roots[1]);
+
+    return disc;
+}
+
+// Solves a*x^3 + b*x^2 + c*x + d = 0 and returns the number of roots (1 or 3) as packet.
+template <typename P>
+P SolveCubicPacket(const P& a, const P& b, const P& c, const P& d, P* roots)
+{
+    using T = typename PacketTraits<P>::ScalarType;
+
+    const P inv = P(T(1)) / a;
+    const P coeffs[3] = { b * inv, c * inv, d * inv };
+
+    const P disc = SolveMonicCubicPacket(coeffs, roots);
+
+    roots[1] = PacketSelectPositive(disc, PacketInfinity<P>(), roots[1]);
+    roots[2] = PacketSelectPositive(disc, PacketInfinity<P>(), roots[2]);
+
+    return PacketSelectPositive(disc, P(T(1)), P(T(3)));
+}
+
+// Sorting network for four elements (infinite elements of missing roots are moved to the end).
+template <typename P>
+void SortQuarticRoots(P* roots)
+{
+    PacketSortMinMax(roots[0], roots[1]);
+    PacketSortMinMax(roots[2], roots[3]);
+    PacketSortMinMax(roots[0], roots[2]);
+    PacketSortMinMax(roots[1], roots[3]);
+    PacketSortMinMax(roots[1], roots[2]);
+}
+
+/*
+Refines the adjacent roots 'x0' and 'x1' of the monic quartic as pair (see "RefineMonicRootPair") where 'close' is positive,
+and keeps the refinement only if it stays within 'maxGap' of the original pair or reduces the residuals. Complex pairs are replaced by +infinity and subtracted from 'n'.
+*/
+template <typename P>
+void RefineQuarticRootPair(const P (&c)[4], P& x0, P& x1, const P& close, const P& maxGap, P& n)
+{
+    using T = typename PacketTraits<P>::ScalarType;
+
+    P y0 = x0, y1 = x1;
+    const P d = RefineMonicRootPair(c, y0, y1);
+
+    /* Residuals of the original and the refined pair */
+    P f0, f1, g0, g1, df;
+    EvalMonicPolynomial(c, x0, f0, df);
+    EvalMonicPolynomial(c, x1, f1, df);
+    EvalMonicPolynomial(c, y0, g0, df);
+    EvalMonicPolynomial(c, y1, g1, df);
+
+    const P inRange = PacketMin(y0 - (x0 - maxGap), (x1 + maxGap) - y1);
+    const P reduced = PacketMax(PacketAbs(f0), PacketAbs(f1)) - PacketMax(PacketAbs(g0), PacketAbs(g1));
+    const P refined = PacketSelectPositive(close, PacketSelectPositive(PacketMax(inRange, reduced), P(T(1)), P(T(-1))), P(T(-1)));
+
+    x0 = PacketSelectPositive(refined, PacketSelectPositive(-d, PacketInfinity<P>(), y0), x0);
+    x1 = PacketSelectPositive(refined, PacketSelectPositive(-d, PacketInfinity<P>(), y1), x1);
+    n  = n - PacketSelectPositive(refined, PacketSelectPositive(-d, P(T(2)), P(T(0))), P(T(0)));
+}
+
+/*
+Solves a*x^4 + b*x^3 + c*x^2 + d*x + e = 0 with Ferrari's method and returns the number of roots (0, 2, or 4) as packet:
+the depressed quartic y^4 + p*y^2 + q*y + r = 0 (with x = y - b/(4a)) is written as (y^2 + p/2 + m)^2 = (s*y - t)^2 with s = sqrt(2m),
+where 'm' is the largest root of the resolvent cubic m^3 + p*m^2 + (p^2/4 - r)*m - q^2/8 = 0, which splits the quartic into two quadratics.
+*/
+template <typename P>
+P SolveQuarticPacket(const P& a, const P& b, const P& c, const P& d, const P& e, P* roots)
+{
+    using T = typename PacketTraits<P>::ScalarType;
+
+    const P zero    = T(0);
+    const P inv     = P(T(1)) / a;
+    const P coeffs[4] = { b * inv, c * inv, d * inv, e * inv };
+
+    /* Depressed quartic */
+    const P a4      = coeffs[0] * P(T(0.25));
+    const P a4Sq    = a4 * a4;
+    const P p       = coeffs[1] - P(T(6)) * a4Sq;
+    const P q       = coeffs[2] - P(T(2)) * coeffs[1] * a4 + P(T(8)) * a4Sq * a4;
+    const P r       = coeffs[3] - coeffs[2] * a4 + coeffs[1] * a4Sq - P(T(3)) * a4Sq * a4Sq;
+
+    /* Largest root of the resolvent cubic, which is non-negative since the cubic is -q^2/8 at m = 0 */
+    const P halfP   = p * P(T(0.5));
+    const P resolvent[3] = { p, halfP * halfP - r, -(q * q) * P(T(0.125)) };
+
+    P m[3];
+    SolveMonicCubicPacket(resolvent, m);
+
+    const P mMax    = PacketMax(m[2], zero);
+    const P s       = PacketSqrt(P(T(2)) * mMax);
+
+    /*
+    t = q/(2s), which is equal to sign(q)*sqrt((m + p/2)^2 - r) due to the resolvent;
+    the latter form is used for small 's' (e.g. biquadratic equations with q = 0) where the division is unstable
+    */
+    const P tDiv    = q / (P(T(2)) * s);
+    const P tSqrt   = PacketSqrt(PacketMax((mMax + halfP) * (mMax + halfP) - r, zero));
+    const P tSmall  = PacketSelectPositive(q, tSqrt, PacketSelectPositive(-q, -tSqrt, zero));
+    const P sLimit  = P(std::sqrt(std::numeric_limits<T>::epsilon())) * (PacketAbs(p) + PacketSqrt(PacketAbs(r)));
+    const P t       = PacketSelectPositive(s - sLimit, tDiv, tSmall);
+
+    const P one     = T(1);
+    const P z       = halfP + mMax;
+
+    /* Quadratic factors whose discriminant is only slightly negative may have a double root, which is decided when the pair is refined */
+    const P sqrtEps = P(std::sqrt(std::numeric_limits<T>::epsilon()));
+    const P discTol = sqrtEps * (s * s + P(T(4)) * (PacketAbs(z) + PacketAbs(t)));
+
+    const P n0      = SolveQuadraticPacket(one, -s, z + t, roots, discTol);
+    const P n1      = SolveQuadraticPacket(one, s, z - t, roots + 2, discTol);
+
+    /* Undo the substitution */
+    for (std::size_t i = 0; i < 4; ++i)
+        roots[i] = PacketSelectPositive((i < 2 ? n0 : n1), roots[i] - a4, PacketInfinity<P>());
+
+    P n = n0 + n1;
+
+    const P scale   = PacketSelectPositive(n0, PacketAbs(roots[0]) + PacketAbs(roots[1]), zero) + PacketSelectPositive(n1, PacketAbs(roots[2]) + PacketAbs(roots[3]), zero);
+    const P maxGap  = P(T(8)) * sqrtEps * scale;
+    const P no      = T(-1);
+
+    /*
+    Polish the roots on the original quartic, but keep the roots where Newton-Raphson moves farther than 'maxGap',
+    e.g. the centers of complex pairs with a tiny imaginary part or a root that Ferrari's method paired wrongly with a double root
+    */
+    P diverged[4], numDiverged = zero;
+    const P factorGaps[2] = { roots[1] - roots[0], roots[3] - roots[2] };
+
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        const P x = PolishMonicRoot(coeffs, PolishMonicRoot(coeffs, roots[i]));
+        diverged[i] = PacketSelectPositive((i < 2 ? n0 : n1), PacketAbs(x - roots[i]) - maxGap, no);
+        roots[i] = PacketSelectPositive(diverged[i], roots[i], x);
+        numDiverged = numDiverged + PacketSelectPositive(diverged[i], one, zero);
+    }
+
+    /*
+    A single diverged root of four real roots is replaced by the sum of all roots (-coeffs[0]) minus the other roots,
+    unless it belongs to a close pair of its quadratic factor (i.e. to a complex pair with a tiny imaginary part)
+    */
+    const P replace = PacketMin(n - P(T(3)), P(T(0.5)) - PacketAbs(numDiverged - one));
+
+    if (PacketSignMask(PacketSelectPositive(replace, no, one)) != 0)
+    {
+        const P sum = roots[0] + roots[1] + roots[2] + roots[3];
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            const P x = PolishMonicRoot(coeffs, PolishMonicRoot(coeffs, roots[i] - coeffs[0] - sum));
+            roots[i] = PacketSelectPositive(PacketMin(replace, PacketMin(diverged[i], factorGaps[i/2] - maxGap)), x, roots[i]);
+        }
+    }
+
+    SortQuarticRoots(roots);
+
+    /*
+    Adjacent roots closer than 'maxGap' (i.e. clusters and double roots, which Ferrari's method only determines with about half the precision)
+    are refined as pair, which also determines whether a pair from a slightly negative discriminant is real or complex.
+    The gaps are reduced by the Newton-Raphson steps of their roots, since Ferrari's method may also split a double root by more than 'maxGap'.
+    Each root is refined in at most one pair per pass (the middle pair takes precedence if it is the closest), and the second pass
+    handles clusters of three roots for which the first pass paired the wrong roots.
+    */
+    const P halfMaxGap = maxGap * P(T(0.5));
+    bool refined = false;
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        P steps[4];
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            P f, df;
+            EvalMonicPolynomial(coeffs, roots[i], f, df);
+
+            /* Twice the Newton-Raphson step, clamped to 'maxGap'/2 (this also avoids the division by zero at exact double roots) */
+            const P twoF    = P(T(2)) * PacketAbs(f);
+            const P absDf   = PacketAbs(df);
+            steps[i] = PacketSelectPositive(halfMaxGap * absDf - twoF, twoF / absDf, halfMaxGap);
+        }
+
+        const P gap01   = roots[1] - roots[0] - (steps[0] + steps[1]);
+        const P gap12   = roots[2] - roots[1] - (steps[1] + steps[2]);
+        const P gap23   = roots[3] - roots[2] - (steps[2] + steps[3]);
+        const P close12 = PacketSelectPositive(PacketMin(gap01 - gap12, gap23 - gap12), maxGap - gap12, no);
+        const P close01 = PacketSelectPositive(close12, no, maxGap - gap01);
+        const P close23 = PacketSelectPositive(close12, no, maxGap - gap23);
+
+        /* Skip the refinement if no pair is close in any element */
+        if (PacketSignMask(PacketSelectPositive(PacketMax(close01, PacketMax(close12, close23)), no, one)) == 0)
+            break;
+
+        refined = true;
+
+        RefineQuarticRootPair(coeffs, roots[0], roots[1], close01, maxGap, n);
+        RefineQuarticRootPair(coeffs, roots[1], roots[2], close12, maxGap, n);
+        RefineQuarticRootPair(coeffs, roots[2], roots[3], close23, maxGap, n);
+
+        /* Sort again, since complex pairs are moved to the end */
+        SortQuarticRoots(roots);
+    }
+
+    /* Polish again, since Newton-Raphson converges slowly for simple roots next to a cluster */
+    if (refined)
+    {
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            const P x = PolishMonicRoot(coeffs, PolishMonicRoot(coeffs, roots[i]));
+            roots[i] = PacketSelectPositive(maxGap - PacketAbs(x - roots[i]), x, roots[i]);
+        }
+        SortQuarticRoots(roots);
+    }
+
+    return n;
+}
+
+
+} // /namespace Details
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Solves the linear equation a*x + b = 0.
+\param[out] roots Array for the root. This is +infinity if there is none.
+\return Number of real roots, i.e. 1 if 'a' is non-zero and 0 otherwise.
+*/
+template <typename T>
+std::size_t SolveLinear(const T& a, const T& b, T roots[1])
+{
+    if (a != T(0))
+    {
+        roots[0] = -b / a;
+        return 1;
+    }
+    roots[0] = std::numeric_limits<T>::infinity();
+    return 0;
+}
+
+/**
+\brief Solves the quadratic equation a*x^2 + b*x + c = 0.
+\param[out] roots Array for the two roots in ascending order. Missing roots are +infinity.
+\return Number of real roots (a double root counts twice). If 'a' is zero, the linear equation is solved.
+\remarks The roots are computed with the cancellation-free form of the quadratic formula, i.e. x0 = q/a and x1 = c/q.
+*/
+template <typename T>
+std::size_t SolveQuadratic(const T& a, const T& b, const T& c, T roots[2])
+{
+    if (a == T(0))
+    {
+        roots[1] = std::numeric_limits<T>::infinity();
+        return SolveLinear(b, c, roots);
+    }
+    return static_cast<std::size_t>(Details::SolveQuadraticPacket(a, b, c, roots));
+}
+
+/**
+\brief Solves the cubic equation a*x^3 + b*x^2 + c*x + d = 0.
+\param[out] roots Array for the three roots in ascending order. Missing roots are +infinity.
+\return Number of real roots (1 or 3). If 'a' is zero, the quadratic equation is solved.
+\remarks The roots are computed in closed form (trigonometric method or Cardano's formula) and polished with one Newton-Raphson iteration.
+*/
+template <typename T>
+std::size_t SolveCubic(const T& a, const T& b, const T& c, const T& d, T roots[3])
+{
+    if (a == T(0))
+    {
+        roots[2] = std::numeric_limits<T>::infinity();
+        return SolveQuadratic(b, c, d, roots);
+    }
+    return static_cast<std::size_t>(Details::SolveCubicPacket(a, b, c, d, roots));
+}
+
+/**
+\brief Solves the quartic equation a*x^4 + b*x^3 + c*x^2 + d*x + e = 0.
+\param[out] roots Array for the four roots in ascending order. Missing roots are +infinity.
+\return Number of real roots (0, 2, or 4). If 'a' is zero, the cubic equation is solved.
+\remarks The roots are computed in closed form (Ferrari's method) and polished with Newton-Raphson iterations.
+Close roots and double roots are refined as pair at the critical point between them, so they are accurate to about the square root
+of the rounding error of the coefficients. A double root may then also be reported as complex pair, i.e. it is not counted.
+*/
+template <typename T>
+std::size_t SolveQuartic(const T& a, const T& b, const T& c, const T& d, const T& e, T roots[4])
+{
+    if (a == T(0))
+    {
+        roots[3] = std::numeric_limits<T>::infinity();
+        return SolveCubic(b, c, d, e, roots);
+    }
+    return static_cast<std::size_t>(Details::SolveQuarticPacket(a, b, c, d, e, roots));
+}
+
+
+namespace Details
+{
+
+
+template <typename T>
+std::size_t SolvePolynomial(const T* c, T* roots, std::integral_constant<std::size_t, 2>)
+{
+    return SolveQuadratic(c[0], c[1], c[2], roots);
+}
+
+template <typename T>
+std::size_t SolvePolynomial(const T* c, T* roots, std::integral_constant<std::size_t, 3>)
+{
+    return SolveCubic(c[0], c[1], c[2], c[3], roots);
+}
+
+template <typename T>
+std::size_t SolvePolynomial(const T* c, T* roots, std::integral_constant<std::size_t, 4>)
+{
+    return SolveQuartic(c[0], c[1], c[2], c[3], c[4], roots);
+}
+
+template <typename P>
+P SolvePolynomialPacket(const P* c, P* roots, std::integral_constant<std::size_t, 2>)
+{
+    return SolveQuadraticPacket(c[0], c[1], c[2], roots);
+}
+
+template <typename P>
+P SolvePolynomialPacket(const P* c, P* roots, std::integral_constant<std::size_t, 3>)
+{
+    return SolveCubicPacket(c[0], c[1], c[2], c[3], roots);
+}
+
+template <typename P>
+P SolvePolynomialPacket(const P* c, P* roots, std::integral_constant<std::size_t, 4>)
+{
+    return SolveQuarticPacket(c[0], c[1], c[2], c[3], c[4], roots);
+}
+
+// Batch kernel for polynomials of the specified degree with the coefficients and roots in AoS layout.
+template <typename T, std::size_t Degree>
+class PolynomialRootsKernel
+{
+
+    public:
+
+        using DegreeTag = std::integral_constant<std::size_t, Degree>;
+
+        PolynomialRootsKernel(const T* coeffs, T* roots, std::size_t* numRoots) :
+            coeffs_   { coeffs   },
+            roots_    { roots    },
+            numRoots_ { numRoots }
+        {
+        }
+
+        template <typename P>
+        void Run(std::size_t i) const
+        {
+            using Traits = PacketTraits<P>;
+
+            const T* c = coeffs_ + i*(Degree + 1);
+
+            P coeffs[Degree + 1], roots[Degree];
+
+            for (std::size_t k = 0; k <= Degree; ++k)
+                coeffs[k] = Traits::LoadStrided(c + k, Degree + 1);
+
+            /* Polynomials of lower degree are solved one by one */
+            T leading[Traits::size];
+            Traits::Store(leading, coeffs[0]);
+
+            bool lowerDegree = false;
+            for (std::size_t j = 0; j < Traits::size; ++j)
+                lowerDegree = (lowerDegree || leading[j] == T(0));
+
+            if (lowerDegree)
+            {
+                for (std::size_t k = 0; k < Traits::size; ++k)
+                    RunScalar(i + k);
+                return;
+            }
+
+            const P n = SolvePolynomialPacket(coeffs, roots, DegreeTag());
+
+            for (std::size_t k = 0; k < Degree; ++k)
+                Traits::StoreStrided(roots_ + i*Degree + k, Degree, roots[k]);
+
+            if (numRoots_)
+            {
+                T counts[Traits::size];
+                Traits::Store(counts, n);
+                for (std::size_t j = 0; j < Traits::size; ++j)
+                    numRoots_[i + j] = static_cast<std::size_t>(counts[j]);
+            }
+        }
+
+    private:
+
+        void RunScalar(std::size_t i) const
+        {
+            const auto n = SolvePolynomial(coeffs_ + i*(Degree + 1), roots_ + i*Degree, DegreeTag());
+            if (numRoots_)
+                numRoots_[i] = n;
+        }
+
+        const T*        coeffs_;
+        T*              roots_;
+        std::size_t*    numRoots_;
+
+};
+
+template <std::size_t Degree, typename T>
+void SolvePolynomialArray(const T* coeffs, T* roots, std::size_t* numRoots, std::size_t count)
+{
+    if (count == 0)
+        return;
+
+    const PolynomialRootsKernel<T, Degree> kernel(coeffs, roots, numRoots);
+
+    ParallelFor(
+        count, 4096,
+        [&kernel](std::size_t begin, std::size_t end, std::size_t)
+        {
+            ForEachPacket<T>(begin, end, kernel);
+        }
+    );
+}
+
+
+} // /namespace Details
+
+
+/**
+\brief Solves all quadratic equations of the specified array.
+\param[in] coeffs Pointer to the coefficients (a, b, c) of each equation, i.e. 'count*3' elements.
+\param[out] roots Pointer to the roots (in ascending order) of each equation, i.e. 'count*2' elements. Missing roots are +infinity.
+\param[out] numRoots Optional pointer to the number of real roots of each equation, i.e. 'count' elements. This may also be null.
+\param[in] count Specifies the number of equations.
+\remarks Single precision equations are processed in SIMD packets (4 or 8 equations at once) with the same algorithm as "SolveQuadratic",
+and the range is distributed with "Details::ParallelFor".
+\see SolveQuadratic
+*/
+template <typename T>
+void SolveQuadraticArray(const T* coeffs, T* roots, std::size_t* numRoots, std::size_t count)
+{
+    Details::SolvePolynomialArray<2>(coeffs, roots, numRoots, count);
+}
+
+/**
+\brief Solves all cubic equations of the specified array.
+\param[in] coeffs Pointer to the coefficients (a, b, c, d) of each equation, i.e. 'count*4' elements.
+\param[out] roots Pointer to the roots of each equation, i.e. 'count*3' elements.
+\see SolveQuadraticArray
+\see SolveCubic
+*/
+template <typename T>
+void SolveCubicArray(const T* coeffs, T* roots, std::size_t* numRoots, std::size_t count)
+{
+    Details::SolvePolynomialArray<3>(coeffs, roots, numRoots, count);
+}
+
+/**
+\brief Solves all quartic equations of the specified array.
+\param[in] coeffs Pointer to the coefficients (a, b, c, d, e) of each equation, i.e. 'count*5' elements.
+\param[out] roots Pointer to the roots of each equation, i.e. 'count*4' elements.
+\see SolveQuadraticArray
+\see SolveQuartic
+*/
+template <typename T>
+void SolveQuarticArray(const T* coeffs, T* roots, std::size_t* numRoots, std::size_t count)
+{
+    Details::SolvePolynomialArray<4>(coeffs, roots, numRoots, count);
+}
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
@@ -117,15 +117,7 @@ class ProjectionMatrix4T
         {
         }
 
-        ProjectionMatrix4T(const ThisType& rhs) :
-            m00 { rhs.m00 },
-            m11 { rhs.m11 },
-            m22 { rhs.m22 },
-            m32 { rhs.m32 },
-            m23 { rhs.m23 },
-            m33 { rhs.m33 }
-        {
-        }
+        ProjectionMatrix4T(const ThisType&) = default;
 
         explicit ProjectionMatrix4T(UninitializeTag)
         {
@@ -171,16 +163,7 @@ class ProjectionMatrix4T
             return *this;
         }
 
-        ThisType& operator = (const ThisType& rhs)
-        {
-            m00 = rhs.m00;
-            m11 = rhs.m11;
-            m22 = rhs.m22;
-            m32 = rhs.m32;
-            m23 = rhs.m23;
-            m33 = rhs.m33;
-            return *this;
-        }
+        ThisType& operator = (const ThisType&) = default;
 
         Vector4T<T> Project(const Vector4T<T>& v)
         {
@@ -546,6 +529,25 @@ void ExtractClippingPlanes4x4(const M& m, T& nearPlane, T& farPlane, int flags =
     }
 }
 
+// Converts the sparse projection matrix into a 4x4 matrix (the sparse elements m23 and m32 are swapped for row vectors).
+template <typename T>
+void ProjectionToMatrix4(Matrix<T, 4, 4>& m, const ProjectionMatrix4T<T>& projection)
+{
+    #ifdef GS_ROW_VECTORS
+    const T m23 = projection.m32, m32 = projection.m23;
+    #else
+    const T m23 = projection.m23, m32 = projection.m32;
+    #endif
+
+    m.Reset();
+    m.At(0, 0) = projection.m00;
+    m.At(1, 1) = projection.m11;
+    m.At(2, 2) = projection.m22;
+    m.At(2, 3) = m23;
+    m.At(3, 2) = m32;
+    m.At(3, 3) = projection.m33;
+}
+
 } // /namespace Details
 
 template <typename T>
@@ -57,13 +57,7 @@ class QuaternionT
         QuaternionT() = default;
         #endif
 
-        QuaternionT(const QuaternionT<T>& rhs) :
-            x { rhs.x },
-            y { rhs.y },
-            z { rhs.z },
-            w { rhs.w }
-        {
-        }
+        QuaternionT(const QuaternionT<T>&) = default;
 
         QuaternionT(const T& x, const T& y, const T& z, const T& w) :
             x { x },
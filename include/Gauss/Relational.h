@@ -0,0 +1,568 @@
+/*
+ * Relational.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_RELATIONAL_H
+#define GS_RELATIONAL_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/SIMD.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+namespace Gs
+{
+
+
+namespace Details
+{
+
+
+/*
+Component-wise comparison operators. The SSE overloads follow the GLSL semantics for NaN:
+all comparisons are false if a component is NaN, except for "not equal" which is true.
+The overloads for '__m128i' compare signed 32-bit integers.
+*/
+
+struct LessThanOp
+{
+    template <typename T>
+    static bool Compare(const T& a, const T& b)
+    {
+        return (a < b);
+    }
+    #ifdef GS_SIMD_SSE2
+    static __m128 Compare(__m128 a, __m128 b)
+    {
+        return _mm_cmplt_ps(a, b);
+    }
+    static __m128i Compare(__m128i a, __m128i b)
+    {
+        return _mm_cmplt_epi32(a, b);
+    }
+    #endif
+};
+
+struct LessThanEqualOp
+{
+    template <typename T>
+    static bool Compare(const T& a, const T& b)
+    {
+        return (a <= b);
+    }
+    #ifdef GS_SIMD_SSE2
+    static __m128 Compare(__m128 a, __m128 b)
+    {
+        return _mm_cmple_ps(a, b);
+    }
+    static __m128i Compare(__m128i a, __m128i b)
+    {
+        return _mm_xor_si128(_mm_cmpgt_epi32(a, b), _mm_set1_epi32(-1));
+    }
+    #endif
+};
+
+struct GreaterThanOp
+{
+    template <typename T>
+    static bool Compare(const T& a, const T& b)
+    {
+        return (a > b);
+    }
+    #ifdef GS_SIMD_SSE2
+    static __m128 Compare(__m128 a, __m128 b)
+    {
+        return _mm_cmpgt_ps(a, b);
+    }
+    static __m128i Compare(__m128i a, __m128i b)
+    {
+        return _mm_cmpgt_epi32(a, b);
+    }
+    #endif
+};
+
+struct GreaterThanEqualOp
+{
+    template <typename T>
+    static bool Compare(const T& a, const T& b)
+    {
+        return (a >= b);
+    }
+    #ifdef GS_SIMD_SSE2
+    static __m128 Compare(__m128 a, __m128 b)
+    {
+        return _mm_cmpge_ps(a, b);
+    }
+    static __m128i Compare(__m128i a, __m128i b)
+    {
+        return _mm_xor_si128(_mm_cmplt_epi32(a, b), _mm_set1_epi32(-1));
+    }
+    #endif
+};
+
+struct EqualOp
+{
+    template <typename T>
+    static bool Compare(const T& a, const T& b)
+    {
+        return (a == b);
+    }
+    #ifdef GS_SIMD_SSE2
+    static __m128 Compare(__m128 a, __m128 b)
+    {
+        return _mm_cmpeq_ps(a, b);
+    }
+    static __m128i Compare(__m128i a, __m128i b)
+    {
+        return _mm_cmpeq_epi32(a, b);
+    }
+    #endif
+};
+
+struct NotEqualOp
+{
+    template <typename T>
+    static bool Compare(const T& a, const T& b)
+    {
+        return (a != b);
+    }
+    #ifdef GS_SIMD_SSE2
+    static __m128 Compare(__m128 a, __m128 b)
+    {
+        return _mm_cmpneq_ps(a, b);
+    }
+    static __m128i Compare(__m128i a, __m128i b)
+    {
+        return _mm_xor_si128(_mm_cmpeq_epi32(a, b), _mm_set1_epi32(-1));
+    }
+    #endif
+};
+
+// Computes 'r[i] = Op::Compare(a[i], b[i])' for all i in [0, N).
+template <typename Op, std::size_t N, typename T>
+void CompareComponents(const T* a, const T* b, bool* r)
+{
+    for (std::size_t i = 0; i < N; ++i)
+        r[i] = Op::Compare(a[i], b[i]);
+}
+
+// Computes 'r[i] = (m[i] ? a[i] : b[i])' for all i in [0, N).
+template <std::size_t N, typename T>
+void SelectComponents(const bool* m, const T* a, const T* b, T* r)
+{
+    for (std::size_t i = 0; i < N; ++i)
+        r[i] = (m[i] ? a[i] : b[i]);
+}
+
+#ifdef GS_SIMD_SSE2
+
+static_assert(sizeof(bool) == 1, "SSE relational functions require 1-byte bools");
+
+// Narrows the comparison masks of 4 floats each into eight bool bytes (0 or 1).
+inline __m128i PackBoolMask8(__m128 lo, __m128 hi)
+{
+    const __m128i w = _mm_packs_epi32(_mm_castps_si128(lo), _mm_castps_si128(hi));
+    return _mm_and_si128(_mm_packs_epi16(w, w), _mm_set1_epi8(1));
+}
+
+// Widens four bool bytes into a comparison mask of 4 floats.
+inline __m128 UnpackBoolMask4(const bool* m)
+{
+    int bytes;
+    std::memcpy(&bytes, m, 4);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i x = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero), zero);
+    return _mm_castsi128_ps(_mm_cmpgt_epi32(x, zero));
+}
+
+// Loads the components of a float vector into an SSE register (the 4th element is zero for 3D vectors).
+inline __m128 LoadComponents(const Vector<float, 3>& v)
+{
+    return _mm_setr_ps(v.x, v.y, v.z, 0.0f);
+}
+
+inline __m128 LoadComponents(const Vector<float, 4>& v)
+{
+    return _mm_loadu_ps(v.Ptr());
+}
+
+// Stores the first 3 or 4 elements of an SSE register into the components of a float vector.
+inline void StoreComponents(Vector<float, 3>& v, __m128 x)
+{
+    _mm_storel_pi(reinterpret_cast<__m64*>(v.Ptr()), x);
+    _mm_store_ss(v.Ptr() + 2, _mm_movehl_ps(x, x));
+}
+
+inline void StoreComponents(Vector<float, 4>& v, __m128 x)
+{
+    _mm_storeu_ps(v.Ptr(), x);
+}
+
+// Returns 'mask ? a : b' per element, where each element of 'mask' is either all zeros or all ones.
+inline __m128 BlendComponents(__m128 mask, __m128 a, __m128 b)
+{
+    #ifdef GS_SIMD_SSE4_1
+    return _mm_blendv_ps(b, a, mask);
+    #else
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    #endif
+}
+
+template <typename Op, std::size_t N>
+void CompareComponents(const float* a, const float* b, bool* r)
+{
+    std::size_t i = 0;
+
+    for (; i + 8 <= N; i += 8)
+    {
+        const __m128 lo = Op::Compare(_mm_loadu_ps(a + i    ), _mm_loadu_ps(b + i    ));
+        const __m128 hi = Op::Compare(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(r + i), PackBoolMask8(lo, hi));
+    }
+
+    for (; i + 4 <= N; i += 4)
+    {
+        const __m128 m = Op::Compare(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+        const int bytes = _mm_cvtsi128_si32(PackBoolMask8(m, m));
+        std::memcpy(r + i, &bytes, 4);
+    }
+
+    for (i = N - N % 4; i < N; ++i)
+        r[i] = Op::Compare(a[i], b[i]);
+}
+
+template <std::size_t N>
+void SelectComponents(const bool* m, const float* a, const float* b, float* r)
+{
+    std::size_t i = 0;
+
+    for (; i + 4 <= N; i += 4)
+    {
+        const __m128 mask = UnpackBoolMask4(m + i);
+        _mm_storeu_ps(r + i, BlendComponents(mask, _mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+
+    for (i = N - N % 4; i < N; ++i)
+        r[i] = (m[i] ? a[i] : b[i]);
+}
+
+/*
+Compares 32-bit integers with the signed SSE2 instructions. Unsigned integers are biased by 0x80000000,
+which maps them onto the signed range in the same order.
+*/
+template <typename Op, std::size_t N, typename T>
+void CompareComponentsInt32(const T* a, const T* b, bool* r, __m128i bias)
+{
+    std::size_t i = 0;
+
+    for (; i + 8 <= N; i += 8)
+    {
+        const __m128i a0 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i    )), bias);
+        const __m128i a1 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 4)), bias);
+        const __m128i b0 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i    )), bias);
+        const __m128i b1 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 4)), bias);
+        const __m128 lo = _mm_castsi128_ps(Op::Compare(a0, b0));
+        const __m128 hi = _mm_castsi128_ps(Op::Compare(a1, b1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(r + i), PackBoolMask8(lo, hi));
+    }
+
+    for (; i + 4 <= N; i += 4)
+    {
+        const __m128i va = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), bias);
+        const __m128i vb = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)), bias);
+        const __m128 m = _mm_castsi128_ps(Op::Compare(va, vb));
+        const int bytes = _mm_cvtsi128_si32(PackBoolMask8(m, m));
+        std::memcpy(r + i, &bytes, 4);
+    }
+
+    for (i = N - N % 4; i < N; ++i)
+        r[i] = Op::Compare(a[i], b[i]);
+}
+
+template <typename Op, std::size_t N>
+void CompareComponents(const std::int32_t* a, const std::int32_t* b, bool* r)
+{
+    CompareComponentsInt32<Op, N>(a, b, r, _mm_setzero_si128());
+}
+
+template <typename Op, std::size_t N>
+void CompareComponents(const std::uint32_t* a, const std::uint32_t* b, bool* r)
+{
+    CompareComponentsInt32<Op, N>(a, b, r, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+}
+
+#endif // /GS_SIMD_SSE2
+
+// Returns true if any of the 'n' bools is true, without early exit.
+inline bool AnyComponent(const bool* m, std::size_t n)
+{
+    unsigned r = 0;
+    for (std::size_t i = 0; i < n; ++i)
+        r |= static_cast<unsigned>(m[i]);
+    return (r != 0);
+}
+
+// Returns true if all of the 'n' bools are true, without early exit.
+inline bool AllComponents(const bool* m, std::size_t n)
+{
+    unsigned r = 1;
+    for (std::size_t i = 0; i < n; ++i)
+        r &= static_cast<unsigned>(m[i]);
+    return (r != 0);
+}
+
+
+} // /namespace Details
+
+
+#ifdef GS_SIMD_SSE2
+
+/**
+\brief Result of a component-wise comparison of float vectors with 3 or 4 components, which keeps the comparison mask in an SSE register.
+\remarks This is returned by the relational functions for Vector3f and Vector4f, and converts implicitly to the boolean vector Vector<bool, N>.
+"Select", "Any", "All", and "Not" operate directly on the register, so branchless code such as "Select(LessThan(a, b), a, b)" never stores the mask as bools.
+*/
+template <std::size_t N>
+class VectorMaskf
+{
+
+    public:
+
+        static_assert(N == 3 || N == 4, "float vector masks can only have 3 or 4 components");
+
+        //! Specifies the number of vector components.
+        static const std::size_t components = N;
+
+        explicit VectorMaskf(__m128 mask) :
+            mask_ { mask }
+        {
+        }
+
+        //! Converts this mask into a boolean vector.
+        operator Vector<bool, N> () const
+        {
+            const int bits = _mm_movemask_ps(mask_);
+            Vector<bool, N> result { UninitializeTag{} };
+            for (std::size_t i = 0; i < N; ++i)
+                result[i] = (((bits >> i) & 1) != 0);
+            return result;
+        }
+
+        //! Returns the specified mask component.
+        bool operator [] (std::size_t component) const
+        {
+            return (((_mm_movemask_ps(mask_) >> component) & 1) != 0);
+        }
+
+        //! Returns the bit mask of the N components, where the i-th bit is set if the i-th component is true.
+        unsigned Bits() const
+        {
+            return (static_cast<unsigned>(_mm_movemask_ps(mask_)) & ((1u << N) - 1u));
+        }
+
+        //! Returns the mask register, where each true component has all bits set.
+        __m128 Get() const
+        {
+            return mask_;
+        }
+
+    private:
+
+        __m128 mask_;
+
+};
+
+#endif // /GS_SIMD_SSE2
+
+
+/* --- Global Functions --- */
+
+/*
+Component-wise relational functions with the semantics of the GLSL/HLSL boolean vectors (e.g. "bvec3" or "bool4").
+In contrast to the "Equals" function and the comparison operators, these functions return one bool per component,
+which can be combined with "Any", "All", and "Not", or used as mask for "Select" to write shader-style code without branches.
+Vectors and matrices of floats and 32-bit integers are compared with SSE instructions, other types with scalar comparisons.
+*/
+
+#define GS_DECL_RELATIONAL_FUNC(NAME, OP)                                                                       \
+    template <typename T, std::size_t N>                                                                        \
+    Vector<bool, N> NAME(const Vector<T, N>& lhs, const Vector<T, N>& rhs)                                      \
+    {                                                                                                           \
+        Vector<bool, N> result { UninitializeTag{} };                                                           \
+        Details::CompareComponents<Details::OP, N>(lhs.Ptr(), rhs.Ptr(), result.Ptr());                         \
+        return result;                                                                                          \
+    }                                                                                                           \
+    template <typename T, std::size_t Rows, std::size_t Cols>                                                   \
+    Matrix<bool, Rows, Cols> NAME(const Matrix<T, Rows, Cols>& lhs, const Matrix<T, Rows, Cols>& rhs)           \
+    {                                                                                                           \
+        Matrix<bool, Rows, Cols> result { UninitializeTag{} };                                                  \
+        Details::CompareComponents<Details::OP, Rows*Cols>(lhs.Ptr(), rhs.Ptr(), result.Ptr());                 \
+        return result;                                                                                          \
+    }
+
+//! Returns the component-wise comparison (lhs < rhs).
+GS_DECL_RELATIONAL_FUNC( LessThan,         LessThanOp         )
+//! Returns the component-wise comparison (lhs <= rhs).
+GS_DECL_RELATIONAL_FUNC( LessThanEqual,    LessThanEqualOp    )
+//! Returns the component-wise comparison (lhs > rhs).
+GS_DECL_RELATIONAL_FUNC( GreaterThan,      GreaterThanOp      )
+//! Returns the component-wise comparison (lhs >= rhs).
+GS_DECL_RELATIONAL_FUNC( GreaterThanEqual, GreaterThanEqualOp )
+//! Returns the component-wise comparison (lhs == rhs) without epsilon. \see Equals
+GS_DECL_RELATIONAL_FUNC( Equal,            EqualOp            )
+//! Returns the component-wise comparison (lhs != rhs) without epsilon.
+GS_DECL_RELATIONAL_FUNC( NotEqual,         NotEqualOp         )
+
+#undef GS_DECL_RELATIONAL_FUNC
+
+#ifdef GS_SIMD_SSE2
+
+#define GS_DECL_RELATIONAL_MASK_FUNC(NAME, OP)                                                                  \
+    inline VectorMaskf<3> NAME(const Vector<float, 3>& lhs, const Vector<float, 3>& rhs)                        \
+    {                                                                                                           \
+        return VectorMaskf<3>(Details::OP::Compare(Details::LoadComponents(lhs), Details::LoadComponents(rhs))); \
+    }                                                                                                           \
+    inline VectorMaskf<4> NAME(const Vector<float, 4>& lhs, const Vector<float, 4>& rhs)                        \
+    {                                                                                                           \
+        return VectorMaskf<4>(Details::OP::Compare(Details::LoadComponents(lhs), Details::LoadComponents(rhs))); \
+    }
+
+GS_DECL_RELATIONAL_MASK_FUNC( LessThan,         LessThanOp         )
+GS_DECL_RELATIONAL_MASK_FUNC( LessThanEqual,    LessThanEqualOp    )
+GS_DECL_RELATIONAL_MASK_FUNC( GreaterThan,      GreaterThanOp      )
+GS_DECL_RELATIONAL_MASK_FUNC( GreaterThanEqual, GreaterThanEqualOp )
+GS_DECL_RELATIONAL_MASK_FUNC( Equal,            EqualOp            )
+GS_DECL_RELATIONAL_MASK_FUNC( NotEqual,         NotEqualOp         )
+
+#undef GS_DECL_RELATIONAL_MASK_FUNC
+
+//! Returns true if any component of the float vector mask is true.
+template <std::size_t N>
+bool Any(const VectorMaskf<N>& mask)
+{
+    return (mask.Bits() != 0);
+}
+
+//! Returns true if all components of the float vector mask are true.
+template <std::size_t N>
+bool All(const VectorMaskf<N>& mask)
+{
+    return (mask.Bits() == (1u << N) - 1u);
+}
+
+//! Returns the component-wise logical complement of the float vector mask.
+template <std::size_t N>
+VectorMaskf<N> Not(const VectorMaskf<N>& mask)
+{
+    return VectorMaskf<N>(_mm_xor_ps(mask.Get(), _mm_castsi128_ps(_mm_set1_epi32(-1))));
+}
+
+#endif // /GS_SIMD_SSE2
+
+//! Returns true if any component of the boolean vector is true.
+template <std::size_t N>
+bool Any(const Vector<bool, N>& vec)
+{
+    return Details::AnyComponent(vec.Ptr(), N);
+}
+
+//! Returns true if any element of the boolean matrix is true.
+template <std::size_t Rows, std::size_t Cols>
+bool Any(const Matrix<bool, Rows, Cols>& mat)
+{
+    return Details::AnyComponent(mat.Ptr(), Rows*Cols);
+}
+
+//! Returns true if all components of the boolean vector are true.
+template <std::size_t N>
+bool All(const Vector<bool, N>& vec)
+{
+    return Details::AllComponents(vec.Ptr(), N);
+}
+
+//! Returns true if all elements of the boolean matrix are true.
+template <std::size_t Rows, std::size_t Cols>
+bool All(const Matrix<bool, Rows, Cols>& mat)
+{
+    return Details::AllComponents(mat.Ptr(), Rows*Cols);
+}
+
+//! Returns the component-wise logical complement of the boolean vector.
+template <std::size_t N>
+Vector<bool, N> Not(const Vector<bool, N>& vec)
+{
+    Vector<bool, N> result { UninitializeTag{} };
+    for (std::size_t i = 0; i < N; ++i)
+        result[i] = !vec[i];
+    return result;
+}
+
+//! Returns the element-wise logical complement of the boolean matrix.
+template <std::size_t Rows, std::size_t Cols>
+Matrix<bool, Rows, Cols> Not(const Matrix<bool, Rows, Cols>& mat)
+{
+    Matrix<bool, Rows, Cols> result { UninitializeTag{} };
+    for (std::size_t i = 0; i < Rows*Cols; ++i)
+        result.Ptr()[i] = !mat.Ptr()[i];
+    return result;
+}
+
+/**
+\brief Selects the components of two vectors by a boolean mask.
+\return Vector where the i-th component is 'a[i]' if 'mask[i]' is true, otherwise 'b[i]'.
+\remarks For float vectors this is a blend of the SSE registers, i.e. there is no branch per component.
+The comparisons of Vector3f and Vector4f return a VectorMaskf, which is blended without the conversion into bools.
+\code
+// Branchless version of: if (x < 0) x = -x;
+x = Gs::Select(Gs::LessThan(x, Gs::Vector4f(0)), -x, x);
+\endcode
+*/
+template <typename T, std::size_t N>
+Vector<T, N> Select(const Vector<bool, N>& mask, const Vector<T, N>& a, const Vector<T, N>& b)
+{
+    Vector<T, N> result { UninitializeTag{} };
+    Details::SelectComponents<N>(mask.Ptr(), a.Ptr(), b.Ptr(), result.Ptr());
+    return result;
+}
+
+//! Selects the elements of two matrices by a boolean mask. \see Select(const Vector<bool, N>&, const Vector<T, N>&, const Vector<T, N>&)
+template <typename T, std::size_t Rows, std::size_t Cols>
+Matrix<T, Rows, Cols> Select(const Matrix<bool, Rows, Cols>& mask, const Matrix<T, Rows, Cols>& a, const Matrix<T, Rows, Cols>& b)
+{
+    Matrix<T, Rows, Cols> result { UninitializeTag{} };
+    Details::SelectComponents<Rows*Cols>(mask.Ptr(), a.Ptr(), b.Ptr(), result.Ptr());
+    return result;
+}
+
+
+#ifdef GS_SIMD_SSE2
+
+//! Selects the components of two float vectors by a float vector mask, which stays in the SSE register. \see VectorMaskf
+template <std::size_t N>
+Vector<float, N> Select(const VectorMaskf<N>& mask, const Vector<float, N>& a, const Vector<float, N>& b)
+{
+    Vector<float, N> result { UninitializeTag{} };
+    Details::StoreComponents(result, Details::BlendComponents(mask.Get(), Details::LoadComponents(a), Details::LoadComponents(b)));
+    return result;
+}
+
+#endif // /GS_SIMD_SSE2
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,471 @@
+/*
+ * RigidBody.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_RIGID_BODY_H
+#define GS_RIGID_BODY_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/Parallel.h>
+#include <Gauss/SIMDPacket.h>
+
+#include <cstddef>
+#include <vector>
+#include <limits>
+
+
+namespace Gs
+{
+
+
+//! Integration methods for the "IntegrateRigidBodies" function.
+enum class RigidBodyIntegration
+{
+    /**
+    \brief Symplectic (semi-implicit) Euler: velocities are integrated first, then positions and orientations with the new velocities.
+    \remarks The gyroscopic torque is ignored, i.e. the angular momentum is not conserved for bodies with non-uniform inertia.
+    */
+    SymplecticEuler,
+
+    /**
+    \brief Symplectic Euler with an implicit gyroscopic torque (one Newton iteration in body space).
+    \remarks This keeps fast spinning bodies with non-uniform inertia stable, at the cost of a 3x3 linear solve per body.
+    */
+    SemiImplicitGyroscopic,
+};
+
+
+/**
+\brief Array of rigid bodies in structure-of-arrays (SoA) layout.
+\tparam T Specifies the data type of the components. This should be float or double.
+\remarks Each vector quantity is stored as separate arrays for its components, e.g. the X coordinates of all positions are stored in 'position[0]'.
+The inverse inertia tensor is specified as diagonal in body space (the principal axes), and the world space inverse inertia tensor
+R * I^-1 * R^T is maintained for each body (6 unique elements of the symmetric matrix).
+Bodies with an inverse mass of zero are static and not affected by the gravity.
+\see IntegrateRigidBodies
+*/
+template <typename T>
+class RigidBodyArrayT
+{
+
+    public:
+
+        static_assert(std::is_floating_point<T>::value, "rigid body arrays can only be used with floating point types");
+
+        //! Specifies the typename of the scalar components.
+        using ScalarType = T;
+
+        /**
+        \brief Resizes the arrays to the specified number of bodies.
+        \remarks New bodies are static at the origin with identity orientation.
+        */
+        void Resize(std::size_t count)
+        {
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                position[i].resize(count, T(0));
+                linearVelocity[i].resize(count, T(0));
+                angularVelocity[i].resize(count, T(0));
+                force[i].resize(count, T(0));
+                torque[i].resize(count, T(0));
+                invInertia[i].resize(count, T(0));
+            }
+
+            for (std::size_t i = 0; i < 4; ++i)
+                orientation[i].resize(count, (i == 3 ? T(1) : T(0)));
+
+            for (std::size_t i = 0; i < 6; ++i)
+                invInertiaWorld[i].resize(count, T(0));
+
+            invMass.resize(count, T(0));
+        }
+
+        //! Returns the number of bodies.
+        std::size_t Size() const
+        {
+            return invMass.size();
+        }
+
+        void SetPosition(std::size_t body, const Vector3T<T>& v)
+        {
+            Scatter(position, body, v);
+        }
+
+        Vector3T<T> GetPosition(std::size_t body) const
+        {
+            return Gather(position, body);
+        }
+
+        void SetLinearVelocity(std::size_t body, const Vector3T<T>& v)
+        {
+            Scatter(linearVelocity, body, v);
+        }
+
+        Vector3T<T> GetLinearVelocity(std::size_t body) const
+        {
+            return Gather(linearVelocity, body);
+        }
+
+        //! Sets the angular velocity (in world space) of the specified body.
+        void SetAngularVelocity(std::size_t body, const Vector3T<T>& v)
+        {
+            Scatter(angularVelocity, body, v);
+        }
+
+        Vector3T<T> GetAngularVelocity(std::size_t body) const
+        {
+            return Gather(angularVelocity, body);
+        }
+
+        //! Sets the orientation of the specified body and updates its world space inverse inertia tensor.
+        void SetOrientation(std::size_t body, const QuaternionT<T>& q)
+        {
+            orientation[0][body] = q.x;
+            orientation[1][body] = q.y;
+            orientation[2][body] = q.z;
+            orientation[3][body] = q.w;
+            UpdateInertiaWorld(body);
+        }
+
+        QuaternionT<T> GetOrientation(std::size_t body) const
+        {
+            return QuaternionT<T>(orientation[0][body], orientation[1][body], orientation[2][body], orientation[3][body]);
+        }
+
+        /**
+        \brief Sets the mass properties of the specified body.
+        \param[in] body Specifies the body index.
+        \param[in] inverseMass Specifies the inverse mass. Zero for static bodies.
+        \param[in] inverseInertia Specifies the diagonal of the inverse inertia tensor in body space.
+        */
+        void SetInverseMass(std::size_t body, const T& inverseMass, const Vector3T<T>& inverseInertia)
+        {
+            invMass[body] = inverseMass;
+            Scatter(invInertia, body, inverseInertia);
+            UpdateInertiaWorld(body);
+        }
+
+        //! Returns the world space inverse inertia tensor of the specified body.
+        Matrix3T<T> GetInverseInertiaWorld(std::size_t body) const
+        {
+            Matrix3T<T> m { UninitializeTag{} };
+            m(0, 0) = invInertiaWorld[0][body];
+            m(0, 1) = invInertiaWorld[1][body];
+            m(0, 2) = invInertiaWorld[2][body];
+            m(1, 0) = invInertiaWorld[1][body];
+            m(1, 1) = invInertiaWorld[3][body];
+            m(1, 2) = invInertiaWorld[4][body];
+            m(2, 0) = invInertiaWorld[2][body];
+            m(2, 1) = invInertiaWorld[4][body];
+            m(2, 2) = invInertiaWorld[5][body];
+            return m;
+        }
+
+        //! Adds the specified force (in world space) to the force accumulator of the specified body.
+        void ApplyForce(std::size_t body, const Vector3T<T>& f)
+        {
+            for (std::size_t i = 0; i < 3; ++i)
+                force[i][body] += f[i];
+        }
+
+        //! Adds the specified torque (in world space) to the torque accumulator of the specified body.
+        void ApplyTorque(std::size_t body, const Vector3T<T>& t)
+        {
+            for (std::size_t i = 0; i < 3; ++i)
+                torque[i][body] += t[i];
+        }
+
+        //! Resets the force and torque accumulators of all bodies.
+        void ClearForces()
+        {
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                std::fill(force[i].begin(), force[i].end(), T(0));
+                std::fill(torque[i].begin(), torque[i].end(), T(0));
+            }
+        }
+
+        //! Updates the world space inverse inertia tensor of the specified body from its orientation.
+        void UpdateInertiaWorld(std::size_t body)
+        {
+            const auto r = GetOrientation(body).ToMatrix3();
+            for (std::size_t i = 0, k = 0; i < 3; ++i)
+            {
+                for (std::size_t j = i; j < 3; ++j, ++k)
+                {
+                    invInertiaWorld[k][body] =
+                    (
+                        r.At(i, 0) * invInertia[0][body] * r.At(j, 0) +
+                        r.At(i, 1) * invInertia[1][body] * r.At(j, 1) +
+                        r.At(i, 2) * invInertia[2][body] * r.At(j, 2)
+                    );
+                }
+            }
+        }
+
+        std::vector<T> position[3];         //!< Positions (X, Y, Z).
+        std::vector<T> linearVelocity[3];   //!< Linear velocities (X, Y, Z).
+        std::vector<T> angularVelocity[3];  //!< Angular velocities in world space (X, Y, Z).
+        std::vector<T> orientation[4];      //!< Orientations as unit quaternions (X, Y, Z, W).
+        std::vector<T> force[3];            //!< Force accumulators in world space (X, Y, Z).
+        std::vector<T> torque[3];           //!< Torque accumulators in world space (X, Y, Z).
+        std::vector<T> invMass;             //!< Inverse masses.
+        std::vector<T> invInertia[3];       //!< Diagonals of the inverse inertia tensors in body space.
+        std::vector<T> invInertiaWorld[6];  //!< Inverse inertia tensors in world space (XX, XY, XZ, YY, YZ, ZZ).
+
+    private:
+
+        static void Scatter(std::vector<T>* streams, std::size_t body, const Vector3T<T>& v)
+        {
+            streams[0][body] = v.x;
+            streams[1][body] = v.y;
+            streams[2][body] = v.z;
+        }
+
+        static Vector3T<T> Gather(const std::vector<T>* streams, std::size_t body)
+        {
+            return Vector3T<T>(streams[0][body], streams[1][body], streams[2][body]);
+        }
+
+};
+
+
+namespace Details
+{
+
+
+// Fused integration kernel for packets of rigid bodies.
+template <typename T>
+class RigidBodyKernel
+{
+
+    public:
+
+        RigidBodyKernel(RigidBodyArrayT<T>& bodies, const T& dt, const Vector3T<T>& gravity, bool gyroscopic) :
+            bodies_     { bodies     },
+            dt_         { dt         },
+            gravity_    { gravity    },
+            gyroscopic_ { gyroscopic }
+        {
+        }
+
+        template <typename P>
+        void Run(std::size_t i) const
+        {
+            using Traits = PacketTraits<P>;
+
+            auto& b = bodies_;
+            const P h = P(dt_);
+
+            /* Load state */
+            P vx = Traits::Load(&b.linearVelocity[0][i]), vy = Traits::Load(&b.linearVelocity[1][i]), vz = Traits::Load(&b.linearVelocity[2][i]);
+            P wx = Traits::Load(&b.angularVelocity[0][i]), wy = Traits::Load(&b.angularVelocity[1][i]), wz = Traits::Load(&b.angularVelocity[2][i]);
+            P qx = Traits::Load(&b.orientation[0][i]), qy = Traits::Load(&b.orientation[1][i]), qz = Traits::Load(&b.orientation[2][i]), qw = Traits::Load(&b.orientation[3][i]);
+
+            const P invMass = Traits::Load(&b.invMass[i]);
+            const P ia = Traits::Load(&b.invInertia[0][i]), ib = Traits::Load(&b.invInertia[1][i]), ic = Traits::Load(&b.invInertia[2][i]);
+
+            /* Integrate linear velocity: v += (g + F/m) * dt, static bodies are not affected by gravity */
+            const P zero = P(T(0));
+            vx = PacketMulAdd(PacketSelectPositive(invMass, P(gravity_.x), zero) + Traits::Load(&b.force[0][i]) * invMass, h, vx);
+            vy = PacketMulAdd(PacketSelectPositive(invMass, P(gravity_.y), zero) + Traits::Load(&b.force[1][i]) * invMass, h, vy);
+            vz = PacketMulAdd(PacketSelectPositive(invMass, P(gravity_.z), zero) + Traits::Load(&b.force[2][i]) * invMass, h, vz);
+
+            /* Integrate angular velocity: w += I_world^-1 * torque * dt */
+            {
+                const P i00 = Traits::Load(&b.invInertiaWorld[0][i]), i01 = Traits::Load(&b.invInertiaWorld[1][i]), i02 = Traits::Load(&b.invInertiaWorld[2][i]);
+                const P i11 = Traits::Load(&b.invInertiaWorld[3][i]), i12 = Traits::Load(&b.invInertiaWorld[4][i]), i22 = Traits::Load(&b.invInertiaWorld[5][i]);
+                const P tx = Traits::Load(&b.torque[0][i]), ty = Traits::Load(&b.torque[1][i]), tz = Traits::Load(&b.torque[2][i]);
+                wx = PacketMulAdd(i00*tx + i01*ty + i02*tz, h, wx);
+                wy = PacketMulAdd(i01*tx + i11*ty + i12*tz, h, wy);
+                wz = PacketMulAdd(i02*tx + i12*ty + i22*tz, h, wz);
+            }
+
+            if (gyroscopic_)
+                ApplyGyroscopicTorque(h, qx, qy, qz, qw, ia, ib, ic, wx, wy, wz);
+
+            /* Integrate position: x += v * dt */
+            Traits::Store(&b.position[0][i], PacketMulAdd(vx, h, Traits::Load(&b.position[0][i])));
+            Traits::Store(&b.position[1][i], PacketMulAdd(vy, h, Traits::Load(&b.position[1][i])));
+            Traits::Store(&b.position[2][i], PacketMulAdd(vz, h, Traits::Load(&b.position[2][i])));
+
+            /* Integrate orientation: q += (0, w) (x) q * dt/2 (Hamilton product), then renormalize */
+            {
+                const P hh = h * P(T(0.5));
+                const P dx = wx*qw + wy*qz - wz*qy;
+                const P dy = wy*qw + wz*qx - wx*qz;
+                const P dz = wz*qw + wx*qy - wy*qx;
+                const P dw = -(wx*qx + wy*qy + wz*qz);
+
+                qx = PacketMulAdd(dx, hh, qx);
+                qy = PacketMulAdd(dy, hh, qy);
+                qz = PacketMulAdd(dz, hh, qz);
+                qw = PacketMulAdd(dw, hh, qw);
+
+                const P invLen = P(T(1)) / PacketSqrt(qx*qx + qy*qy + qz*qz + qw*qw);
+                qx = qx * invLen;
+                qy = qy * invLen;
+                qz = qz * invLen;
+                qw = qw * invLen;
+            }
+
+            /* Update world space inverse inertia: R * I^-1 * R^T */
+            P r[9];
+            RotationMatrix(qx, qy, qz, qw, r);
+
+            Traits::Store(&b.invInertiaWorld[0][i], r[0]*r[0]*ia + r[1]*r[1]*ib + r[2]*r[2]*ic);
+            Traits::Store(&b.invInertiaWorld[1][i], r[0]*r[3]*ia + r[1]*r[4]*ib + r[2]*r[5]*ic);
+            Traits::Store(&b.invInertiaWorld[2][i], r[0]*r[6]*ia + r[1]*r[7]*ib + r[2]*r[8]*ic);
+            Traits::Store(&b.invInertiaWorld[3][i], r[3]*r[3]*ia + r[4]*r[4]*ib + r[5]*r[5]*ic);
+            Traits::Store(&b.invInertiaWorld[4][i], r[3]*r[6]*ia + r[4]*r[7]*ib + r[5]*r[8]*ic);
+            Traits::Store(&b.invInertiaWorld[5][i], r[6]*r[6]*ia + r[7]*r[7]*ib + r[8]*r[8]*ic);
+
+            /* Store state */
+            Traits::Store(&b.linearVelocity[0][i], vx);
+            Traits::Store(&b.linearVelocity[1][i], vy);
+            Traits::Store(&b.linearVelocity[2][i], vz);
+            Traits::Store(&b.angularVelocity[0][i], wx);
+            Traits::Store(&b.angularVelocity[1][i], wy);
+            Traits::Store(&b.angularVelocity[2][i], wz);
+            Traits::Store(&b.orientation[0][i], qx);
+            Traits::Store(&b.orientation[1][i], qy);
+            Traits::Store(&b.orientation[2][i], qz);
+            Traits::Store(&b.orientation[3][i], qw);
+        }
+
+    private:
+
+        // Rotation matrix (row-major, r[row*3 + col]) of the unit quaternion.
+        template <typename P>
+        static void RotationMatrix(const P& x, const P& y, const P& z, const P& w, P* r)
+        {
+            const P one = P(T(1)), two = P(T(2));
+            r[0] = one - two*(y*y + z*z);
+            r[1] = two*(x*y - z*w);
+            r[2] = two*(x*z + y*w);
+            r[3] = two*(x*y + z*w);
+            r[4] = one - two*(x*x + z*z);
+            r[5] = two*(y*z - x*w);
+            r[6] = two*(x*z - y*w);
+            r[7] = two*(y*z + x*w);
+            r[8] = one - two*(x*x + y*y);
+        }
+
+        /*
+        Solves the implicit gyroscopic equation I*(w' - w) + dt * w' x (I*w') = 0 in body space with one Newton iteration.
+        Bodies with an infinite inertia around any axis (zero inverse inertia) keep their angular velocity.
+        */
+        template <typename P>
+        static void ApplyGyroscopicTorque(
+            const P& h, const P& qx, const P& qy, const P& qz, const P& qw,
+            const P& ia, const P& ib, const P& ic, P& wx, P& wy, P& wz)
+        {
+            P r[9];
+            RotationMatrix(qx, qy, qz, qw, r);
+
+            /* Transform angular velocity into body space: w_b = R^T * w */
+            const P bx = r[0]*wx + r[3]*wy + r[6]*wz;
+            const P by = r[1]*wx + r[4]*wy + r[7]*wz;
+            const P bz = r[2]*wx + r[5]*wy + r[8]*wz;
+
+            /* Body space inertia and angular momentum */
+            const P minInv = P(std::numeric_limits<T>::epsilon());
+            const P one = P(T(1));
+            const P Ia = one / PacketMax(ia, minInv), Ib = one / PacketMax(ib, minInv), Ic = one / PacketMax(ic, minInv);
+            const P Lx = Ia*bx, Ly = Ib*by, Lz = Ic*bz;
+
+            /* Residual f = dt * w_b x L */
+            const P fx = h*(by*Lz - bz*Ly);
+            const P fy = h*(bz*Lx - bx*Lz);
+            const P fz = h*(bx*Ly - by*Lx);
+
+            /* Jacobian J = I + dt * (skew(w_b) * I - skew(L)) */
+            const P j00 = Ia,               j01 = h*(Lz - bz*Ib),   j02 = h*(by*Ic - Ly);
+            const P j10 = h*(bz*Ia - Lz),   j11 = Ib,               j12 = h*(Lx - bx*Ic);
+            const P j20 = h*(Ly - by*Ia),   j21 = h*(bx*Ib - Lx),   j22 = Ic;
+
+            /* Newton step: w_b -= J^-1 * f */
+            const P c00 = j11*j22 - j12*j21, c01 = j02*j21 - j01*j22, c02 = j01*j12 - j02*j11;
+            const P c10 = j12*j20 - j10*j22, c11 = j00*j22 - j02*j20, c12 = j02*j10 - j00*j12;
+            const P c20 = j10*j21 - j11*j20, c21 = j01*j20 - j00*j21, c22 = j00*j11 - j01*j10;
+
+            const P invDet = one / (j00*c00 + j01*c10 + j02*c20);
+
+            const P nx = bx - (c00*fx + c01*fy + c02*fz) * invDet;
+            const P ny = by - (c10*fx + c11*fy + c12*fz) * invDet;
+            const P nz = bz - (c20*fx + c21*fy + c22*fz) * invDet;
+
+            /* Transform back into world space: w = R * w_b */
+            const P minInvInertia = PacketMin(ia, PacketMin(ib, ic));
+            wx = PacketSelectPositive(minInvInertia, r[0]*nx + r[1]*ny + r[2]*nz, wx);
+            wy = PacketSelectPositive(minInvInertia, r[3]*nx + r[4]*ny + r[5]*nz, wy);
+            wz = PacketSelectPositive(minInvInertia, r[6]*nx + r[7]*ny + r[8]*nz, wz);
+        }
+
+    private:
+
+        RigidBodyArrayT<T>& bodies_;
+        T                   dt_;
+        Vector3T<T>         gravity_;
+        bool                gyroscopic_;
+
+};
+
+
+} // /namespace Details
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Integrates all rigid bodies of the specified array by one time step.
+\param[in,out] bodies Specifies the rigid body array.
+\param[in] dt Specifies the time step.
+\param[in] gravity Specifies the gravity acceleration which is applied to all dynamic bodies.
+\param[in] method Specifies the integration method. By default RigidBodyIntegration::SymplecticEuler.
+\remarks Velocity, position, and orientation integration, quaternion renormalization, and the update of the world space inverse inertia tensors
+are fused into a single pass over the SoA streams. Single precision bodies are processed in SIMD packets (4 or 8 bodies at once),
+and the range of bodies is distributed with "Details::ParallelFor".
+The force and torque accumulators are not modified. \see RigidBodyArrayT::ClearForces
+\see RigidBodyIntegration
+*/
+template <typename T>
+void IntegrateRigidBodies(
+    RigidBodyArrayT<T>&     bodies,
+    const T&                dt,
+    const Vector3T<T>&      gravity,
+    RigidBodyIntegration    method = RigidBodyIntegration::SymplecticEuler)
+{
+    const Details::RigidBodyKernel<T> kernel(bodies, dt, gravity, (method == RigidBodyIntegration::SemiImplicitGyroscopic));
+
+    Details::ParallelFor(
+        bodies.Size(), 4096,
+        [&kernel](std::size_t begin, std::size_t end, std::size_t)
+        {
+            Details::ForEachPacket<T>(begin, end, kernel);
+        }
+    );
+}
+
+
+/* --- Type Alias --- */
+
+using RigidBodyArray     = RigidBodyArrayT<Real>;
+using RigidBodyArrayf    = RigidBodyArrayT<float>;
+using RigidBodyArrayd    = RigidBodyArrayT<double>;
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,386 @@
+/*
+ * RotationGenerator.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_ROTATION_GENERATOR_H
+#define GS_ROTATION_GENERATOR_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+
+#include <cmath>
+#include <cstddef>
+
+
+namespace Gs
+{
+
+
+/**
+\brief Generator for the sine and cosine of the angles 'startAngle + i*stepAngle' for i = 0, 1, 2, ...
+\tparam T Specifies the data type of the vector components. This should be float or double.
+\remarks Instead of calling std::sin and std::cos for each angle, the next pair is computed by the recurrence
+\code
+cos(a + d) = cos(a) - (alpha*cos(a) + beta*sin(a))
+sin(a + d) = sin(a) - (alpha*sin(a) - beta*cos(a))
+\endcode
+with alpha = 2*sin(d/2)^2 and beta = sin(d), which does not suffer from the cancellation of 1 - cos(d) for small steps.
+The rounding errors grow linearly with the number of steps, therefore the state is re-computed from std::sin and std::cos
+every 'resyncInterval' steps. Hence, the drift is bounded by roughly 'resyncInterval' units in the last place.
+\code
+// 32 points on a circle with radius 2
+Gs::Vector2 points[32];
+Gs::RotationGenerator2 generator(0.0f, 2.0f*Gs::pi/32);
+generator.Generate(Gs::Vector2(2, 0), points, 32);
+\endcode
+*/
+template <typename T>
+class RotationGenerator2T
+{
+
+    public:
+
+        static_assert(std::is_floating_point<T>::value, "rotation generators can only be used with floating point types");
+
+        //! Specifies the typename of the scalar components.
+        using ScalarType = T;
+
+        //! Default interval (in number of steps) after which the state is re-computed from std::sin and std::cos.
+        static const std::size_t defaultResyncInterval = 64;
+
+        RotationGenerator2T(const T& startAngle, const T& stepAngle, std::size_t resyncInterval = defaultResyncInterval) :
+            resyncInterval_ { resyncInterval > 0 ? resyncInterval : 1 }
+        {
+            Reset(startAngle, stepAngle);
+        }
+
+        //! Restarts the generator with the specified start and step angles (in radians).
+        void Reset(const T& startAngle, const T& stepAngle)
+        {
+            startAngle_ = startAngle;
+            stepAngle_  = stepAngle;
+            index_      = 0;
+
+            const T halfSin = std::sin(stepAngle / T(2));
+            alpha_ = T(2) * halfSin * halfSin;
+            beta_  = std::sin(stepAngle);
+
+            Resync();
+        }
+
+        //! Restarts the generator with the current start and step angles.
+        void Restart()
+        {
+            index_ = 0;
+            Resync();
+        }
+
+        //! Returns the (cosine, sine) pair of the current angle and advances to the next angle.
+        Vector2T<T> Next()
+        {
+            const Vector2T<T> result(cos_, sin_);
+            Advance();
+            return result;
+        }
+
+        //! Returns the specified vector rotated (counter-clockwise) by the current angle and advances to the next angle.
+        Vector2T<T> Next(const Vector2T<T>& vec)
+        {
+            const Vector2T<T> result(
+                vec.x*cos_ - vec.y*sin_,
+                vec.x*sin_ + vec.y*cos_
+            );
+            Advance();
+            return result;
+        }
+
+        //! Writes the next 'count' (cosine, sine) pairs to the output array.
+        void Generate(Vector2T<T>* output, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                output[i] = Next();
+        }
+
+        //! Writes the specified vector rotated by the next 'count' angles to the output array.
+        void Generate(const Vector2T<T>& vec, Vector2T<T>* output, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                output[i] = Next(vec);
+        }
+
+        //! Returns the cosine of the current angle.
+        const T& Cos() const
+        {
+            return cos_;
+        }
+
+        //! Returns the sine of the current angle.
+        const T& Sin() const
+        {
+            return sin_;
+        }
+
+        //! Returns the current angle, i.e. 'startAngle + index*stepAngle'.
+        T Angle() const
+        {
+            return static_cast<T>(AccurateAngle());
+        }
+
+        //! Returns the number of steps since the last reset.
+        std::size_t Index() const
+        {
+            return index_;
+        }
+
+        //! Advances to the next angle.
+        void Advance()
+        {
+            ++index_;
+
+            if (++stepsSinceResync_ >= resyncInterval_)
+                Resync();
+            else
+            {
+                const T c = cos_;
+                const T s = sin_;
+                cos_ = c - (alpha_*c + beta_*s);
+                sin_ = s - (alpha_*s - beta_*c);
+            }
+        }
+
+    private:
+
+        // Angle in double precision, so that large indices do not lose precision for float.
+        double AccurateAngle() const
+        {
+            return static_cast<double>(startAngle_) + static_cast<double>(index_) * static_cast<double>(stepAngle_);
+        }
+
+        void Resync()
+        {
+            const double angle = AccurateAngle();
+            cos_ = static_cast<T>(std::cos(angle));
+            sin_ = static_cast<T>(std::sin(angle));
+            stepsSinceResync_ = 0;
+        }
+
+        T           startAngle_         = T(0);
+        T           stepAngle_          = T(0);
+        T           alpha_              = T(0);
+        T           beta_               = T(0);
+        T           cos_                = T(1);
+        T           sin_                = T(0);
+        std::size_t index_              = 0;
+        std::size_t stepsSinceResync_   = 0;
+        std::size_t resyncInterval_;
+
+};
+
+/**
+\brief Generator for rotations around a fixed axis by the angles 'startAngle + i*stepAngle' for i = 0, 1, 2, ...
+\tparam T Specifies the data type of the vector components. This should be float or double.
+\remarks This is the 3D counterpart of RotationGenerator2T. Internally the half angles are generated,
+from which the quaternions (axis*sin(angle/2), cos(angle/2)) are built directly, and the full angles for the vector rotation
+are derived by the double angle formulas. The vectors are rotated in the same direction as with "RotateVectorAroundAxis".
+\see RotationGenerator2T
+\see RotateVectorAroundAxis
+*/
+template <typename T>
+class AxisRotationGeneratorT
+{
+
+    public:
+
+        //! Specifies the typename of the scalar components.
+        using ScalarType = T;
+
+        AxisRotationGeneratorT(
+            const Vector3T<T>&  axis,
+            const T&            startAngle,
+            const T&            stepAngle,
+            std::size_t         resyncInterval = RotationGenerator2T<T>::defaultResyncInterval) :
+                axis_           { axis.Normalized()                                     },
+                halfRotation_   { startAngle / T(2), stepAngle / T(2), resyncInterval  }
+        {
+        }
+
+        //! Restarts the generator with the specified start and step angles (in radians).
+        void Reset(const T& startAngle, const T& stepAngle)
+        {
+            halfRotation_.Reset(startAngle / T(2), stepAngle / T(2));
+        }
+
+        //! Returns the unit quaternion of the current angle and advances to the next angle.
+        QuaternionT<T> NextQuaternion()
+        {
+            const T s = halfRotation_.Sin();
+            const QuaternionT<T> result(axis_.x*s, axis_.y*s, axis_.z*s, halfRotation_.Cos());
+            halfRotation_.Advance();
+            return result;
+        }
+
+        //! Returns the specified vector rotated around the axis by the current angle and advances to the next angle.
+        Vector3T<T> Next(const Vector3T<T>& vec)
+        {
+            const T d = Dot(axis_, vec);
+            return NextRotated(axis_*d, vec - axis_*d, Cross(axis_, vec));
+        }
+
+        //! Writes the unit quaternions of the next 'count' angles to the output array.
+        void GenerateQuaternions(QuaternionT<T>* output, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                output[i] = NextQuaternion();
+        }
+
+        //! Writes the specified vector rotated around the axis by the next 'count' angles to the output array.
+        void Generate(const Vector3T<T>& vec, Vector3T<T>* output, std::size_t count)
+        {
+            /* Decompose the vector once: vec = parallel + perpendicular, and the perpendicular part rotated by 90 degrees */
+            const T d = Dot(axis_, vec);
+            const Vector3T<T> parallel = axis_*d;
+            const Vector3T<T> perpendicular = vec - parallel;
+            const Vector3T<T> binormal = Cross(axis_, vec);
+
+            for (std::size_t i = 0; i < count; ++i)
+                output[i] = NextRotated(parallel, perpendicular, binormal);
+        }
+
+        //! Returns the normalized rotation axis.
+        const Vector3T<T>& GetAxis() const
+        {
+            return axis_;
+        }
+
+        //! Returns the current angle.
+        T Angle() const
+        {
+            return halfRotation_.Angle() * T(2);
+        }
+
+    private:
+
+        Vector3T<T> NextRotated(const Vector3T<T>& parallel, const Vector3T<T>& perpendicular, const Vector3T<T>& binormal)
+        {
+            /* cos(a) = cos(a/2)^2 - sin(a/2)^2, sin(a) = 2*sin(a/2)*cos(a/2) */
+            const T hc = halfRotation_.Cos();
+            const T hs = halfRotation_.Sin();
+            const T c  = hc*hc - hs*hs;
+            const T s  = T(2)*hs*hc;
+
+            halfRotation_.Advance();
+
+            return parallel + perpendicular*c + binormal*s;
+        }
+
+        Vector3T<T>             axis_;
+        RotationGenerator2T<T>  halfRotation_;
+
+};
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Writes 'count' points of a circular arc from 'startAngle' to 'endAngle' (both inclusive) to the output array.
+\remarks The angles are specified in radians and are measured counter-clockwise from the X axis.
+*/
+template <typename T>
+void GenerateArcPoints(
+    const Vector2T<T>&  center,
+    const T&            radius,
+    const T&            startAngle,
+    const T&            endAngle,
+    Vector2T<T>*        output,
+    std::size_t         count)
+{
+    if (count == 0)
+        return;
+
+    const T step = (count > 1 ? (endAngle - startAngle) / static_cast<T>(count - 1) : T(0));
+
+    RotationGenerator2T<T> generator(startAngle, step);
+
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = center + generator.Next() * radius;
+}
+
+/**
+\brief Writes 'count' points of a full circle to the output array, beginning at the X axis.
+\remarks The last point is not a duplicate of the first one.
+*/
+template <typename T>
+void GenerateCirclePoints(const Vector2T<T>& center, const T& radius, Vector2T<T>* output, std::size_t count)
+{
+    if (count == 0)
+        return;
+
+    RotationGenerator2T<T> generator(T(0), T(2) * T(Gs::pi) / static_cast<T>(count));
+
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = center + generator.Next() * radius;
+}
+
+/**
+\brief Writes the points of a sphere with 'numRings + 1' rings (including the poles) and 'numSegments' segments to the output array.
+\param[out] output Pointer to the output array. This must have at least '(numRings + 1) * numSegments' elements.
+\remarks The points are ordered ring by ring, beginning at the north pole (0, 0, radius). The spherical coordinates follow the convention of SphericalT,
+i.e. theta is the angle to the Z axis and phi is the angle around the Z axis. Both poles are duplicated 'numSegments' times,
+which is the common layout for texture coordinates.
+\see SphericalT
+*/
+template <typename T>
+void GenerateSpherePoints(
+    const Vector3T<T>&  center,
+    const T&            radius,
+    std::size_t         numRings,
+    std::size_t         numSegments,
+    Vector3T<T>*        output)
+{
+    if (numRings == 0 || numSegments == 0)
+        return;
+
+    RotationGenerator2T<T> thetaGenerator(T(0), T(Gs::pi) / static_cast<T>(numRings));
+    RotationGenerator2T<T> phiGenerator(T(0), T(2) * T(Gs::pi) / static_cast<T>(numSegments));
+
+    for (std::size_t ring = 0; ring <= numRings; ++ring)
+    {
+        const auto theta = thetaGenerator.Next();
+        const T ringRadius = theta.y * radius;
+        const T z = theta.x * radius;
+
+        for (std::size_t segment = 0; segment < numSegments; ++segment)
+        {
+            const auto phi = phiGenerator.Next();
+            *output++ = center + Vector3T<T>(phi.x * ringRadius, phi.y * ringRadius, z);
+        }
+
+        phiGenerator.Restart();
+    }
+}
+
+
+/* --- Type Alias --- */
+
+using RotationGenerator2    = RotationGenerator2T<Real>;
+using RotationGenerator2f   = RotationGenerator2T<float>;
+using RotationGenerator2d   = RotationGenerator2T<double>;
+
+using AxisRotationGenerator     = AxisRotationGeneratorT<Real>;
+using AxisRotationGeneratorf    = AxisRotationGeneratorT<float>;
+using AxisRotationGeneratord    = AxisRotationGeneratorT<double>;
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,61 @@
+/*
+ * SIMD.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_SIMD_H
+#define GS_SIMD_H
+
+
+#include "Config.h"
+
+
+/*
+Detects the SIMD instruction sets the compiler generates code for.
+The batch functions use the following macros to select their SIMD implementation:
+GS_SIMD_SSE2, GS_SIMD_SSE4_1, GS_SIMD_AVX, GS_SIMD_AVX2, and GS_SIMD_FMA.
+*/
+#ifndef GS_DISABLE_SIMD
+
+#   if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define GS_SIMD_SSE2
+#   endif
+
+#   if defined(__SSE4_1__) || (defined(_MSC_VER) && defined(__AVX__))
+#       define GS_SIMD_SSE4_1
+#   endif
+
+#   if defined(__AVX__)
+#       define GS_SIMD_AVX
+#   endif
+
+#   if defined(__AVX2__)
+#       define GS_SIMD_AVX2
+#   endif
+
+#   if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+#       define GS_SIMD_FMA
+#   endif
+
+#endif
+
+#if defined(GS_SIMD_SSE2)
+#   include <emmintrin.h>
+#endif
+
+#if defined(GS_SIMD_SSE4_1)
+#   include <smmintrin.h>
+#endif
+
+#if defined(GS_SIMD_AVX) || defined(GS_SIMD_AVX2) || defined(GS_SIMD_FMA)
+#   include <immintrin.h>
+#endif
+
+
+#endif
+
+
+
+// ================================================================================
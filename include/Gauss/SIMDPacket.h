@@ -0,0 +1,654 @@
+/*
+ * SIMDPacket.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_SIMD_PACKET_H
+#define GS_SIMD_PACKET_H
+
+
+#include "SIMD.h"
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+
+namespace Gs
+{
+
+
+namespace Details
+{
+
+
+/*
+Packets are used to write SoA batch kernels only once for scalars and SIMD registers:
+a kernel provides a member function template 'Run<P>(index)' that processes 'PacketTraits<P>::size' elements,
+and "ForEachPacket" calls it with the widest native packet type and the scalar type for the remainder.
+*/
+
+//! Packet traits for scalar types, i.e. packets with a single element.
+template <typename T>
+struct PacketTraits
+{
+    using ScalarType = T;
+
+    static const std::size_t size = 1;
+
+    static T Load(const T* ptr)
+    {
+        return *ptr;
+    }
+
+    static void Store(T* ptr, const T& value)
+    {
+        *ptr = value;
+    }
+
+    static T LoadStrided(const T* ptr, std::size_t /*stride*/)
+    {
+        return *ptr;
+    }
+
+    static void StoreStrided(T* ptr, std::size_t /*stride*/, const T& value)
+    {
+        *ptr = value;
+    }
+};
+
+template <typename T>
+T PacketSqrt(const T& x)
+{
+    return std::sqrt(x);
+}
+
+template <typename T>
+T PacketAbs(const T& x)
+{
+    return std::abs(x);
+}
+
+template <typename T>
+T PacketAtan(const T& x)
+{
+    return std::atan(x);
+}
+
+template <typename T>
+T PacketAcos(const T& x)
+{
+    return std::acos(x);
+}
+
+template <typename T>
+T PacketCbrt(const T& x)
+{
+    return std::cbrt(x);
+}
+
+template <typename T>
+void PacketSinCos(const T& x, T& s, T& c)
+{
+    s = std::sin(x);
+    c = std::cos(x);
+}
+
+template <typename T>
+T PacketMin(const T& a, const T& b)
+{
+    return std::min(a, b);
+}
+
+template <typename T>
+T PacketMax(const T& a, const T& b)
+{
+    return std::max(a, b);
+}
+
+//! Returns (a * b + c).
+template <typename T>
+T PacketMulAdd(const T& a, const T& b, const T& c)
+{
+    return a * b + c;
+}
+
+//! Returns 'a' for each element where 'x' is greater than zero, otherwise 'b'.
+template <typename T>
+T PacketSelectPositive(const T& x, const T& a, const T& b)
+{
+    return (x > T(0) ? a : b);
+}
+
+//! Returns a bit mask where the i-th bit is set if the sign bit of the i-th element is set.
+template <typename T>
+unsigned PacketSignMask(const T& x)
+{
+    return (std::signbit(x) ? 1u : 0u);
+}
+
+template <typename T>
+T PacketFloor(const T& x)
+{
+    return std::floor(x);
+}
+
+template <typename T>
+T PacketTrunc(const T& x)
+{
+    return std::trunc(x);
+}
+
+//! Rounds half-way cases away from zero like std::round.
+template <typename T>
+T PacketRound(const T& x)
+{
+    return std::round(x);
+}
+
+//! Returns 1 if x is greater than zero, -1 if x is less than zero, and 0 otherwise.
+template <typename T>
+T PacketSign(const T& x)
+{
+    return static_cast<T>((T(0) < x) - (x < T(0)));
+}
+
+//! Returns 0 if x is less than 'edge', otherwise 1.
+template <typename T>
+T PacketStep(const T& edge, const T& x)
+{
+    return (x < edge ? T(0) : T(1));
+}
+
+//! Returns the reciprocal square root of x, which must be greater than zero.
+template <typename T>
+T PacketRsqrt(const T& x)
+{
+    return T(1) / std::sqrt(x);
+}
+
+//! Stores the i-th elements of the packets 'a', 'b', 'c', and 'd' consecutively at (ptr + i*stride).
+template <typename T>
+void PacketStoreInterleaved4(T* ptr, std::size_t /*stride*/, const T& a, const T& b, const T& c, const T& d)
+{
+    ptr[0] = a;
+    ptr[1] = b;
+    ptr[2] = c;
+    ptr[3] = d;
+}
+
+
+#ifdef GS_SIMD_SSE2
+
+//! Packet of four single precision floats (SSE).
+struct PacketF4
+{
+    PacketF4() = default;
+
+    PacketF4(__m128 v) :
+        v { v }
+    {
+    }
+
+    PacketF4(float s) :
+        v { _mm_set1_ps(s) }
+    {
+    }
+
+    __m128 v;
+};
+
+template <>
+struct PacketTraits<PacketF4>
+{
+    using ScalarType = float;
+
+    static const std::size_t size = 4;
+
+    static PacketF4 Load(const float* ptr)
+    {
+        return _mm_loadu_ps(ptr);
+    }
+
+    static void Store(float* ptr, const PacketF4& value)
+    {
+        _mm_storeu_ps(ptr, value.v);
+    }
+
+    static PacketF4 LoadStrided(const float* ptr, std::size_t stride)
+    {
+        return _mm_setr_ps(ptr[0], ptr[stride], ptr[stride*2], ptr[stride*3]);
+    }
+
+    static void StoreStrided(float* ptr, std::size_t stride, const PacketF4& value)
+    {
+        alignas(16) float tmp[4];
+        _mm_store_ps(tmp, value.v);
+        for (std::size_t i = 0; i < 4; ++i)
+            ptr[stride*i] = tmp[i];
+    }
+};
+
+inline PacketF4 operator + (const PacketF4& lhs, const PacketF4& rhs) { return _mm_add_ps(lhs.v, rhs.v); }
+inline PacketF4 operator - (const PacketF4& lhs, const PacketF4& rhs) { return _mm_sub_ps(lhs.v, rhs.v); }
+inline PacketF4 operator * (const PacketF4& lhs, const PacketF4& rhs) { return _mm_mul_ps(lhs.v, rhs.v); }
+inline PacketF4 operator / (const PacketF4& lhs, const PacketF4& rhs) { return _mm_div_ps(lhs.v, rhs.v); }
+inline PacketF4 operator - (const PacketF4& rhs) { return _mm_xor_ps(rhs.v, _mm_set1_ps(-0.0f)); }
+
+inline PacketF4 PacketSqrt(const PacketF4& x) { return _mm_sqrt_ps(x.v); }
+inline PacketF4 PacketMin(const PacketF4& a, const PacketF4& b) { return _mm_min_ps(a.v, b.v); }
+inline PacketF4 PacketMax(const PacketF4& a, const PacketF4& b) { return _mm_max_ps(a.v, b.v); }
+
+inline PacketF4 PacketMulAdd(const PacketF4& a, const PacketF4& b, const PacketF4& c)
+{
+    #ifdef GS_SIMD_FMA
+    return _mm_fmadd_ps(a.v, b.v, c.v);
+    #else
+    return _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v);
+    #endif
+}
+
+inline PacketF4 PacketSelectPositive(const PacketF4& x, const PacketF4& a, const PacketF4& b)
+{
+    const __m128 mask = _mm_cmpgt_ps(x.v, _mm_setzero_ps());
+    return _mm_or_ps(_mm_and_ps(mask, a.v), _mm_andnot_ps(mask, b.v));
+}
+
+inline PacketF4 PacketAbs(const PacketF4& x)
+{
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), x.v);
+}
+
+inline unsigned PacketSignMask(const PacketF4& x)
+{
+    return static_cast<unsigned>(_mm_movemask_ps(x.v));
+}
+
+inline PacketF4 PacketTrunc(const PacketF4& x)
+{
+    #ifdef GS_SIMD_SSE4_1
+    return _mm_round_ps(x.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    #else
+    /* Values with |x| >= 2^23 (and NaN) are already integral and are not converted; the sign bit is kept for -0 */
+    const __m128 signBit    = _mm_set1_ps(-0.0f);
+    const __m128 small      = _mm_cmplt_ps(_mm_andnot_ps(signBit, x.v), _mm_set1_ps(8388608.0f));
+    const __m128 t          = _mm_cvtepi32_ps(_mm_cvttps_epi32(x.v));
+    return _mm_or_ps(_mm_or_ps(_mm_and_ps(small, t), _mm_andnot_ps(small, x.v)), _mm_and_ps(signBit, x.v));
+    #endif
+}
+
+inline PacketF4 PacketFloor(const PacketF4& x)
+{
+    #ifdef GS_SIMD_SSE4_1
+    return _mm_floor_ps(x.v);
+    #else
+    const __m128 t = PacketTrunc(x).v;
+    return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, x.v), _mm_set1_ps(1.0f)));
+    #endif
+}
+
+inline PacketF4 PacketRound(const PacketF4& x)
+{
+    const __m128 signBit    = _mm_set1_ps(-0.0f);
+    const __m128 t          = PacketTrunc(x).v;
+    const __m128 half       = _mm_cmpge_ps(_mm_andnot_ps(signBit, _mm_sub_ps(x.v, t)), _mm_set1_ps(0.5f));
+    const __m128 one        = _mm_or_ps(_mm_and_ps(signBit, x.v), _mm_set1_ps(1.0f));
+    return _mm_add_ps(t, _mm_and_ps(half, one));
+}
+
+inline PacketF4 PacketSign(const PacketF4& x)
+{
+    const __m128 zero = _mm_setzero_ps();
+    return _mm_or_ps(
+        _mm_and_ps(_mm_cmpgt_ps(x.v, zero), _mm_set1_ps(1.0f)),
+        _mm_and_ps(_mm_cmplt_ps(x.v, zero), _mm_set1_ps(-1.0f))
+    );
+}
+
+inline PacketF4 PacketStep(const PacketF4& edge, const PacketF4& x)
+{
+    return _mm_andnot_ps(_mm_cmplt_ps(x.v, edge.v), _mm_set1_ps(1.0f));
+}
+
+// Hardware estimate (12 bits) refined with one Newton-Raphson step.
+inline PacketF4 PacketRsqrt(const PacketF4& x)
+{
+    const __m128 y = _mm_rsqrt_ps(x.v);
+    const __m128 h = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), x.v), _mm_mul_ps(y, y));
+    return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), h));
+}
+
+inline void PacketStoreInterleaved4(float* ptr, std::size_t stride, const PacketF4& a, const PacketF4& b, const PacketF4& c, const PacketF4& d)
+{
+    __m128 r0 = a.v, r1 = b.v, r2 = c.v, r3 = d.v;
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(ptr,            r0);
+    _mm_storeu_ps(ptr + stride,   r1);
+    _mm_storeu_ps(ptr + stride*2, r2);
+    _mm_storeu_ps(ptr + stride*3, r3);
+}
+
+// Arc tangent with the range reduction and polynomial of the Cephes library (atanf).
+inline PacketF4 PacketAtan(const PacketF4& x)
+{
+    const __m128 sign   = _mm_and_ps(x.v, _mm_set1_ps(-0.0f));
+    const __m128 ax     = _mm_andnot_ps(_mm_set1_ps(-0.0f), x.v);
+    const __m128 one    = _mm_set1_ps(1.0f);
+
+    /* Reduce into [0, tan(pi/8)]: atan(x) = pi/2 + atan(-1/x) for x > tan(3pi/8), and pi/4 + atan((x - 1)/(x + 1)) for x > tan(pi/8) */
+    const __m128 big    = _mm_cmpgt_ps(ax, _mm_set1_ps(2.414213562373095f));
+    const __m128 mid    = _mm_andnot_ps(big, _mm_cmpgt_ps(ax, _mm_set1_ps(0.4142135623730950f)));
+
+    const __m128 y0     = _mm_or_ps(_mm_and_ps(big, _mm_set1_ps(1.570796326794897f)), _mm_and_ps(mid, _mm_set1_ps(0.7853981633974483f)));
+
+    __m128 xr = _mm_andnot_ps(_mm_or_ps(big, mid), ax);
+    xr = _mm_or_ps(xr, _mm_and_ps(big, _mm_div_ps(_mm_set1_ps(-1.0f), ax)));
+    xr = _mm_or_ps(xr, _mm_and_ps(mid, _mm_div_ps(_mm_sub_ps(ax, one), _mm_add_ps(ax, one))));
+
+    const PacketF4 z = _mm_mul_ps(xr, xr);
+    PacketF4 p = PacketMulAdd(z, PacketF4(8.05374449538e-2f), PacketF4(-1.38776856032e-1f));
+    p = PacketMulAdd(p, z, PacketF4(1.99777106478e-1f));
+    p = PacketMulAdd(p, z, PacketF4(-3.33329491539e-1f));
+    p = PacketMulAdd(p * z, xr, xr);
+
+    return _mm_xor_ps(_mm_add_ps(y0, p.v), sign);
+}
+
+// Arc cosine with the identity acos(x) = 2*atan(sqrt((1 - x)/(1 + x))), which also yields pi for x = -1 since atan(inf) = pi/2.
+inline PacketF4 PacketAcos(const PacketF4& x)
+{
+    const PacketF4 one = 1.0f;
+    return PacketAtan(PacketSqrt((one - x) / (one + x))) * PacketF4(2.0f);
+}
+
+// Cube root with an initial guess from the exponent bits (divided by three) and three Newton-Raphson iterations.
+inline PacketF4 PacketCbrt(const PacketF4& x)
+{
+    const __m128 sign   = _mm_and_ps(x.v, _mm_set1_ps(-0.0f));
+    const __m128 ax     = _mm_andnot_ps(_mm_set1_ps(-0.0f), x.v);
+
+    const __m128i bits  = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_castps_si128(ax)), _mm_set1_ps(1.0f/3.0f)));
+    PacketF4 y = _mm_castsi128_ps(_mm_add_epi32(bits, _mm_set1_epi32(709921077)));
+
+    const PacketF4 px = ax, twoThirds = 2.0f/3.0f, oneThird = 1.0f/3.0f;
+    for (int i = 0; i < 3; ++i)
+        y = PacketMulAdd(twoThirds, y, oneThird * px / (y * y));
+
+    /* Zero has no valid initial guess */
+    const __m128 nonZero = _mm_cmpgt_ps(ax, _mm_setzero_ps());
+    return _mm_or_ps(_mm_and_ps(nonZero, y.v), sign);
+}
+
+// Sine and cosine with a Cody-Waite range reduction to [-pi/4, pi/4] and the polynomials of the Cephes library (sinf, cosf).
+inline void PacketSinCos(const PacketF4& x, PacketF4& s, PacketF4& c)
+{
+    /* x = r + k*pi/2 */
+    const __m128i k     = _mm_cvtps_epi32(_mm_mul_ps(x.v, _mm_set1_ps(0.6366197723675814f)));
+    const __m128  kf    = _mm_cvtepi32_ps(k);
+
+    __m128 r = _mm_sub_ps(x.v, _mm_mul_ps(kf, _mm_set1_ps(1.5703125f)));
+    r = _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(4.837512969970703125e-4f)));
+    r = _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(7.54978995489188216e-8f)));
+
+    const PacketF4 pr = r;
+    const PacketF4 z = _mm_mul_ps(r, r);
+
+    PacketF4 ps = PacketMulAdd(z, PacketF4(-1.9515295891e-4f), PacketF4(8.3321608736e-3f));
+    ps = PacketMulAdd(ps, z, PacketF4(-1.6666654611e-1f));
+    ps = PacketMulAdd(ps * z, pr, pr);
+
+    PacketF4 pc = PacketMulAdd(z, PacketF4(2.443315711809948e-5f), PacketF4(-1.388731625493765e-3f));
+    pc = PacketMulAdd(pc, z, PacketF4(4.166664568298827e-2f));
+    pc = PacketMulAdd(pc * z, z, PacketF4(1.0f) - z * PacketF4(0.5f));
+
+    /* Select the quadrant: sin(x) = { s, c, -s, -c }[k & 3] and cos(x) = { c, -s, -c, s }[k & 3] */
+    const __m128i one   = _mm_set1_epi32(1);
+    const __m128i two   = _mm_set1_epi32(2);
+    const __m128  swap  = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(k, one), one));
+    const __m128  signS = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(k, two), 30));
+    const __m128  signC = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(k, one), two), 30));
+
+    s = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, pc.v), _mm_andnot_ps(swap, ps.v)), signS);
+    c = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, ps.v), _mm_andnot_ps(swap, pc.v)), signC);
+}
+
+#endif
+
+#ifdef GS_SIMD_AVX
+
+//! Packet of eight single precision floats (AVX).
+struct PacketF8
+{
+    PacketF8() = default;
+
+    PacketF8(__m256 v) :
+        v { v }
+    {
+    }
+
+    PacketF8(float s) :
+        v { _mm256_set1_ps(s) }
+    {
+    }
+
+    __m256 v;
+};
+
+template <>
+struct PacketTraits<PacketF8>
+{
+    using ScalarType = float;
+
+    static const std::size_t size = 8;
+
+    static PacketF8 Load(const float* ptr)
+    {
+        return _mm256_loadu_ps(ptr);
+    }
+
+    static void Store(float* ptr, const PacketF8& value)
+    {
+        _mm256_storeu_ps(ptr, value.v);
+    }
+
+    static PacketF8 LoadStrided(const float* ptr, std::size_t stride)
+    {
+        return _mm256_setr_ps(
+            ptr[0],        ptr[stride],   ptr[stride*2], ptr[stride*3],
+            ptr[stride*4], ptr[stride*5], ptr[stride*6], ptr[stride*7]
+        );
+    }
+
+    static void StoreStrided(float* ptr, std::size_t stride, const PacketF8& value)
+    {
+        alignas(32) float tmp[8];
+        _mm256_store_ps(tmp, value.v);
+        for (std::size_t i = 0; i < 8; ++i)
+            ptr[stride*i] = tmp[i];
+    }
+};
+
+inline PacketF8 operator + (const PacketF8& lhs, const PacketF8& rhs) { return _mm256_add_ps(lhs.v, rhs.v); }
+inline PacketF8 operator - (const PacketF8& lhs, const PacketF8& rhs) { return _mm256_sub_ps(lhs.v, rhs.v); }
+inline PacketF8 operator * (const PacketF8& lhs, const PacketF8& rhs) { return _mm256_mul_ps(lhs.v, rhs.v); }
+inline PacketF8 operator / (const PacketF8& lhs, const PacketF8& rhs) { return _mm256_div_ps(lhs.v, rhs.v); }
+inline PacketF8 operator - (const PacketF8& rhs) { return _mm256_xor_ps(rhs.v, _mm256_set1_ps(-0.0f)); }
+
+inline PacketF8 PacketSqrt(const PacketF8& x) { return _mm256_sqrt_ps(x.v); }
+inline PacketF8 PacketMin(const PacketF8& a, const PacketF8& b) { return _mm256_min_ps(a.v, b.v); }
+inline PacketF8 PacketMax(const PacketF8& a, const PacketF8& b) { return _mm256_max_ps(a.v, b.v); }
+
+inline PacketF8 PacketMulAdd(const PacketF8& a, const PacketF8& b, const PacketF8& c)
+{
+    #ifdef GS_SIMD_FMA
+    return _mm256_fmadd_ps(a.v, b.v, c.v);
+    #else
+    return _mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v);
+    #endif
+}
+
+inline PacketF8 PacketSelectPositive(const PacketF8& x, const PacketF8& a, const PacketF8& b)
+{
+    return _mm256_blendv_ps(b.v, a.v, _mm256_cmp_ps(x.v, _mm256_setzero_ps(), _CMP_GT_OQ));
+}
+
+inline PacketF8 PacketAbs(const PacketF8& x)
+{
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x.v);
+}
+
+inline unsigned PacketSignMask(const PacketF8& x)
+{
+    return static_cast<unsigned>(_mm256_movemask_ps(x.v));
+}
+
+inline PacketF8 PacketTrunc(const PacketF8& x)
+{
+    return _mm256_round_ps(x.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+}
+
+inline PacketF8 PacketFloor(const PacketF8& x)
+{
+    return _mm256_floor_ps(x.v);
+}
+
+inline PacketF8 PacketRound(const PacketF8& x)
+{
+    const __m256 signBit    = _mm256_set1_ps(-0.0f);
+    const __m256 t          = PacketTrunc(x).v;
+    const __m256 half       = _mm256_cmp_ps(_mm256_andnot_ps(signBit, _mm256_sub_ps(x.v, t)), _mm256_set1_ps(0.5f), _CMP_GE_OQ);
+    const __m256 one        = _mm256_or_ps(_mm256_and_ps(signBit, x.v), _mm256_set1_ps(1.0f));
+    return _mm256_add_ps(t, _mm256_and_ps(half, one));
+}
+
+inline PacketF8 PacketSign(const PacketF8& x)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    return _mm256_or_ps(
+        _mm256_and_ps(_mm256_cmp_ps(x.v, zero, _CMP_GT_OQ), _mm256_set1_ps(1.0f)),
+        _mm256_and_ps(_mm256_cmp_ps(x.v, zero, _CMP_LT_OQ), _mm256_set1_ps(-1.0f))
+    );
+}
+
+inline PacketF8 PacketStep(const PacketF8& edge, const PacketF8& x)
+{
+    return _mm256_andnot_ps(_mm256_cmp_ps(x.v, edge.v, _CMP_LT_OQ), _mm256_set1_ps(1.0f));
+}
+
+inline PacketF8 PacketRsqrt(const PacketF8& x)
+{
+    const __m256 y = _mm256_rsqrt_ps(x.v);
+    const __m256 h = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), x.v), _mm256_mul_ps(y, y));
+    return _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5f), h));
+}
+
+inline void PacketStoreInterleaved4(float* ptr, std::size_t stride, const PacketF8& a, const PacketF8& b, const PacketF8& c, const PacketF8& d)
+{
+    PacketStoreInterleaved4(
+        ptr, stride,
+        PacketF4(_mm256_castps256_ps128(a.v)), PacketF4(_mm256_castps256_ps128(b.v)),
+        PacketF4(_mm256_castps256_ps128(c.v)), PacketF4(_mm256_castps256_ps128(d.v))
+    );
+    PacketStoreInterleaved4(
+        ptr + stride*4, stride,
+        PacketF4(_mm256_extractf128_ps(a.v, 1)), PacketF4(_mm256_extractf128_ps(b.v, 1)),
+        PacketF4(_mm256_extractf128_ps(c.v, 1)), PacketF4(_mm256_extractf128_ps(d.v, 1))
+    );
+}
+
+// AVX (without AVX2) has no 256-bit integer instructions, so both halves are processed with SSE.
+inline PacketF8 PacketAtan(const PacketF8& x)
+{
+    const PacketF4 lo = PacketAtan(PacketF4(_mm256_castps256_ps128(x.v)));
+    const PacketF4 hi = PacketAtan(PacketF4(_mm256_extractf128_ps(x.v, 1)));
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(lo.v), hi.v, 1);
+}
+
+inline PacketF8 PacketAcos(const PacketF8& x)
+{
+    const PacketF8 one = 1.0f;
+    return PacketAtan(PacketSqrt((one - x) / (one + x))) * PacketF8(2.0f);
+}
+
+inline PacketF8 PacketCbrt(const PacketF8& x)
+{
+    const PacketF4 lo = PacketCbrt(PacketF4(_mm256_castps256_ps128(x.v)));
+    const PacketF4 hi = PacketCbrt(PacketF4(_mm256_extractf128_ps(x.v, 1)));
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(lo.v), hi.v, 1);
+}
+
+inline void PacketSinCos(const PacketF8& x, PacketF8& s, PacketF8& c)
+{
+    PacketF4 sLo, cLo, sHi, cHi;
+    PacketSinCos(PacketF4(_mm256_castps256_ps128(x.v)), sLo, cLo);
+    PacketSinCos(PacketF4(_mm256_extractf128_ps(x.v, 1)), sHi, cHi);
+    s = _mm256_insertf128_ps(_mm256_castps128_ps256(sLo.v), sHi.v, 1);
+    c = _mm256_insertf128_ps(_mm256_castps128_ps256(cLo.v), cHi.v, 1);
+}
+
+#endif
+
+
+//! Widest native packet type for the scalar type 'T'.
+template <typename T>
+struct NativePacket
+{
+    using Type = T;
+};
+
+#if defined(GS_SIMD_AVX)
+
+template <>
+struct NativePacket<float>
+{
+    using Type = PacketF8;
+};
+
+#elif defined(GS_SIMD_SSE2)
+
+template <>
+struct NativePacket<float>
+{
+    using Type = PacketF4;
+};
+
+#endif
+
+/**
+\brief Calls 'kernel.template Run<P>(i)' for all elements in the range [begin, end).
+\remarks 'P' is the native packet type of 'T' for as many elements as possible and 'T' for the remaining elements.
+\see NativePacket
+*/
+template <typename T, typename Kernel>
+void ForEachPacket(std::size_t begin, std::size_t end, const Kernel& kernel)
+{
+    using P = typename NativePacket<T>::Type;
+
+    const std::size_t packetSize = PacketTraits<P>::size;
+
+    std::size_t i = begin;
+
+    for (; i + packetSize <= end; i += packetSize)
+        kernel.template Run<P>(i);
+
+    /* Less than 'packetSize' elements remain, so the scalar loop has a constant trip count bound */
+    const std::size_t tail = end - i;
+
+    for (std::size_t k = 0; k < packetSize - 1 && k < tail; ++k)
+        kernel.template Run<T>(i + k);
+}
+
+
+} // /namespace Details
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
@@ -35,6 +35,9 @@ class SphericalT
 
     public:
 
+        //! Specifies the typename of the scalar components.
+        using ScalarType = T;
+
         #ifndef GS_DISABLE_AUTO_INIT
         SphericalT() :
             radius { T(0) },
@@ -46,12 +49,7 @@ class SphericalT
         SphericalT() = default;
         #endif
 
-        SphericalT(const SphericalT<T>& rhs) :
-            radius { rhs.radius },
-            theta  { rhs.theta  },
-            phi    { rhs.phi    }
-        {
-        }
+        SphericalT(const SphericalT<T>&) = default;
 
         SphericalT(const T& radius, const T& theta, const T& phi) :
             radius { radius },
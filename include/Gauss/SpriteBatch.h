@@ -0,0 +1,298 @@
+/*
+ * SpriteBatch.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_SPRITE_BATCH_H
+#define GS_SPRITE_BATCH_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/Parallel.h>
+#include <Gauss/SIMDPacket.h>
+
+#include <cstddef>
+#include <vector>
+
+
+namespace Gs
+{
+
+
+/**
+\brief Vertex of a sprite quad, as written by the "GenerateSpriteVertices" function.
+\tparam T Specifies the data type of the components. This should be float or double.
+*/
+template <typename T>
+struct SpriteVertexT
+{
+    Vector2T<T> position;   //!< Transformed vertex position.
+    Vector2T<T> texCoord;   //!< Texture coordinate.
+};
+
+
+/**
+\brief Array of 2D sprites in structure-of-arrays (SoA) layout.
+\tparam T Specifies the data type of the components. This should be float or double.
+\remarks Each sprite is a unit quad [0, 1] x [0, 1] which is translated by the negative pivot, scaled, rotated, and finally translated by the position,
+i.e. the same as the affine transformation built with AffineMatrix3T::SetPosition, AffineMatrix3T::SetRotationAndScale, and AffineMatrix3T::Translate(-pivot).
+The scale is therefore the size of the sprite, and the pivot is specified in unit quad coordinates, e.g. (0.5, 0.5) to rotate around the center.
+\see GenerateSpriteVertices
+*/
+template <typename T>
+class SpriteArrayT
+{
+
+    public:
+
+        static_assert(std::is_floating_point<T>::value, "sprite arrays can only be used with floating point types");
+
+        //! Specifies the typename of the scalar components.
+        using ScalarType = T;
+
+        /**
+        \brief Resizes the arrays to the specified number of sprites.
+        \remarks New sprites are unit quads at the origin with the pivot at their left-top corner and the full texture.
+        */
+        void Resize(std::size_t count)
+        {
+            for (std::size_t i = 0; i < 2; ++i)
+            {
+                position[i].resize(count, T(0));
+                scale[i].resize(count, T(1));
+                pivot[i].resize(count, T(0));
+            }
+
+            for (std::size_t i = 0; i < 4; ++i)
+                texCoord[i].resize(count, (i < 2 ? T(0) : T(1)));
+
+            rotation.resize(count, T(0));
+        }
+
+        //! Returns the number of sprites.
+        std::size_t Size() const
+        {
+            return rotation.size();
+        }
+
+        void SetPosition(std::size_t sprite, const Vector2T<T>& v)
+        {
+            position[0][sprite] = v.x;
+            position[1][sprite] = v.y;
+        }
+
+        Vector2T<T> GetPosition(std::size_t sprite) const
+        {
+            return Vector2T<T>(position[0][sprite], position[1][sprite]);
+        }
+
+        void SetScale(std::size_t sprite, const Vector2T<T>& v)
+        {
+            scale[0][sprite] = v.x;
+            scale[1][sprite] = v.y;
+        }
+
+        Vector2T<T> GetScale(std::size_t sprite) const
+        {
+            return Vector2T<T>(scale[0][sprite], scale[1][sprite]);
+        }
+
+        //! Sets the pivot (in unit quad coordinates) of the specified sprite.
+        void SetPivot(std::size_t sprite, const Vector2T<T>& v)
+        {
+            pivot[0][sprite] = v.x;
+            pivot[1][sprite] = v.y;
+        }
+
+        Vector2T<T> GetPivot(std::size_t sprite) const
+        {
+            return Vector2T<T>(pivot[0][sprite], pivot[1][sprite]);
+        }
+
+        //! Sets the texture coordinate rectangle of the specified sprite.
+        void SetTexCoords(std::size_t sprite, const Vector2T<T>& min, const Vector2T<T>& max)
+        {
+            texCoord[0][sprite] = min.x;
+            texCoord[1][sprite] = min.y;
+            texCoord[2][sprite] = max.x;
+            texCoord[3][sprite] = max.y;
+        }
+
+        std::vector<T> position[2];     //!< Positions (X, Y).
+        std::vector<T> rotation;        //!< Rotation angles (in radians).
+        std::vector<T> scale[2];        //!< Scaling, i.e. the sizes of the sprites (X, Y).
+        std::vector<T> pivot[2];        //!< Pivots in unit quad coordinates (X, Y).
+        std::vector<T> texCoord[4];     //!< Texture coordinate rectangles (min X, min Y, max X, max Y).
+
+};
+
+
+namespace Details
+{
+
+
+// Fused quad generation kernel for packets of sprites.
+template <typename T>
+class SpriteVertexKernel
+{
+
+    public:
+
+        SpriteVertexKernel(const SpriteArrayT<T>& sprites, SpriteVertexT<T>* vertices, const AffineMatrix3T<T>& transform) :
+            sprites_  { sprites                         },
+            vertices_ { reinterpret_cast<T*>(vertices)  },
+            g00_      { transform.At(0, 0)              },
+            g01_      { transform.At(0, 1)              },
+            g02_      { transform.At(0, 2)              },
+            g10_      { transform.At(1, 0)              },
+            g11_      { transform.At(1, 1)              },
+            g12_      { transform.At(1, 2)              }
+        {
+        }
+
+        template <typename P>
+        void Run(std::size_t i) const
+        {
+            using Traits = PacketTraits<P>;
+
+            const auto& s = sprites_;
+
+            /* Columns of the sprite rotation and scaling */
+            P sn, cs;
+            PacketSinCos(Traits::Load(&s.rotation[i]), sn, cs);
+
+            const P sx = Traits::Load(&s.scale[0][i]), sy = Traits::Load(&s.scale[1][i]);
+            const P c0x = sx * cs, c0y = sx * sn;
+            const P c1x = -(sy * sn), c1y = sy * cs;
+
+            /* Origin of the unit quad in world space: position - R*S*pivot */
+            const P px = Traits::Load(&s.pivot[0][i]), py = Traits::Load(&s.pivot[1][i]);
+            const P ox = Traits::Load(&s.position[0][i]) - (c0x * px + c1x * py);
+            const P oy = Traits::Load(&s.position[1][i]) - (c0y * px + c1y * py);
+
+            /* Fold in the global transformation */
+            const P g00 = P(g00_), g01 = P(g01_), g10 = P(g10_), g11 = P(g11_);
+
+            const P ax = g00 * c0x + g01 * c0y, ay = g10 * c0x + g11 * c0y;
+            const P bx = g00 * c1x + g01 * c1y, by = g10 * c1x + g11 * c1y;
+
+            const P v0x = PacketMulAdd(g00, ox, PacketMulAdd(g01, oy, P(g02_)));
+            const P v0y = PacketMulAdd(g10, ox, PacketMulAdd(g11, oy, P(g12_)));
+
+            /* Write the corners (0, 0), (1, 0), (1, 1), and (0, 1) */
+            const P u0 = Traits::Load(&s.texCoord[0][i]), v0 = Traits::Load(&s.texCoord[1][i]);
+            const P u1 = Traits::Load(&s.texCoord[2][i]), v1 = Traits::Load(&s.texCoord[3][i]);
+
+            T* out = vertices_ + i*16;
+
+            PacketStoreInterleaved4(out,      16, v0x,           v0y,           u0, v0);
+            PacketStoreInterleaved4(out +  4, 16, v0x + ax,      v0y + ay,      u1, v0);
+            PacketStoreInterleaved4(out +  8, 16, v0x + ax + bx, v0y + ay + by, u1, v1);
+            PacketStoreInterleaved4(out + 12, 16, v0x + bx,      v0y + by,      u0, v1);
+        }
+
+    private:
+
+        const SpriteArrayT<T>&  sprites_;
+        T*                      vertices_;
+        T                       g00_, g01_, g02_;
+        T                       g10_, g11_, g12_;
+
+};
+
+
+} // /namespace Details
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Generates the quad vertices of all sprites of the specified array.
+\param[in] sprites Specifies the sprite array.
+\param[out] vertices Pointer to the vertex buffer. This must have space for at least 'sprites.Size()*4' vertices.
+The corners (0, 0), (1, 0), (1, 1), and (0, 1) of each unit quad are written in this order, with the respective corners of the texture coordinate rectangle.
+\param[in] transform Specifies a global transformation (e.g. a 2D camera) which is folded into each sprite transformation.
+\remarks Single precision sprites are processed in SIMD packets (4 or 8 sprites at once), and the range of sprites is distributed with "Details::ParallelFor".
+\see SpriteArrayT
+*/
+template <typename T>
+void GenerateSpriteVertices(const SpriteArrayT<T>& sprites, SpriteVertexT<T>* vertices, const AffineMatrix3T<T>& transform)
+{
+    static_assert(sizeof(SpriteVertexT<T>) == sizeof(T)*4, "SpriteVertexT<T> must be tightly packed");
+
+    const Details::SpriteVertexKernel<T> kernel(sprites, vertices, transform);
+
+    Details::ParallelFor(
+        sprites.Size(), 4096,
+        [&kernel](std::size_t begin, std::size_t end, std::size_t)
+        {
+            Details::ForEachPacket<T>(begin, end, kernel);
+        }
+    );
+}
+
+//! Generates the quad vertices of all sprites of the specified array without global transformation.
+template <typename T>
+void GenerateSpriteVertices(const SpriteArrayT<T>& sprites, SpriteVertexT<T>* vertices)
+{
+    GenerateSpriteVertices(sprites, vertices, AffineMatrix3T<T>());
+}
+
+/**
+\brief Generates the quad vertices of all sprites and folds in the specified planar projection, i.e. the vertex positions are written in clip space.
+\param[in] projection Specifies the projection matrix. This must be an affine projection in the XY plane, such as the matrices from ProjectionMatrix4T::Planar.
+Only the X and Y rows are used, since the sprites lie in the plane Z = 0 and W remains 1.
+\see ProjectionMatrix4T::Planar
+*/
+template <typename T>
+void GenerateSpriteVertices(const SpriteArrayT<T>& sprites, SpriteVertexT<T>* vertices, const Matrix<T, 4, 4>& projection)
+{
+    AffineMatrix3T<T> transform;
+
+    transform.At(0, 0) = projection.At(0, 0);
+    transform.At(0, 1) = projection.At(0, 1);
+    transform.At(0, 2) = projection.At(0, 3);
+
+    transform.At(1, 0) = projection.At(1, 0);
+    transform.At(1, 1) = projection.At(1, 1);
+    transform.At(1, 2) = projection.At(1, 3);
+
+    GenerateSpriteVertices(sprites, vertices, transform);
+}
+
+/**
+\brief Generates the quad vertices of all sprites and folds in the specified sparse projection, e.g. from ProjectionMatrix4T::Orthogonal.
+\see GenerateSpriteVertices(const SpriteArrayT<T>&, SpriteVertexT<T>*, const Matrix<T, 4, 4>&)
+*/
+template <typename T>
+void GenerateSpriteVertices(const SpriteArrayT<T>& sprites, SpriteVertexT<T>* vertices, const ProjectionMatrix4T<T>& projection)
+{
+    Matrix<T, 4, 4> m;
+    Details::ProjectionToMatrix4(m, projection);
+    GenerateSpriteVertices(sprites, vertices, m);
+}
+
+
+/* --- Type Alias --- */
+
+using SpriteVertex      = SpriteVertexT<Real>;
+using SpriteVertexf     = SpriteVertexT<float>;
+using SpriteVertexd     = SpriteVertexT<double>;
+
+using SpriteArray       = SpriteArrayT<Real>;
+using SpriteArrayf      = SpriteArrayT<float>;
+using SpriteArrayd      = SpriteArrayT<double>;
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
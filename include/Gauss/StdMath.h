@@ -11,6 +11,7 @@
 
 #include "Vector.h"
 #include "Matrix.h"
+#include "SIMDPacket.h"
 #include <cmath>
 #include <functional>
 
@@ -19,6 +20,228 @@ namespace Gs
 {
 
 
+namespace Details
+{
+
+
+/*
+Element-wise operations of the GLSL/HLSL built-in functions, written once for scalars and SIMD packets.
+Each operation is a function object with a member function template for the packet type 'P'.
+*/
+
+struct ShaderMinOp
+{
+    template <typename P>
+    P operator () (const P& a, const P& b) const
+    {
+        return PacketMin(a, b);
+    }
+};
+
+struct ShaderMaxOp
+{
+    template <typename P>
+    P operator () (const P& a, const P& b) const
+    {
+        return PacketMax(a, b);
+    }
+};
+
+struct ShaderAbsOp
+{
+    template <typename P>
+    P operator () (const P& x) const
+    {
+        return PacketAbs(x);
+    }
+};
+
+struct ShaderSignOp
+{
+    template <typename P>
+    P operator () (const P& x) const
+    {
+        return PacketSign(x);
+    }
+};
+
+// GLSL: fract(x) = x - floor(x)
+struct ShaderFractOp
+{
+    template <typename P>
+    P operator () (const P& x) const
+    {
+        return x - PacketFloor(x);
+    }
+};
+
+// GLSL: mod(x, y) = x - y * floor(x / y), i.e. the result has the sign of y (unlike std::fmod).
+struct ShaderModOp
+{
+    template <typename P>
+    P operator () (const P& x, const P& y) const
+    {
+        return x - y * PacketFloor(x / y);
+    }
+};
+
+struct ShaderStepOp
+{
+    template <typename P>
+    P operator () (const P& edge, const P& x) const
+    {
+        return PacketStep(edge, x);
+    }
+};
+
+struct ShaderFmaOp
+{
+    template <typename P>
+    P operator () (const P& a, const P& b, const P& c) const
+    {
+        return PacketMulAdd(a, b, c);
+    }
+};
+
+struct ShaderRoundOp
+{
+    template <typename P>
+    P operator () (const P& x) const
+    {
+        return PacketRound(x);
+    }
+};
+
+struct ShaderTruncOp
+{
+    template <typename P>
+    P operator () (const P& x) const
+    {
+        return PacketTrunc(x);
+    }
+};
+
+struct ShaderInverseSqrtOp
+{
+    template <typename P>
+    P operator () (const P& x) const
+    {
+        return P(1) / PacketSqrt(x);
+    }
+};
+
+struct ShaderRsqrtOp
+{
+    template <typename P>
+    P operator () (const P& x) const
+    {
+        return PacketRsqrt(x);
+    }
+};
+
+// Packet type for the remaining elements after the native packets, i.e. SSE packets for floats when AVX is enabled.
+template <typename T>
+struct ShaderMathTailPacket
+{
+    using Type = T;
+};
+
+#ifdef GS_SIMD_AVX
+
+template <>
+struct ShaderMathTailPacket<float>
+{
+    using Type = PacketF4;
+};
+
+#endif
+
+// Calls 'kernel.template Run<P>(i)' for all elements in [0, n) with the native packets, the tail packets, and the scalar type.
+template <typename T, typename Kernel>
+void ForEachShaderMathPacket(std::size_t n, const Kernel& kernel)
+{
+    using P = typename NativePacket<T>::Type;
+    using Q = typename ShaderMathTailPacket<T>::Type;
+
+    std::size_t i = 0;
+
+    for (; i + PacketTraits<P>::size <= n; i += PacketTraits<P>::size)
+        kernel.template Run<P>(i);
+
+    for (; i + PacketTraits<Q>::size <= n; i += PacketTraits<Q>::size)
+        kernel.template Run<Q>(i);
+
+    for (; i < n; ++i)
+        kernel.template Run<T>(i);
+}
+
+template <typename T, typename Op>
+struct ShaderMathKernel1
+{
+    const T*    x;
+    T*          y;
+    Op          op;
+
+    template <typename P>
+    void Run(std::size_t i) const
+    {
+        PacketTraits<P>::Store(y + i, op(PacketTraits<P>::Load(x + i)));
+    }
+};
+
+template <typename T, typename Op>
+struct ShaderMathKernel2
+{
+    const T*    x1;
+    const T*    x2;
+    T*          y;
+    Op          op;
+
+    template <typename P>
+    void Run(std::size_t i) const
+    {
+        PacketTraits<P>::Store(y + i, op(PacketTraits<P>::Load(x1 + i), PacketTraits<P>::Load(x2 + i)));
+    }
+};
+
+template <typename T, typename Op>
+struct ShaderMathKernel3
+{
+    const T*    x1;
+    const T*    x2;
+    const T*    x3;
+    T*          y;
+    Op          op;
+
+    template <typename P>
+    void Run(std::size_t i) const
+    {
+        PacketTraits<P>::Store(y + i, op(PacketTraits<P>::Load(x1 + i), PacketTraits<P>::Load(x2 + i), PacketTraits<P>::Load(x3 + i)));
+    }
+};
+
+template <typename T, typename Op>
+void ShaderMathTransform(const T* x, T* y, std::size_t n, const Op& op)
+{
+    ForEachShaderMathPacket<T>(n, ShaderMathKernel1<T, Op>{ x, y, op });
+}
+
+template <typename T, typename Op>
+void ShaderMathTransform(const T* x1, const T* x2, T* y, std::size_t n, const Op& op)
+{
+    ForEachShaderMathPacket<T>(n, ShaderMathKernel2<T, Op>{ x1, x2, y, op });
+}
+
+template <typename T, typename Op>
+void ShaderMathTransform(const T* x1, const T* x2, const T* x3, T* y, std::size_t n, const Op& op)
+{
+    ForEachShaderMathPacket<T>(n, ShaderMathKernel3<T, Op>{ x1, x2, x3, y, op });
+}
+
+
+} // /namespace Details
+
+
 /* --- Global Functions --- */
 
 #define GS_DECL_STDMATH_FUNC1(NAME)                             \
@@ -86,8 +309,101 @@ GS_DECL_STDMATH_FUNC1( ceil  )
 GS_DECL_STDMATH_FUNC1( floor )
 
 
+/*
+Element-wise GLSL/HLSL built-in functions. Vectors, matrices, and arrays of floats are processed with SSE/AVX packets.
+The array forms (e.g. "FractArray") take 'count' elements, and the output array may be equal to an input array.
+*/
+
+#define GS_DECL_SHADERMATH_FUNC1(NAME, ARRAYNAME, OP)                                                   \
+    template <typename T, std::size_t N>                                                                \
+    Vector<T, N> NAME(const Vector<T, N>& x)                                                            \
+    {                                                                                                   \
+        Vector<T, N> y { UninitializeTag{} };                                                           \
+        Details::ShaderMathTransform(x.Ptr(), y.Ptr(), N, Details::OP());                               \
+        return y;                                                                                       \
+    }                                                                                                   \
+    template <typename T, std::size_t Rows, std::size_t Cols>                                           \
+    Matrix<T, Rows, Cols> NAME(const Matrix<T, Rows, Cols>& x)                                          \
+    {                                                                                                   \
+        Matrix<T, Rows, Cols> y { UninitializeTag{} };                                                  \
+        Details::ShaderMathTransform(x.Ptr(), y.Ptr(), Rows*Cols, Details::OP());                       \
+        return y;                                                                                       \
+    }                                                                                                   \
+    template <typename T>                                                                               \
+    void ARRAYNAME(const T* x, T* y, std::size_t count)                                                 \
+    {                                                                                                   \
+        Details::ShaderMathTransform(x, y, count, Details::OP());                                       \
+    }
+
+#define GS_DECL_SHADERMATH_FUNC2(NAME, ARRAYNAME, OP)                                                   \
+    template <typename T, std::size_t N>                                                                \
+    Vector<T, N> NAME(const Vector<T, N>& x1, const Vector<T, N>& x2)                                   \
+    {                                                                                                   \
+        Vector<T, N> y { UninitializeTag{} };                                                           \
+        Details::ShaderMathTransform(x1.Ptr(), x2.Ptr(), y.Ptr(), N, Details::OP());                    \
+        return y;                                                                                       \
+    }                                                                                                   \
+    template <typename T, std::size_t Rows, std::size_t Cols>                                           \
+    Matrix<T, Rows, Cols> NAME(const Matrix<T, Rows, Cols>& x1, const Matrix<T, Rows, Cols>& x2)        \
+    {                                                                                                   \
+        Matrix<T, Rows, Cols> y { UninitializeTag{} };                                                  \
+        Details::ShaderMathTransform(x1.Ptr(), x2.Ptr(), y.Ptr(), Rows*Cols, Details::OP());            \
+        return y;                                                                                       \
+    }                                                                                                   \
+    template <typename T>                                                                               \
+    void ARRAYNAME(const T* x1, const T* x2, T* y, std::size_t count)                                   \
+    {                                                                                                   \
+        Details::ShaderMathTransform(x1, x2, y, count, Details::OP());                                  \
+    }
+
+#define GS_DECL_SHADERMATH_FUNC3(NAME, ARRAYNAME, OP)                                                               \
+    template <typename T, std::size_t N>                                                                            \
+    Vector<T, N> NAME(const Vector<T, N>& x1, const Vector<T, N>& x2, const Vector<T, N>& x3)                       \
+    {                                                                                                               \
+        Vector<T, N> y { UninitializeTag{} };                                                                       \
+        Details::ShaderMathTransform(x1.Ptr(), x2.Ptr(), x3.Ptr(), y.Ptr(), N, Details::OP());                      \
+        return y;                                                                                                   \
+    }                                                                                                               \
+    template <typename T, std::size_t Rows, std::size_t Cols>                                                       \
+    Matrix<T, Rows, Cols> NAME(                                                                                     \
+        const Matrix<T, Rows, Cols>& x1, const Matrix<T, Rows, Cols>& x2, const Matrix<T, Rows, Cols>& x3)          \
+    {                                                                                                               \
+        Matrix<T, Rows, Cols> y { UninitializeTag{} };                                                              \
+        Details::ShaderMathTransform(x1.Ptr(), x2.Ptr(), x3.Ptr(), y.Ptr(), Rows*Cols, Details::OP());              \
+        return y;                                                                                                   \
+    }                                                                                                               \
+    template <typename T>                                                                                           \
+    void ARRAYNAME(const T* x1, const T* x2, const T* x3, T* y, std::size_t count)                                  \
+    {                                                                                                               \
+        Details::ShaderMathTransform(x1, x2, x3, y, count, Details::OP());                                          \
+    }
+
+
+GS_DECL_SHADERMATH_FUNC2( min,         MinArray,         ShaderMinOp         )
+GS_DECL_SHADERMATH_FUNC2( max,         MaxArray,         ShaderMaxOp         )
+GS_DECL_SHADERMATH_FUNC1( abs,         AbsArray,         ShaderAbsOp         )
+GS_DECL_SHADERMATH_FUNC1( sign,        SignArray,        ShaderSignOp        )
+
+GS_DECL_SHADERMATH_FUNC1( fract,       FractArray,       ShaderFractOp       )
+GS_DECL_SHADERMATH_FUNC2( mod,         ModArray,         ShaderModOp         )
+GS_DECL_SHADERMATH_FUNC2( step,        StepArray,        ShaderStepOp        )
+GS_DECL_SHADERMATH_FUNC3( fma,         FmaArray,         ShaderFmaOp         )
+
+GS_DECL_SHADERMATH_FUNC1( round,       RoundArray,       ShaderRoundOp       )
+GS_DECL_SHADERMATH_FUNC1( trunc,       TruncArray,       ShaderTruncOp       )
+
+// Precise reciprocal square root (GLSL: inversesqrt), i.e. 1 / sqrt(x).
+GS_DECL_SHADERMATH_FUNC1( inversesqrt, InverseSqrtArray, ShaderInverseSqrtOp )
+
+// Fast reciprocal square root (HLSL: rsqrt) with the hardware estimate and one Newton-Raphson step (about 22 bits for floats). x must be greater than zero.
+GS_DECL_SHADERMATH_FUNC1( rsqrt,       RsqrtArray,       ShaderRsqrtOp       )
+
+
 #undef GS_DECL_STDMATH_FUNC1
 #undef GS_DECL_STDMATH_FUNC2
+#undef GS_DECL_SHADERMATH_FUNC1
+#undef GS_DECL_SHADERMATH_FUNC2
+#undef GS_DECL_SHADERMATH_FUNC3
 
 
 } // /namespace Gs
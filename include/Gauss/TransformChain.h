@@ -0,0 +1,258 @@
+/*
+ * TransformChain.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_TRANSFORM_CHAIN_H
+#define GS_TRANSFORM_CHAIN_H
+
+
+#include "Decl.h"
+#include "Matrix.h"
+#include "Vector.h"
+#include "Algebra.h"
+
+#include <cstddef>
+
+
+namespace Gs
+{
+
+
+/**
+\brief Lazy chain of matrix products, e.g. "P * V * M", which is only evaluated when it is applied to a vector.
+\tparam Prev Specifies the type of the preceding chain. This is 'void' for the first matrix of the chain.
+\tparam T Specifies the data type of the matrix components.
+\tparam Rows Specifies the number of rows of the last matrix in the chain.
+\tparam Cols Specifies the number of columns of the last matrix in the chain.
+\remarks A chain is created with the "Chain" function and extended with the multiplication operator:
+\code
+// Evaluates P*(V*(M*v)), i.e. three matrix-vector products instead of two matrix-matrix products
+Gs::Vector4 p = Gs::Chain(P) * V * M * v;
+
+// Pre-multiplies the chain once, if this is cheaper for the number of vectors
+(Gs::Chain(P) * V * M).Transform(inputVectors, outputVectors, count);
+\endcode
+The chain only stores references to its matrices, so it must not outlive them.
+\see Chain
+*/
+template <class Prev, typename T, std::size_t Rows, std::size_t Cols>
+class TransformChain
+{
+
+    public:
+
+        //! Number of matrices in this chain.
+        static const std::size_t length     = Prev::length + 1;
+
+        //! Number of rows of the chain product.
+        static const std::size_t rows       = Prev::rows;
+
+        //! Number of columns of the chain product.
+        static const std::size_t columns    = Cols;
+
+        //! Number of scalar multiplications to transform a single column vector through the chain (from right to left).
+        static const std::size_t lazyCost   = Prev::lazyCost + Rows*Cols;
+
+        //! Number of scalar multiplications to compute the chain product (from left to right).
+        static const std::size_t productCost = Prev::productCost + Prev::rows*Rows*Cols;
+
+        //! Specifies the typename of the scalar components.
+        using ScalarType    = T;
+
+        //! Typename of the evaluated chain product.
+        using ProductType   = Matrix<T, rows, columns>;
+
+        TransformChain(const Prev& prev, const Matrix<T, Rows, Cols>& mat) :
+            prev_ { prev },
+            mat_  { mat  }
+        {
+        }
+
+        //! Returns the evaluated chain product, i.e. the matrices multiplied from left to right.
+        ProductType Product() const
+        {
+            return prev_.Product() * mat_;
+        }
+
+        //! Returns the specified column vector transformed by this chain from right to left.
+        Vector<T, rows> TransformColumn(const Vector<T, Cols>& vec) const
+        {
+            return prev_.TransformColumn(mat_ * vec);
+        }
+
+        //! Returns the specified row vector transformed by this chain from left to right.
+        Vector<T, Cols> TransformRow(const Vector<T, rows>& vec) const
+        {
+            return prev_.TransformRow(vec) * mat_;
+        }
+
+        /**
+        \brief Returns true if pre-multiplying the chain is cheaper than transforming the specified number of vectors individually.
+        \remarks The chain product costs a fixed number of multiplications, but transforming a vector with the product
+        only costs rows*columns multiplications instead of 'lazyCost' multiplications.
+        */
+        static bool PreferProduct(std::size_t count)
+        {
+            return (length > 1 && productCost + count*rows*columns < count*lazyCost);
+        }
+
+        /**
+        \brief Transforms an array of column vectors by this chain.
+        \param[in] input Pointer to the first input vector.
+        \param[out] output Pointer to the first output vector. This may be equal to 'input' if rows and columns are equal.
+        \param[in] count Number of vectors to transform.
+        \remarks Depending on the number of vectors, the chain is either pre-multiplied once, or each vector is transformed from right to left.
+        \see PreferProduct
+        */
+        void Transform(const Vector<T, Cols>* input, Vector<T, rows>* output, std::size_t count) const
+        {
+            if (PreferProduct(count))
+            {
+                const auto product = Product();
+                for (std::size_t i = 0; i < count; ++i)
+                    output[i] = product * input[i];
+            }
+            else
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                    output[i] = TransformColumn(input[i]);
+            }
+        }
+
+        /**
+        \brief Transforms an array of row vectors by this chain.
+        \see Transform
+        */
+        void TransformRows(const Vector<T, rows>* input, Vector<T, Cols>* output, std::size_t count) const
+        {
+            if (PreferProduct(count))
+            {
+                const auto product = Product();
+                for (std::size_t i = 0; i < count; ++i)
+                    output[i] = input[i] * product;
+            }
+            else
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                    output[i] = TransformRow(input[i]);
+            }
+        }
+
+    private:
+
+        Prev                            prev_;
+        const Matrix<T, Rows, Cols>&    mat_;
+
+};
+
+//! Specialization for the first matrix of a chain.
+template <typename T, std::size_t Rows, std::size_t Cols>
+class TransformChain<void, T, Rows, Cols>
+{
+
+    public:
+
+        static const std::size_t length         = 1;
+        static const std::size_t rows           = Rows;
+        static const std::size_t columns        = Cols;
+        static const std::size_t lazyCost       = Rows*Cols;
+        static const std::size_t productCost    = 0;
+
+        using ScalarType    = T;
+        using ProductType   = Matrix<T, Rows, Cols>;
+
+        explicit TransformChain(const Matrix<T, Rows, Cols>& mat) :
+            mat_ { mat }
+        {
+        }
+
+        const ProductType& Product() const
+        {
+            return mat_;
+        }
+
+        Vector<T, Rows> TransformColumn(const Vector<T, Cols>& vec) const
+        {
+            return mat_ * vec;
+        }
+
+        Vector<T, Cols> TransformRow(const Vector<T, Rows>& vec) const
+        {
+            return vec * mat_;
+        }
+
+        static bool PreferProduct(std::size_t)
+        {
+            return false;
+        }
+
+        void Transform(const Vector<T, Cols>* input, Vector<T, Rows>* output, std::size_t count) const
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                output[i] = mat_ * input[i];
+        }
+
+        void TransformRows(const Vector<T, Rows>* input, Vector<T, Cols>* output, std::size_t count) const
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                output[i] = input[i] * mat_;
+        }
+
+    private:
+
+        const Matrix<T, Rows, Cols>& mat_;
+
+};
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Starts a lazy transform chain with the specified matrix.
+\see TransformChain
+*/
+template <typename T, std::size_t Rows, std::size_t Cols>
+TransformChain<void, T, Rows, Cols> Chain(const Matrix<T, Rows, Cols>& mat)
+{
+    return TransformChain<void, T, Rows, Cols>(mat);
+}
+
+
+/* --- Global Operators --- */
+
+//! Appends the matrix 'rhs' to the chain 'lhs'. Nothing is evaluated here.
+template <class Prev, typename T, std::size_t Rows, std::size_t Cols, std::size_t NextCols>
+TransformChain<TransformChain<Prev, T, Rows, Cols>, T, Cols, NextCols> operator * (
+    const TransformChain<Prev, T, Rows, Cols>& lhs, const Matrix<T, Cols, NextCols>& rhs)
+{
+    return TransformChain<TransformChain<Prev, T, Rows, Cols>, T, Cols, NextCols>(lhs, rhs);
+}
+
+//! Transforms the column vector 'rhs' by the chain 'lhs' from right to left.
+template <class Prev, typename T, std::size_t Rows, std::size_t Cols>
+Vector<T, TransformChain<Prev, T, Rows, Cols>::rows> operator * (
+    const TransformChain<Prev, T, Rows, Cols>& lhs, const Vector<T, Cols>& rhs)
+{
+    return lhs.TransformColumn(rhs);
+}
+
+//! Transforms the row vector 'lhs' by the chain 'rhs' from left to right.
+template <class Prev, typename T, std::size_t Rows, std::size_t Cols>
+Vector<T, Cols> operator * (
+    const Vector<T, TransformChain<Prev, T, Rows, Cols>::rows>& lhs, const TransformChain<Prev, T, Rows, Cols>& rhs)
+{
+    return rhs.TransformRow(lhs);
+}
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
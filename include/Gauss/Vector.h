@@ -49,10 +49,7 @@ class Vector
         Vector() = default;
         #endif
 
-        Vector(const Vector<T, N>& rhs)
-        {
-            std::copy(std::begin(rhs.v_), std::end(rhs.v_), v_);
-        }
+        Vector(const Vector<T, N>&) = default;
 
         explicit Vector(const T& scalar)
         {
@@ -47,11 +47,7 @@ class Vector<T, 2>
         Vector() = default;
         #endif
 
-        Vector(const Vector<T, 2>& rhs) :
-            x { rhs.x },
-            y { rhs.y }
-        {
-        }
+        Vector(const Vector<T, 2>&) = default;
 
         explicit Vector(const Vector<T, 3>& rhs) :
             x { rhs.x },
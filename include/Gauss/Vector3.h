@@ -49,12 +49,7 @@ class Vector<T, 3>
         Vector() = default;
         #endif
 
-        Vector(const Vector<T, 3>& rhs) :
-            x { rhs.x },
-            y { rhs.y },
-            z { rhs.z }
-        {
-        }
+        Vector(const Vector<T, 3>&) = default;
 
         explicit Vector(const Vector<T, 4>& rhs) :
             x { rhs.x },
@@ -0,0 +1,562 @@
+/*
+ * Vector3A.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_VECTOR3A_H
+#define GS_VECTOR3A_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/SIMD.h>
+
+#include <cmath>
+#include <cstddef>
+
+
+namespace Gs
+{
+
+
+namespace Details
+{
+
+
+/*
+Component-wise operations on 16 byte aligned arrays of four components, where the 4th component is ignored.
+The generic implementation only operates on the first three components.
+*/
+template <typename T>
+struct Vector3AOps
+{
+    static void Add(T* r, const T* a, const T* b)
+    {
+        r[0] = a[0] + b[0];
+        r[1] = a[1] + b[1];
+        r[2] = a[2] + b[2];
+    }
+
+    static void Sub(T* r, const T* a, const T* b)
+    {
+        r[0] = a[0] - b[0];
+        r[1] = a[1] - b[1];
+        r[2] = a[2] - b[2];
+    }
+
+    static void Mul(T* r, const T* a, const T* b)
+    {
+        r[0] = a[0] * b[0];
+        r[1] = a[1] * b[1];
+        r[2] = a[2] * b[2];
+    }
+
+    static void Div(T* r, const T* a, const T* b)
+    {
+        r[0] = a[0] / b[0];
+        r[1] = a[1] / b[1];
+        r[2] = a[2] / b[2];
+    }
+
+    static void Scale(T* r, const T* a, const T& s)
+    {
+        r[0] = a[0] * s;
+        r[1] = a[1] * s;
+        r[2] = a[2] * s;
+    }
+
+    static void Negate(T* r, const T* a)
+    {
+        r[0] = -a[0];
+        r[1] = -a[1];
+        r[2] = -a[2];
+    }
+
+    static T Dot(const T* a, const T* b)
+    {
+        return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+    }
+
+    static void Cross(T* r, const T* a, const T* b)
+    {
+        const T x = a[1]*b[2] - b[1]*a[2];
+        const T y = b[0]*a[2] - a[0]*b[2];
+        const T z = a[0]*b[1] - b[0]*a[1];
+        r[0] = x;
+        r[1] = y;
+        r[2] = z;
+    }
+
+    static void Normalize(T* r)
+    {
+        T len = Dot(r, r);
+        if (len != T(0) && len != T(1))
+        {
+            len = T(1) / std::sqrt(len);
+            Scale(r, r, len);
+        }
+    }
+};
+
+#ifdef GS_SIMD_SSE2
+
+// SSE implementation for float, which operates on all four lanes at once.
+template <>
+struct Vector3AOps<float>
+{
+    static void Add(float* r, const float* a, const float* b)
+    {
+        _mm_store_ps(r, _mm_add_ps(_mm_load_ps(a), _mm_load_ps(b)));
+    }
+
+    static void Sub(float* r, const float* a, const float* b)
+    {
+        _mm_store_ps(r, _mm_sub_ps(_mm_load_ps(a), _mm_load_ps(b)));
+    }
+
+    static void Mul(float* r, const float* a, const float* b)
+    {
+        _mm_store_ps(r, _mm_mul_ps(_mm_load_ps(a), _mm_load_ps(b)));
+    }
+
+    static void Div(float* r, const float* a, const float* b)
+    {
+        /* Divide the 4th lane by one to avoid 0/0 in the padding */
+        const __m128 wOne = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, 0x3f800000));
+        const __m128 mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+        _mm_store_ps(r, _mm_div_ps(_mm_load_ps(a), _mm_or_ps(_mm_and_ps(_mm_load_ps(b), mask), wOne)));
+    }
+
+    static void Scale(float* r, const float* a, const float& s)
+    {
+        _mm_store_ps(r, _mm_mul_ps(_mm_load_ps(a), _mm_set1_ps(s)));
+    }
+
+    static void Negate(float* r, const float* a)
+    {
+        _mm_store_ps(r, _mm_xor_ps(_mm_load_ps(a), _mm_set1_ps(-0.0f)));
+    }
+
+    // Returns the dot product of the first three lanes in all four lanes.
+    static __m128 Dot3(__m128 a, __m128 b)
+    {
+        #ifdef GS_SIMD_SSE4_1
+        return _mm_dp_ps(a, b, 0x7f);
+        #else
+        const __m128 m = _mm_mul_ps(a, b);
+        const __m128 x = _mm_shuffle_ps(m, m, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m128 y = _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m128 z = _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 2, 2, 2));
+        return _mm_add_ps(_mm_add_ps(x, y), z);
+        #endif
+    }
+
+    static float Dot(const float* a, const float* b)
+    {
+        return _mm_cvtss_f32(Dot3(_mm_load_ps(a), _mm_load_ps(b)));
+    }
+
+    static void Cross(float* r, const float* a, const float* b)
+    {
+        /* (a * b.yzx - a.yzx * b).yzx */
+        const __m128 va     = _mm_load_ps(a);
+        const __m128 vb     = _mm_load_ps(b);
+        const __m128 aYZX   = _mm_shuffle_ps(va, va, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 bYZX   = _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 c      = _mm_sub_ps(_mm_mul_ps(va, bYZX), _mm_mul_ps(aYZX, vb));
+        _mm_store_ps(r, _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1)));
+    }
+
+    static void Normalize(float* r)
+    {
+        const __m128 v      = _mm_load_ps(r);
+        const __m128 lenSq  = Dot3(v, v);
+        const float  len    = _mm_cvtss_f32(lenSq);
+        if (len != 0.0f && len != 1.0f)
+            _mm_store_ps(r, _mm_div_ps(v, _mm_sqrt_ps(lenSq)));
+    }
+};
+
+#endif // /GS_SIMD_SSE2
+
+
+} // /namespace Details
+
+
+/**
+\brief 3D vector class with components: x, y, and z, which is padded to 16 bytes.
+\tparam T Specifies the data type of the vector components. This should be float or double.
+\remarks In contrast to Vector3T, this vector occupies an entire SSE register for float, so it can be loaded and stored with aligned instructions.
+The 4th component 'w' is only padding: it is initialized with zero, but its value after arithmetic operations is unspecified.
+This type is implicitly convertible from and to Vector3T, so it is meant for hot data (e.g. particle positions),
+while Vector3T remains the compact type for storage and vertex buffers.
+\see Vector3T
+*/
+template <typename T>
+class alignas(16) Vector3AT
+{
+
+    public:
+
+        //! Specifies the typename of the scalar components.
+        using ScalarType = T;
+
+        //! Specifies the number of vector components.
+        static const std::size_t components = 3;
+
+        #ifndef GS_DISABLE_AUTO_INIT
+        Vector3AT() :
+            x { T(0) },
+            y { T(0) },
+            z { T(0) },
+            w { T(0) }
+        {
+        }
+        #else
+        Vector3AT() = default;
+        #endif
+
+        Vector3AT(const Vector3AT<T>&) = default;
+
+        explicit Vector3AT(const T& scalar) :
+            x { scalar },
+            y { scalar },
+            z { scalar },
+            w { T(0)   }
+        {
+        }
+
+        Vector3AT(const T& x, const T& y, const T& z) :
+            x { x    },
+            y { y    },
+            z { z    },
+            w { T(0) }
+        {
+        }
+
+        Vector3AT(const Vector3T<T>& rhs) :
+            x { rhs.x },
+            y { rhs.y },
+            z { rhs.z },
+            w { T(0)  }
+        {
+        }
+
+        explicit Vector3AT(UninitializeTag)
+        {
+            // do nothing
+        }
+
+        Vector3AT<T>& operator = (const Vector3AT<T>&) = default;
+
+        operator Vector3T<T> () const
+        {
+            return Vector3T<T>(x, y, z);
+        }
+
+        Vector3AT<T>& operator += (const Vector3AT<T>& rhs)
+        {
+            Details::Vector3AOps<T>::Add(Ptr(), Ptr(), rhs.Ptr());
+            return *this;
+        }
+
+        Vector3AT<T>& operator -= (const Vector3AT<T>& rhs)
+        {
+            Details::Vector3AOps<T>::Sub(Ptr(), Ptr(), rhs.Ptr());
+            return *this;
+        }
+
+        Vector3AT<T>& operator *= (const Vector3AT<T>& rhs)
+        {
+            Details::Vector3AOps<T>::Mul(Ptr(), Ptr(), rhs.Ptr());
+            return *this;
+        }
+
+        Vector3AT<T>& operator /= (const Vector3AT<T>& rhs)
+        {
+            Details::Vector3AOps<T>::Div(Ptr(), Ptr(), rhs.Ptr());
+            return *this;
+        }
+
+        Vector3AT<T>& operator *= (const T rhs)
+        {
+            Details::Vector3AOps<T>::Scale(Ptr(), Ptr(), rhs);
+            return *this;
+        }
+
+        Vector3AT<T>& operator /= (const T rhs)
+        {
+            Details::Vector3AOps<T>::Scale(Ptr(), Ptr(), T(1) / rhs);
+            return *this;
+        }
+
+        Vector3AT<T> operator - () const
+        {
+            Vector3AT<T> result { UninitializeTag{} };
+            Details::Vector3AOps<T>::Negate(result.Ptr(), Ptr());
+            return result;
+        }
+
+        /**
+        \brief Returns the specified vector component.
+        \param[in] component Specifies the vector component index. This must be 0, 1, or 2.
+        */
+        T& operator [] (std::size_t component)
+        {
+            GS_ASSERT(component < (Vector3AT<T>::components));
+            return *((&x) + component);
+        }
+
+        /**
+        \brief Returns the specified vector component.
+        \param[in] component Specifies the vector component index. This must be 0, 1, or 2.
+        */
+        const T& operator [] (std::size_t component) const
+        {
+            GS_ASSERT(component < (Vector3AT<T>::components));
+            return *((&x) + component);
+        }
+
+        //! Returns the squared length of this vector.
+        T LengthSq() const
+        {
+            return Details::Vector3AOps<T>::Dot(Ptr(), Ptr());
+        }
+
+        //! Returns the length of this vector.
+        T Length() const
+        {
+            return std::sqrt(LengthSq());
+        }
+
+        /**
+        Normalizes this vector to the unit length of 1.
+        \see Normalized
+        \see Length
+        */
+        void Normalize()
+        {
+            Details::Vector3AOps<T>::Normalize(Ptr());
+        }
+
+        /**
+        Returns a normalized instance of this vector.
+        \see Normalize
+        */
+        Vector3AT<T> Normalized() const
+        {
+            auto vec = *this;
+            vec.Normalize();
+            return vec;
+        }
+
+        //! Returns a pointer to the first element of this vector.
+        T* Ptr()
+        {
+            return &x;
+        }
+
+        //! Returns a constant pointer to the first element of this vector.
+        const T* Ptr() const
+        {
+            return &x;
+        }
+
+        T x, y, z;
+
+        //! Padding component. This is not part of the vector and its value is unspecified after arithmetic operations.
+        T w;
+
+};
+
+
+/* --- Global Operators --- */
+
+template <typename T>
+Vector3AT<T> operator + (const Vector3AT<T>& lhs, const Vector3AT<T>& rhs)
+{
+    Vector3AT<T> result { UninitializeTag{} };
+    Details::Vector3AOps<T>::Add(result.Ptr(), lhs.Ptr(), rhs.Ptr());
+    return result;
+}
+
+template <typename T>
+Vector3AT<T> operator - (const Vector3AT<T>& lhs, const Vector3AT<T>& rhs)
+{
+    Vector3AT<T> result { UninitializeTag{} };
+    Details::Vector3AOps<T>::Sub(result.Ptr(), lhs.Ptr(), rhs.Ptr());
+    return result;
+}
+
+template <typename T>
+Vector3AT<T> operator * (const Vector3AT<T>& lhs, const Vector3AT<T>& rhs)
+{
+    Vector3AT<T> result { UninitializeTag{} };
+    Details::Vector3AOps<T>::Mul(result.Ptr(), lhs.Ptr(), rhs.Ptr());
+    return result;
+}
+
+template <typename T>
+Vector3AT<T> operator / (const Vector3AT<T>& lhs, const Vector3AT<T>& rhs)
+{
+    Vector3AT<T> result { UninitializeTag{} };
+    Details::Vector3AOps<T>::Div(result.Ptr(), lhs.Ptr(), rhs.Ptr());
+    return result;
+}
+
+template <typename T>
+Vector3AT<T> operator * (const Vector3AT<T>& lhs, const T& rhs)
+{
+    Vector3AT<T> result { UninitializeTag{} };
+    Details::Vector3AOps<T>::Scale(result.Ptr(), lhs.Ptr(), rhs);
+    return result;
+}
+
+template <typename T>
+Vector3AT<T> operator * (const T& lhs, const Vector3AT<T>& rhs)
+{
+    return rhs * lhs;
+}
+
+template <typename T>
+Vector3AT<T> operator / (const Vector3AT<T>& lhs, const T& rhs)
+{
+    return lhs * (T(1) / rhs);
+}
+
+
+/* --- Global Functions --- */
+
+//! Returns the dot product of the two aligned vectors.
+template <typename T>
+T Dot(const Vector3AT<T>& lhs, const Vector3AT<T>& rhs)
+{
+    return Details::Vector3AOps<T>::Dot(lhs.Ptr(), rhs.Ptr());
+}
+
+//! Returns the cross product of the two aligned vectors.
+template <typename T>
+Vector3AT<T> Cross(const Vector3AT<T>& lhs, const Vector3AT<T>& rhs)
+{
+    Vector3AT<T> result { UninitializeTag{} };
+    Details::Vector3AOps<T>::Cross(result.Ptr(), lhs.Ptr(), rhs.Ptr());
+    return result;
+}
+
+//! Returns the squared length of the aligned vector.
+template <typename T>
+T LengthSq(const Vector3AT<T>& vec)
+{
+    return vec.LengthSq();
+}
+
+//! Returns the length of the aligned vector.
+template <typename T>
+T Length(const Vector3AT<T>& vec)
+{
+    return vec.Length();
+}
+
+//! Normalizes the aligned vector to the unit length of 1.
+template <typename T>
+void Normalize(Vector3AT<T>& vec)
+{
+    vec.Normalize();
+}
+
+/**
+\brief Returns the specified column of the affine matrix as aligned vector.
+\param[in] col Specifies the column index. This must be in the range [0, 3], where the 4th column is the position.
+\remarks The column refers to the column vector convention, i.e. the same as "At(0, col)" to "At(2, col)".
+*/
+template <typename T>
+Vector3AT<T> GetColumnA(const AffineMatrix4T<T>& mat, std::size_t col)
+{
+    return Vector3AT<T>(mat.At(0, col), mat.At(1, col), mat.At(2, col));
+}
+
+//! Sets the specified column of the affine matrix from an aligned vector. \see GetColumnA
+template <typename T>
+void SetColumnA(AffineMatrix4T<T>& mat, std::size_t col, const Vector3AT<T>& vec)
+{
+    mat.At(0, col) = vec.x;
+    mat.At(1, col) = vec.y;
+    mat.At(2, col) = vec.z;
+}
+
+//! Transforms the aligned vector as point (i.e. including the translation) by the affine matrix.
+template <typename T>
+Vector3AT<T> TransformVector(const AffineMatrix4T<T>& mat, const Vector3AT<T>& vec)
+{
+    return Vector3AT<T>(
+        vec.x*mat.At(0, 0) + vec.y*mat.At(0, 1) + vec.z*mat.At(0, 2) + mat.At(0, 3),
+        vec.x*mat.At(1, 0) + vec.y*mat.At(1, 1) + vec.z*mat.At(1, 2) + mat.At(1, 3),
+        vec.x*mat.At(2, 0) + vec.y*mat.At(2, 1) + vec.z*mat.At(2, 2) + mat.At(2, 3)
+    );
+}
+
+#ifdef GS_SIMD_SSE2
+
+inline Vector3AT<float> TransformVector(const AffineMatrix4T<float>& mat, const Vector3AT<float>& vec)
+{
+    __m128 c0, c1, c2, c3;
+
+    #if defined GS_ROW_VECTORS == defined GS_ROW_MAJOR_STORAGE
+
+    /* Columns are stored consecutively: load 4 floats each, the 4th column is loaded with an offset of one */
+    const float* m = mat.Ptr();
+    c0 = _mm_loadu_ps(m);
+    c1 = _mm_loadu_ps(m + 3);
+    c2 = _mm_loadu_ps(m + 6);
+    c3 = _mm_loadu_ps(m + 8);
+    c3 = _mm_shuffle_ps(c3, c3, _MM_SHUFFLE(3, 3, 2, 1));
+
+    #else
+
+    /* Rows are stored consecutively: transpose the 3x4 matrix */
+    const float* m = mat.Ptr();
+    __m128 r0 = _mm_loadu_ps(m);
+    __m128 r1 = _mm_loadu_ps(m + 4);
+    __m128 r2 = _mm_loadu_ps(m + 8);
+    __m128 r3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    c0 = r0;
+    c1 = r1;
+    c2 = r2;
+    c3 = r3;
+
+    #endif
+
+    const __m128 v = _mm_load_ps(vec.Ptr());
+
+    const __m128 result = _mm_add_ps(
+        _mm_add_ps(_mm_mul_ps(c0, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0))), _mm_mul_ps(c1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)))),
+        _mm_add_ps(_mm_mul_ps(c2, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))), c3)
+    );
+
+    Vector3AT<float> out { UninitializeTag{} };
+    _mm_store_ps(out.Ptr(), result);
+    return out;
+}
+
+#endif // /GS_SIMD_SSE2
+
+
+/* --- Type Alias --- */
+
+using Vector3A  = Vector3AT<Real>;
+using Vector3Af = Vector3AT<float>;
+using Vector3Ad = Vector3AT<double>;
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
@@ -49,13 +49,7 @@ class Vector<T, 4>
         Vector() = default;
         #endif
 
-        Vector(const Vector<T, 4>& rhs) :
-            x { rhs.x },
-            y { rhs.y },
-            z { rhs.z },
-            w { rhs.w }
-        {
-        }
+        Vector(const Vector<T, 4>&) = default;
 
         explicit Vector(const Vector<T, 2>& xy, const Vector<T, 2>& zw) :
             x { xy.x },
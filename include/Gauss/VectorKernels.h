@@ -0,0 +1,326 @@
+/*
+ * VectorKernels.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_VECTOR_KERNELS_H
+#define GS_VECTOR_KERNELS_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/SIMDPacket.h>
+
+#include <cstddef>
+#include <cmath>
+
+
+namespace Gs
+{
+
+
+namespace Details
+{
+
+
+/*
+Reduction kernels for the generic Vector<T, N> class. They operate on packets of the native SIMD type,
+so that large vectors (e.g. feature descriptors with 32, 64, or 128 components) are processed with SSE/AVX.
+*/
+
+// Accumulates the product of 'a' and 'b'.
+struct VectorDotOp
+{
+    template <typename P>
+    P operator () (const P& a, const P& b, const P& sum) const
+    {
+        return PacketMulAdd(a, b, sum);
+    }
+};
+
+// Accumulates the squared difference of 'a' and 'b'.
+struct VectorDistanceSqOp
+{
+    template <typename P>
+    P operator () (const P& a, const P& b, const P& sum) const
+    {
+        const P d = a - b;
+        return PacketMulAdd(d, d, sum);
+    }
+};
+
+/*
+Returns the sum of 'op(a[i], b[i])' for all i in [0, n).
+Vectors with less than 8 components are accumulated sequentially (i.e. with the same rounding as the scalar loop),
+larger vectors are accumulated with four independent packet accumulators to hide the latency of the additions.
+*/
+template <typename T, typename Op>
+T VectorReduce(const T* a, const T* b, std::size_t n, const Op& op)
+{
+    if (n < 8)
+    {
+        T sum = T(0);
+        for (std::size_t i = 0; i < n; ++i)
+            sum = op(a[i], b[i], sum);
+        return sum;
+    }
+
+    using P         = typename NativePacket<T>::Type;
+    using Traits    = PacketTraits<P>;
+
+    const std::size_t w = Traits::size;
+
+    P s0 = T(0), s1 = T(0), s2 = T(0), s3 = T(0);
+
+    std::size_t i = 0;
+
+    for (; i + w*4 <= n; i += w*4)
+    {
+        s0 = op(Traits::Load(a + i      ), Traits::Load(b + i      ), s0);
+        s1 = op(Traits::Load(a + i + w  ), Traits::Load(b + i + w  ), s1);
+        s2 = op(Traits::Load(a + i + w*2), Traits::Load(b + i + w*2), s2);
+        s3 = op(Traits::Load(a + i + w*3), Traits::Load(b + i + w*3), s3);
+    }
+
+    /* Less than four packets remain */
+    const std::size_t numPackets = (n - i) / w;
+
+    for (std::size_t k = 0; k < 3 && k < numPackets; ++k, i += w)
+        s0 = op(Traits::Load(a + i), Traits::Load(b + i), s0);
+
+    /* Horizontal sum of the accumulators */
+    T lanes[w];
+    Traits::Store(lanes, (s0 + s1) + (s2 + s3));
+
+    T sum = T(0);
+    for (std::size_t j = 0; j < w; ++j)
+        sum += lanes[j];
+
+    /* Less than 'w' components remain, so the scalar loop has a constant trip count bound */
+    const std::size_t tail = n - i;
+
+    for (std::size_t k = 0; k < w - 1 && k < tail; ++k)
+        sum = op(a[i + k], b[i + k], sum);
+
+    return sum;
+}
+
+// Reductions with an accumulator type 'A' that can be wider than the component type 'T'.
+template <typename A, typename T>
+struct VectorAccumulator
+{
+    static A Dot(const T* a, const T* b, std::size_t n)
+    {
+        A s0 = A(0), s1 = A(0), s2 = A(0), s3 = A(0);
+        std::size_t i = 0;
+
+        for (; i + 4 <= n; i += 4)
+        {
+            s0 += static_cast<A>(a[i    ]) * static_cast<A>(b[i    ]);
+            s1 += static_cast<A>(a[i + 1]) * static_cast<A>(b[i + 1]);
+            s2 += static_cast<A>(a[i + 2]) * static_cast<A>(b[i + 2]);
+            s3 += static_cast<A>(a[i + 3]) * static_cast<A>(b[i + 3]);
+        }
+
+        const std::size_t tail = n - i;
+
+        for (std::size_t k = 0; k < 3 && k < tail; ++k)
+            s0 += static_cast<A>(a[i + k]) * static_cast<A>(b[i + k]);
+
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    static A DistanceSq(const T* a, const T* b, std::size_t n)
+    {
+        A s0 = A(0), s1 = A(0), s2 = A(0), s3 = A(0);
+        std::size_t i = 0;
+
+        for (; i + 4 <= n; i += 4)
+        {
+            const A d0 = static_cast<A>(a[i    ]) - static_cast<A>(b[i    ]);
+            const A d1 = static_cast<A>(a[i + 1]) - static_cast<A>(b[i + 1]);
+            const A d2 = static_cast<A>(a[i + 2]) - static_cast<A>(b[i + 2]);
+            const A d3 = static_cast<A>(a[i + 3]) - static_cast<A>(b[i + 3]);
+            s0 += d0*d0;
+            s1 += d1*d1;
+            s2 += d2*d2;
+            s3 += d3*d3;
+        }
+
+        const std::size_t tail = n - i;
+
+        for (std::size_t k = 0; k < 3 && k < tail; ++k)
+        {
+            const A d = static_cast<A>(a[i + k]) - static_cast<A>(b[i + k]);
+            s0 += d*d;
+        }
+
+        return (s0 + s1) + (s2 + s3);
+    }
+};
+
+template <typename T>
+struct VectorAccumulator<T, T>
+{
+    static T Dot(const T* a, const T* b, std::size_t n)
+    {
+        return VectorReduce(a, b, n, VectorDotOp());
+    }
+
+    static T DistanceSq(const T* a, const T* b, std::size_t n)
+    {
+        return VectorReduce(a, b, n, VectorDistanceSqOp());
+    }
+};
+
+#ifdef GS_SIMD_SSE2
+
+// Float components with double precision accumulators: converts 8 floats per iteration into four pairs of doubles.
+template <>
+struct VectorAccumulator<double, float>
+{
+    static double Dot(const float* a, const float* b, std::size_t n)
+    {
+        return Reduce<false>(a, b, n);
+    }
+
+    static double DistanceSq(const float* a, const float* b, std::size_t n)
+    {
+        return Reduce<true>(a, b, n);
+    }
+
+    private:
+
+        template <bool Difference>
+        static __m128d Accumulate(__m128 a, __m128 b, __m128d sumLo, __m128d sumHi, __m128d& outHi)
+        {
+            __m128d aLo = _mm_cvtps_pd(a), aHi = _mm_cvtps_pd(_mm_movehl_ps(a, a));
+            __m128d bLo = _mm_cvtps_pd(b), bHi = _mm_cvtps_pd(_mm_movehl_ps(b, b));
+
+            if (Difference)
+            {
+                aLo = _mm_sub_pd(aLo, bLo);
+                aHi = _mm_sub_pd(aHi, bHi);
+                bLo = aLo;
+                bHi = aHi;
+            }
+
+            outHi = _mm_add_pd(sumHi, _mm_mul_pd(aHi, bHi));
+            return _mm_add_pd(sumLo, _mm_mul_pd(aLo, bLo));
+        }
+
+        template <bool Difference>
+        static double Reduce(const float* a, const float* b, std::size_t n)
+        {
+            __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd(), s2 = _mm_setzero_pd(), s3 = _mm_setzero_pd();
+
+            std::size_t i = 0;
+
+            for (; i + 8 <= n; i += 8)
+            {
+                s0 = Accumulate<Difference>(_mm_loadu_ps(a + i    ), _mm_loadu_ps(b + i    ), s0, s1, s1);
+                s2 = Accumulate<Difference>(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4), s2, s3, s3);
+            }
+
+            const __m128d s = _mm_add_pd(_mm_add_pd(s0, s1), _mm_add_pd(s2, s3));
+            double sum = _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+
+            const std::size_t tail = n - i;
+
+            for (std::size_t k = 0; k < 7 && k < tail; ++k)
+            {
+                const double d = (Difference ? static_cast<double>(a[i + k]) - static_cast<double>(b[i + k]) : static_cast<double>(a[i + k]));
+                sum += d * (Difference ? d : static_cast<double>(b[i + k]));
+            }
+
+            return sum;
+        }
+};
+
+#endif // /GS_SIMD_SSE2
+
+
+} // /namespace Details
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Returns the dot product between the two vectors 'lhs' and 'rhs'.
+\remarks For vectors with at least 8 components, this is computed with multiple SIMD accumulators.
+This overload is used instead of the generic "Dot" function template in "Algebra.h".
+*/
+template <typename T, std::size_t N>
+T Dot(const Vector<T, N>& lhs, const Vector<T, N>& rhs)
+{
+    return Details::VectorAccumulator<T, T>::Dot(lhs.Ptr(), rhs.Ptr(), N);
+}
+
+//! Returns the squared length of the specified vector. \see Dot
+template <typename T, std::size_t N>
+T LengthSq(const Vector<T, N>& vec)
+{
+    return Details::VectorAccumulator<T, T>::Dot(vec.Ptr(), vec.Ptr(), N);
+}
+
+//! Returns the length (euclidian norm) of the specified vector. \see Dot
+template <typename T, std::size_t N>
+T Length(const Vector<T, N>& vec)
+{
+    return std::sqrt(LengthSq(vec));
+}
+
+//! Returns the squared distance between the two vectors 'lhs' and 'rhs'. \see Dot
+template <typename T, std::size_t N>
+T DistanceSq(const Vector<T, N>& lhs, const Vector<T, N>& rhs)
+{
+    return Details::VectorAccumulator<T, T>::DistanceSq(lhs.Ptr(), rhs.Ptr(), N);
+}
+
+//! Returns the distance between the two vectors 'lhs' and 'rhs'. \see Dot
+template <typename T, std::size_t N>
+T Distance(const Vector<T, N>& lhs, const Vector<T, N>& rhs)
+{
+    return std::sqrt(DistanceSq(lhs, rhs));
+}
+
+/**
+\brief Returns the dot product between the two vectors 'lhs' and 'rhs' with the accumulator type 'A'.
+\tparam A Specifies the accumulator type, e.g. double for vectors of floats, to reduce the rounding error of long sums.
+\code
+Gs::Vector<float, 128> a, b;
+double d = Gs::AccumulateDot<double>(a, b);
+\endcode
+*/
+template <typename A, typename T, std::size_t N>
+A AccumulateDot(const Vector<T, N>& lhs, const Vector<T, N>& rhs)
+{
+    return Details::VectorAccumulator<A, T>::Dot(lhs.Ptr(), rhs.Ptr(), N);
+}
+
+//! Returns the squared length of the specified vector with the accumulator type 'A'. \see AccumulateDot
+template <typename A, typename T, std::size_t N>
+A AccumulateLengthSq(const Vector<T, N>& vec)
+{
+    return Details::VectorAccumulator<A, T>::Dot(vec.Ptr(), vec.Ptr(), N);
+}
+
+//! Returns the squared distance between the two vectors 'lhs' and 'rhs' with the accumulator type 'A'. \see AccumulateDot
+template <typename A, typename T, std::size_t N>
+A AccumulateDistanceSq(const Vector<T, N>& lhs, const Vector<T, N>& rhs)
+{
+    return Details::VectorAccumulator<A, T>::DistanceSq(lhs.Ptr(), rhs.Ptr(), N);
+}
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,438 @@
+/*
+ * VoxelTraversal.h
+ *
+ * This file is part of the "GaussianLib" project (Copyright (c) 2015 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef GS_VOXEL_TRAVERSAL_H
+#define GS_VOXEL_TRAVERSAL_H
+
+// <<< extension header >>>
+
+
+#include <Gauss/Gauss.h>
+#include <Gauss/SIMDPacket.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+
+namespace Gs
+{
+
+
+/**
+\brief Uniform voxel grid for the "TraverseVoxels" functions.
+\tparam T Specifies the data type of the coordinates. This should be float or double.
+\remarks The grid covers the box [origin, origin + cellSize * resolution], and the cell (0, 0, 0) is located at the grid origin.
+*/
+template <typename T>
+struct VoxelGridT
+{
+    Vector3T<T> origin;     //!< Minimum corner of the grid.
+    Vector3T<T> cellSize;   //!< Size of each cell.
+    Vector3i    resolution; //!< Number of cells in X, Y, and Z direction.
+};
+
+
+namespace Details
+{
+
+
+// Traversal state of a single ray (Amanatides-Woo).
+template <typename T>
+struct VoxelRayState
+{
+    std::int32_t    cell[3];
+    std::int32_t    step[3];
+    T               tNext[3];
+    T               tDelta[3];
+    T               tEnter;
+    T               tEnd;
+};
+
+// Clips the ray against the grid bounds and computes the initial traversal state. Returns false if the ray misses the grid.
+template <typename T>
+bool SetupVoxelRay(
+    const VoxelGridT<T>&    grid,
+    const Vector3T<T>&      origin,
+    const Vector3T<T>&      direction,
+    const T&                tMin,
+    const T&                tMax,
+    VoxelRayState<T>&       state)
+{
+    const T infinity = std::numeric_limits<T>::max();
+
+    T t0 = tMin, t1 = tMax;
+
+    for (std::size_t a = 0; a < 3; ++a)
+    {
+        if (grid.resolution[a] <= 0)
+            return false;
+
+        const T lo = grid.origin[a];
+        const T hi = grid.origin[a] + grid.cellSize[a] * static_cast<T>(grid.resolution[a]);
+
+        if (direction[a] != T(0))
+        {
+            T ta = (lo - origin[a]) / direction[a];
+            T tb = (hi - origin[a]) / direction[a];
+            if (ta > tb)
+                std::swap(ta, tb);
+            t0 = std::max(t0, ta);
+            t1 = std::min(t1, tb);
+        }
+        else if (origin[a] < lo || origin[a] > hi)
+            return false;
+    }
+
+    if (t0 > t1)
+        return false;
+
+    state.tEnter    = t0;
+    state.tEnd      = t1;
+
+    for (std::size_t a = 0; a < 3; ++a)
+    {
+        /* Determine start cell at the entry point */
+        const T p = origin[a] + direction[a] * t0;
+        const auto c = std::max(0, std::min(grid.resolution[a] - 1, static_cast<std::int32_t>(std::floor((p - grid.origin[a]) / grid.cellSize[a]))));
+
+        state.cell[a] = c;
+
+        if (direction[a] > T(0))
+        {
+            state.step[a]   = 1;
+            state.tNext[a]  = (grid.origin[a] + static_cast<T>(c + 1) * grid.cellSize[a] - origin[a]) / direction[a];
+            state.tDelta[a] = grid.cellSize[a] / direction[a];
+        }
+        else if (direction[a] < T(0))
+        {
+            state.step[a]   = -1;
+            state.tNext[a]  = (grid.origin[a] + static_cast<T>(c) * grid.cellSize[a] - origin[a]) / direction[a];
+            state.tDelta[a] = -grid.cellSize[a] / direction[a];
+        }
+        else
+        {
+            state.step[a]   = 0;
+            state.tNext[a]  = infinity;
+            state.tDelta[a] = infinity;
+        }
+    }
+
+    return true;
+}
+
+// Returns the axis of the next step, i.e. the axis with the nearest cell boundary.
+template <typename T>
+std::size_t NextVoxelAxis(const T (&tNext)[3])
+{
+    if (tNext[0] < tNext[1])
+        return (tNext[0] < tNext[2] ? 0 : 2);
+    else
+        return (tNext[1] < tNext[2] ? 1 : 2);
+}
+
+/*
+Packet traversal of ray batches: each lane of the packet holds one ray, and when a ray terminates,
+its lane is refilled with the next ray of the batch, so the packet stays occupied even for incoherent rays.
+The cells are stored as floating-point values to step them with the same packet instructions.
+*/
+template <typename T, typename P, typename Visitor>
+void TraverseVoxelPackets(
+    const VoxelGridT<T>&    grid,
+    const Vector3T<T>*      origins,
+    const Vector3T<T>*      directions,
+    std::size_t             count,
+    const T&                maxDistance,
+    Visitor&                visitor)
+{
+    using Traits = PacketTraits<P>;
+
+    static const std::size_t N = Traits::size;
+
+    T cell[3][N], step[3][N], tNext[3][N], tDelta[3][N], tEnter[N], tEnd[N];
+    T visitCell[3][N], visitEnter[N], tExit[N];
+    std::size_t ray[N];
+    bool active[N];
+
+    std::size_t nextRay = 0;
+
+    auto refill = [&](std::size_t lane)
+    {
+        active[lane] = false;
+        while (nextRay < count && !active[lane])
+        {
+            VoxelRayState<T> s;
+            if (SetupVoxelRay(grid, origins[nextRay], directions[nextRay], T(0), maxDistance, s))
+            {
+                for (std::size_t a = 0; a < 3; ++a)
+                {
+                    cell[a][lane]   = static_cast<T>(s.cell[a]);
+                    step[a][lane]   = static_cast<T>(s.step[a]);
+                    tNext[a][lane]  = s.tNext[a];
+                    tDelta[a][lane] = s.tDelta[a];
+                }
+                tEnter[lane]    = s.tEnter;
+                tEnd[lane]      = s.tEnd;
+                ray[lane]       = nextRay;
+                active[lane]    = true;
+            }
+            ++nextRay;
+        }
+        if (!active[lane])
+        {
+            /* Keep unused lanes finite */
+            for (std::size_t a = 0; a < 3; ++a)
+            {
+                cell[a][lane]   = T(0);
+                step[a][lane]   = T(0);
+                tNext[a][lane]  = T(0);
+                tDelta[a][lane] = T(0);
+            }
+            tEnter[lane]    = T(0);
+            tEnd[lane]      = T(0);
+        }
+    };
+
+    std::size_t numActive = 0;
+    for (std::size_t lane = 0; lane < N; ++lane)
+    {
+        refill(lane);
+        if (active[lane])
+            ++numActive;
+    }
+
+    const P zero = P(T(0)), one = P(T(1));
+
+    while (numActive > 0)
+    {
+        /* Exit distance of the current cells */
+        const P tn0 = Traits::Load(tNext[0]), tn1 = Traits::Load(tNext[1]), tn2 = Traits::Load(tNext[2]);
+        const P te  = PacketMin(PacketMin(tn0, tn1), PacketMin(tn2, Traits::Load(tEnd)));
+
+        Traits::Store(tExit, te);
+        Traits::Store(visitEnter, Traits::Load(tEnter));
+
+        /* Step all lanes along the axis with the nearest cell boundary, and keep the current cells for the visitor */
+        const P selX = PacketSelectPositive(PacketMin(tn1 - tn0, tn2 - tn0), one, zero);
+        const P selY = (one - selX) * PacketSelectPositive(tn2 - tn1, one, zero);
+        const P selZ = one - selX - selY;
+
+        const P sel[3] = { selX, selY, selZ };
+        const P tn[3] = { tn0, tn1, tn2 };
+
+        for (std::size_t a = 0; a < 3; ++a)
+        {
+            const P c = Traits::Load(cell[a]);
+            Traits::Store(visitCell[a], c);
+            Traits::Store(cell[a], PacketMulAdd(sel[a], Traits::Load(step[a]), c));
+            Traits::Store(tNext[a], PacketMulAdd(sel[a], Traits::Load(tDelta[a]), tn[a]));
+        }
+        Traits::Store(tEnter, te);
+
+        /* Visit the cells, and refill the lanes of rays that terminated or left the grid */
+        for (std::size_t lane = 0; lane < N; ++lane)
+        {
+            if (!active[lane])
+                continue;
+
+            const Vector3i c(
+                static_cast<std::int32_t>(visitCell[0][lane]),
+                static_cast<std::int32_t>(visitCell[1][lane]),
+                static_cast<std::int32_t>(visitCell[2][lane])
+            );
+
+            const bool inside =
+            (
+                c.x >= 0 && c.x < grid.resolution.x &&
+                c.y >= 0 && c.y < grid.resolution.y &&
+                c.z >= 0 && c.z < grid.resolution.z
+            );
+
+            if (!inside || !visitor(ray[lane], c, visitEnter[lane], tExit[lane]) || tExit[lane] >= tEnd[lane])
+            {
+                refill(lane);
+                if (!active[lane])
+                    --numActive;
+            }
+        }
+    }
+}
+
+
+} // /namespace Details
+
+
+/* --- Global Functions --- */
+
+/**
+\brief Traverses all cells of a uniform voxel grid that are intersected by the specified ray segment (3D DDA by Amanatides and Woo).
+\param[in] grid Specifies the voxel grid.
+\param[in] origin Specifies the ray origin.
+\param[in] direction Specifies the ray direction. This does not need to be normalized, the ray parameters are in units of this vector.
+\param[in] tMin Specifies the start of the ray segment.
+\param[in] tMax Specifies the end of the ray segment.
+\param[in] visitor Specifies the visitor which is called for each cell in the order of traversal.
+Its signature must be compatible to 'bool visitor(const Vector3i& cell, T tEnter, T tExit)', and it returns false to terminate the traversal.
+\return True if the visitor terminated the traversal (e.g. on a hit), otherwise false.
+*/
+template <typename T, typename Visitor>
+bool TraverseVoxels(
+    const VoxelGridT<T>&    grid,
+    const Vector3T<T>&      origin,
+    const Vector3T<T>&      direction,
+    const T&                tMin,
+    const T&                tMax,
+    Visitor                 visitor)
+{
+    Details::VoxelRayState<T> s;
+    if (!Details::SetupVoxelRay(grid, origin, direction, tMin, tMax, s))
+        return false;
+
+    Vector3i cell(s.cell[0], s.cell[1], s.cell[2]);
+    T tEnter = s.tEnter;
+
+    while (true)
+    {
+        const T tExit = std::min(std::min(s.tNext[0], s.tNext[1]), std::min(s.tNext[2], s.tEnd));
+
+        if (!visitor(cell, tEnter, tExit))
+            return true;
+        if (tExit >= s.tEnd)
+            return false;
+
+        const auto a = Details::NextVoxelAxis(s.tNext);
+
+        cell[a] += s.step[a];
+        if (cell[a] < 0 || cell[a] >= grid.resolution[a])
+            return false;
+
+        tEnter = tExit;
+        s.tNext[a] += s.tDelta[a];
+    }
+}
+
+//! Traverses all cells of a uniform voxel grid that are intersected by the ray segment [0, maxDistance].
+template <typename T, typename Visitor>
+bool TraverseVoxels(
+    const VoxelGridT<T>&    grid,
+    const Vector3T<T>&      origin,
+    const Vector3T<T>&      direction,
+    const T&                maxDistance,
+    Visitor                 visitor)
+{
+    return TraverseVoxels(grid, origin, direction, T(0), maxDistance, visitor);
+}
+
+/**
+\brief Traverses a batch of rays through a uniform voxel grid.
+\param[in] grid Specifies the voxel grid.
+\param[in] origins Pointer to the ray origins.
+\param[in] directions Pointer to the ray directions.
+\param[in] count Specifies the number of rays.
+\param[in] maxDistance Specifies the end of all ray segments, which start at zero.
+\param[in] visitor Specifies the visitor which is called for each cell of each ray.
+Its signature must be compatible to 'bool visitor(std::size_t ray, const Vector3i& cell, T tEnter, T tExit)', and it returns false to terminate the traversal of that ray.
+\remarks Single precision rays are stepped in SIMD packets (4 or 8 rays at once). A lane whose ray terminated is refilled with the next ray,
+so the cells of different rays are visited in interleaved order, but the cells of each ray are still visited in the order of traversal.
+The cell indices are stepped as floating-point values, so the resolution must not exceed 2^24 per axis for single precision.
+\see TraverseVoxels
+*/
+template <typename T, typename Visitor>
+void TraverseVoxelsBatch(
+    const VoxelGridT<T>&    grid,
+    const Vector3T<T>*      origins,
+    const Vector3T<T>*      directions,
+    std::size_t             count,
+    const T&                maxDistance,
+    Visitor                 visitor)
+{
+    Details::TraverseVoxelPackets<T, typename Details::NativePacket<T>::Type>(grid, origins, directions, count, maxDistance, visitor);
+}
+
+/**
+\brief Traverses a two-level brickmap, i.e. a coarse grid of bricks where only the cells of occupied bricks are traversed.
+\param[in] grid Specifies the voxel grid of the fine cells.
+\param[in] brickSize Specifies the number of fine cells per brick in X, Y, and Z direction.
+\param[in] origin Specifies the ray origin.
+\param[in] direction Specifies the ray direction.
+\param[in] maxDistance Specifies the end of the ray segment, which starts at zero.
+\param[in] brickVisitor Specifies the visitor which is called for each brick.
+Its signature must be compatible to 'bool brickVisitor(const Vector3i& brick)', and it returns true if the brick is occupied and its cells must be traversed.
+\param[in] cellVisitor Specifies the visitor which is called for each cell of the occupied bricks.
+Its signature must be compatible to 'bool cellVisitor(const Vector3i& cell, T tEnter, T tExit)', where 'cell' is the index of the fine cell in the entire grid,
+and it returns false to terminate the traversal.
+\return True if the cell visitor terminated the traversal, otherwise false.
+*/
+template <typename T, typename BrickVisitor, typename CellVisitor>
+bool TraverseBrickmap(
+    const VoxelGridT<T>&    grid,
+    const Vector3i&         brickSize,
+    const Vector3T<T>&      origin,
+    const Vector3T<T>&      direction,
+    const T&                maxDistance,
+    BrickVisitor            brickVisitor,
+    CellVisitor             cellVisitor)
+{
+    VoxelGridT<T> brickGrid;
+    brickGrid.origin = grid.origin;
+
+    for (std::size_t a = 0; a < 3; ++a)
+    {
+        brickGrid.cellSize[a]   = grid.cellSize[a] * static_cast<T>(brickSize[a]);
+        brickGrid.resolution[a] = (grid.resolution[a] + brickSize[a] - 1) / brickSize[a];
+    }
+
+    return TraverseVoxels(
+        brickGrid, origin, direction, maxDistance,
+        [&](const Vector3i& brick, T tEnter, T tExit) -> bool
+        {
+            if (!brickVisitor(brick))
+                return true;
+
+            /* Traverse the cells of this brick within the ray segment of the brick */
+            VoxelGridT<T> cellGrid;
+            Vector3i firstCell;
+
+            for (std::size_t a = 0; a < 3; ++a)
+            {
+                firstCell[a]            = brick[a] * brickSize[a];
+                cellGrid.origin[a]      = grid.origin[a] + static_cast<T>(firstCell[a]) * grid.cellSize[a];
+                cellGrid.cellSize[a]    = grid.cellSize[a];
+                cellGrid.resolution[a]  = std::min(brickSize[a], grid.resolution[a] - firstCell[a]);
+            }
+
+            const bool terminated = TraverseVoxels(
+                cellGrid, origin, direction, tEnter, tExit,
+                [&](const Vector3i& cell, T tCellEnter, T tCellExit) -> bool
+                {
+                    return cellVisitor(firstCell + cell, tCellEnter, tCellExit);
+                }
+            );
+
+            return !terminated;
+        }
+    );
+}
+
+
+/* --- Type Alias --- */
+
+using VoxelGrid     = VoxelGridT<Real>;
+using VoxelGridf    = VoxelGridT<float>;
+using VoxelGridd    = VoxelGridT<double>;
+
+
+} // /namespace Gs
+
+
+#endif
+
+
+
+// ================================================================================
@@ -13,6 +13,12 @@
 #include <vector>
 #include <cstdlib>
 #include <complex>
+#include <chrono>
+#include <cstring>
+#include <type_traits>
+#include <memory>
+#include <map>
+#include <stdexcept>
 
 
 #ifdef _MSC_VER
@@ -165,8 +171,10 @@ void affineMatrixTest1()
     //B.MakeInverse();
 
     std::cout << "A = " << std::endl << A << std::endl;
+    #ifdef GS_ENABLE_INVERSE_OPERATOR
     std::cout << "Inv(A) = " << std::endl << (A^-1) << std::endl;
     std::cout << "A*Inv(A) = " << std::endl << A*(A^-1) << std::endl;
+    #endif
     std::cout << "B = " << std::endl << B << std::endl;
     std::cout << "B^T = " << std::endl << B.Transposed() << std::endl;
     std::cout << "Inv(B) = " << std::endl << B.Inverse() << std::endl;
@@ -298,8 +306,10 @@ void projectionTest1()
     std::cout << "Planar      Projection R = " << std::endl << R << std::endl;
     std::cout << "P*P^-1 = " << std::endl << P*P.Inverse() << std::endl;
     std::cout << "a = " << a << std::endl;
+    #ifdef GS_ENABLE_SWIZZLE_OPERATOR
     std::cout << "Project(R, a) = ";
     std::cout << (R * a).xy() << std::endl;
+    #endif
 }
 
 void equalsTest1()
@@ -554,3 +564,2706 @@ void matrixInitializerTest1()
     std::cout << "A = " << std::endl << A << std::endl;
 }
 
+
+void transformChainTest1()
+{
+    auto P = ProjectionMatrix4::Perspective(Real(4)/Real(3), 1.0f, 100.0f, 74.0f*pi/180.0f).ToMatrix4();
+    Matrix4 V, M;
+
+    Translate(V, Vector3(0, -2, 10));
+    RotateFree(M, Vector3(1, 1, 0).Normalized(), pi*0.25f);
+    Scale(M, Vector3(1, 2, 3));
+
+    const Vector4 v(1, 2, 3, 1);
+
+    std::cout << "P * V * M * v         = " << P * V * M * v << std::endl;
+    std::cout << "Chain(P) * V * M * v  = " << Chain(P) * V * M * v << std::endl;
+    std::cout << "v * P * V * M         = " << v * P * V * M << std::endl;
+    std::cout << "v * (Chain(P) * V * M) = " << v * (Chain(P) * V * M) << std::endl;
+
+    std::vector<Vector4> input, output(16);
+    for (int i = 0; i < 16; ++i)
+        input.push_back(Vector4(Real(i), Real(i % 3), Real(-i), 1));
+
+    auto chain = Chain(P) * V * M;
+
+    std::cout << "PreferProduct(1)      = " << std::boolalpha << chain.PreferProduct(1) << std::endl;
+    std::cout << "PreferProduct(16)     = " << std::boolalpha << chain.PreferProduct(16) << std::endl;
+
+    chain.Transform(input.data(), output.data(), 1);
+    std::cout << "Transform(in[0])      = " << output[0] << std::endl;
+
+    chain.Transform(input.data(), output.data(), output.size());
+    std::cout << "Transform(in[15])     = " << output[15] << std::endl;
+    std::cout << "P * V * M * in[15]    = " << P * V * M * input[15] << std::endl;
+}
+
+static void GenerateSphereMesh(std::vector<Vector3>& vertices, std::vector<std::uint32_t>& indices, int segsU, int segsV, Real radius)
+{
+    for (int v = 0; v <= segsV; ++v)
+    {
+        for (int u = 0; u <= segsU; ++u)
+        {
+            const Real theta = pi*Real(v)/Real(segsV), phi = Real(2)*pi*Real(u)/Real(segsU);
+            vertices.push_back(Vector3(Spherical(radius, theta, phi)));
+        }
+    }
+
+    for (int v = 0; v < segsV; ++v)
+    {
+        for (int u = 0; u < segsU; ++u)
+        {
+            const auto i0 = static_cast<std::uint32_t>(v*(segsU + 1) + u), i1 = i0 + 1, i2 = i0 + segsU + 1, i3 = i2 + 1;
+            indices.insert(indices.end(), { i0, i2, i1, i1, i2, i3 });
+        }
+    }
+}
+
+void meshSimplificationTest1()
+{
+    std::vector<Vector3> vertices, outVertices;
+    std::vector<std::uint32_t> indices, outIndices, remap;
+
+    GenerateSphereMesh(vertices, indices, 256, 128, 2.0f);
+
+    const auto startTime = std::chrono::steady_clock::now();
+    auto numTris = SimplifyMesh(vertices.data(), vertices.size(), indices.data(), indices.size(), indices.size()/30, outVertices, outIndices, remap);
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+
+    Real maxDeviation = 0;
+    for (const auto& v : outVertices)
+        maxDeviation = std::max(maxDeviation, std::abs(v.Length() - Real(2)));
+
+    std::cout << "SimplifyMesh: " << indices.size()/3 << " -> " << numTris << " triangles, ";
+    std::cout << vertices.size() << " -> " << outVertices.size() << " vertices (" << duration.count() << " ms)" << std::endl;
+    std::cout << "max. radius deviation = " << maxDeviation << std::endl;
+    std::cout << "remap[1000] = " << remap[1000] << ", Quadric(plane z=1).Evaluate(0, 0, 3) = ";
+    std::cout << Quadric::Plane(Vector3(0, 0, 1), -1).Evaluate(Vector3(0, 0, 3)) << std::endl;
+
+    /* Count edges with more than two faces in the output (must be zero due to the link condition) */
+    std::map<std::pair<std::uint32_t, std::uint32_t>, int> edgeFaces;
+    for (std::size_t i = 0; i < outIndices.size(); i += 3)
+    {
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            const auto a = outIndices[i + j], b = outIndices[i + (j + 1) % 3];
+            ++edgeFaces[std::make_pair(std::min(a, b), std::max(a, b))];
+        }
+    }
+
+    std::size_t nonManifoldEdges = 0;
+    for (const auto& e : edgeFaces)
+    {
+        if (e.second > 2)
+            ++nonManifoldEdges;
+    }
+
+    /* Every edge collapse of a tetrahedron violates the link condition */
+    const Vector3 tetVertices[] = { Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(0, 0, 1) };
+    const std::uint32_t tetIndices[] = { 0, 2, 1, 0, 1, 3, 0, 3, 2, 1, 2, 3 };
+    auto tetTris = SimplifyMesh(tetVertices, 4, tetIndices, 12, 0, outVertices, outIndices, remap);
+
+    std::cout << "non-manifold edges = " << nonManifoldEdges << ", tetrahedron: 4 -> " << tetTris << " triangles (expected 4)" << std::endl;
+
+    #ifdef GS_ENABLE_MULTI_THREADING
+    /* Exceptions in worker threads are re-thrown on the calling thread */
+    bool caught = false;
+    try
+    {
+        Details::ParallelFor(
+            1u << 16, 1,
+            [](std::size_t, std::size_t, std::size_t chunk)
+            {
+                if (chunk > 0)
+                    throw std::runtime_error("worker failure");
+            }
+        );
+    }
+    catch (const std::runtime_error&)
+    {
+        caught = true;
+    }
+    std::cout << "ParallelFor re-throws worker exception: " << (caught || Details::ParallelChunks(1u << 16, 1) == 1 ? "ok" : "FAILED") << std::endl;
+    #endif
+}
+
+void vertexNormalsTest1()
+{
+    std::vector<Vector3> vertices, normals;
+    std::vector<Vector2> texCoords;
+    std::vector<Vector4> tangents;
+    std::vector<std::uint32_t> indices, packedNormals;
+
+    const int segsU = 256, segsV = 128;
+    GenerateSphereMesh(vertices, indices, segsU, segsV, 2.0f);
+
+    for (int v = 0; v <= segsV; ++v)
+    {
+        for (int u = 0; u <= segsU; ++u)
+            texCoords.push_back(Vector2(Real(u)/Real(segsU), Real(v)/Real(segsV)));
+    }
+
+    VertexFaceAdjacency adjacency;
+    adjacency.Build(indices.data(), indices.size(), vertices.size());
+
+    normals.resize(vertices.size());
+    packedNormals.resize(vertices.size());
+    tangents.resize(vertices.size());
+
+    const auto startTime = std::chrono::steady_clock::now();
+    ComputeVertexNormals(vertices.data(), vertices.size(), indices.data(), indices.size(), adjacency, normals.data(), NormalWeighting::Angle);
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    ComputeVertexNormals(vertices.data(), vertices.size(), indices.data(), indices.size(), adjacency, packedNormals.data(), NormalPacking::Octahedral16, NormalWeighting::Angle);
+    ComputeTangentFrames(vertices.data(), texCoords.data(), normals.data(), vertices.size(), indices.data(), indices.size(), adjacency, tangents.data());
+
+    /* Compare normals with the analytic sphere normals (ignoring the poles) */
+    Real maxNormalError = 0, maxPackingError = 0, maxTangentDot = 0;
+    for (std::size_t i = segsU + 1; i + segsU + 1 < vertices.size(); ++i)
+    {
+        const auto n = vertices[i].Normalized();
+        maxNormalError  = std::max(maxNormalError, Distance(n, normals[i]));
+        maxPackingError = std::max(maxPackingError, Distance(normals[i], UnpackOctahedral16<Real>(packedNormals[i])));
+        maxTangentDot   = std::max(maxTangentDot, std::abs(Dot(n, Vector3(tangents[i].x, tangents[i].y, tangents[i].z))));
+    }
+
+    std::cout << "ComputeVertexNormals: " << vertices.size() << " vertices (" << duration.count() << " us)" << std::endl;
+    std::cout << "max. normal error = " << maxNormalError << ", max. octahedral packing error = " << maxPackingError << std::endl;
+    std::cout << "max. |Dot(normal, tangent)| = " << maxTangentDot << ", tangent[1000] = " << tangents[1000] << std::endl;
+    std::cout << "UnpackSnorm10_10_10_2(PackSnorm10_10_10_2(0.5, -0.25, 1, -1)) = ";
+    std::cout << UnpackSnorm10_10_10_2<Real>(PackSnorm10_10_10_2(Vector4(0.5f, -0.25f, 1, -1))) << std::endl;
+}
+
+void rigidBodyTest1()
+{
+    const std::size_t numBodies = 100000;
+
+    RigidBodyArray bodies;
+    bodies.Resize(numBodies);
+
+    for (std::size_t i = 0; i < numBodies; ++i)
+    {
+        bodies.SetInverseMass(i, Real(1), Vector3(1, Real(0.5), Real(0.25)));
+        bodies.SetAngularVelocity(i, Vector3(0, 0, pi*Real(0.5)));
+    }
+
+    /* Body 1 is static, body 2 spins around its intermediate axis (slightly perturbed) */
+    bodies.SetInverseMass(1, 0, Vector3(0));
+    bodies.SetAngularVelocity(2, Vector3(Real(0.01), 5, 0));
+
+    const Vector3 gravity(0, Real(-9.81), 0);
+    const Real dt = Real(0.01);
+
+    const auto startTime = std::chrono::steady_clock::now();
+    for (int step = 0; step < 100; ++step)
+        IntegrateRigidBodies(bodies, dt, gravity, RigidBodyIntegration::SemiImplicitGyroscopic);
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+
+    /* Angular momentum magnitude in world space: |I_world * w| */
+    auto angularMomentum = [&](std::size_t i)
+    {
+        const auto invI = bodies.GetInverseInertiaWorld(i);
+        Matrix3 inertia;
+        Inverse(inertia, invI);
+        return (inertia * bodies.GetAngularVelocity(i)).Length();
+    };
+
+    std::cout << "IntegrateRigidBodies: " << numBodies << " bodies x 100 steps (" << duration.count() << " ms)" << std::endl;
+    std::cout << "position[0] = " << bodies.GetPosition(0) << ", position[1] = " << bodies.GetPosition(1) << std::endl;
+    std::cout << "orientation[0] * (1, 0, 0) = " << (bodies.GetOrientation(0) * Vector3(1, 0, 0)) << std::endl;
+    std::cout << "|L[2]| = " << angularMomentum(2) << " (initial 10), |w[2]| = " << bodies.GetAngularVelocity(2).Length() << std::endl;
+
+    /* Symplectic Euler: free fall is integrated exactly up to the O(dt) position offset, and spinning around a principal axis stays stable */
+    RigidBodyArray eulerBodies;
+    eulerBodies.Resize(3);
+
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        eulerBodies.SetInverseMass(i, Real(1), Vector3(1, Real(0.5), Real(0.25)));
+        eulerBodies.SetAngularVelocity(i, Vector3(0, 0, pi*Real(0.5)));
+    }
+    eulerBodies.SetInverseMass(1, 0, Vector3(0));
+
+    for (int step = 0; step < 100; ++step)
+        IntegrateRigidBodies(eulerBodies, dt, gravity, RigidBodyIntegration::SymplecticEuler);
+
+    /* After 1 s: y = -g/2 * t^2 - g/2 * t * dt (symplectic Euler), rotated by pi/2 around the Z axis */
+    const Real expectedY = gravity.y*Real(0.5) + gravity.y*Real(0.5)*dt;
+    std::cout << "SymplecticEuler: position[0].y = " << eulerBodies.GetPosition(0).y << " (expected " << expectedY << "), position[1] = " << eulerBodies.GetPosition(1) << std::endl;
+    std::cout << "SymplecticEuler: orientation[0] * (1, 0, 0) = " << (eulerBodies.GetOrientation(0) * Vector3(1, 0, 0)) << " (expected (0, 1, 0))";
+    std::cout << ", |w[0]| = " << eulerBodies.GetAngularVelocity(0).Length() << " (expected " << pi*Real(0.5) << ")" << std::endl;
+}
+
+void lieGroupTest1()
+{
+    /* Compare exponential map with angle-axis conversion and the rotation matrix */
+    const Vector3 omega(Real(0.3), Real(-1.2), Real(0.7));
+
+    Quaternion q0, q1;
+    q0.SetAngleAxis(omega.Normalized(), omega.Length());
+    ExpSO3(q1, omega);
+
+    Matrix3 r;
+    ExpSO3(r, omega);
+
+    std::cout << "ExpSO3(omega) = " << q1 << ", SetAngleAxis = " << q0 << std::endl;
+    std::cout << "ExpSO3(omega) as matrix:" << std::endl << r << std::endl;
+    std::cout << "LogSO3(ExpSO3(omega)) = " << LogSO3(q1) << ", LogSO3(matrix) = " << LogSO3(r) << std::endl;
+
+    Vector3 tiny(Real(1e-4), Real(-2e-4), Real(3e-5));
+    ExpSO3(q1, tiny);
+    std::cout << "LogSO3(ExpSO3(tiny)) = " << LogSO3(q1) << std::endl;
+
+    /* Check left Jacobian: Exp(omega + delta) ~ Exp(Jl * delta) * Exp(omega) */
+    const Vector3 delta(Real(1e-3), Real(2e-3), Real(-1e-3));
+    const auto jl = LeftJacobianSO3(omega);
+    const auto lhs = ComposeSO3(omega + delta, Vector3(0));
+    #ifdef GS_ROW_VECTORS
+    const auto rhs = ComposeSO3(delta * jl, omega);
+    #else
+    const auto rhs = ComposeSO3(jl * delta, omega);
+    #endif
+    std::cout << "Jacobian error = " << Distance(lhs, rhs) << ", Jl * Jl^-1 = " << std::endl << (jl * InverseLeftJacobianSO3(omega)) << std::endl;
+
+    /* SE(3) round trip */
+    const Vector3 v(1, 2, 3);
+    AffineMatrix4 m;
+    ExpSE3(m, v, omega);
+
+    Vector3 v2, omega2;
+    LogSE3(m, v2, omega2);
+    std::cout << "LogSE3(ExpSE3(v, omega)) = " << v2 << ", " << omega2 << std::endl;
+
+    /* Batch versions */
+    const std::size_t n = 100000;
+    std::vector<Vector3> omegas(n), logs(n);
+    std::vector<Quaternion> quats(n);
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const Real s = Real(i) / Real(n);
+        omegas[i] = Vector3(std::sin(s*Real(100)), std::cos(s*Real(37)), s - Real(0.5)) * (s*Real(3));
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    ExpSO3Array(omegas.data(), quats.data(), n);
+    LogSO3Array(quats.data(), logs.data(), n);
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    Real maxError = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        Quaternion q;
+        ExpSO3(q, omegas[i]);
+        maxError = std::max(maxError, std::abs(q.x - quats[i].x) + std::abs(q.y - quats[i].y) + std::abs(q.z - quats[i].z) + std::abs(q.w - quats[i].w));
+        maxError = std::max(maxError, Distance(LogSO3(quats[i]), logs[i]));
+    }
+
+    std::cout << "ExpSO3Array + LogSO3Array: " << n << " elements (" << duration.count() << " us), max. error to scalar version = " << maxError << std::endl;
+
+    /* Compare single precision Jacobians with double precision around the switch between Taylor series and closed forms */
+    double maxJacobianError = 0;
+    for (double theta : { 0.05, 0.1, 0.15, 0.2, 0.5, 0.7, 1.0 })
+    {
+        const Vector3d wd = Vector3d(0.6, -0.48, 0.64) * theta;
+        const Vector3f wf(float(wd.x), float(wd.y), float(wd.z));
+        const Vector3f vf(1, 2, 3);
+
+        const auto jf = LeftJacobianSO3(wf), jfInv = InverseLeftJacobianSO3(wf);
+        const auto jd = LeftJacobianSO3(wd), jdInv = InverseLeftJacobianSO3(wd);
+        const auto jf6 = LeftJacobianSE3(vf, wf);
+        const auto jd6 = LeftJacobianSE3(Vector3d(1, 2, 3), wd);
+
+        for (std::size_t r = 0; r < 3; ++r)
+        {
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                maxJacobianError = std::max(maxJacobianError, std::abs(double(jf(r, c)) - jd(r, c)));
+                maxJacobianError = std::max(maxJacobianError, std::abs(double(jfInv(r, c)) - jdInv(r, c)));
+            }
+        }
+
+        for (std::size_t r = 0; r < 6; ++r)
+        {
+            for (std::size_t c = 0; c < 6; ++c)
+                maxJacobianError = std::max(maxJacobianError, std::abs(double(jf6(r, c)) - jd6(r, c)));
+        }
+    }
+
+    /* Compare the SE(3) Jacobians with central differences: Exp(x + d) = Exp(Jl * d) * Exp(x) = Exp(x) * Exp(Jr * d) */
+    double maxSE3JacobianError = 0;
+    for (double theta : { 0.01, 0.05, 0.3, 1.0, 2.0 })
+    {
+        const Vector3d w = Vector3d(0.6, -0.48, 0.64) * theta;
+        const Vector3d t(0.8, -1.5, 0.4);
+
+        const auto jl = LeftJacobianSE3(t, w);
+        const auto jr = RightJacobianSE3(t, w);
+        const double h = 1.0e-6;
+
+        for (std::size_t c = 0; c < 6; ++c)
+        {
+            Vector3d dv(0.0), dw(0.0);
+            (c < 3 ? dv[c] : dw[c - 3]) = h;
+
+            Vector3d lv[2], lw[2], rv[2], rw[2];
+            for (int i = 0; i < 2; ++i)
+            {
+                const double sign = (i == 0 ? 1.0 : -1.0);
+                ComposeSE3(t + dv*sign, w + dw*sign, -t, -w, lv[i], lw[i]);
+                ComposeSE3(-t, -w, t + dv*sign, w + dw*sign, rv[i], rw[i]);
+            }
+
+            for (std::size_t r = 0; r < 3; ++r)
+            {
+                maxSE3JacobianError = std::max(maxSE3JacobianError, std::abs((lv[0][r] - lv[1][r]) / (2.0*h) - jl.At(r,     c)));
+                maxSE3JacobianError = std::max(maxSE3JacobianError, std::abs((lw[0][r] - lw[1][r]) / (2.0*h) - jl.At(r + 3, c)));
+                maxSE3JacobianError = std::max(maxSE3JacobianError, std::abs((rv[0][r] - rv[1][r]) / (2.0*h) - jr.At(r,     c)));
+                maxSE3JacobianError = std::max(maxSE3JacobianError, std::abs((rw[0][r] - rw[1][r]) / (2.0*h) - jr.At(r + 3, c)));
+            }
+        }
+    }
+
+    std::cout << "max. error of float Jacobians (theta in [0.05, 1]) = " << maxJacobianError;
+    std::cout << ", SE(3) Jacobians to central differences (theta in [0.01, 2]) = " << maxSE3JacobianError << std::endl;
+}
+
+void kdTreeTest1()
+{
+    /* Generate pseudo-random points with a linear congruential generator */
+    std::uint32_t seed = 12345;
+    auto random = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return Real(seed >> 8) / Real(1 << 24);
+    };
+
+    const std::size_t numPoints = 200000, numQueries = 100000, k = 8;
+
+    std::vector<Vector3> points(numPoints), queries(numQueries);
+    for (auto& p : points)
+        p = Vector3(random(), random(), random());
+    for (auto& q : queries)
+        q = Vector3(random(), random(), random());
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    KdTree tree;
+    tree.Build(points.data(), points.size());
+
+    const auto buildDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+
+    std::vector<std::uint32_t> indices(numQueries*k);
+    std::vector<Real> distancesSq(numQueries*k);
+
+    startTime = std::chrono::steady_clock::now();
+    tree.FindNearestBatch(queries.data(), numQueries, k, indices.data(), distancesSq.data());
+    const auto queryDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+
+    /* Compare some queries with brute force search */
+    std::size_t mismatches = 0;
+    for (std::size_t q = 0; q < numQueries; q += 5000)
+    {
+        std::vector<Real> bruteForce(numPoints);
+        for (std::size_t i = 0; i < numPoints; ++i)
+            bruteForce[i] = DistanceSq(queries[q], points[i]);
+        std::partial_sort(bruteForce.begin(), bruteForce.begin() + k, bruteForce.end());
+
+        for (std::size_t j = 0; j < k; ++j)
+        {
+            if (bruteForce[j] != distancesSq[q*k + j] || DistanceSq(queries[q], points[indices[q*k + j]]) != distancesSq[q*k + j])
+                ++mismatches;
+        }
+    }
+
+    std::vector<std::uint32_t> radiusIndices;
+    tree.FindRadius(Vector3(Real(0.5)), Real(0.05), radiusIndices);
+
+    std::cout << "KdTree: build " << numPoints << " points (" << buildDuration.count() << " ms), ";
+    std::cout << numQueries << " x " << k << "-NN queries (" << queryDuration.count() << " ms), mismatches = " << mismatches << std::endl;
+    std::cout << "points within radius 0.05 around (0.5, 0.5, 0.5): " << radiusIndices.size() << " (expected approx. " << (numPoints*Real(4)/Real(3)*pi*Real(0.05*0.05*0.05)) << ")" << std::endl;
+}
+
+#define GS_ASSERT_TRIVIALLY_COPYABLE(TYPE)                                                  \
+    static_assert(std::is_trivially_copyable<TYPE>::value, #TYPE " must be trivially copyable");  \
+    static_assert(std::is_standard_layout<TYPE>::value, #TYPE " must have standard layout")
+
+void triviallyCopyableTest1()
+{
+    using Vector5f = Vector<float, 5>;
+
+    GS_ASSERT_TRIVIALLY_COPYABLE(Vector2f);
+    GS_ASSERT_TRIVIALLY_COPYABLE(Vector3f);
+    GS_ASSERT_TRIVIALLY_COPYABLE(Vector4f);
+    GS_ASSERT_TRIVIALLY_COPYABLE(Vector3d);
+    GS_ASSERT_TRIVIALLY_COPYABLE(Vector4i);
+    GS_ASSERT_TRIVIALLY_COPYABLE(Vector5f);
+    GS_ASSERT_TRIVIALLY_COPYABLE(Matrix2f);
+    GS_ASSERT_TRIVIALLY_COPYABLE(Matrix3f);
+    GS_ASSERT_TRIVIALLY_COPYABLE(Matrix4f);
+    GS_ASSERT_TRIVIALLY_COPYABLE(Matrix4d);
+    GS_ASSERT_TRIVIALLY_COPYABLE(Matrix34f);
+    GS_ASSERT_TRIVIALLY_COPYABLE(AffineMatrix3f);
+    GS_ASSERT_TRIVIALLY_COPYABLE(AffineMatrix4f);
+    GS_ASSERT_TRIVIALLY_COPYABLE(AffineMatrix4d);
+    GS_ASSERT_TRIVIALLY_COPYABLE(ProjectionMatrix4f);
+    GS_ASSERT_TRIVIALLY_COPYABLE(Quaternionf);
+    GS_ASSERT_TRIVIALLY_COPYABLE(Quaterniond);
+    GS_ASSERT_TRIVIALLY_COPYABLE(Sphericalf);
+    GS_ASSERT_TRIVIALLY_COPYABLE(Quadricf);
+
+    /* Bulk copy with memcpy */
+    std::vector<Matrix4> src(100000, Matrix4::Identity()), dst(src.size());
+
+    const auto startTime = std::chrono::steady_clock::now();
+    std::memcpy(dst.data(), src.data(), src.size()*sizeof(Matrix4));
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    std::cout << "memcpy of " << src.size() << " Matrix4 (" << duration.count() << " us), dst[1234] = " << std::endl << dst[1234] << std::endl;
+}
+
+#undef GS_ASSERT_TRIVIALLY_COPYABLE
+
+void castArrayTest1()
+{
+    /* Convert simulation transforms (double) to render transforms (float) */
+    std::vector<Matrix4d> simTransforms(100000);
+    for (std::size_t i = 0; i < simTransforms.size(); ++i)
+    {
+        simTransforms[i] = Matrix4d::Identity();
+        Translate(simTransforms[i], Vector3d(double(i), 0.5, -double(i)*0.25));
+    }
+
+    std::vector<Matrix4f> renderTransforms(simTransforms.size());
+
+    auto startTime = std::chrono::steady_clock::now();
+    CastArray(renderTransforms.data(), simTransforms.data(), simTransforms.size());
+    const auto castArrayDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < simTransforms.size(); ++i)
+        renderTransforms[i] = simTransforms[i].Cast<float>();
+    const auto castDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    /* Compare SIMD and scalar conversions including tails, rounding modes and saturation */
+    const float values[] = { 0.5f, 1.5f, -2.5f, -0.7f, 3.2f, 1e10f, -1e10f, std::numeric_limits<float>::quiet_NaN(), 2147483520.0f, -2147483648.0f, 7.9f };
+    const std::size_t numValues = sizeof(values)/sizeof(values[0]);
+
+    std::size_t mismatches = 0;
+
+    for (auto rounding : { CastRounding::Truncate, CastRounding::Nearest, CastRounding::Floor, CastRounding::Ceil })
+    {
+        std::int32_t intValues[numValues];
+        CastArray(intValues, values, numValues, rounding, true);
+
+        double doubleValues[numValues];
+        std::int32_t intValuesFromDouble[numValues];
+        CastArray(doubleValues, values, numValues);
+        CastArray(intValuesFromDouble, doubleValues, numValues, rounding, true);
+
+        for (std::size_t i = 0; i < numValues; ++i)
+        {
+            const auto expected = Details::CastScalar<std::int32_t>(values[i], rounding, true, std::true_type());
+            if (intValues[i] != expected || intValuesFromDouble[i] != expected)
+                ++mismatches;
+        }
+    }
+
+    const Vector4i iv[3] = { Vector4i(1, -2, 3, -4), Vector4i(5, 6, 7, 8), Vector4i(-9, 10, 11, 12) };
+    Vector4f fv[3];
+    CastArray(fv, iv, 3);
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        if (fv[i] != iv[i].Cast<float>())
+            ++mismatches;
+    }
+
+    std::cout << "CastArray of " << simTransforms.size() << " Matrix4d -> Matrix4f (" << castArrayDuration.count() << " us), ";
+    std::cout << "Cast<float> loop (" << castDuration.count() << " us), mismatches = " << mismatches << std::endl;
+    std::cout << "renderTransforms[1234] = " << std::endl << renderTransforms[1234] << std::endl;
+}
+
+void spriteBatchTest1()
+{
+    std::uint32_t seed = 7;
+    auto random = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return Real(seed >> 8) / Real(1 << 24);
+    };
+
+    const std::size_t numSprites = 100000;
+
+    SpriteArray sprites;
+    sprites.Resize(numSprites);
+
+    for (std::size_t i = 0; i < numSprites; ++i)
+    {
+        sprites.SetPosition(i, Vector2(random()*Real(1920), random()*Real(1080)));
+        sprites.rotation[i] = (random()*Real(2) - Real(1))*pi;
+        sprites.SetScale(i, Vector2(Real(8) + random()*Real(64), Real(8) + random()*Real(64)));
+        sprites.SetPivot(i, Vector2(Real(0.5)));
+        sprites.SetTexCoords(i, Vector2(Real(0.25), Real(0)), Vector2(Real(0.5), Real(0.25)));
+    }
+
+    Matrix4 projection;
+    ProjectionMatrix4::Planar(projection, Real(1920), Real(1080));
+
+    std::vector<SpriteVertex> vertices(numSprites*4);
+
+    /* Warm up and measure */
+    GenerateSpriteVertices(sprites, vertices.data(), projection);
+
+    const auto startTime = std::chrono::steady_clock::now();
+    GenerateSpriteVertices(sprites, vertices.data(), projection);
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    /* Compare with per-sprite affine matrices */
+    const Vector2 corners[4] = { Vector2(0, 0), Vector2(1, 0), Vector2(1, 1), Vector2(0, 1) };
+
+    Real maxError = Real(0);
+
+    for (std::size_t i = 0; i < numSprites; i += 97)
+    {
+        AffineMatrix3 m;
+        m.SetPosition(sprites.GetPosition(i));
+        m.SetRotationAndScale(sprites.rotation[i], sprites.GetScale(i));
+        m.Translate(-sprites.GetPivot(i));
+
+        for (std::size_t j = 0; j < 4; ++j)
+        {
+            const auto p = TransformVector(m, corners[j]);
+            const auto clip = TransformVector(projection, Vector4(p.x, p.y, Real(0), Real(1)));
+            maxError = std::max(maxError, std::max(std::abs(clip.x - vertices[i*4 + j].position.x), std::abs(clip.y - vertices[i*4 + j].position.y)));
+        }
+    }
+
+    std::cout << "GenerateSpriteVertices: " << numSprites << " sprites (" << duration.count() << " us), max error = " << maxError << std::endl;
+    std::cout << "sprite[0] vertices: ";
+    for (std::size_t j = 0; j < 4; ++j)
+        std::cout << "(" << vertices[j].position << " | " << vertices[j].texCoord << ") ";
+    std::cout << std::endl;
+
+    /* Sparse orthogonal projection must match its dense 4x4 matrix */
+    const auto ortho = ProjectionMatrix4::Orthogonal(Real(1920), Real(1080), Real(0.1), Real(100));
+
+    std::vector<SpriteVertex> orthoVertices(numSprites*4);
+    GenerateSpriteVertices(sprites, vertices.data(), ortho);
+    GenerateSpriteVertices(sprites, orthoVertices.data(), ortho.ToMatrix4());
+
+    Real maxOrthoError = Real(0);
+    for (std::size_t i = 0; i < numSprites*4; ++i)
+        maxOrthoError = std::max(maxOrthoError, Distance(vertices[i].position, orthoVertices[i].position));
+
+    std::cout << "GenerateSpriteVertices(ProjectionMatrix4): max error to dense matrix = " << maxOrthoError << std::endl;
+}
+
+void voxelTraversalTest1()
+{
+    /* Sparse occupancy: a sphere shell inside a 128^3 grid */
+    const std::int32_t n = 128;
+
+    VoxelGrid grid;
+    grid.origin     = Vector3(Real(-1));
+    grid.cellSize   = Vector3(Real(2) / Real(n));
+    grid.resolution = Vector3i(n, n, n);
+
+    std::vector<bool> occupied(n*n*n);
+    for (std::int32_t z = 0; z < n; ++z)
+    {
+        for (std::int32_t y = 0; y < n; ++y)
+        {
+            for (std::int32_t x = 0; x < n; ++x)
+            {
+                const auto p = grid.origin + (Vector3(Real(x), Real(y), Real(z)) + Vector3(Real(0.5))) * grid.cellSize;
+                const auto r = p.Length();
+                occupied[(z*n + y)*n + x] = (r > Real(0.7) && r < Real(0.75) && p.x < Real(0.5));
+            }
+        }
+    }
+
+    auto isOccupied = [&](const Vector3i& c)
+    {
+        return occupied[(c.z*n + c.y)*n + c.x];
+    };
+
+    /* Rays from a sphere around the grid towards random points near the center */
+    std::uint32_t seed = 42;
+    auto random = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return Real(seed >> 8) / Real(1 << 24);
+    };
+
+    const std::size_t numRays = 100000;
+
+    std::vector<Vector3> origins(numRays), directions(numRays);
+    for (std::size_t i = 0; i < numRays; ++i)
+    {
+        const auto theta = random() * pi * Real(2), phi = std::acos(random() * Real(2) - Real(1));
+        origins[i] = Vector3(std::cos(theta)*std::sin(phi), std::sin(theta)*std::sin(phi), std::cos(phi)) * Real(2);
+        directions[i] = Vector3(random(), random(), random()) * Real(0.4) - Vector3(Real(0.2)) - origins[i];
+    }
+
+    /* Scalar traversal */
+    const Vector3i noHit(-1, -1, -1);
+
+    std::vector<Vector3i> hitsScalar(numRays, noHit), hitsBatch(numRays, noHit), hitsBrickmap(numRays, noHit);
+    std::vector<Real> distScalar(numRays, Real(-1)), distBrickmap(numRays, Real(-1));
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < numRays; ++i)
+    {
+        TraverseVoxels(
+            grid, origins[i], directions[i], Real(1),
+            [&](const Vector3i& cell, Real tEnter, Real) -> bool
+            {
+                if (isOccupied(cell))
+                {
+                    hitsScalar[i] = cell;
+                    distScalar[i] = tEnter;
+                    return false;
+                }
+                return true;
+            }
+        );
+    }
+
+    const auto scalarDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+
+    /* Batch traversal */
+    startTime = std::chrono::steady_clock::now();
+
+    TraverseVoxelsBatch(
+        grid, origins.data(), directions.data(), numRays, Real(1),
+        [&](std::size_t ray, const Vector3i& cell, Real, Real) -> bool
+        {
+            if (isOccupied(cell))
+            {
+                hitsBatch[ray] = cell;
+                return false;
+            }
+            return true;
+        }
+    );
+
+    const auto batchDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+
+    /* Brickmap traversal with 8^3 bricks */
+    const std::int32_t b = 8, nb = n / b;
+
+    std::vector<bool> brickOccupied(nb*nb*nb, false);
+    for (std::int32_t z = 0; z < n; ++z)
+    {
+        for (std::int32_t y = 0; y < n; ++y)
+        {
+            for (std::int32_t x = 0; x < n; ++x)
+            {
+                if (occupied[(z*n + y)*n + x])
+                    brickOccupied[((z/b)*nb + y/b)*nb + x/b] = true;
+            }
+        }
+    }
+
+    startTime = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < numRays; ++i)
+    {
+        TraverseBrickmap(
+            grid, Vector3i(b, b, b), origins[i], directions[i], Real(1),
+            [&](const Vector3i& brick) -> bool
+            {
+                return brickOccupied[(brick.z*nb + brick.y)*nb + brick.x];
+            },
+            [&](const Vector3i& cell, Real tEnter, Real) -> bool
+            {
+                if (isOccupied(cell))
+                {
+                    hitsBrickmap[i] = cell;
+                    distBrickmap[i] = tEnter;
+                    return false;
+                }
+                return true;
+            }
+        );
+    }
+
+    const auto brickmapDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+
+    std::size_t numHits = 0, batchMismatches = 0, brickmapMismatches = 0;
+    for (std::size_t i = 0; i < numRays; ++i)
+    {
+        if (hitsScalar[i] != noHit)
+            ++numHits;
+        if (hitsBatch[i] != hitsScalar[i])
+            ++batchMismatches;
+        if (hitsBrickmap[i] != hitsScalar[i] && std::abs(distBrickmap[i] - distScalar[i]) > Real(1.0e-4))
+            ++brickmapMismatches;
+    }
+
+    std::cout << "TraverseVoxels: " << numRays << " rays through " << n << "^3 grid, hits = " << numHits;
+    std::cout << " (scalar " << scalarDuration.count() << " ms, batch " << batchDuration.count() << " ms, brickmap " << brickmapDuration.count() << " ms)" << std::endl;
+    std::cout << "mismatches: batch = " << batchMismatches << ", brickmap = " << brickmapMismatches << std::endl;
+}
+
+void occlusionCullingTest1()
+{
+    /* Camera at the origin looking along +Z */
+    AffineMatrix4 view;
+    const auto projection = ProjectionMatrix4::Perspective(Real(2), Real(0.1), Real(100), pi*Real(0.5));
+
+    /* Occluder: tessellated wall in the plane Z = 10 with X in [-5, 5] and Y in [-3, 3] */
+    const std::size_t segsX = 40, segsY = 24;
+
+    std::vector<Vector3> vertices;
+    std::vector<std::uint32_t> indices;
+
+    for (std::size_t y = 0; y <= segsY; ++y)
+    {
+        for (std::size_t x = 0; x <= segsX; ++x)
+            vertices.push_back(Vector3(Real(-5) + Real(10)*Real(x)/Real(segsX), Real(-3) + Real(6)*Real(y)/Real(segsY), Real(10)));
+    }
+
+    for (std::size_t y = 0; y < segsY; ++y)
+    {
+        for (std::size_t x = 0; x < segsX; ++x)
+        {
+            const auto i = static_cast<std::uint32_t>(y*(segsX + 1) + x);
+            const auto j = static_cast<std::uint32_t>(i + segsX + 1);
+            indices.insert(indices.end(), { i, i + 1, j + 1, i, j + 1, j });
+        }
+    }
+
+    /* Random occludee boxes */
+    std::uint32_t seed = 1234;
+    auto random = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return Real(seed >> 8) / Real(1 << 24);
+    };
+
+    const std::size_t numBoxes = 100000;
+
+    std::vector<Vector3> boxMins(numBoxes), boxMaxs(numBoxes);
+    for (std::size_t i = 0; i < numBoxes; ++i)
+    {
+        boxMins[i] = Vector3(random()*Real(30) - Real(15), random()*Real(16) - Real(8), Real(2) + random()*Real(28));
+        boxMaxs[i] = boxMins[i] + Vector3(Real(0.5));
+    }
+
+    OcclusionBuffer buffer(256, 128);
+    buffer.SetViewProjection(view, projection);
+
+    auto startTime = std::chrono::steady_clock::now();
+    buffer.RasterizeOccluders(vertices.data(), vertices.size(), indices.data(), indices.size());
+    const auto rasterDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    std::unique_ptr<bool[]> visible(new bool[numBoxes]);
+
+    startTime = std::chrono::steady_clock::now();
+    buffer.TestBoxes(boxMins.data(), boxMaxs.data(), numBoxes, visible.get());
+    const auto testDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    /* Compare with analytic occlusion by the wall, boxes outside the viewport are determined with an empty buffer */
+    OcclusionBuffer emptyBuffer(256, 128);
+    emptyBuffer.SetViewProjection(view, projection);
+
+    std::size_t numOccluded = 0, numExpectedOccluded = 0, falselyOccluded = 0;
+
+    auto compareOcclusion = [&]()
+    {
+        numOccluded = 0;
+        numExpectedOccluded = 0;
+        falselyOccluded = 0;
+
+        for (std::size_t i = 0; i < numBoxes; ++i)
+        {
+            if (!emptyBuffer.TestBox(boxMins[i], boxMaxs[i]))
+                continue;
+
+            bool expectedOccluded = (boxMins[i].z > Real(10));
+            for (std::size_t c = 0; c < 8 && expectedOccluded; ++c)
+            {
+                const Vector3 p(
+                    (c & 1) != 0 ? boxMaxs[i].x : boxMins[i].x,
+                    (c & 2) != 0 ? boxMaxs[i].y : boxMins[i].y,
+                    (c & 4) != 0 ? boxMaxs[i].z : boxMins[i].z
+                );
+                const auto s = Real(10) / p.z;
+                if (std::abs(p.x * s) > Real(5) || std::abs(p.y * s) > Real(3))
+                    expectedOccluded = false;
+            }
+
+            if (!visible[i])
+                ++numOccluded;
+            if (expectedOccluded)
+                ++numExpectedOccluded;
+            if (!visible[i] && !expectedOccluded)
+                ++falselyOccluded;
+        }
+    };
+
+    compareOcclusion();
+
+    std::cout << "OcclusionBuffer: rasterized " << indices.size()/3 << " triangles (" << rasterDuration.count() << " us), ";
+    std::cout << "tested " << numBoxes << " boxes (" << testDuration.count() << " us)" << std::endl;
+    std::cout << "occluded = " << numOccluded << ", expected occluded by wall = " << numExpectedOccluded << ", falsely occluded = " << falselyOccluded << std::endl;
+
+    /* The coverage of adjacent triangles is merged, so the tessellated wall must occlude nearly all boxes behind it (only boxes along its silhouette remain visible) */
+    const bool tessellatedWallOccludes = (numOccluded*10 >= numExpectedOccluded*9 && falselyOccluded == 0);
+    const std::size_t tessellatedOccluded = numOccluded;
+
+    std::cout << "tessellated wall occludes at least 90% of the boxes behind it: " << (tessellatedWallOccludes ? "ok" : "FAILED") << std::endl;
+
+    /* Same wall as coarse occluder with two triangles */
+    const std::uint32_t c0 = 0, c1 = static_cast<std::uint32_t>(segsX), c2 = static_cast<std::uint32_t>((segsY + 1)*(segsX + 1) - 1), c3 = c2 - c1;
+    const std::uint32_t coarseIndices[] = { c0, c1, c2, c0, c2, c3 };
+
+    buffer.Clear();
+    buffer.RasterizeOccluders(vertices.data(), vertices.size(), coarseIndices, 6);
+    buffer.TestBoxes(boxMins.data(), boxMaxs.data(), numBoxes, visible.get());
+
+    compareOcclusion();
+
+    std::cout << "coarse wall: occluded = " << numOccluded << " (expected " << tessellatedOccluded << " as for the tessellated wall), falsely occluded = " << falselyOccluded << std::endl;
+
+    /* Occluder edge through pixel column 128 (X in [128, 128.55] covered), box behind it only in the uncovered part X in [128.7, 128.9] */
+    auto worldX = [&projection](Real screenX, Real z)
+    {
+        return (screenX/Real(256) - Real(0.5)) * Real(2) / projection.m00 * z;
+    };
+
+    const Vector3 edgeVertices[] =
+    {
+        Vector3(Real(-20), Real(-10), Real(10)), Vector3(worldX(Real(128.55), Real(10)), Real(-10), Real(10)),
+        Vector3(worldX(Real(128.55), Real(10)), Real(10), Real(10)), Vector3(Real(-20), Real(10), Real(10)),
+    };
+    const std::uint32_t edgeIndices[] = { 0, 1, 2, 0, 2, 3 };
+
+    buffer.Clear();
+    buffer.RasterizeOccluders(edgeVertices, 4, edgeIndices, 6);
+
+    const bool edgeBoxVisible = buffer.TestBox(
+        Vector3(worldX(Real(128.7), Real(20)), Real(-0.1), Real(20)),
+        Vector3(worldX(Real(128.9), Real(20)), Real(0.1), Real(20.1))
+    );
+    const bool innerBoxVisible = buffer.TestBox(
+        Vector3(worldX(Real(100), Real(20)), Real(-0.1), Real(20)),
+        Vector3(worldX(Real(110), Real(20)), Real(0.1), Real(20.1))
+    );
+
+    std::cout << "box behind partly covered edge pixel visible = " << edgeBoxVisible << " (expected 1), box behind covered pixels visible = " << innerBoxVisible << " (expected 0)" << std::endl;
+}
+
+void polynomialTest1()
+{
+    std::uint32_t seed = 13;
+    auto random = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return Real(seed >> 8) / Real(1 << 24);
+    };
+
+    /*
+    Build quartics from known roots: (x - r0)(x - r1) * ((x - u)^2 + v^2), where v = 0 for four real roots.
+    Every fourth quartic has a complex pair, a double root (r1 = r0), or a cluster of two roots with a gap in [1e-4, 1e-2].
+    */
+    const std::size_t numPolynomials = 100000;
+
+    std::vector<Real> coeffs(numPolynomials*5);
+    std::vector<double> expectedRoots(numPolynomials*4);
+    std::vector<std::size_t> expectedNumRoots(numPolynomials);
+
+    /* Magnitude polynomials (x + |r0|)(x + |r1|) * (x^2 + |s1|*x + u^2 + v^2), which bound the rounding errors of the coefficients (p1 = u^2 - v^2 cancels) */
+    std::vector<double> magnitudes(numPolynomials*4);
+
+    for (std::size_t i = 0; i < numPolynomials; ++i)
+    {
+        Real r[4];
+        for (auto& x : r)
+            x = random()*Real(20) - Real(10);
+
+        const bool complexPair = (i % 4 == 1);
+
+        if (i % 4 == 2)
+            r[1] = r[0];
+        else if (i % 4 == 3)
+            r[1] = r[0] + Real(std::pow(10.0, -4.0 + 2.0*double(random())));
+
+        const Real u = (r[2] + r[3])*Real(0.5), v = (complexPair ? random()*Real(4) + Real(0.5) : (r[3] - r[2])*Real(0.5));
+
+        /* Product of (x^2 - s0*x + p0) and (x^2 - s1*x + p1) */
+        const Real s0 = r[0] + r[1], p0 = r[0]*r[1];
+        const Real s1 = Real(2)*u, p1 = (complexPair ? u*u + v*v : u*u - v*v);
+
+        const Real a = random()*Real(4) + Real(0.25);
+
+        coeffs[i*5 + 0] = a;
+        coeffs[i*5 + 1] = a*(-s0 - s1);
+        coeffs[i*5 + 2] = a*(p0 + p1 + s0*s1);
+        coeffs[i*5 + 3] = a*(-s0*p1 - s1*p0);
+        coeffs[i*5 + 4] = a*(p0*p1);
+
+        magnitudes[i*4 + 0] = std::abs(double(r[0]));
+        magnitudes[i*4 + 1] = std::abs(double(r[1]));
+        magnitudes[i*4 + 2] = std::abs(double(s1));
+        magnitudes[i*4 + 3] = double(u)*double(u) + double(v)*double(v);
+
+        expectedNumRoots[i] = (complexPair ? 2 : 4);
+
+        if (complexPair)
+            r[2] = r[3] = std::numeric_limits<Real>::infinity();
+        std::sort(r, r + 4);
+        std::copy(r, r + 4, &expectedRoots[i*4]);
+    }
+
+    std::vector<Real> roots(numPolynomials*4);
+    std::vector<std::size_t> numRoots(numPolynomials);
+
+    /* Warm up and measure */
+    SolveQuarticArray(coeffs.data(), roots.data(), numRoots.data(), numPolynomials);
+
+    auto startTime = std::chrono::steady_clock::now();
+    SolveQuarticArray(coeffs.data(), roots.data(), numRoots.data(), numPolynomials);
+    const auto batchDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    std::vector<Real> scalarRoots(numPolynomials*4);
+    std::vector<std::size_t> scalarNumRoots(numPolynomials);
+
+    startTime = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < numPolynomials; ++i)
+    {
+        const Real* c = &coeffs[i*5];
+        scalarNumRoots[i] = SolveQuartic(c[0], c[1], c[2], c[3], c[4], &scalarRoots[i*4]);
+    }
+    const auto scalarDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    /*
+    Compare roots against the error bound of their condition: the coefficients are perturbed by rounding errors of about eps*M(|x|),
+    where M is the magnitude polynomial, which moves a root by min(e/|p'(x)|, sqrt(e/|p''(x)/2|)) with e = eps*M(|x|).
+    This covers simple roots as well as clustered and double roots, whose error grows with the square root of the perturbation.
+    Close or double roots may also turn into a complex pair within that bound, in which case the solver must report the two other roots.
+    */
+    const double eps = double(std::numeric_limits<Real>::epsilon()), errorBoundScale = 16.0;
+
+    std::size_t countMismatches = 0, numPairsAsComplex = 0;
+    double maxRelativeError = 0.0, maxBoundedError = 0.0;
+
+    auto rootErrorBound = [&](std::size_t i, double x)
+    {
+        const double* m = &magnitudes[i*4];
+        const double ax = std::abs(x);
+        const double e = eps * errorBoundScale * double(coeffs[i*5]) * (ax + m[0])*(ax + m[1])*(ax*ax + m[2]*ax + m[3]);
+
+        double p[5];
+        for (std::size_t k = 0; k < 5; ++k)
+            p[k] = double(coeffs[i*5 + k]);
+
+        const double d1 = ((4.0*p[0]*x + 3.0*p[1])*x + 2.0*p[2])*x + p[3];
+        const double d2 = (6.0*p[0]*x + 3.0*p[1])*x + p[2];
+
+        return std::min(e / std::abs(d1), std::sqrt(e / std::abs(d2)));
+    };
+
+    /* Returns the max. error relative to the condition bound between the found roots and the expected roots 'cmp' */
+    auto compareRoots = [&](std::size_t i, const Real* found, const double* cmp, std::size_t n, double& relativeError)
+    {
+        double boundedError = 0.0;
+        relativeError = 0.0;
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            const double error = std::abs(double(found[j]) - cmp[j]);
+            relativeError = std::max(relativeError, error / std::max(1.0, std::abs(cmp[j])));
+            boundedError = std::max(boundedError, error / rootErrorBound(i, cmp[j]));
+        }
+        return boundedError;
+    };
+
+    /* Returns true if the expected roots 'x0' and 'x1' are equal within their error bounds, i.e. may be reported as complex pair */
+    auto isClosePair = [&](std::size_t i, double x0, double x1)
+    {
+        return (std::abs(x1 - x0) <= rootErrorBound(i, x0) + rootErrorBound(i, x1));
+    };
+
+    for (std::size_t i = 0; i < numPolynomials; ++i)
+    {
+        const std::size_t numExpected = expectedNumRoots[i];
+        const double* expected = &expectedRoots[i*4];
+
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            const Real* found = (pass == 0 ? &roots[i*4] : &scalarRoots[i*4]);
+            const std::size_t numFound = (pass == 0 ? numRoots[i] : scalarNumRoots[i]);
+
+            /*
+            If the solver reports fewer roots, the missing ones must be close pairs of expected roots (e.g. double roots),
+            and the remaining roots are compared for the best matching choice of pairs
+            */
+            double boundedError = std::numeric_limits<double>::infinity(), relativeError = 0.0, error = 0.0;
+
+            if (numFound == numExpected)
+                boundedError = compareRoots(i, found, expected, numFound, relativeError);
+            else if (numFound + 2 == numExpected)
+            {
+                for (std::size_t j = 1; j < numExpected; ++j)
+                {
+                    if (isClosePair(i, expected[j - 1], expected[j]))
+                    {
+                        double cmp[4];
+                        std::copy(expected, expected + j - 1, cmp);
+                        std::copy(expected + j + 1, expected + numExpected, cmp + j - 1);
+
+                        const double e = compareRoots(i, found, cmp, numFound, error);
+                        if (e < boundedError)
+                        {
+                            boundedError = e;
+                            relativeError = error;
+                        }
+                    }
+                }
+            }
+            else if (numFound + 4 == numExpected)
+            {
+                if ( ( isClosePair(i, expected[0], expected[1]) && isClosePair(i, expected[2], expected[3]) ) ||
+                     ( isClosePair(i, expected[1], expected[2]) && isClosePair(i, expected[0], expected[3]) ) )
+                {
+                    boundedError = 0.0;
+                }
+            }
+
+            if (boundedError == std::numeric_limits<double>::infinity())
+            {
+                ++countMismatches;
+                continue;
+            }
+
+            numPairsAsComplex += (numExpected - numFound)/2;
+            maxRelativeError = std::max(maxRelativeError, relativeError);
+            maxBoundedError = std::max(maxBoundedError, boundedError);
+        }
+    }
+
+    /* Lower degrees including degenerate leading coefficients */
+    Real r[4];
+    const std::size_t n0 = SolveQuadratic(Real(1), Real(-3), Real(2), r);
+    const bool quadraticOk = (n0 == 2 && std::abs(r[0] - Real(1)) < Real(1e-4) && std::abs(r[1] - Real(2)) < Real(1e-4));
+
+    const std::size_t n1 = SolveCubic(Real(2), Real(-12), Real(22), Real(-12), r);
+    const bool cubicOk = (n1 == 3 && std::abs(r[0] - Real(1)) < Real(1e-4) && std::abs(r[1] - Real(2)) < Real(1e-4) && std::abs(r[2] - Real(3)) < Real(1e-4));
+
+    const std::size_t n2 = SolveCubic(Real(1), Real(0), Real(1), Real(-2), r);
+    const bool cubicSingleOk = (n2 == 1 && std::abs(r[0] - Real(1)) < Real(1e-4) && r[1] == std::numeric_limits<Real>::infinity());
+
+    const std::size_t n3 = SolveQuartic(Real(0), Real(0), Real(1), Real(-4), Real(4), r);
+    const bool degenerateOk = (n3 == 2 && std::abs(r[0] - Real(2)) < Real(1e-3) && std::abs(r[1] - Real(2)) < Real(1e-3) && r[2] == std::numeric_limits<Real>::infinity());
+
+    const Real cubicCoeffs[] = { 1, -6, 11, -6, 0, 1, -3, 2, 1, 0, -1, 0 };
+    Real cubicRoots[9];
+    std::size_t cubicNumRoots[3];
+    SolveCubicArray(cubicCoeffs, cubicRoots, cubicNumRoots, 3);
+
+    std::cout << "SolveQuarticArray: " << numPolynomials << " quartics (" << batchDuration.count() << " us), ";
+    std::cout << "SolveQuartic loop (" << scalarDuration.count() << " us)" << std::endl;
+    std::cout << "root count mismatches = " << countMismatches << ", close root pairs reported as complex = " << numPairsAsComplex << ", max relative error = " << maxRelativeError << std::endl;
+    std::cout << "max error relative to the condition bound (including double and clustered roots) = " << maxBoundedError << " (" << (maxBoundedError <= 1.0 && countMismatches == 0 ? "ok" : "FAILED") << ")" << std::endl;
+    std::cout << "quadratic ok = " << quadraticOk << ", cubic ok = " << cubicOk << ", single cubic root ok = " << cubicSingleOk << ", degenerate quartic ok = " << degenerateOk << std::endl;
+    std::cout << "cubic roots: ";
+    for (std::size_t i = 0; i < 3; ++i)
+        std::cout << "{ " << cubicRoots[i*3] << ", " << cubicRoots[i*3 + 1] << ", " << cubicRoots[i*3 + 2] << " } (" << cubicNumRoots[i] << ") ";
+    std::cout << std::endl;
+}
+
+void convexHullTest1()
+{
+    std::uint32_t seed = 17;
+    auto random = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return Real(seed >> 8) / Real(1 << 24);
+    };
+
+    /* Points in an ellipsoid and on a sphere (where all points are on the hull) */
+    std::vector<Vector3> points(200000);
+    for (auto& p : points)
+    {
+        do
+        {
+            p = Vector3(random(), random(), random())*Real(2) - Vector3(1);
+        }
+        while (p.LengthSq() > Real(1));
+        p.x *= Real(3);
+    }
+
+    std::vector<Vector3> spherePoints(20000);
+    for (auto& p : spherePoints)
+    {
+        p = Vector3(random(), random(), random())*Real(2) - Vector3(1);
+        p.Normalize();
+    }
+
+    auto checkHull = [](const std::vector<Vector3>& points, const std::vector<std::uint32_t>& indices, bool containsAllPoints, std::size_t& numVertices) -> bool
+    {
+        /* Each directed edge must occur once, and its reversed edge must also occur (closed 2-manifold) */
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+        for (std::size_t i = 0; i < indices.size(); i += 3)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+                edges.push_back({ indices[i + j], indices[i + (j + 1) % 3] });
+        }
+        std::sort(edges.begin(), edges.end());
+
+        bool valid = (std::adjacent_find(edges.begin(), edges.end()) == edges.end());
+        for (const auto& e : edges)
+        {
+            if (!std::binary_search(edges.begin(), edges.end(), std::make_pair(e.second, e.first)))
+                valid = false;
+        }
+
+        /* Euler's formula, and convexity for a subset of all points or the hull vertices */
+        std::vector<std::uint32_t> vertices(indices);
+        std::sort(vertices.begin(), vertices.end());
+        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+        numVertices = vertices.size();
+
+        if (numVertices + indices.size()/3 != edges.size()/2 + 2)
+            valid = false;
+
+        if (containsAllPoints)
+        {
+            vertices.clear();
+            for (std::size_t j = 0; j < points.size(); j += 97)
+                vertices.push_back(static_cast<std::uint32_t>(j));
+        }
+
+        for (std::size_t i = 0; i < indices.size(); i += 3)
+        {
+            const auto a = points[indices[i]].Cast<double>(), b = points[indices[i + 1]].Cast<double>(), c = points[indices[i + 2]].Cast<double>();
+            const auto normal = Cross(b - a, c - a);
+            for (auto v : vertices)
+            {
+                if (Dot(normal, points[v].Cast<double>() - a) > 1e-9)
+                    valid = false;
+            }
+        }
+
+        return valid;
+    };
+
+    std::vector<std::uint32_t> indices, sphereIndices, simplifiedIndices;
+
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto numTriangles = BuildConvexHull(points.data(), points.size(), indices);
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    BuildConvexHull(spherePoints.data(), spherePoints.size(), sphereIndices);
+    BuildConvexHull(points.data(), points.size(), simplifiedIndices, 32);
+
+    std::size_t numVertices = 0, numSphereVertices = 0, numSimplifiedVertices = 0;
+    const bool valid            = checkHull(points, indices, true, numVertices);
+    const bool sphereValid      = checkHull(spherePoints, sphereIndices, true, numSphereVertices);
+    const bool simplifiedValid  = checkHull(points, simplifiedIndices, false, numSimplifiedVertices);
+
+    /* Degenerated input: coplanar points */
+    std::vector<Vector3> planarPoints(100);
+    for (auto& p : planarPoints)
+        p = Vector3(random(), Real(0.5), random());
+
+    std::vector<std::uint32_t> planarIndices;
+    const auto numPlanarTriangles = BuildConvexHull(planarPoints.data(), planarPoints.size(), planarIndices);
+
+    std::cout << "BuildConvexHull: " << points.size() << " points (" << duration.count() << " us), " << numTriangles << " triangles, ";
+    std::cout << numVertices << " vertices, valid = " << valid << std::endl;
+    std::cout << "sphere hull: " << numSphereVertices << " of " << spherePoints.size() << " vertices, valid = " << sphereValid;
+    std::cout << ", simplified hull: " << numSimplifiedVertices << " vertices, valid = " << simplifiedValid << ", coplanar points: " << numPlanarTriangles << " triangles" << std::endl;
+}
+
+void clippingTest1()
+{
+    std::uint32_t seed = 23;
+    auto random = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return Real(seed >> 8) / Real(1 << 24);
+    };
+
+    /* Ground grid with 256x256 cells in [0, 64] on the XZ plane */
+    const std::uint32_t gridSize = 256;
+    const Real cellSize = Real(0.25);
+
+    std::vector<Vector3> vertices;
+    std::vector<std::uint32_t> indices;
+
+    for (std::uint32_t z = 0; z <= gridSize; ++z)
+    {
+        for (std::uint32_t x = 0; x <= gridSize; ++x)
+            vertices.push_back(Vector3(Real(x)*cellSize, Real(0), Real(z)*cellSize));
+    }
+
+    for (std::uint32_t z = 0; z < gridSize; ++z)
+    {
+        for (std::uint32_t x = 0; x < gridSize; ++x)
+        {
+            const std::uint32_t i = z*(gridSize + 1) + x;
+            indices.insert(indices.end(), { i, i + gridSize + 1, i + 1, i + 1, i + gridSize + 1, i + gridSize + 2 });
+        }
+    }
+
+    auto boxPlanes = [](const Vector3& center, const Vector3& halfSize, Vector4* planes)
+    {
+        planes[0] = Vector4( 1,  0,  0, halfSize.x - center.x);
+        planes[1] = Vector4(-1,  0,  0, halfSize.x + center.x);
+        planes[2] = Vector4( 0,  1,  0, halfSize.y - center.y);
+        planes[3] = Vector4( 0, -1,  0, halfSize.y + center.y);
+        planes[4] = Vector4( 0,  0,  1, halfSize.z - center.z);
+        planes[5] = Vector4( 0,  0, -1, halfSize.z + center.z);
+    };
+
+    auto polygonArea = [](const PolygonClipper& clipper, std::size_t polygon) -> Real
+    {
+        const auto v = clipper.VerticesBegin(polygon);
+        Vector3 areaVector(0);
+        for (std::size_t i = 2; i < clipper.NumVertices(polygon); ++i)
+            areaVector += Cross(v[i - 1] - v[0], v[i] - v[0]);
+        return areaVector.Length() * Real(0.5);
+    };
+
+    PolygonClipper clipper;
+
+    /* Decals with candidate triangles of the overlapped grid cells */
+    const std::size_t numDecals = 4000;
+
+    struct Decal
+    {
+        Vector4                     planes[6];
+        std::vector<std::uint32_t>  indices;
+        Real                        area;
+    };
+
+    std::vector<Decal> decals(numDecals);
+    for (auto& decal : decals)
+    {
+        const Vector3 halfSize(Real(0.25) + random()*Real(1.5), Real(1), Real(0.25) + random()*Real(1.5));
+        const Vector3 center(Real(2) + random()*Real(60), random()*Real(0.5) - Real(0.25), Real(2) + random()*Real(60));
+        boxPlanes(center, halfSize, decal.planes);
+        decal.area = halfSize.x*halfSize.z*Real(4);
+
+        const auto x0 = static_cast<std::uint32_t>((center.x - halfSize.x)/cellSize), x1 = static_cast<std::uint32_t>((center.x + halfSize.x)/cellSize);
+        const auto z0 = static_cast<std::uint32_t>((center.z - halfSize.z)/cellSize), z1 = static_cast<std::uint32_t>((center.z + halfSize.z)/cellSize);
+        for (auto z = z0; z <= z1; ++z)
+        {
+            for (auto x = x0; x <= x1; ++x)
+            {
+                const auto cell = (z*gridSize + x)*6;
+                decal.indices.insert(decal.indices.end(), indices.begin() + cell, indices.begin() + cell + 6);
+            }
+        }
+    }
+
+    std::vector<std::size_t> firstPolygons(numDecals + 1);
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    clipper.Clear();
+    for (std::size_t i = 0; i < numDecals; ++i)
+    {
+        firstPolygons[i] = clipper.NumPolygons();
+        clipper.SetPlanes(decals[i].planes, 6);
+        clipper.ClipTriangles(vertices.data(), decals[i].indices.data(), decals[i].indices.size() / 3);
+    }
+    firstPolygons[numDecals] = clipper.NumPolygons();
+
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    /* All output vertices must be inside of the box, and the clipped area must match the box footprint */
+    std::size_t numCandidates = 0, numInvalid = 0;
+    Real maxAreaError = 0;
+
+    for (std::size_t i = 0; i < numDecals; ++i)
+    {
+        numCandidates += decals[i].indices.size() / 3;
+
+        Real area = 0;
+        for (auto p = firstPolygons[i]; p < firstPolygons[i + 1]; ++p)
+        {
+            for (auto v = clipper.VerticesBegin(p); v != clipper.VerticesEnd(p); ++v)
+            {
+                for (const auto& plane : decals[i].planes)
+                {
+                    if (plane.x*v->x + plane.y*v->y + plane.z*v->z + plane.w < Real(-1e-4))
+                        ++numInvalid;
+                }
+            }
+            area += polygonArea(clipper, p);
+        }
+
+        maxAreaError = std::max(maxAreaError, std::abs(area - decals[i].area) / decals[i].area);
+    }
+
+    std::vector<std::uint32_t> decalIndices;
+    clipper.Triangulate(decalIndices);
+
+    /* Single large decal over the entire grid (distributed over several chunks) */
+    Vector4 largePlanes[6];
+    boxPlanes(Vector3(Real(32), Real(0), Real(32)), Vector3(Real(20.1), Real(1), Real(20.1)), largePlanes);
+
+    clipper.Clear();
+    clipper.SetPlanes(largePlanes, 6);
+    clipper.ClipTriangles(vertices.data(), indices.data(), indices.size() / 3);
+
+    Real largeArea = 0;
+    bool largeOrdered = true;
+    for (std::size_t p = 0; p < clipper.NumPolygons(); ++p)
+    {
+        largeArea += polygonArea(clipper, p);
+        if (p > 0 && clipper.GetSource(p) <= clipper.GetSource(p - 1))
+            largeOrdered = false;
+    }
+
+    /* Convex polygon against a pyramid of planes through the origin */
+    const Vector3 square[4] = { Vector3(-2, -2, 1), Vector3(2, -2, 1), Vector3(2, 2, 1), Vector3(-2, 2, 1) };
+    const Vector4 pyramidPlanes[4] = { Vector4(1, 0, 1, 0), Vector4(-1, 0, 1, 0), Vector4(0, 1, 1, 0), Vector4(0, -1, 1, 0) };
+
+    clipper.Clear();
+    clipper.SetPlanes(pyramidPlanes, 4);
+    const auto numSquareVertices = clipper.ClipPolygon(square, 4);
+    const auto squareArea = polygonArea(clipper, 0);
+
+    std::cout << "PolygonClipper: " << numDecals << " decals, " << numCandidates << " candidate triangles (" << duration.count() << " us), ";
+    std::cout << firstPolygons[numDecals] << " polygons, " << decalIndices.size() / 3 << " triangles, invalid vertices = " << numInvalid;
+    std::cout << ", max. area error = " << maxAreaError << std::endl;
+    std::cout << "large decal: area = " << largeArea << " (expected " << Real(40.2*40.2) << "), ordered = " << largeOrdered;
+    std::cout << ", square vs. pyramid: " << numSquareVertices << " vertices, area = " << squareArea << " (expected 4)" << std::endl;
+}
+
+void rotationGeneratorTest1()
+{
+    /* Small steps over many turns (with resynchronization) */
+    const std::size_t numSteps = 1000000;
+    const Real step = Real(0.001);
+
+    std::vector<Vector2> points(numSteps);
+
+    auto startTime = std::chrono::steady_clock::now();
+    RotationGenerator2 generator(Real(0.5), step);
+    generator.Generate(points.data(), numSteps);
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < numSteps; ++i)
+    {
+        const double angle = 0.5 + static_cast<double>(i) * static_cast<double>(step);
+        points[i] -= Vector2(static_cast<Real>(std::cos(angle)), static_cast<Real>(std::sin(angle)));
+    }
+    const auto durationStd = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    Real maxError = 0;
+    for (const auto& p : points)
+        maxError = std::max(maxError, std::max(std::abs(p.x), std::abs(p.y)));
+
+    /* Same without resynchronization to show the drift */
+    RotationGenerator2 unsyncedGenerator(Real(0.5), step, numSteps);
+    Real maxUnsyncedError = 0;
+    for (std::size_t i = 0; i < numSteps; ++i)
+    {
+        const double angle = 0.5 + static_cast<double>(i) * static_cast<double>(step);
+        const auto p = unsyncedGenerator.Next();
+        maxUnsyncedError = std::max(maxUnsyncedError, static_cast<Real>(std::abs(p.x - std::cos(angle))));
+    }
+
+    /* 3D rotations compared to RotateVectorAroundAxis and quaternions */
+    const Vector3 axis(1, 2, -3), vec(Real(0.3), Real(-1.2), Real(2));
+    const std::size_t numRotations = 1000;
+    const Real rotationStep = Real(0.037);
+
+    std::vector<Vector3> rotated(numRotations);
+    std::vector<Quaternion> rotations(numRotations);
+
+    AxisRotationGenerator axisGenerator(axis, Real(0.2), rotationStep);
+    axisGenerator.Generate(vec, rotated.data(), numRotations);
+    axisGenerator.Reset(Real(0.2), rotationStep);
+    axisGenerator.GenerateQuaternions(rotations.data(), numRotations);
+
+    Real maxAxisError = 0, maxQuaternionError = 0;
+    for (std::size_t i = 0; i < numRotations; ++i)
+    {
+        const auto expected = RotateVectorAroundAxis(vec, axis, Real(0.2) + Real(i)*rotationStep);
+        maxAxisError = std::max(maxAxisError, (rotated[i] - expected).Length());
+        maxQuaternionError = std::max(maxQuaternionError, (rotations[i] * vec - expected).Length());
+    }
+
+    /* Circle, arc, and sphere points */
+    Vector2 circle[8], arc[3];
+    GenerateCirclePoints(Vector2(1, 1), Real(2), circle, 8);
+    GenerateArcPoints(Vector2(0), Real(1), Real(0), Real(pi), arc, 3);
+
+    std::vector<Vector3> sphere(9*16);
+    GenerateSpherePoints(Vector3(0), Real(3), 8, 16, sphere.data());
+
+    Real maxRadiusError = 0;
+    for (const auto& p : sphere)
+        maxRadiusError = std::max(maxRadiusError, std::abs(p.Length() - Real(3)));
+
+    std::cout << "RotationGenerator2: " << numSteps << " steps (" << duration.count() << " us, std::sin/cos: " << durationStd.count() << " us), ";
+    std::cout << "max. error = " << maxError << ", without resync = " << maxUnsyncedError << std::endl;
+    std::cout << "AxisRotationGenerator: max. vector error = " << maxAxisError << ", max. quaternion error = " << maxQuaternionError << std::endl;
+    std::cout << "circle[2] = " << circle[2] << ", arc = { " << arc[0] << ", " << arc[1] << ", " << arc[2] << " }, ";
+    std::cout << "sphere poles = " << sphere.front() << ", " << sphere.back() << ", max. radius error = " << maxRadiusError << std::endl;
+}
+
+void vector3ATest1()
+{
+    static_assert(sizeof(Vector3A) == 4*sizeof(Real) && alignof(Vector3A) >= 16, "Vector3A must be padded to 16 bytes");
+
+    std::uint32_t seed = 31;
+    auto random = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return Real(seed >> 8) / Real(1 << 24) * Real(2) - Real(1);
+    };
+
+    /* Compare against Vector3 */
+    const std::size_t count = 100000;
+
+    std::vector<Vector3> a(count), b(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        a[i] = Vector3(random(), random(), random());
+        b[i] = Vector3(random(), random(), random());
+    }
+
+    AffineMatrix4 mat(
+        Real(0.8), Real(-0.6), 0, 4,
+        Real(0.6), Real(0.8), 0, -2,
+        0, 0, 2, 5
+    );
+
+    Real maxError = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Vector3A u = a[i], v = b[i];
+
+        const Vector3 results[] =
+        {
+            u + v, u - v, u * v, u / v, u * Real(3), -u, Cross(u, v), u.Normalized(), TransformVector(mat, u),
+            Vector3(Dot(u, v), u.Length(), 0),
+        };
+        const Vector3 expected[] =
+        {
+            a[i] + b[i], a[i] - b[i], a[i] * b[i], a[i] / b[i], a[i] * Real(3), -a[i], Cross(a[i], b[i]), a[i].Normalized(), TransformVector(mat, a[i]),
+            Vector3(Dot(a[i], b[i]), a[i].Length(), 0),
+        };
+
+        for (std::size_t j = 0; j < sizeof(results)/sizeof(results[0]); ++j)
+            maxError = std::max(maxError, (results[j] - expected[j]).Length() / std::max(Real(1), expected[j].Length()));
+    }
+
+    /* Column access */
+    auto column = GetColumnA(mat, 3);
+    column.z += Real(1);
+    SetColumnA(mat, 3, column);
+
+    /* Performance: normalized cross products of many vectors */
+    std::vector<Vector3A> aa(a.begin(), a.end()), ba(b.begin(), b.end());
+    std::vector<Vector3> results3(count);
+    std::vector<Vector3A> resultsA(count);
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (int n = 0; n < 10; ++n)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            results3[i] = TransformVector(mat, Cross(a[i], b[i]).Normalized() + a[i]);
+    }
+    const auto duration3 = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    for (int n = 0; n < 10; ++n)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            resultsA[i] = TransformVector(mat, Cross(aa[i], ba[i]).Normalized() + aa[i]);
+    }
+    const auto durationA = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    Real maxResultError = 0;
+    for (std::size_t i = 0; i < count; ++i)
+        maxResultError = std::max(maxResultError, (Vector3(resultsA[i]) - results3[i]).Length());
+
+    std::cout << "Vector3A: size = " << sizeof(Vector3A) << ", max. error = " << maxError << ", column[3] = " << Vector3(GetColumnA(mat, 3));
+    std::cout << ", Vector3 (" << duration3.count() << " us) vs. Vector3A (" << durationA.count() << " us), max. error = " << maxResultError << std::endl;
+}
+
+void descriptorMatchingTest1()
+{
+    using Descriptor = Vector<float, 128>;
+
+    std::uint32_t seed = 41;
+    auto random = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return float(seed >> 8) / float(1 << 24);
+    };
+
+    /* Element-wise operations and reductions compared to scalar loops in double precision */
+    Descriptor a { UninitializeTag{} }, b { UninitializeTag{} };
+    for (std::size_t i = 0; i < Descriptor::components; ++i)
+    {
+        a[i] = random();
+        b[i] = random() + 0.5f;
+    }
+
+    const Descriptor c = (a + b) * b / (b - a * 2.0f) / 3.0f;
+
+    double maxOpError = 0, dot = 0, distSq = 0;
+    for (std::size_t i = 0; i < Descriptor::components; ++i)
+    {
+        const float expected = (a[i] + b[i]) * b[i] / (b[i] - a[i] * 2.0f) / 3.0f;
+        maxOpError = std::max(maxOpError, static_cast<double>(std::abs(c[i] - expected)));
+        dot += static_cast<double>(a[i]) * static_cast<double>(b[i]);
+        distSq += (static_cast<double>(a[i]) - static_cast<double>(b[i])) * (static_cast<double>(a[i]) - static_cast<double>(b[i]));
+    }
+
+    const double dotError           = std::abs(Dot(a, b) - dot) / dot;
+    const double accDotError        = std::abs(AccumulateDot<double>(a, b) - dot) / dot;
+    const double distSqError        = std::abs(DistanceSq(a, b) - distSq) / distSq;
+    const double accDistSqError     = std::abs(AccumulateDistanceSq<double>(a, b) - distSq) / distSq;
+
+    /* Nearest descriptor search: queries are perturbed copies of random descriptors */
+    const std::size_t numDescriptors = 10000, numQueries = 1000;
+
+    std::vector<Descriptor> descriptors(numDescriptors), queries(numQueries);
+    std::vector<std::size_t> expectedIndices(numQueries);
+
+    for (auto& d : descriptors)
+    {
+        for (std::size_t i = 0; i < Descriptor::components; ++i)
+            d[i] = random();
+    }
+
+    for (std::size_t q = 0; q < numQueries; ++q)
+    {
+        expectedIndices[q] = static_cast<std::size_t>(random() * float(numDescriptors - 1));
+        queries[q] = descriptors[expectedIndices[q]];
+        for (std::size_t i = 0; i < Descriptor::components; ++i)
+            queries[q][i] += (random() - 0.5f) * 0.1f;
+    }
+
+    std::vector<DescriptorMatchf> matches(numQueries);
+
+    auto startTime = std::chrono::steady_clock::now();
+    FindNearestDescriptors(queries.data(), numQueries, descriptors.data(), numDescriptors, matches.data());
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    /* Scalar reference for a subset of the queries */
+    startTime = std::chrono::steady_clock::now();
+    std::size_t numMismatches = 0;
+    for (std::size_t q = 0; q < numQueries; q += 10)
+    {
+        std::size_t best = 0;
+        float bestDistSq = std::numeric_limits<float>::max();
+        for (std::size_t j = 0; j < numDescriptors; ++j)
+        {
+            float d = 0.0f;
+            for (std::size_t i = 0; i < Descriptor::components; ++i)
+                d += (queries[q][i] - descriptors[j][i]) * (queries[q][i] - descriptors[j][i]);
+            if (d < bestDistSq)
+            {
+                bestDistSq = d;
+                best = j;
+            }
+        }
+        if (best != matches[q].index || best != expectedIndices[q])
+            ++numMismatches;
+    }
+    const auto durationScalar = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime) * 10;
+
+    std::size_t numCorrect = 0;
+    for (std::size_t q = 0; q < numQueries; ++q)
+    {
+        if (matches[q].index == expectedIndices[q] && matches[q].distanceSq < 0.64f * matches[q].secondDistanceSq)
+            ++numCorrect;
+    }
+
+    const auto single = FindNearestDescriptor(queries[0], descriptors.data(), numDescriptors);
+
+    /* The same query must get identical distances at every position of the batch */
+    std::vector<Descriptor> repeatedQueries(7, queries[1]);
+    std::vector<DescriptorMatchf> repeatedMatches(repeatedQueries.size());
+    FindNearestDescriptors(repeatedQueries.data(), repeatedQueries.size(), descriptors.data(), numDescriptors, repeatedMatches.data());
+
+    bool positionIndependent = true;
+    for (const auto& m : repeatedMatches)
+    {
+        if (m.index != repeatedMatches[0].index || m.distanceSq != DistanceSq(queries[1], descriptors[m.index]) || m.secondDistanceSq != repeatedMatches[0].secondDistanceSq)
+            positionIndependent = false;
+    }
+
+    std::cout << "Vector<float, 128>: max. op error = " << maxOpError << ", Dot error = " << dotError << " (double acc. = " << accDotError << "), ";
+    std::cout << "DistanceSq error = " << distSqError << " (double acc. = " << accDistSqError << ")" << std::endl;
+    std::cout << "FindNearestDescriptors: " << numQueries << " x " << numDescriptors << " (" << duration.count() << " us, scalar approx. " << durationScalar.count() << " us), ";
+    std::cout << "mismatches = " << numMismatches << ", passed ratio test = " << numCorrect << ", single query index = " << single.index << " (expected " << expectedIndices[0] << ")";
+    std::cout << ", batch position independent = " << std::boolalpha << positionIndependent << std::endl;
+}
+
+void integerVectorTest1()
+{
+    std::uint32_t seed = 73;
+    auto random = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return seed;
+    };
+
+    /* Vector operations compared to scalar expressions */
+    std::size_t numVectorErrors = 0;
+
+    for (int n = 0; n < 1000; ++n)
+    {
+        Vector4i a { UninitializeTag{} }, b { UninitializeTag{} };
+        Vector4ui ua { UninitializeTag{} }, ub { UninitializeTag{} };
+
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            ua[i] = random();
+            ub[i] = (n % 3 == 0 ? ua[i] : random() >> (n % 5));
+            a[i] = static_cast<std::int32_t>(ua[i]);
+            b[i] = static_cast<std::int32_t>(ub[i]);
+        }
+
+        const Vector4i sum = a + b, diff = a - b, prod = a * b, bits = (a & b) | (~a ^ b), shl = a << 3, shr = a >> 5;
+        const Vector4i mn = min(a, b), mx = max(a, b);
+        const Vector<bool, 4> lt = LessThan(a, b), gt = GreaterThan(a, b), ge = GreaterThanEqual(a, b), eq = Equal(a, b), ne = NotEqual(a, b);
+        const Vector4ui uprod = ua * ub, ushr = ua >> 5, umn = min(ua, ub), umx = max(ua, ub);
+        const Vector<bool, 4> ult = LessThan(ua, ub), ugt = GreaterThan(ua, ub), ule = LessThanEqual(ua, ub);
+
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            const bool ok =
+                static_cast<std::uint32_t>(sum[i])  == ua[i] + ub[i]                                    &&
+                static_cast<std::uint32_t>(diff[i]) == ua[i] - ub[i]                                    &&
+                static_cast<std::uint32_t>(prod[i]) == ua[i] * ub[i]                                    &&
+                static_cast<std::uint32_t>(bits[i]) == ((ua[i] & ub[i]) | (~ua[i] ^ ub[i]))             &&
+                static_cast<std::uint32_t>(shl[i])  == (ua[i] << 3)                                     &&
+                shr[i]                              == (a[i] < 0 ? ~(~a[i] >> 5) : a[i] >> 5)           &&
+                mn[i]                               == std::min(a[i], b[i])                             &&
+                mx[i]                               == std::max(a[i], b[i])                             &&
+                lt[i]                               == (a[i] < b[i])                                    &&
+                gt[i]                               == (a[i] > b[i])                                    &&
+                ge[i]                               == (a[i] >= b[i])                                   &&
+                eq[i]                               == (a[i] == b[i])                                   &&
+                ne[i]                               == (a[i] != b[i])                                   &&
+                uprod[i]                            == ua[i] * ub[i]                                    &&
+                ushr[i]                             == (ua[i] >> 5)                                     &&
+                umn[i]                              == std::min(ua[i], ub[i])                           &&
+                umx[i]                              == std::max(ua[i], ub[i])                           &&
+                ult[i]                              == (ua[i] < ub[i])                                  &&
+                ugt[i]                              == (ua[i] > ub[i])                                  &&
+                ule[i]                              == (ua[i] <= ub[i]);
+            if (!ok)
+                ++numVectorErrors;
+        }
+
+        /* Longer vectors are compared with the 8-wide and 4-wide paths and the scalar remainder */
+        Vector<std::uint32_t, 15> uc { UninitializeTag{} }, ud { UninitializeTag{} };
+        for (std::size_t i = 0; i < 15; ++i)
+        {
+            uc[i] = random();
+            ud[i] = (i % 4 == 0 ? uc[i] : random());
+        }
+
+        const Vector<bool, 15> ulong = LessThan(uc, ud), ulongEq = Equal(uc, ud);
+        for (std::size_t i = 0; i < 15; ++i)
+        {
+            if (ulong[i] != (uc[i] < ud[i]) || ulongEq[i] != (uc[i] == ud[i]))
+                ++numVectorErrors;
+        }
+
+        /* Generic left shift of negative values */
+        const Vector<std::int16_t, 3> sv { std::int16_t(-3), std::int16_t(a[0] >> 16), std::int16_t(-32768) };
+        const Vector<std::int16_t, 3> svShl = sv << 2;
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            if (static_cast<std::uint16_t>(svShl[i]) != static_cast<std::uint16_t>(static_cast<std::uint16_t>(sv[i]) << 2))
+                ++numVectorErrors;
+        }
+    }
+
+    /* Matrix operations compared to the generic implementation */
+    Matrix4i ma { UninitializeTag{} }, mb { UninitializeTag{} };
+    Vector4i v { UninitializeTag{} };
+    for (std::size_t r = 0; r < 4; ++r)
+    {
+        v[r] = static_cast<std::int32_t>(random() % 201) - 100;
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            ma(r, c) = static_cast<std::int32_t>(random() % 201) - 100;
+            mb(r, c) = static_cast<std::int32_t>(random() % 201) - 100;
+        }
+    }
+
+    const Matrix4i mprod = ma * mb, msum = ma + mb, mdiff = ma - mb;
+    const Vector4i mv = ma * v;
+
+    std::size_t numMatrixErrors = 0;
+    for (std::size_t r = 0; r < 4; ++r)
+    {
+        std::int32_t expectedMv = 0;
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            std::int32_t expected = 0;
+            for (std::size_t k = 0; k < 4; ++k)
+                expected += ma(r, k) * mb(k, c);
+            if (mprod(r, c) != expected || msum(r, c) != ma(r, c) + mb(r, c) || mdiff(r, c) != ma(r, c) - mb(r, c))
+                ++numMatrixErrors;
+            expectedMv += ma(r, c) * v[c];
+        }
+        if (mv[r] != expectedMv)
+            ++numMatrixErrors;
+    }
+
+    /* Division by runtime constants compared to the built-in division */
+    const std::int32_t divisors[] = { 1, 2, 3, 7, 10, 16, 641, 1 << 20, 0x7fffffff, -1, -2, -7, -1000, std::numeric_limits<std::int32_t>::min() };
+
+    std::vector<std::int32_t> numerators =
+    {
+        0, 1, -1, 2, -2, 7, -7, 100, -100, std::numeric_limits<std::int32_t>::max(), std::numeric_limits<std::int32_t>::min() + 1
+    };
+    for (int i = 0; i < 10000; ++i)
+        numerators.push_back(static_cast<std::int32_t>(random()));
+
+    std::size_t numDivisionErrors = 0;
+    std::vector<std::int32_t> quotients(numerators.size());
+    std::vector<std::uint32_t> unsignedNumerators(numerators.begin(), numerators.end()), unsignedQuotients(numerators.size());
+    unsignedNumerators.push_back(0xffffffffu);
+    unsignedQuotients.push_back(0);
+
+    for (auto d : divisors)
+    {
+        const IntegerDivideri divider(d);
+        DivideArray(numerators.data(), quotients.data(), numerators.size(), divider);
+
+        for (std::size_t i = 0; i < numerators.size(); ++i)
+        {
+            if (quotients[i] != numerators[i] / d || numerators[i] / divider != numerators[i] / d || divider.Remainder(numerators[i]) != numerators[i] % d)
+                ++numDivisionErrors;
+        }
+
+        const std::uint32_t ud = static_cast<std::uint32_t>(d);
+        const IntegerDividerui unsignedDivider(ud);
+        DivideArray(unsignedNumerators.data(), unsignedQuotients.data(), unsignedNumerators.size(), unsignedDivider);
+
+        for (std::size_t i = 0; i < unsignedNumerators.size(); ++i)
+        {
+            if (unsignedQuotients[i] != unsignedNumerators[i] / ud || unsignedDivider.Remainder(unsignedNumerators[i]) != unsignedNumerators[i] % ud)
+                ++numDivisionErrors;
+        }
+    }
+
+    const Vector4i vq = Vector4i(-9, 9, 100, -100) / IntegerDivideri(4);
+    if (vq != Vector4i(-2, 2, 25, -25))
+        ++numDivisionErrors;
+
+    /* Conversion of linear cell indices into grid coordinates */
+    const std::uint32_t gridWidth = 1000 + (random() % 10), numCells = 4000000;
+    std::vector<std::uint32_t> cells(numCells), rows(numCells);
+    for (std::uint32_t i = 0; i < numCells; ++i)
+        cells[i] = i;
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (std::uint32_t i = 0; i < numCells; ++i)
+        rows[i] = cells[i] / gridWidth;
+    const auto durationBuiltin = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    std::uint32_t checksum = 0;
+    for (auto r : rows)
+        checksum += r;
+
+    startTime = std::chrono::steady_clock::now();
+    DivideArray(cells.data(), rows.data(), numCells, IntegerDividerui(gridWidth));
+    const auto durationDivider = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    for (auto r : rows)
+        checksum -= r;
+
+    std::cout << "Integer vectors: vector errors = " << numVectorErrors << ", matrix errors = " << numMatrixErrors << ", division errors = " << numDivisionErrors << std::endl;
+    std::cout << "DivideArray: " << numCells << " cells (" << durationDivider.count() << " us, built-in division " << durationBuiltin.count() << " us), checksum = " << checksum << std::endl;
+}
+
+void relationalTest1()
+{
+    std::uint32_t seed = 19;
+    auto random = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return float(seed >> 8) / float(1 << 24) * 2.0f - 1.0f;
+    };
+
+    /* Component-wise comparisons compared to scalar comparisons, including equal components and NaN */
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    std::size_t numErrors = 0;
+
+    for (int n = 0; n < 1000; ++n)
+    {
+        Vector<float, 11> a { UninitializeTag{} }, b { UninitializeTag{} };
+        for (std::size_t i = 0; i < a.components; ++i)
+        {
+            a[i] = random();
+            b[i] = (i % 3 == 0 ? a[i] : random());
+        }
+        a[n % 11] = (n % 7 == 0 ? nan : a[n % 11]);
+
+        const auto lt = LessThan(a, b), le = LessThanEqual(a, b), gt = GreaterThan(a, b);
+        const auto ge = GreaterThanEqual(a, b), eq = Equal(a, b), ne = NotEqual(a, b);
+        const auto sel = Select(lt, a, b);
+
+        for (std::size_t i = 0; i < a.components; ++i)
+        {
+            if ( lt[i] != (a[i] <  b[i]) || le[i] != (a[i] <= b[i]) || gt[i] != (a[i] >  b[i]) ||
+                 ge[i] != (a[i] >= b[i]) || eq[i] != (a[i] == b[i]) || ne[i] != (a[i] != b[i]) ||
+                 sel[i] != (a[i] < b[i] ? a[i] : b[i]) )
+            {
+                ++numErrors;
+            }
+        }
+
+        if (Any(lt) != (lt[0] || lt[1] || lt[2] || lt[3] || lt[4] || lt[5] || lt[6] || lt[7] || lt[8] || lt[9] || lt[10]))
+            ++numErrors;
+        if (All(Not(eq)) == Any(eq))
+            ++numErrors;
+    }
+
+    /* Vector3f and Vector4f comparisons, whose masks stay in SIMD registers for Select, Any, All, and Not */
+    for (int n = 0; n < 1000; ++n)
+    {
+        Vector4f a(random(), random(), random(), random()), b(random(), a.y, random(), random());
+        a[n % 4] = (n % 7 == 0 ? nan : a[n % 4]);
+
+        const Vector3f a3(a.x, a.y, a.z), b3(b.x, b.y, b.z);
+
+        const Vector<bool, 4> le = LessThanEqual(a, b), ne = NotEqual(a, b);
+        const Vector<bool, 3> ge3 = GreaterThanEqual(a3, b3);
+        const Vector4f sel = Select(LessThan(a, b), a, b);
+        const Vector3f sel3 = Select(Not(GreaterThanEqual(a3, b3)), a3, b3);
+
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            if ( le[i] != (a[i] <= b[i]) || ne[i] != (a[i] != b[i]) || Equal(a, b)[i] != (a[i] == b[i]) ||
+                 sel[i] != (a[i] < b[i] ? a[i] : b[i]) )
+            {
+                ++numErrors;
+            }
+        }
+
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            if (ge3[i] != (a3[i] >= b3[i]) || (sel3[i] == sel3[i] && sel3[i] != (!(a3[i] >= b3[i]) ? a3[i] : b3[i])))
+                ++numErrors;
+        }
+
+        if (Any(Not(LessThan(a3, a3 + Vector3f(1.0f)))) != (a3.x != a3.x || a3.y != a3.y || a3.z != a3.z))
+            ++numErrors;
+        if (Any(GreaterThan(a3, b3)) != (a3.x > b3.x || a3.y > b3.y || a3.z > b3.z) || All(Equal(a, a)) != (a.x == a.x && a.y == a.y && a.z == a.z && a.w == a.w))
+            ++numErrors;
+    }
+
+    /* Matrices and integer vectors */
+    Matrix4f ma, mb;
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        ma.Ptr()[i] = random();
+        mb.Ptr()[i] = random();
+    }
+
+    const Matrix4f mmin = Select(LessThan(ma, mb), ma, mb);
+    for (std::size_t r = 0; r < 4; ++r)
+    {
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            if (mmin(r, c) != std::min(ma(r, c), mb(r, c)))
+                ++numErrors;
+        }
+    }
+
+    if (!All(Equal(ma, ma)) || Any(NotEqual(ma, ma)) || !All(GreaterThanEqual(Vector3i(1, 2, 3), Vector3i(1, 2, 2))))
+        ++numErrors;
+    if (Select(Vector3T<bool>(true, false, true), Vector3i(1, 2, 3), Vector3i(4, 5, 6)) != Vector3i(1, 5, 3))
+        ++numErrors;
+
+    /* Branchless clamping of vectors compared to branches, repeated on a working set that stays in the L1 cache */
+    const std::size_t numVectors = 2048, numRepetitions = 500;
+    std::vector<Vector4f> points(numVectors), clampedBranch(numVectors), clampedSelect(numVectors);
+    for (auto& p : points)
+        p = Vector4f(random(), random(), random(), random());
+
+    const Vector4f lower(-0.5f), upper(0.5f);
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (std::size_t n = 0; n < numRepetitions; ++n)
+    {
+        for (std::size_t i = 0; i < numVectors; ++i)
+        {
+            for (std::size_t j = 0; j < 4; ++j)
+            {
+                if (points[i][j] < lower[j])
+                    clampedBranch[i][j] = lower[j];
+                else if (points[i][j] > upper[j])
+                    clampedBranch[i][j] = upper[j];
+                else
+                    clampedBranch[i][j] = points[i][j];
+            }
+        }
+    }
+    const auto durationBranch = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    for (std::size_t n = 0; n < numRepetitions; ++n)
+    {
+        for (std::size_t i = 0; i < numVectors; ++i)
+        {
+            const Vector4f& p = points[i];
+            clampedSelect[i] = Select(LessThan(p, lower), lower, Select(GreaterThan(p, upper), upper, p));
+        }
+    }
+    const auto durationSelect = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    std::size_t numClampErrors = 0;
+    for (std::size_t i = 0; i < numVectors; ++i)
+    {
+        if (clampedBranch[i] != clampedSelect[i])
+            ++numClampErrors;
+    }
+
+    std::cout << "Relational functions: errors = " << numErrors << ", clamp errors = " << numClampErrors << std::endl;
+    std::cout << "Select clamp: " << numVectors*numRepetitions << " vectors (" << durationSelect.count() << " us, branches " << durationBranch.count() << " us)" << std::endl;
+}
+
+void shaderMathTest1()
+{
+    std::uint32_t seed = 101;
+    auto random = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return (float(seed >> 8) / float(1 << 24) * 2.0f - 1.0f) * 100.0f;
+    };
+
+    /* Built-in functions compared to scalar expressions, including half-way cases and large values */
+    const std::size_t n = 10007;
+    std::vector<float> a(n), b(n), c(n), y(n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        a[i] = random();
+        b[i] = random();
+        c[i] = random();
+    }
+    a[0] = 2.5f; a[1] = -2.5f; a[2] = 0.5f; a[3] = -0.5f; a[4] = 1e9f; a[5] = -1e9f; a[6] = 8388609.0f; a[7] = -0.0f;
+    b[5] = 0.0f;
+
+    std::size_t numErrors = 0;
+    auto checkArray = [&](const char* name, const std::function<float(std::size_t)>& expected, float tolerance)
+    {
+        std::size_t errors = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const float e = expected(i);
+            if (std::abs(y[i] - e) > tolerance * std::max(1.0f, std::abs(e)))
+                ++errors;
+        }
+        if (errors > 0)
+            std::cout << "  " << name << ": " << errors << " errors" << std::endl;
+        numErrors += errors;
+    };
+
+    MinArray(a.data(), b.data(), y.data(), n);
+    checkArray("min", [&](std::size_t i) { return std::min(a[i], b[i]); }, 0.0f);
+    MaxArray(a.data(), b.data(), y.data(), n);
+    checkArray("max", [&](std::size_t i) { return std::max(a[i], b[i]); }, 0.0f);
+    AbsArray(a.data(), y.data(), n);
+    checkArray("abs", [&](std::size_t i) { return std::abs(a[i]); }, 0.0f);
+    SignArray(b.data(), y.data(), n);
+    checkArray("sign", [&](std::size_t i) { return float((0.0f < b[i]) - (b[i] < 0.0f)); }, 0.0f);
+    FractArray(a.data(), y.data(), n);
+    checkArray("fract", [&](std::size_t i) { return a[i] - std::floor(a[i]); }, 0.0f);
+    ModArray(a.data(), c.data(), y.data(), n);
+    checkArray("mod", [&](std::size_t i) { return a[i] - c[i] * std::floor(a[i] / c[i]); }, 0.0f);
+    StepArray(b.data(), a.data(), y.data(), n);
+    checkArray("step", [&](std::size_t i) { return (a[i] < b[i] ? 0.0f : 1.0f); }, 0.0f);
+    FmaArray(a.data(), b.data(), c.data(), y.data(), n);
+    checkArray("fma", [&](std::size_t i) { return a[i] * b[i] + c[i]; }, 1e-6f);
+    RoundArray(a.data(), y.data(), n);
+    checkArray("round", [&](std::size_t i) { return std::round(a[i]); }, 0.0f);
+    TruncArray(a.data(), y.data(), n);
+    checkArray("trunc", [&](std::size_t i) { return std::trunc(a[i]); }, 0.0f);
+    AbsArray(c.data(), c.data(), n);
+    InverseSqrtArray(c.data(), y.data(), n);
+    checkArray("inversesqrt", [&](std::size_t i) { return 1.0f / std::sqrt(c[i]); }, 1e-6f);
+    RsqrtArray(c.data(), y.data(), n);
+    checkArray("rsqrt", [&](std::size_t i) { return 1.0f / std::sqrt(c[i]); }, 1e-6f);
+
+    /* Vector and matrix forms */
+    const Vector3f v(-1.25f, 0.5f, 2.75f);
+    const Vector3f vm = mod(v, Vector3f(1.0f)), vf = fract(v), vr = round(v), vs = step(Vector3f(0.0f), v);
+    if (vm != Vector3f(0.75f, 0.5f, 0.75f) || vf != vm || vr != Vector3f(-1.0f, 1.0f, 3.0f) || vs != Vector3f(0.0f, 1.0f, 1.0f))
+        ++numErrors;
+
+    const Vector4d vd = sign(Vector4d(-3.0, 0.0, 2.0, -0.5)) * inversesqrt(Vector4d(4.0));
+    if (vd != Vector4d(-0.5, 0.0, 0.5, -0.5))
+        ++numErrors;
+
+    Matrix4f m;
+    for (std::size_t i = 0; i < 16; ++i)
+        m.Ptr()[i] = a[i + 10];
+    const Matrix4f mt = trunc(abs(m)), mmin = min(m, max(m, fma(m, m, m)));
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        if (mt.Ptr()[i] != std::trunc(std::abs(m.Ptr()[i])) || mmin.Ptr()[i] != m.Ptr()[i])
+            ++numErrors;
+    }
+
+    /* Timing of fract over a large array compared to a scalar loop */
+    const std::size_t numLarge = 4000000;
+    std::vector<float> large(numLarge), largeOut(numLarge);
+    for (auto& x : large)
+        x = random();
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < numLarge; ++i)
+        largeOut[i] = large[i] - std::floor(large[i]);
+    const auto durationScalar = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    FractArray(large.data(), largeOut.data(), numLarge);
+    const auto durationPacket = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    std::cout << "Shader math functions: errors = " << numErrors << std::endl;
+    std::cout << "FractArray: " << numLarge << " elements (" << durationPacket.count() << " us, scalar " << durationScalar.count() << " us)" << std::endl;
+}
+
+void noiseTest1()
+{
+    std::uint32_t seed = 7;
+    auto random = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return (float(seed >> 8) / float(1 << 24) * 2.0f - 1.0f) * 50.0f;
+    };
+
+    /* Continuity across lattice cells and value range of all basis functions */
+    double maxJump = 0.0, maxAbs = 0.0;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        const Vector4d p(std::floor(random()), std::floor(random()), std::floor(random()), std::floor(random()));
+        const Vector4d e(1e-7, -1e-7, 1e-7, -1e-7);
+        const Vector4d q = p + Vector4d(random(), random(), random(), random()) * 0.02;
+
+        const double values[][2] =
+        {
+            { GradientNoise(Vector2d(p.x, p.y) - Vector2d(e.x, e.y)), GradientNoise(Vector2d(p.x, p.y) + Vector2d(e.x, e.y)) },
+            { GradientNoise(Vector3d(p.x, p.y, p.z) - Vector3d(e.x, e.y, e.z)), GradientNoise(Vector3d(p.x, p.y, p.z) + Vector3d(e.x, e.y, e.z)) },
+            { GradientNoise(p - e), GradientNoise(p + e) },
+            { SimplexNoise(Vector2d(q.x, q.y) - Vector2d(e.x, e.y)), SimplexNoise(Vector2d(q.x, q.y) + Vector2d(e.x, e.y)) },
+            { SimplexNoise(Vector3d(q.x, q.y, q.z) - Vector3d(e.x, e.y, e.z)), SimplexNoise(Vector3d(q.x, q.y, q.z) + Vector3d(e.x, e.y, e.z)) },
+            { SimplexNoise(q - e), SimplexNoise(q + e) },
+        };
+
+        for (const auto& v : values)
+        {
+            maxJump = std::max(maxJump, std::abs(v[0] - v[1]));
+            maxAbs = std::max(maxAbs, std::max(std::abs(v[0]), std::abs(v[1])));
+        }
+    }
+
+    /* Packets (NoiseArray) compared to single points, with fBm and domain warping */
+    NoiseDescriptorf desc;
+    desc.octaves        = 4;
+    desc.frequency      = 0.05f;
+    desc.warpStrength   = 2.0f;
+
+    const std::size_t numPoints = 10003;
+    std::vector<Vector3f> points(numPoints);
+    std::vector<float> values(numPoints);
+    for (auto& p : points)
+        p = Vector3f(random(), random(), random());
+
+    float maxArrayError = 0.0f;
+    for (auto type : { NoiseType::Gradient, NoiseType::Simplex })
+    {
+        desc.type = type;
+        NoiseArray(points.data(), values.data(), numPoints, desc);
+        for (std::size_t i = 0; i < numPoints; ++i)
+            maxArrayError = std::max(maxArrayError, std::abs(values[i] - Noise(points[i], desc)));
+    }
+
+    /* Grid of fBm gradient noise compared to single points */
+    desc.type           = NoiseType::Gradient;
+    desc.warpStrength   = 0.0f;
+
+    const std::size_t gridSize = 512;
+    const Vector2f origin(-10.0f, 3.5f), spacing(0.25f, 0.5f);
+    std::vector<float> grid(gridSize*gridSize);
+
+    auto startTime = std::chrono::steady_clock::now();
+    NoiseGrid(grid.data(), gridSize, gridSize, origin, spacing, desc);
+    const auto durationGrid = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    float maxGridError = 0.0f;
+    startTime = std::chrono::steady_clock::now();
+    for (std::size_t y = 0; y < gridSize; ++y)
+    {
+        for (std::size_t x = 0; x < gridSize; ++x)
+        {
+            const float v = Noise(Vector2f(origin.x + float(x) * spacing.x, origin.y + float(y) * spacing.y), desc);
+            maxGridError = std::max(maxGridError, std::abs(grid[y*gridSize + x] - v));
+        }
+    }
+    const auto durationScalar = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    std::vector<float> volume(32*16*8);
+    NoiseGrid(volume.data(), 32, 16, 8, Vector3f(1.0f), Vector3f(0.5f), desc);
+    const float volumeError = std::abs(volume[(7*16 + 5)*32 + 3] - Noise(Vector3f(1.0f + 3*0.5f, 1.0f + 5*0.5f, 1.0f + 7*0.5f), desc));
+
+    std::cout << "Noise: max. jump at cell borders = " << maxJump << ", max. |value| = " << maxAbs << ", NoiseArray error = " << maxArrayError << std::endl;
+    std::cout << "NoiseGrid: " << gridSize << "x" << gridSize << ", 4 octaves (" << durationGrid.count() << " us, scalar " << durationScalar.count() << " us), ";
+    std::cout << "max. error = " << maxGridError << ", volume error = " << volumeError << std::endl;
+}
+
+template <typename T, std::size_t Rows, std::size_t Cols>
+double transposeError(const Matrix<T, Rows, Cols>& m)
+{
+    auto t = m.Transposed();
+    double error = 0.0;
+
+    for (std::size_t r = 0; r < Rows; ++r)
+    {
+        for (std::size_t c = 0; c < Cols; ++c)
+            error += std::abs(static_cast<double>(t(c, r)) - static_cast<double>(m(r, c)));
+    }
+
+    return error;
+}
+
+template <typename T, std::size_t N>
+double transposeInPlaceError(const Matrix<T, N, N>& m)
+{
+    auto t = m;
+    t.Transpose();
+
+    double error = transposeError(m);
+
+    for (std::size_t r = 0; r < N; ++r)
+    {
+        for (std::size_t c = 0; c < N; ++c)
+            error += std::abs(static_cast<double>(t(c, r)) - static_cast<double>(m(r, c)));
+    }
+
+    return error;
+}
+
+template <typename T, std::size_t Rows, std::size_t Cols>
+void fillTransposeMatrix(Matrix<T, Rows, Cols>& m)
+{
+    for (std::size_t i = 0; i < Rows*Cols; ++i)
+        m.Ptr()[i] = static_cast<T>(i*7 % 101);
+}
+
+void transposeTest1()
+{
+    /* Transpose of 4x4 tiles, non-square matrices, and matrices which do not fill whole tiles */
+    Matrix4f a;
+    Matrix4d b;
+    Matrix<float, 6, 9> c;
+    Matrix<int, 5, 5> d;
+    Matrix<double, 19, 19> e;
+
+    fillTransposeMatrix(a);
+    fillTransposeMatrix(b);
+    fillTransposeMatrix(c);
+    fillTransposeMatrix(d);
+    fillTransposeMatrix(e);
+
+    std::vector<Matrix<float, 37, 37>> f(1);
+    fillTransposeMatrix(f[0]);
+
+    const double error =
+    (
+        transposeInPlaceError(a) + transposeInPlaceError(b) + transposeError(c) +
+        transposeInPlaceError(d) + transposeInPlaceError(e) + transposeInPlaceError(f[0])
+    );
+
+    /* Batch transpose of 4x4 matrices compared to the element-wise copy and to "Transposed" per matrix, repeated on a working set that stays in the L1/L2 cache */
+    const std::size_t numMatrices = 1024, numRepetitions = 200;
+    std::vector<Matrix4f> input(numMatrices), output(numMatrices), reference(numMatrices), transposed(numMatrices);
+
+    for (std::size_t i = 0; i < numMatrices; ++i)
+    {
+        fillTransposeMatrix(input[i]);
+        input[i](i % 4, (i / 4) % 4) = static_cast<float>(i);
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (std::size_t n = 0; n < numRepetitions; ++n)
+        TransposeArray(input.data(), output.data(), numMatrices);
+    const auto durationBatch = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    for (std::size_t n = 0; n < numRepetitions; ++n)
+    {
+        for (std::size_t i = 0; i < numMatrices; ++i)
+            transposed[i] = input[i].Transposed();
+    }
+    const auto durationTransposed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    for (std::size_t n = 0; n < numRepetitions; ++n)
+    {
+        for (std::size_t i = 0; i < numMatrices; ++i)
+        {
+            for (std::size_t r = 0; r < 4; ++r)
+            {
+                for (std::size_t c = 0; c < 4; ++c)
+                    reference[i](c, r) = input[i](r, c);
+            }
+        }
+    }
+    const auto durationScalar = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    std::size_t batchErrors = 0;
+    for (std::size_t i = 0; i < numMatrices; ++i)
+    {
+        if (!std::equal(output[i].Ptr(), output[i].Ptr() + 16, reference[i].Ptr()) || !std::equal(transposed[i].Ptr(), transposed[i].Ptr() + 16, reference[i].Ptr()))
+            ++batchErrors;
+    }
+
+    TransposeArray(output.data(), numMatrices);
+    for (std::size_t i = 0; i < numMatrices; ++i)
+    {
+        if (!std::equal(output[i].Ptr(), output[i].Ptr() + 16, input[i].Ptr()))
+            ++batchErrors;
+    }
+
+    /* Batch transpose of 4x4 double matrices, out of place and in place */
+    std::vector<Matrix4d> inputD(5), outputD(5);
+    for (auto& m : inputD)
+        fillTransposeMatrix(m);
+
+    const auto originalD = inputD;
+
+    TransposeArray(inputD.data(), outputD.data(), inputD.size());
+    TransposeArray(inputD.data(), inputD.size());
+
+    for (std::size_t i = 0; i < inputD.size(); ++i)
+    {
+        for (std::size_t r = 0; r < 4; ++r)
+        {
+            for (std::size_t c = 0; c < 4; ++c)
+            {
+                if (outputD[i](c, r) != originalD[i](r, c) || inputD[i](c, r) != originalD[i](r, c))
+                    ++batchErrors;
+            }
+        }
+    }
+
+    /* In-place transpose of a large matrix compared to the swap of single elements */
+    std::vector<Matrix<float, 256, 256>> large(2);
+    fillTransposeMatrix(large[0]);
+    large[1] = large[0];
+
+    startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; ++i)
+        large[0].Transpose();
+    const auto durationBlocked = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < 100; ++i)
+    {
+        for (std::size_t r = 0; r < 256; ++r)
+        {
+            for (std::size_t c = r + 1; c < 256; ++c)
+                std::swap(large[1](r, c), large[1](c, r));
+        }
+    }
+    const auto durationSwap = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    const bool largeEqual = std::equal(large[0].Ptr(), large[0].Ptr() + 256*256, large[1].Ptr());
+
+    std::cout << "Transpose: error = " << error << ", TransposeArray errors = " << batchErrors << " (";
+    std::cout << numMatrices*numRepetitions << " x Matrix4f: " << durationBatch.count() << " us, Transposed " << durationTransposed.count() << " us, scalar " << durationScalar.count() << " us)" << std::endl;
+    std::cout << "Transpose 256x256 in place x100: " << durationBlocked.count() << " us, element swap " << durationSwap.count() << " us, equal = " << largeEqual << std::endl;
+}
+
+template <typename T, std::size_t N>
+double matrixMaxError(const Matrix<T, N, N>& a, const Matrix<T, N, N>& b)
+{
+    double error = 0.0;
+    for (std::size_t i = 0; i < N*N; ++i)
+        error = std::max(error, std::abs(static_cast<double>(a[i]) - static_cast<double>(b[i])));
+    return error;
+}
+
+template <typename T, std::size_t N>
+void fillRandomMatrix(Matrix<T, N, N>& m, std::uint32_t& seed, double scale)
+{
+    for (std::size_t i = 0; i < N*N; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        m[i] = static_cast<T>((double(seed >> 8) / double(1 << 24) * 2.0 - 1.0) * scale);
+    }
+}
+
+void matrixFunctionTest1()
+{
+    std::uint32_t seed = 11;
+
+    /* Exponential of a nilpotent matrix (finite series) and of a diagonal matrix with a large norm */
+    Matrix3d n;
+    n.Reset();
+    n(0, 1) = 2.0;
+    n(1, 2) = 3.0;
+
+    Matrix3d expN = Matrix3d::Identity() + n + n*n*0.5;
+    double expError = matrixMaxError(MatrixExp(n), expN);
+
+    Matrix3d d;
+    d.Reset();
+    d(0, 0) = 10.0;
+    d(1, 1) = -3.0;
+    d(2, 2) = 0.5;
+
+    const auto expD = MatrixExp(d);
+    expError = std::max(expError, std::abs(expD(0, 0) / std::exp(10.0) - 1.0));
+    expError = std::max(expError, std::abs(expD(1, 1) - std::exp(-3.0)) + std::abs(expD(2, 2) - std::exp(0.5)) + std::abs(expD(0, 1)));
+
+    /* Non-finite input must be rejected without modifying the output */
+    Matrix3d nonFinite = d, expNonFinite = expD;
+    nonFinite(1, 2) = std::numeric_limits<double>::infinity();
+    const bool infRejected = (!MatrixExp(expNonFinite, nonFinite) && matrixMaxError(expNonFinite, expD) == 0.0 && std::isnan(MatrixExp(nonFinite)(0, 0)));
+    nonFinite(1, 2) = std::numeric_limits<double>::quiet_NaN();
+    const bool nanRejected = (!MatrixExp(expNonFinite, nonFinite) && matrixMaxError(expNonFinite, expD) == 0.0);
+
+    /* Round trips exp(log(A)), exp(A)*exp(-A), and integer powers */
+    double logError = 0.0, inverseError = 0.0, powError = 0.0;
+    int logFailures = 0;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        Matrix<double, 6, 6> a;
+        fillRandomMatrix(a, seed, 0.3);
+        a += Matrix<double, 6, 6>::Identity() * 2.0;
+
+        Matrix<double, 6, 6> logA;
+        if (MatrixLog(logA, a))
+            logError = std::max(logError, matrixMaxError(MatrixExp(logA), a));
+        else
+            ++logFailures;
+
+        inverseError = std::max(inverseError, matrixMaxError(MatrixExp(a) * MatrixExp(a * -1.0), Matrix<double, 6, 6>::Identity()));
+
+        Matrix4d b;
+        fillRandomMatrix(b, seed, 0.5);
+        b += Matrix4d::Identity();
+
+        powError = std::max(powError, matrixMaxError(MatrixPow(b, 5), b*b*b*b*b) / MatrixPow(b, 5).Ptr()[0]);
+        powError = std::max(powError, matrixMaxError(MatrixPow(b, -3) * MatrixPow(b, 3), Matrix4d::Identity()));
+    }
+
+    /* Single precision compared to double precision */
+    Matrix4f f;
+    fillRandomMatrix(f, seed, 2.0);
+    const double floatError = matrixMaxError(MatrixExp(f).Cast<double>(), MatrixExp(f.Cast<double>())) / Details::MatrixNorm1(MatrixExp(f.Cast<double>()));
+
+    /* Batches of small matrices */
+    const std::size_t numMatrices = 20000;
+    std::vector<Matrix4f> input4(numMatrices), output4(numMatrices);
+    std::vector<Matrix<double, 6, 6>> input6(numMatrices), output6(numMatrices);
+
+    for (std::size_t i = 0; i < numMatrices; ++i)
+    {
+        fillRandomMatrix(input4[i], seed, 1.0);
+        fillRandomMatrix(input6[i], seed, 1.0);
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    MatrixExpArray(input4.data(), output4.data(), numMatrices);
+    const auto duration4 = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    MatrixExpArray(input6.data(), output6.data(), numMatrices);
+    const auto duration6 = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < numMatrices; ++i)
+        MatrixLog(input6[i], output6[i]);
+    const auto durationLog6 = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    std::cout << "MatrixExp: error = " << expError << ", exp(A)*exp(-A) error = " << inverseError << ", float rel. error = " << floatError;
+    std::cout << ", non-finite rejected = " << std::boolalpha << (infRejected && nanRejected) << std::endl;
+    std::cout << "MatrixLog: exp(log(A)) error = " << logError << ", failures = " << logFailures << ", MatrixPow error = " << powError << std::endl;
+    std::cout << "MatrixExpArray: " << numMatrices << " x Matrix4f: " << duration4.count() << " us, " << numMatrices << " x 6x6 double: " << duration6.count() << " us, ";
+    std::cout << "MatrixLog 6x6 double: " << durationLog6.count() << " us" << std::endl;
+}
+
+void orthonormalizationTest1()
+{
+    std::uint32_t seed = 5;
+    auto random = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return float(seed >> 8) / float(1 << 24) * 2.0f - 1.0f;
+    };
+
+    /* Rotations with drift, where every second matrix and quaternion is clean */
+    const std::size_t count = 100000;
+    std::vector<Matrix3f> rotations(count), matrices(count);
+    std::vector<AffineMatrix4f> affineMatrices(count);
+    std::vector<Quaternionf> quaternions(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Quaternionf q(random(), random(), random(), random());
+        q.Normalize();
+
+        rotations[i] = q.ToMatrix3();
+        matrices[i] = rotations[i];
+        quaternions[i] = q;
+
+        if (i % 2 == 1)
+        {
+            for (std::size_t j = 0; j < 9; ++j)
+                matrices[i][j] += random() * 0.01f;
+            quaternions[i] *= 1.0f + random() * 0.01f;
+        }
+
+        affineMatrices[i].LoadIdentity();
+        for (std::size_t r = 0; r < 3; ++r)
+        {
+            for (std::size_t c = 0; c < 3; ++c)
+                affineMatrices[i].At(r, c) = matrices[i].At(r, c);
+        }
+        affineMatrices[i].SetPosition(Vector3f(float(i), 2.0f, 3.0f));
+    }
+
+    auto rotationError = [&](const std::vector<Matrix3f>& m)
+    {
+        float error = 0.0f;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (std::size_t j = 0; j < 9; ++j)
+                error = std::max(error, std::abs(m[i][j] - rotations[i][j]));
+        }
+        return error;
+    };
+
+    const float threshold = 1.0e-5f;
+    OrthonormalizationStatsf statsGramSchmidt, statsPolar, statsAffine, statsQuaternion;
+
+    auto matricesGramSchmidt = matrices;
+    auto startTime = std::chrono::steady_clock::now();
+    OrthonormalizeArray(matricesGramSchmidt.data(), count, OrthonormalizationMethod::GramSchmidt, threshold, &statsGramSchmidt);
+    const auto durationGramSchmidt = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    auto matricesPolar = matrices;
+    startTime = std::chrono::steady_clock::now();
+    OrthonormalizeArray(matricesPolar.data(), count, OrthonormalizationMethod::Polar, threshold, &statsPolar);
+    const auto durationPolar = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    OrthonormalizeArray(affineMatrices.data(), count, OrthonormalizationMethod::Polar, threshold, &statsAffine);
+
+    float affineError = 0.0f;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        affineError = std::max(affineError, std::abs(affineMatrices[i].GetPosition().x - float(i)));
+        for (std::size_t r = 0; r < 3; ++r)
+        {
+            for (std::size_t c = 0; c < 3; ++c)
+                affineError = std::max(affineError, std::abs(affineMatrices[i].At(r, c) - matricesPolar[i].At(r, c)));
+        }
+    }
+
+    auto quaternionsNormalize = quaternions;
+    startTime = std::chrono::steady_clock::now();
+    for (auto& q : quaternionsNormalize)
+        q.Normalize();
+    const auto durationNormalize = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    RenormalizeArray(quaternions.data(), count, threshold, &statsQuaternion);
+    const auto durationRenormalize = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    std::cout << "OrthonormalizeArray (GramSchmidt): " << statsGramSchmidt.numCorrected << " of " << count << " corrected, max. drift = " << statsGramSchmidt.maxDrift;
+    std::cout << ", residual = " << statsGramSchmidt.maxResidual << ", rotation error = " << rotationError(matricesGramSchmidt) << " (" << durationGramSchmidt.count() << " us)" << std::endl;
+    std::cout << "OrthonormalizeArray (Polar): " << statsPolar.numCorrected << " of " << count << " corrected, mean drift = " << statsPolar.meanDrift;
+    std::cout << ", residual = " << statsPolar.maxResidual << ", rotation error = " << rotationError(matricesPolar) << " (" << durationPolar.count() << " us), affine error = " << affineError << std::endl;
+    std::cout << "RenormalizeArray: " << statsQuaternion.numCorrected << " of " << count << " corrected, max. drift = " << statsQuaternion.maxDrift;
+    std::cout << ", residual = " << statsQuaternion.maxResidual << " (" << durationRenormalize.count() << " us, Normalize " << durationNormalize.count() << " us)" << std::endl;
+}
+
+void cubemapViewsTest1()
+{
+    std::uint32_t seed = 3;
+    auto random = [&seed]()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return float(seed >> 8) / float(1 << 24) * 2.0f - 1.0f;
+    };
+
+    const int flags = ProjectionFlags::RightHanded;
+    const auto projection = CubemapProjection(0.1f, 50.0f, flags);
+
+    const std::size_t numLights = 1003;
+    std::vector<Vector3f> eyes(numLights);
+    for (auto& e : eyes)
+        e = Vector3f(random(), random(), random()) * 100.0f;
+
+    std::vector<AffineMatrix4f> views(numLights*6);
+    std::vector<Matrix4f> viewProjections(numLights*6);
+    std::vector<Vector4f> planes(numLights*6*FrustumPlane::Num);
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (int n = 0; n < 10; ++n)
+        BuildCubemapViews(eyes.data(), numLights, projection, views.data(), viewProjections.data(), planes.data(), flags);
+    const auto durationBatch = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    /* Build the same outputs one face at a time */
+    std::vector<AffineMatrix4f> referenceViews(numLights*6);
+    std::vector<Matrix4f> referenceViewProjections(numLights*6);
+    std::vector<Vector4f> referencePlanes(numLights*6*FrustumPlane::Num);
+
+    Matrix4f projectionMatrix;
+    Details::ProjectionToMatrix4(projectionMatrix, projection);
+
+    startTime = std::chrono::steady_clock::now();
+    for (int n = 0; n < 10; ++n)
+    {
+        for (std::size_t i = 0; i < numLights; ++i)
+        {
+            for (std::size_t f = 0; f < 6; ++f)
+            {
+                const std::size_t k = i*6 + f;
+                referenceViews[k] = CubemapFaceView(eyes[i], static_cast<CubemapFace>(f), flags);
+
+                const auto v = referenceViews[k].ToMatrix4();
+                for (std::size_t r = 0; r < 4; ++r)
+                {
+                    for (std::size_t c = 0; c < 4; ++c)
+                    {
+                        referenceViewProjections[k].At(r, c) = 0.0f;
+                        for (std::size_t j = 0; j < 4; ++j)
+                            referenceViewProjections[k].At(r, c) += projectionMatrix.At(r, j) * v.At(j, c);
+                    }
+                }
+
+                Vector4f facePlanes[FrustumPlane::Num];
+                ExtractFrustumPlanes(facePlanes, referenceViewProjections[k], flags);
+                std::copy(std::begin(facePlanes), std::end(facePlanes), referencePlanes.begin() + k*FrustumPlane::Num);
+            }
+        }
+    }
+    const auto durationScalar = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+
+    /* Compare with single matrices, and classify random points with the clip coordinates and the frustum planes */
+
+    float viewError = 0.0f, viewProjectionError = 0.0f;
+    std::size_t planeMismatches = 0, insideCount = 0;
+
+    for (std::size_t i = 0; i < numLights; ++i)
+    {
+        for (std::size_t f = 0; f < 6; ++f)
+        {
+            const std::size_t k = i*6 + f;
+
+            for (std::size_t j = 0; j < 12; ++j)
+                viewError = std::max(viewError, std::abs(views[k][j] - referenceViews[k][j]));
+
+            for (int n = 0; n < 20; ++n)
+            {
+                const Vector4f point(eyes[i].x + random()*60.0f, eyes[i].y + random()*60.0f, eyes[i].z + random()*60.0f, 1.0f);
+                const Vector4f viewPoint = TransformVector(referenceViews[k], point);
+
+                #ifdef GS_ROW_VECTORS
+                const Vector4f clip = viewPoint * projection;
+                #else
+                const Vector4f clip = projection * viewPoint;
+                #endif
+
+                const Vector4f clipBatch = TransformVector(viewProjections[k], point);
+                viewProjectionError = std::max(viewProjectionError, Distance(clip, clipBatch) / std::max(1.0f, std::abs(clip.w)));
+
+                const float margin = 1.0e-3f * std::abs(clip.w);
+                const bool insideClip =
+                (
+                    std::abs(clip.x) <= clip.w - margin && std::abs(clip.y) <= clip.w - margin &&
+                    clip.z >= margin && clip.z <= clip.w - margin
+                );
+                const bool outsideClip =
+                (
+                    std::abs(clip.x) > clip.w + margin || std::abs(clip.y) > clip.w + margin ||
+                    clip.z < -margin || clip.z > clip.w + margin
+                );
+
+                bool insidePlanes = true;
+                for (std::size_t l = 0; l < FrustumPlane::Num; ++l)
+                {
+                    const auto& p = planes[k*FrustumPlane::Num + l];
+                    if (p.x*point.x + p.y*point.y + p.z*point.z + p.w < 0.0f)
+                        insidePlanes = false;
+                }
+
+                if ((insideClip && !insidePlanes) || (outsideClip && insidePlanes))
+                    ++planeMismatches;
+                if (insideClip)
+                    ++insideCount;
+            }
+        }
+    }
+
+    /* The horizontal texture axis of each face must be the same for both handedness conventions, and only the vertical axis is flipped */
+    const Vector3f faceRight[6] =
+    {
+        Vector3f(0, 0, -1), Vector3f(0, 0, 1), Vector3f(1, 0, 0), Vector3f(1, 0, 0), Vector3f(1, 0, 0), Vector3f(-1, 0, 0)
+    };
+    const Vector3f faceForward[6] =
+    {
+        Vector3f(1, 0, 0), Vector3f(-1, 0, 0), Vector3f(0, 1, 0), Vector3f(0, -1, 0), Vector3f(0, 0, 1), Vector3f(0, 0, -1)
+    };
+    const Vector3f faceUpLH[6] =
+    {
+        Vector3f(0, 1, 0), Vector3f(0, 1, 0), Vector3f(0, 0, -1), Vector3f(0, 0, 1), Vector3f(0, 1, 0), Vector3f(0, 1, 0)
+    };
+
+    std::size_t orientationErrors = 0;
+
+    for (int faceFlags : { 0, int(ProjectionFlags::RightHanded) })
+    {
+        const auto faceProjection = CubemapProjection(0.1f, 50.0f, faceFlags);
+        const Vector3f eye(1.0f, -2.0f, 3.0f);
+        const float upSign = (faceFlags != 0 ? -1.0f : 1.0f);
+
+        for (std::size_t f = 0; f < 6; ++f)
+        {
+            const auto view = CubemapFaceView(eye, static_cast<CubemapFace>(f), faceFlags);
+
+            auto projectNDC = [&](const Vector3f& offset)
+            {
+                const Vector3f p = eye + faceForward[f] * 5.0f + offset;
+                const Vector4f viewPoint = TransformVector(view, Vector4f(p.x, p.y, p.z, 1.0f));
+                #ifdef GS_ROW_VECTORS
+                const Vector4f clip = viewPoint * faceProjection;
+                #else
+                const Vector4f clip = faceProjection * viewPoint;
+                #endif
+                return Vector2f(clip.x / clip.w, clip.y / clip.w);
+            };
+
+            const Vector2f center   = projectNDC(Vector3f(0.0f));
+            const Vector2f right    = projectNDC(faceRight[f] * 0.5f);
+            const Vector2f up       = projectNDC(faceUpLH[f] * (0.5f * upSign));
+
+            if (std::abs(center.x) > 1.0e-5f || std::abs(center.y) > 1.0e-5f || right.x <= 0.05f || std::abs(right.y) > 1.0e-5f || up.y <= 0.05f || std::abs(up.x) > 1.0e-5f)
+                ++orientationErrors;
+        }
+    }
+
+    std::cout << "BuildCubemapViews: " << numLights << " eyes x10 (" << durationBatch.count() << " us, per face " << durationScalar.count() << " us), view error = " << viewError;
+    std::cout << ", view-projection error = " << viewProjectionError << ", frustum plane mismatches = " << planeMismatches << " (" << insideCount << " points inside)";
+    std::cout << ", face orientation errors = " << orientationErrors << std::endl;
+}
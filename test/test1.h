@@ -13,6 +13,27 @@
 #include <Gauss/StdMath.h>
 #include <Gauss/HLSLTypes.h>
 #include <Gauss/GLSLTypes.h>
+#include <Gauss/MeshSimplification.h>
+#include <Gauss/MeshNormals.h>
+#include <Gauss/RigidBody.h>
+#include <Gauss/LieGroup.h>
+#include <Gauss/KdTree.h>
+#include <Gauss/SpriteBatch.h>
+#include <Gauss/VoxelTraversal.h>
+#include <Gauss/OcclusionCulling.h>
+#include <Gauss/Polynomial.h>
+#include <Gauss/ConvexHull.h>
+#include <Gauss/PolygonClipping.h>
+#include <Gauss/RotationGenerator.h>
+#include <Gauss/Vector3A.h>
+#include <Gauss/VectorKernels.h>
+#include <Gauss/DescriptorMatching.h>
+#include <Gauss/IntegerVector.h>
+#include <Gauss/Relational.h>
+#include <Gauss/Noise.h>
+#include <Gauss/MatrixFunctions.h>
+#include <Gauss/Orthonormalization.h>
+#include <Gauss/CubemapViews.h>
 
 
 void commonTest1();
@@ -39,6 +60,31 @@ void sseVector4Test1();
 void sseVector4Test2();
 void vector3Test1();
 void matrixInitializerTest1();
+void transformChainTest1();
+void meshSimplificationTest1();
+void vertexNormalsTest1();
+void rigidBodyTest1();
+void lieGroupTest1();
+void kdTreeTest1();
+void triviallyCopyableTest1();
+void castArrayTest1();
+void spriteBatchTest1();
+void voxelTraversalTest1();
+void occlusionCullingTest1();
+void polynomialTest1();
+void convexHullTest1();
+void clippingTest1();
+void rotationGeneratorTest1();
+void vector3ATest1();
+void descriptorMatchingTest1();
+void integerVectorTest1();
+void relationalTest1();
+void shaderMathTest1();
+void noiseTest1();
+void transposeTest1();
+void matrixFunctionTest1();
+void orthonormalizationTest1();
+void cubemapViewsTest1();
 
 
 #endif
@@ -41,6 +41,31 @@ int main()
         sseVector4Test1();
         sseVector4Test2();
         matrixInitializerTest1();
+        transformChainTest1();
+        meshSimplificationTest1();
+        vertexNormalsTest1();
+        rigidBodyTest1();
+        lieGroupTest1();
+        kdTreeTest1();
+        triviallyCopyableTest1();
+        castArrayTest1();
+        spriteBatchTest1();
+        voxelTraversalTest1();
+        occlusionCullingTest1();
+        polynomialTest1();
+        convexHullTest1();
+        clippingTest1();
+        rotationGeneratorTest1();
+        vector3ATest1();
+        descriptorMatchingTest1();
+        integerVectorTest1();
+        relationalTest1();
+        shaderMathTest1();
+        noiseTest1();
+        transposeTest1();
+        matrixFunctionTest1();
+        orthonormalizationTest1();
+        cubemapViewsTest1();
     }
     catch (const std::exception& e)
     {